@@ -0,0 +1,66 @@
+# Patch Triangle so contexts may be used from several threads at once.
+#
+# Triangle keeps its random seed and its exact arithmetic constants in
+# globals.  triangleinit() reset the seed and recomputed the constants for
+# every new context, so a context created on one thread could disturb the
+# predicates of a mesh being built on another.
+#
+#  - randomseed becomes thread local.  A context is created and used on one
+#    thread, so its sequence matches a serial run.
+#  - exactinit() only runs for the first context.  The first context must be
+#    created before any parallel region (TMesh.cpp does this at load time).
+#  - triangle_api.h defines TRIANGLE_THREAD_SAFE so callers can tell a patched
+#    build from a system Triangle.
+#
+# Run with -DSOURCE_DIR=<Triangle source dir> -P Triangle_ThreadSafe.cmake
+
+SET( TRI_C "${SOURCE_DIR}/src/Triangle/triangle.c" )
+SET( TRI_API_H "${SOURCE_DIR}/src/Triangle/triangle_api.h" )
+
+FILE( READ "${TRI_C}" TRI_C_SRC )
+FILE( READ "${TRI_API_H}" TRI_API_SRC )
+
+STRING( FIND "${TRI_API_SRC}" "TRIANGLE_THREAD_SAFE" ALREADY_PATCHED )
+IF( NOT ALREADY_PATCHED EQUAL -1 )
+	RETURN()
+ENDIF()
+
+SET( SEED_OLD "unsigned long randomseed;                     /* Current random number seed. */" )
+SET( SEED_NEW
+"#ifdef _MSC_VER
+__declspec(thread) unsigned long randomseed;   /* Current random number seed. */
+#else
+__thread unsigned long randomseed;             /* Current random number seed. */
+#endif
+
+int exactinitdone = 0;           /* Exact arithmetic constants are computed. */" )
+
+SET( EXACT_OLD "  exactinit();                     /* Initialize exact arithmetic constants. */" )
+SET( EXACT_NEW
+"  if (!exactinitdone) {
+    exactinit();                   /* Initialize exact arithmetic constants. */
+    exactinitdone = 1;
+  }" )
+
+SET( API_OLD "#endif /* TRIANGLE_API_H */" )
+SET( API_NEW
+"/* Contexts may be created and used concurrently once one has been created. */
+#define TRIANGLE_THREAD_SAFE 1
+
+#endif /* TRIANGLE_API_H */" )
+
+FOREACH( PAIR "TRI_C_SRC;SEED_OLD" "TRI_C_SRC;EXACT_OLD" "TRI_API_SRC;API_OLD" )
+	LIST( GET PAIR 0 SRC_VAR )
+	LIST( GET PAIR 1 OLD_VAR )
+	STRING( FIND "${${SRC_VAR}}" "${${OLD_VAR}}" POS )
+	IF( POS EQUAL -1 )
+		MESSAGE( FATAL_ERROR "Triangle_ThreadSafe: ${OLD_VAR} not found, Triangle source has changed" )
+	ENDIF()
+ENDFOREACH()
+
+STRING( REPLACE "${SEED_OLD}" "${SEED_NEW}" TRI_C_SRC "${TRI_C_SRC}" )
+STRING( REPLACE "${EXACT_OLD}" "${EXACT_NEW}" TRI_C_SRC "${TRI_C_SRC}" )
+STRING( REPLACE "${API_OLD}" "${API_NEW}" TRI_API_SRC "${TRI_API_SRC}" )
+
+FILE( WRITE "${TRI_C}" "${TRI_C_SRC}" )
+FILE( WRITE "${TRI_API_H}" "${TRI_API_SRC}" )
@@ -7,6 +7,9 @@ ENDIF()
 
 ExternalProject_Add( TRIANGLE
 	URL ${CMAKE_CURRENT_SOURCE_DIR}/Triangle-cf4d7dbfc799.zip
+	PATCH_COMMAND ${CMAKE_COMMAND}
+		-DSOURCE_DIR=<SOURCE_DIR>
+		-P "${CMAKE_CURRENT_SOURCE_DIR}/Triangle_ThreadSafe.cmake"
 	CMAKE_ARGS -DCMAKE_C_COMPILER=${CMAKE_C_COMPILER}
 		-DCMAKE_CXX_COMPILER=${CMAKE_CXX_COMPILER}
 		-DCMAKE_CXX_FLAGS=${CMAKE_CXX_FLAGS}
@@ -11,6 +11,9 @@
 #include "SubSurfaceMgr.h"
 #include "main.h"
 #include "MeshAnalysis.h"
+#include "FileUtil.h"
+#include "MeshTopology.h"
+#include "ResultsMgr.h"
 
 #ifdef DEBUG_CFD_MESH
 // #include <direct.h>
@@ -921,7 +924,7 @@ void CfdMeshMgrSingleton::WriteTaggedSTL( const string &filename )
     }
 
     //==== Build Map ====//
-    map< int, vector< int > > indMap;
+    PntIndexMap indMap;
     vector< int > pntShift;
     BuildIndMap( allPntVec, indMap, pntShift );
 
@@ -933,9 +936,9 @@ void CfdMeshMgrSingleton::WriteTaggedSTL( const string &filename )
         vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
         for ( int f = 0 ; f <  ( int )sFaceVec.size() ; f++ )
         {
-            int i0 = FindPntIndex( sPntVec[sFaceVec[f].ind0], allPntVec, indMap );
-            int i1 = FindPntIndex( sPntVec[sFaceVec[f].ind1], allPntVec, indMap );
-            int i2 = FindPntIndex( sPntVec[sFaceVec[f].ind2], allPntVec, indMap );
+            int i0 = FindPntIndex( sPntVec[sFaceVec[f].ind0], indMap );
+            int i1 = FindPntIndex( sPntVec[sFaceVec[f].ind1], indMap );
+            int i2 = FindPntIndex( sPntVec[sFaceVec[f].ind2], indMap );
             SimpFace sface;
             sface.ind0 = pntShift[i0];
             sface.ind1 = pntShift[i1];
@@ -944,7 +947,7 @@ void CfdMeshMgrSingleton::WriteTaggedSTL( const string &filename )
             if( sFaceVec[f].m_isQuad )
             {
                 sface.m_isQuad = true;
-                int i3 = FindPntIndex( sPntVec[sFaceVec[f].ind3], allPntVec, indMap );
+                int i3 = FindPntIndex( sPntVec[sFaceVec[f].ind3], indMap );
                 sface.ind3 = pntShift[i3];
             }
 
@@ -962,7 +965,7 @@ void CfdMeshMgrSingleton::WriteTaggedSTL( const string &filename )
         }
     }
 
-    FILE* file_id = fopen( filename.c_str(), "w" );
+    FILE* file_id = OpenExportFile( filename );
     if ( file_id )
     {
         std::vector< int > tags = SubSurfaceMgr.GetAllTags();
@@ -1025,7 +1028,7 @@ void CfdMeshMgrSingleton::WriteTaggedSTL( const string &filename )
 
 void CfdMeshMgrSingleton::WriteSTL( const string &filename )
 {
-    FILE* file_id = fopen( filename.c_str(), "w" );
+    FILE* file_id = OpenExportFile( filename );
     if ( file_id )
     {
         int numwake = 0;
@@ -1061,7 +1064,7 @@ void CfdMeshMgrSingleton::WriteSTL( const string &filename )
 
 void CfdMeshMgrSingleton::WriteTetGen( const string &filename )
 {
-    FILE* fp = fopen( filename.c_str(), "w" );
+    FILE* fp = OpenExportFile( filename );
     if ( !fp )
     {
         return;
@@ -1080,7 +1083,7 @@ void CfdMeshMgrSingleton::WriteTetGen( const string &filename )
     }
 
     //==== Build Map ====//
-    map< int, vector< int > > indMap;
+    PntIndexMap indMap;
     vector< int > pntShift;
     int numPnts = BuildIndMap( allPntVec, indMap, pntShift );
 
@@ -1108,9 +1111,9 @@ void CfdMeshMgrSingleton::WriteTetGen( const string &filename )
         vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
         for ( int f = 0 ; f < ( int )sFaceVec.size() ; f++ )
         {
-            int i0 = FindPntIndex( sPntVec[sFaceVec[f].ind0], allPntVec, indMap );
-            int i1 = FindPntIndex( sPntVec[sFaceVec[f].ind1], allPntVec, indMap );
-            int i2 = FindPntIndex( sPntVec[sFaceVec[f].ind2], allPntVec, indMap );
+            int i0 = FindPntIndex( sPntVec[sFaceVec[f].ind0], indMap );
+            int i1 = FindPntIndex( sPntVec[sFaceVec[f].ind1], indMap );
+            int i2 = FindPntIndex( sPntVec[sFaceVec[f].ind2], indMap );
             int ind1 = pntShift[i0] + 1;
             int ind2 = pntShift[i1] + 1;
             int ind3 = pntShift[i2] + 1;
@@ -1120,7 +1123,7 @@ void CfdMeshMgrSingleton::WriteTetGen( const string &filename )
             fprintf( fp, "1 0 %d\n", tag );
             if( sFaceVec[f].m_isQuad )
             {
-                int i3 = FindPntIndex( sPntVec[sFaceVec[f].ind3], allPntVec, indMap );
+                int i3 = FindPntIndex( sPntVec[sFaceVec[f].ind3], indMap );
                 int ind4 = pntShift[i3] + 1;
 
                 // <# of corners> <corner 1> <corner 2> <corner 3> <corner 4>
@@ -1250,12 +1253,12 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
     }
 
     //==== Build Map ====//
-    map< int, vector< int > > indMap;
+    PntIndexMap indMap;
     vector< int > pntShift;
     BuildIndMap( allPntVec, indMap, pntShift );
 
     //==== Build Wake Map If Available ====//
-    map< int, vector< int > > wakeIndMap;
+    PntIndexMap wakeIndMap;
     vector< int > wakePntShift;
     if ( wakeAllPntVec.size() )
     {
@@ -1277,9 +1280,9 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
             vector< vec2d >& sUWVec = m_SurfVec[i]->GetMesh()->GetSimpUWPntVec();
             for ( int t = 0 ; t <  ( int )sFaceVec.size() ; t++ )
             {
-                int i0 = FindPntIndex( sPntVec[sFaceVec[t].ind0], allPntVec, indMap );
-                int i1 = FindPntIndex( sPntVec[sFaceVec[t].ind1], allPntVec, indMap );
-                int i2 = FindPntIndex( sPntVec[sFaceVec[t].ind2], allPntVec, indMap );
+                int i0 = FindPntIndex( sPntVec[sFaceVec[t].ind0], indMap );
+                int i1 = FindPntIndex( sPntVec[sFaceVec[t].ind1], indMap );
+                int i2 = FindPntIndex( sPntVec[sFaceVec[t].ind2], indMap );
                 SimpFace sface;
                 sface.ind0 = pntShift[i0] + 1;
                 sface.ind1 = pntShift[i1] + 1;
@@ -1288,7 +1291,7 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
                 if( sFaceVec[t].m_isQuad )
                 {
                     sface.m_isQuad = true;
-                    int i3 = FindPntIndex( sPntVec[sFaceVec[t].ind3], allPntVec, indMap );
+                    int i3 = FindPntIndex( sPntVec[sFaceVec[t].ind3], indMap );
                     sface.ind3 = pntShift[i3] + 1;
                     ntristrict++; // Bonus tri for split quad.
                 }
@@ -1323,14 +1326,14 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
                     if ( ( n0 + n1 + n2 + n3 ) == 2 ) // Two true, one or two false.
                     {
                         // Perform index lookup as above.
-                        int i0 = pntShift[ FindPntIndex( sPntVec[sFaceVec[t].ind0], allPntVec, indMap ) ] + 1;
-                        int i1 = pntShift[ FindPntIndex( sPntVec[sFaceVec[t].ind1], allPntVec, indMap ) ] + 1;
-                        int i2 = pntShift[ FindPntIndex( sPntVec[sFaceVec[t].ind2], allPntVec, indMap ) ] + 1;
+                        int i0 = pntShift[ FindPntIndex( sPntVec[sFaceVec[t].ind0], indMap ) ] + 1;
+                        int i1 = pntShift[ FindPntIndex( sPntVec[sFaceVec[t].ind1], indMap ) ] + 1;
+                        int i2 = pntShift[ FindPntIndex( sPntVec[sFaceVec[t].ind2], indMap ) ] + 1;
 
                         int i3 = -1;
                         if( sFaceVec[t].m_isQuad )
                         {
-                            i3 = pntShift[ FindPntIndex( sPntVec[sFaceVec[t].ind3], allPntVec, indMap ) ] + 1;
+                            i3 = pntShift[ FindPntIndex( sPntVec[sFaceVec[t].ind3], indMap ) ] + 1;
                         }
 
                         // Add nodes to wake edges, lowest u first.
@@ -1458,9 +1461,9 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
             vector< vec2d >& sUWVec = m_SurfVec[i]->GetMesh()->GetSimpUWPntVec();
             for ( int f = 0 ; f < ( int )sFaceVec.size() ; f++ )
             {
-                int i0 = FindPntIndex( sPntVec[sFaceVec[f].ind0], wakeAllPntVec, wakeIndMap );
-                int i1 = FindPntIndex( sPntVec[sFaceVec[f].ind1], wakeAllPntVec, wakeIndMap );
-                int i2 = FindPntIndex( sPntVec[sFaceVec[f].ind2], wakeAllPntVec, wakeIndMap );
+                int i0 = FindPntIndex( sPntVec[sFaceVec[f].ind0], wakeIndMap );
+                int i1 = FindPntIndex( sPntVec[sFaceVec[f].ind1], wakeIndMap );
+                int i2 = FindPntIndex( sPntVec[sFaceVec[f].ind2], wakeIndMap );
                 SimpFace sface;
                 sface.ind0 = wakePntShift[i0] + 1 + wakeIndOffset;
                 sface.ind1 = wakePntShift[i1] + 1 + wakeIndOffset;
@@ -1469,7 +1472,7 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
                 if( sFaceVec[f].m_isQuad )
                 {
                     sface.m_isQuad = true;
-                    int i3 = FindPntIndex( sPntVec[sFaceVec[f].ind3], wakeAllPntVec, wakeIndMap );
+                    int i3 = FindPntIndex( sPntVec[sFaceVec[f].ind3], wakeIndMap );
                     sface.ind3 = wakePntShift[i3] + 1 + wakeIndOffset;
                     ntristrict++; // Bonus tri for split quad
                 }
@@ -1507,7 +1510,7 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
     //=====================================================================================//
     if ( dat_fn.length() != 0 )
     {
-        FILE* fp = fopen( dat_fn.c_str(), "w" );
+        FILE* fp = OpenExportFile( dat_fn );
 
         if ( fp )
         {
@@ -1548,7 +1551,7 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
     //=====================================================================================//
     if ( obj_fn.length() != 0 )
     {
-        FILE* fp = fopen( obj_fn.c_str(), "w" );
+        FILE* fp = OpenExportFile( obj_fn );
 
         if ( fp )
         {
@@ -1581,7 +1584,7 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
     //=====================================================================================//
     if ( tri_fn.length() != 0 )
     {
-        FILE* fp = fopen( tri_fn.c_str(), "w" );
+        FILE* fp = OpenExportFile( tri_fn );
 
         if ( fp )
         {
@@ -1623,7 +1626,7 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
     //=====================================================================================//
     if ( gmsh_fn.length() != 0 )
     {
-        FILE* fp = fopen( gmsh_fn.c_str(), "w" );
+        FILE* fp = OpenExportFile( gmsh_fn );
         if ( fp )
         {
             fprintf( fp, "$MeshFormat\n" );
@@ -1668,7 +1671,7 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
     //=====================================================================================//
     if ( vspgeom_fn.length() != 0 )
     {
-        FILE* fp = fopen( vspgeom_fn.c_str(), "w" );
+        FILE* fp = OpenExportFile( vspgeom_fn );
 
         if ( fp )
         {
@@ -1813,7 +1816,7 @@ void CfdMeshMgrSingleton::WriteFacet( const string &facet_fn )
     }
 
     //==== Build Map ====//
-    map< int, vector< int > > indMap;
+    PntIndexMap indMap;
     vector< int > pntShift;
     BuildIndMap( allPntVec, indMap, pntShift );
 
@@ -1827,9 +1830,9 @@ void CfdMeshMgrSingleton::WriteFacet( const string &facet_fn )
             vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
             for ( int f = 0; f < (int)sFaceVec.size(); f++ )
             {
-                int i0 = FindPntIndex( sPntVec[sFaceVec[f].ind0], allPntVec, indMap );
-                int i1 = FindPntIndex( sPntVec[sFaceVec[f].ind1], allPntVec, indMap );
-                int i2 = FindPntIndex( sPntVec[sFaceVec[f].ind2], allPntVec, indMap );
+                int i0 = FindPntIndex( sPntVec[sFaceVec[f].ind0], indMap );
+                int i1 = FindPntIndex( sPntVec[sFaceVec[f].ind1], indMap );
+                int i2 = FindPntIndex( sPntVec[sFaceVec[f].ind2], indMap );
                 SimpFace sface;
                 sface.ind0 = pntShift[i0] + 1;
                 sface.ind1 = pntShift[i1] + 1;
@@ -1838,7 +1841,7 @@ void CfdMeshMgrSingleton::WriteFacet( const string &facet_fn )
                 if ( sFaceVec[f].m_isQuad )
                 {
                     sface.m_isQuad = true;
-                    int i3 = FindPntIndex( sPntVec[sFaceVec[f].ind3], allPntVec, indMap );
+                    int i3 = FindPntIndex( sPntVec[sFaceVec[f].ind3], indMap );
                     sface.ind3 = pntShift[i3] + 1;
                 }
                 allFaceVec.push_back( sface );
@@ -1860,7 +1863,7 @@ void CfdMeshMgrSingleton::WriteFacet( const string &facet_fn )
     //=====================================================================================//
     if ( facet_fn.length() != 0 )
     {
-        FILE* fp = fopen( facet_fn.c_str(), "w" );
+        FILE* fp = OpenExportFile( facet_fn );
 
         if ( fp )
         {
@@ -1954,10 +1957,27 @@ void CfdMeshMgrSingleton::WriteFacet( const string &facet_fn )
     }
 }
 
-string CfdMeshMgrSingleton::CheckWaterTight()
+//==== Offending Edges As Flat Node Pairs And Point Pairs ====//
+static void AddTopologyEdges( Results* res, const string & name, const vector< pair< int, int > > & edge_vec, const vector< Node* > & node_vec )
 {
-    vector< Face* > faceVec;
+    vector< int > ind_vec;
+    vector< vec3d > pnt_vec;
+    ind_vec.reserve( 2 * edge_vec.size() );
+    pnt_vec.reserve( 2 * edge_vec.size() );
+    for ( int i = 0 ; i < ( int )edge_vec.size() ; i++ )
+    {
+        ind_vec.push_back( edge_vec[i].first );
+        ind_vec.push_back( edge_vec[i].second );
+        pnt_vec.push_back( node_vec[ edge_vec[i].first ]->pnt );
+        pnt_vec.push_back( node_vec[ edge_vec[i].second ]->pnt );
+    }
+    res->Add( NameValData( "Num_" + name, ( int )edge_vec.size() ) );
+    res->Add( NameValData( name + "_Nodes", ind_vec ) );
+    res->Add( NameValData( name + "_Pnts", pnt_vec ) );
+}
 
+string CfdMeshMgrSingleton::CheckWaterTight()
+{
     vector< vec3d* > allPntVec;
     for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
     {
@@ -1972,7 +1992,7 @@ string CfdMeshMgrSingleton::CheckWaterTight()
     }
 
     //==== Build Map ====//
-    map< int, vector< int > > indMap;
+    PntIndexMap indMap;
     vector< int > pntShift;
     BuildIndMap( allPntVec, indMap, pntShift );
 
@@ -1987,9 +2007,9 @@ string CfdMeshMgrSingleton::CheckWaterTight()
         }
     }
 
-    //==== Create Edges and Tris ====//
-    int moreThanTwoTriPerEdge = 0;
-    map< int, vector<Edge*> > edgeMap;
+    //==== Index Faces ====//
+    vector< int > faceStart( 1, 0 );
+    vector< int > faceNodes;
     for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
     {
         if( m_SurfVec[i]->GetSurfaceCfdType() != vsp::CFD_TRANSPARENT || m_SurfVec[i]->GetFarFlag() || m_SurfVec[i]->GetSymPlaneFlag() )
@@ -1998,109 +2018,85 @@ string CfdMeshMgrSingleton::CheckWaterTight()
             vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
             for ( int f = 0 ; f < ( int )sFaceVec.size() ; f++ )
             {
-                int i0 = FindPntIndex( sPntVec[sFaceVec[f].ind0], allPntVec, indMap );
-                int i1 = FindPntIndex( sPntVec[sFaceVec[f].ind1], allPntVec, indMap );
-                int i2 = FindPntIndex( sPntVec[sFaceVec[f].ind2], allPntVec, indMap );
-                int ind1 = pntShift[i0];
-                int ind2 = pntShift[i1];
-                int ind3 = pntShift[i2];
-
-                Edge *e0, *e1, *e2, *e3;
+                int i0 = FindPntIndex( sPntVec[sFaceVec[f].ind0], indMap );
+                int i1 = FindPntIndex( sPntVec[sFaceVec[f].ind1], indMap );
+                int i2 = FindPntIndex( sPntVec[sFaceVec[f].ind2], indMap );
+                faceNodes.push_back( pntShift[i0] );
+                faceNodes.push_back( pntShift[i1] );
+                faceNodes.push_back( pntShift[i2] );
 
-                Face* face = NULL;
                 if ( sFaceVec[f].m_isQuad )
                 {
-                    int i3 = FindPntIndex( sPntVec[sFaceVec[f].ind3], allPntVec, indMap );
-                    int ind4 = pntShift[i3];
-
-                    e0 = FindAddEdge( edgeMap, m_nodeStore, ind1, ind2 );
-                    e1 = FindAddEdge( edgeMap, m_nodeStore, ind2, ind3 );
-                    e2 = FindAddEdge( edgeMap, m_nodeStore, ind3, ind4 );
-                    e3 = FindAddEdge( edgeMap, m_nodeStore, ind4, ind1 );
-
-                    face = new Face( m_nodeStore[ind1], m_nodeStore[ind2], m_nodeStore[ind3],  m_nodeStore[ind4], e0, e1, e2, e3 );
-                }
-                else
-                {
-                    e0 = FindAddEdge( edgeMap, m_nodeStore, ind1, ind2 );
-                    e1 = FindAddEdge( edgeMap, m_nodeStore, ind2, ind3 );
-                    e2 = FindAddEdge( edgeMap, m_nodeStore, ind3, ind1 );
-                    face = new Face( m_nodeStore[ind1], m_nodeStore[ind2], m_nodeStore[ind3], e0, e1, e2 );
-                }
-
-                if ( !e0->SetFace( face ) )
-                {
-                    face->debugFlag = true;
-                    moreThanTwoTriPerEdge++;
-                }
-                if ( !e1->SetFace( face ) )
-                {
-                    face->debugFlag = true;
-                    moreThanTwoTriPerEdge++;
-                }
-                if ( !e2->SetFace( face ) )
-                {
-                    face->debugFlag = true;
-                    moreThanTwoTriPerEdge++;
-                }
-
-                if ( sFaceVec[f].m_isQuad )
-                {
-                    if ( !e3->SetFace( face ) )
-                    {
-                        face->debugFlag = true;
-                        moreThanTwoTriPerEdge++;
-                    }
-                }
-
-                faceVec.push_back( face );
-
-                if ( face->debugFlag )
-                {
-                    m_BadFaces.push_back( face );
+                    int i3 = FindPntIndex( sPntVec[sFaceVec[f].ind3], indMap );
+                    faceNodes.push_back( pntShift[i3] );
                 }
+                faceStart.push_back( faceNodes.size() );
             }
         }
     }
 
-    //==== Find Border Edges ====//
-    int num_border_edges = 0;
-    map<int, vector<Edge*> >::const_iterator iter;
-    for ( iter = edgeMap.begin() ; iter != edgeMap.end() ; ++iter )
-    {
-        for ( int i = 0 ; i < ( int )iter->second.size() ; i++ )
-        {
-            Edge* e = iter->second[i];
-            if ( !( e->f0 && e->f1 ) )
-            {
-                m_BadEdges.push_back( e );
-                e->debugFlag = true;
-                num_border_edges++;
-            }
+    //==== Open, Non-Manifold And Flipped Edges In One Pass ====//
+    MeshTopology topo;
+    topo.Check( faceStart, faceNodes );
 
-        }
+    //==== Keep Offending Edges And Faces For Display ====//
+    vector< pair< int, int > > badEdgeVec = topo.m_OpenEdgeVec;
+    badEdgeVec.insert( badEdgeVec.end(), topo.m_NonManifoldEdgeVec.begin(), topo.m_NonManifoldEdgeVec.end() );
+    badEdgeVec.insert( badEdgeVec.end(), topo.m_FlippedEdgeVec.begin(), topo.m_FlippedEdgeVec.end() );
+    for ( int i = 0 ; i < ( int )badEdgeVec.size() ; i++ )
+    {
+        Edge* e = new Edge( m_nodeStore[ badEdgeVec[i].first ], m_nodeStore[ badEdgeVec[i].second ] );
+        e->debugFlag = true;
+        m_BadEdges.push_back( e );
     }
 
-    //==== Clean Up ====//
-    for ( iter = edgeMap.begin() ; iter != edgeMap.end() ; ++iter )
+    vector< int > badFaceVec = topo.m_ExcessFaceVec;
+    badFaceVec.insert( badFaceVec.end(), topo.m_FlippedFaceVec.begin(), topo.m_FlippedFaceVec.end() );
+    badFaceVec.insert( badFaceVec.end(), topo.m_DegenerateFaceVec.begin(), topo.m_DegenerateFaceVec.end() );
+    std::sort( badFaceVec.begin(), badFaceVec.end() );
+    badFaceVec.erase( std::unique( badFaceVec.begin(), badFaceVec.end() ), badFaceVec.end() );
+    for ( int i = 0 ; i < ( int )badFaceVec.size() ; i++ )
     {
-        for ( int i = 0 ; i < ( int )iter->second.size() ; i++ )
+        int s = faceStart[ badFaceVec[i] ];
+        Face* face = NULL;
+        if ( faceStart[ badFaceVec[i] + 1 ] - s == 4 )
         {
-            if ( ! iter->second[i]->debugFlag )
-            {
-                delete iter->second[i];
-            }
+            face = new Face( m_nodeStore[ faceNodes[s] ], m_nodeStore[ faceNodes[s + 1] ], m_nodeStore[ faceNodes[s + 2] ], m_nodeStore[ faceNodes[s + 3] ],
+                             NULL, NULL, NULL, NULL );
         }
-    }
-    for ( int i = 0 ; i < ( int )faceVec.size() ; i++ )
-    {
-        if ( ! faceVec[i]->debugFlag )
+        else
         {
-            delete faceVec[i];
+            face = new Face( m_nodeStore[ faceNodes[s] ], m_nodeStore[ faceNodes[s + 1] ], m_nodeStore[ faceNodes[s + 2] ], NULL, NULL, NULL );
         }
+        face->debugFlag = true;
+        m_BadFaces.push_back( face );
+    }
+
+    //==== Results For Automated Checks ====//
+    // Nodes are numbered as merged above and faces in surface order, the same
+    // numbering the mesh files are written with.
+    Results* res = ResultsMgr.CreateResults( "CFD_Mesh_Topology" );
+    if ( res )
+    {
+        res->Add( NameValData( "Num_Nodes", ( int )m_nodeStore.size() ) );
+        res->Add( NameValData( "Num_Faces", topo.m_NumFaces ) );
+        res->Add( NameValData( "Num_Edges", topo.m_NumEdges ) );
+        res->Add( NameValData( "Water_Tight", ( int )topo.IsWaterTight() ) );
+        res->Add( NameValData( "Oriented", ( int )topo.IsOriented() ) );
+        AddTopologyEdges( res, "Open_Edges", topo.m_OpenEdgeVec, m_nodeStore );
+        AddTopologyEdges( res, "NonManifold_Edges", topo.m_NonManifoldEdgeVec, m_nodeStore );
+        AddTopologyEdges( res, "Flipped_Edges", topo.m_FlippedEdgeVec, m_nodeStore );
+        res->Add( NameValData( "Open_Edge_Faces", topo.m_OpenEdgeFaceVec ) );
+        res->Add( NameValData( "Excess_Faces", topo.m_ExcessFaceVec ) );
+        res->Add( NameValData( "Flipped_Faces", topo.m_FlippedFaceVec ) );
+        res->Add( NameValData( "Degenerate_Faces", topo.m_DegenerateFaceVec ) );
     }
 
+    int num_border_edges = topo.m_OpenEdgeVec.size();
+    int moreThanTwoTriPerEdge = topo.m_NumExcessUses;
+
     char resultStr[255];
+    string resultTxt;
     if ( num_border_edges || moreThanTwoTriPerEdge )
     {
         sprintf( resultStr, "NOT Water Tight : %d Border Edges, %d Edges > 2 Tris\n",
@@ -2110,121 +2106,29 @@ string CfdMeshMgrSingleton::CheckWaterTight()
     {
         sprintf( resultStr, "Is Water Tight\n" );
     }
+    resultTxt = resultStr;
 
-    return string( resultStr );
-
-}
-
-Edge* CfdMeshMgrSingleton::FindAddEdge( map< int, vector<Edge*> > & edgeMap, vector< Node* > & nodeVec, int ind1, int ind2 )
-{
-    Edge* e = NULL;
-    map<int, vector<Edge*> >::const_iterator iter;
-    int combind = ind1 + ind2;
-    iter = edgeMap.find( combind );
-
-    if ( iter != edgeMap.end() )    // Found Edge Vec so Check
+    if ( !topo.IsOriented() )
     {
-        vector<Edge*> eVec = edgeMap[combind];
-        for ( int i = 0 ; i < ( int )eVec.size() ; i++ )
-        {
-            if ( eVec[i]->ContainsNodes( nodeVec[ind1], nodeVec[ind2] ) )
-            {
-                return eVec[i];
-            }
-        }
+        sprintf( resultStr, "NOT Oriented : %d Edges With Matching Direction\n", ( int )topo.m_FlippedEdgeVec.size() );
+        resultTxt += resultStr;
     }
 
-    //==== No Edge Found so Create
-    e = new Edge( nodeVec[ind1], nodeVec[ind2] );
-    edgeMap[combind].push_back( e );
-
-    return e;
+    return resultTxt;
 }
 
-int CfdMeshMgrSingleton::BuildIndMap( vector< vec3d* > & allPntVec, map< int, vector< int > >& indMap, vector< int > & pntShift )
+int CfdMeshMgrSingleton::BuildIndMap( vector< vec3d* > & allPntVec, PntIndexMap& indMap, vector< int > & pntShift )
 {
-//double max_dist = 0.0;
     double tol = 1.0e-12;
-    map<int, vector<int> >::const_iterator iter;
-    for ( int i = 0 ; i < ( int )allPntVec.size() ; i++ )
-    {
-        int combind = ( int )( ( allPntVec[i]->x() + allPntVec[i]->y() + allPntVec[i]->z() ) * 10000.0 );
-        iter = indMap.find( combind );
-        if ( iter == indMap.end() ) // Add Index
-        {
-            indMap[combind].push_back( i );
-        }
-        else
-        {
-            bool addIndexFlag = true;
-            for ( int j = 0 ; j < ( int )iter->second.size() ; j++ )
-            {
-                int testind = iter->second[j];
-
-                if ( std::abs( allPntVec[i]->x() - allPntVec[testind]->x() ) < tol  &&
-                        std::abs( allPntVec[i]->y() - allPntVec[testind]->y() ) < tol  &&
-                        std::abs( allPntVec[i]->z() - allPntVec[testind]->z() ) < tol  )
-                {
-                    addIndexFlag = false;
-                }
-            }
-            if ( addIndexFlag )
-            {
-                indMap[combind].push_back( i );
-            }
-        }
-    }
-
-    //==== Figure Out Point Shifts ====//
-    pntShift.resize( allPntVec.size() );
-    for ( int i = 0 ; i < ( int )pntShift.size() ; i++ )
-    {
-        pntShift[i] = -999;
-    }
-
-    for ( iter = indMap.begin() ; iter != indMap.end() ; ++iter )
-    {
-        for ( int i = 0 ; i < ( int )iter->second.size() ; i++ )
-        {
-            int ind = iter->second[i];
-            pntShift[ind] = 1;
-        }
-    }
-
-    int cnt = 0;
-    for ( int i = 0 ; i < ( int )pntShift.size() ; i++ )
-    {
-        if ( pntShift[i] > 0 )
-        {
-            pntShift[i] = cnt;
-            cnt++;
-        }
-    }
-
-    return cnt;
-
+    return indMap.Build( allPntVec, tol, pntShift );
 }
 
-int  CfdMeshMgrSingleton::FindPntIndex(  vec3d& pnt, vector< vec3d* > & allPntVec, map< int, vector< int > >& indMap )
+int  CfdMeshMgrSingleton::FindPntIndex(  vec3d& pnt, PntIndexMap& indMap )
 {
-    double tol = 1.0e-12;
-    map<int, vector<int> >::const_iterator iter;
-
-    int combind = ( int )( ( pnt.x() + pnt.y() + pnt.z() ) * 10000.0 );
-    iter = indMap.find( combind );
-    if ( iter != indMap.end() )
+    int ind = indMap.Find( pnt );
+    if ( ind >= 0 )
     {
-        for ( int j = 0 ; j < ( int )iter->second.size() ; j++ )
-        {
-            int testind = iter->second[j];
-
-            if ( std::abs( pnt.x() - allPntVec[testind]->x() ) < tol  &&
-                    std::abs( pnt.y() - allPntVec[testind]->y() ) < tol  &&
-                    std::abs( pnt.z() - allPntVec[testind]->z() ) < tol  )
-            {
-                return testind;
-            }
-        }
+        return ind;
     }
 
     printf( "Error: CfdMeshMgr.FindPntIndex can't find index\n" );
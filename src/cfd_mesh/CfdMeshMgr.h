@@ -70,6 +70,7 @@
 #include "Vec3d.h"
 #include "DrawObj.h"
 #include "XferSurf.h"
+#include "PntNodeMerge.h"
 
 #include <cassert>
 
@@ -157,12 +158,10 @@ public:
 
     void ExportFiles() override;
     //virtual void CheckDupOrAdd( Node* node, vector< Node* > & nodeVec );
-    virtual int BuildIndMap( vector< vec3d* > & allPntVec, map< int, vector< int > >& indMap, vector< int > & pntShift );
-    virtual int  FindPntIndex( vec3d& pnt, vector< vec3d* > & allPntVec,
-                               map< int, vector< int > >& indMap );
+    virtual int BuildIndMap( vector< vec3d* > & allPntVec, PntIndexMap& indMap, vector< int > & pntShift );
+    virtual int  FindPntIndex( vec3d& pnt, PntIndexMap& indMap );
 
     virtual string CheckWaterTight();
-    virtual Edge* FindAddEdge( map< int, vector<Edge*> > & edgeMap, vector< Node* > & nodeVec, int ind1, int ind2 );
 
     virtual void BuildDomain();
     void BuildGrid() override;
@@ -6,6 +6,7 @@
 #include "main.h"  // For version numbers
 #include "StructureMgr.h"
 #include "FeaMeshMgr.h"
+#include "FileUtil.h"
 
 FeaMesh::FeaMesh( string & struct_id )
 {
@@ -53,7 +54,7 @@ void FeaMesh::Cleanup()
 
     m_FixPntVec.clear();
 
-    m_IndMap.clear();
+    m_IndMap.Clear();
     m_PntShift.clear();
 
     m_StructName = "";
@@ -768,7 +769,7 @@ void FeaMesh::WriteNASTRAN()
 {
     string fn = GetStructSettingsPtr()->GetExportFileName( vsp::FEA_NASTRAN_FILE_NAME );
 
-    FILE* fp = fopen( fn.c_str(), "w" ); // Open *_NASTRAN.dat
+    FILE* fp = OpenExportFile( fn ); // Open *_NASTRAN.dat
 
     // Create temporary file to store NASTRAN bulk data. Case control information (SETs) will be
     //  defined in the *_NASTRAN.dat file prior to the bulk data (elements, gridpoints, etc.)
@@ -1179,7 +1180,7 @@ void FeaMesh::WriteNASTRANSet( FILE* Nastran_fid, FILE* NKey_fid, int & set_num,
 void FeaMesh::WriteCalculix()
 {
     string fn = GetStructSettingsPtr()->GetExportFileName( vsp::FEA_CALCULIX_FILE_NAME );
-    FILE* fp = fopen( fn.c_str(), "w" );
+    FILE* fp = OpenExportFile( fn );
 
     if ( fp )
     {
@@ -1763,7 +1764,7 @@ void FeaMesh::WriteGmsh()
     int eoffset = m_StructSettings.m_ElementOffset;
 
     string fn = GetStructSettingsPtr()->GetExportFileName( vsp::FEA_GMSH_FILE_NAME );
-    FILE* fp = fopen( fn.c_str(), "w" );
+    FILE* fp = OpenExportFile( fn );
     if ( fp )
     {
         //=====================================================================================//
@@ -1837,7 +1838,7 @@ void FeaMesh::WriteGmsh()
 void FeaMesh::WriteSTL()
 {
     string fn = GetStructSettingsPtr()->GetExportFileName( vsp::FEA_STL_FILE_NAME );
-    FILE* fp = fopen( fn.c_str(), "w" );
+    FILE* fp = OpenExportFile( fn );
     if ( fp )
     {
         for ( unsigned int i = 0; i < m_NumFeaParts; i++ )
@@ -9,6 +9,7 @@
 #include "SimpleMeshSettings.h"
 #include "SimpleSubSurface.h"
 #include "SimpleBC.h"
+#include "PntNodeMerge.h"
 
 void CloseNASTRAN( FILE* fp, FILE* temp, FILE* nkey_fp );
 
@@ -147,7 +148,7 @@ public:
 
     vector< FeaNode* > m_FeaNodeVec;
     vector< vec3d* > m_AllPntVec;
-    map< int, vector< int > > m_IndMap;
+    PntIndexMap m_IndMap;
     vector< int > m_PntShift;
 
     vector < FixPoint > m_FixPntVec; // Fix point data map.
@@ -13,6 +13,7 @@
 #include "main.h"
 #include "StringUtil.h"
 #include "MeshAnalysis.h"
+#include "FileUtil.h"
 #include "StlHelper.h"
 #include "MessageMgr.h"
 #include "VspUtil.h"
@@ -1223,8 +1224,8 @@ void FeaMeshMgrSingleton::BuildFeaMesh()
     BndBox bb = m_Vehicle->GetBndBox();
     double tol = bb.GetLargestDist() * 1.0e-10;
 
-    //==== Use NanoFlann to Find Close Points and Group ====//
-    IndexPntNodes( pnCloud, tol );
+    //==== Use Hash Grid to Find Close Points and Group ====//
+    WeldPntNodes( pnCloud, tol );
 
     //==== Load Used Nodes ====//
     vector < vec3d > node_vec;
@@ -2284,7 +2285,7 @@ void FeaMeshMgrSingleton::TagFeaNodes()
     }
 
     //==== Build Node Map ====//
-    GetMeshPtr()->m_IndMap.clear();
+    GetMeshPtr()->m_IndMap.Clear();
     GetMeshPtr()->m_PntShift.clear();
     BuildIndMap( m_AllPntVec, GetMeshPtr()->m_IndMap, GetMeshPtr()->m_PntShift );
 
@@ -2292,7 +2293,7 @@ void FeaMeshMgrSingleton::TagFeaNodes()
     for ( int i = 0; i < (int)GetMeshPtr()->m_FeaNodeVec.size(); i++ )
     {
         GetMeshPtr()->m_FeaNodeVec[i]->m_Tags.clear();
-        int ind = FindPntIndex( GetMeshPtr()->m_FeaNodeVec[i]->m_Pnt, m_AllPntVec, GetMeshPtr()->m_IndMap );
+        int ind = FindPntIndex( GetMeshPtr()->m_FeaNodeVec[i]->m_Pnt, GetMeshPtr()->m_IndMap );
         GetMeshPtr()->m_FeaNodeVec[i]->m_Index = GetMeshPtr()->m_PntShift[ind] + 1;
     }
 
@@ -2311,7 +2312,7 @@ void FeaMeshMgrSingleton::TagFeaNodes()
 
         for ( int j = 0; j < (int)temp_nVec.size(); j++ )
         {
-            int ind = FindPntIndex( temp_nVec[j]->m_Pnt, m_AllPntVec, GetMeshPtr()->m_IndMap );
+            int ind = FindPntIndex( temp_nVec[j]->m_Pnt, GetMeshPtr()->m_IndMap );
             GetMeshPtr()->m_FeaNodeVec[ind]->AddTag( i );
         }
     }
@@ -2331,7 +2332,7 @@ void FeaMeshMgrSingleton::TagFeaNodes()
 
         for ( int j = 0; j < (int)temp_nVec.size(); j++ )
         {
-            int ind = FindPntIndex( temp_nVec[j]->m_Pnt, m_AllPntVec, GetMeshPtr()->m_IndMap );
+            int ind = FindPntIndex( temp_nVec[j]->m_Pnt, GetMeshPtr()->m_IndMap );
             GetMeshPtr()->m_FeaNodeVec[ind]->AddTag( i + GetMeshPtr()->m_NumFeaParts );
         }
     }
@@ -2350,7 +2351,7 @@ void FeaMeshMgrSingleton::TagFeaNodes()
                     GetMeshPtr()->m_FeaNodeVec[i]->AddTag( fxpt.m_FeaPartIndex );
                     GetMeshPtr()->m_FeaNodeVec[i]->m_FixedPointFlag = true;
 
-                    int ind = FindPntIndex( GetMeshPtr()->m_FeaNodeVec[i]->m_Pnt, m_AllPntVec, GetMeshPtr()->m_IndMap );
+                    int ind = FindPntIndex( GetMeshPtr()->m_FeaNodeVec[i]->m_Pnt, GetMeshPtr()->m_IndMap );
 
                     // Set fix point node index here.
                     GetMeshPtr()->m_FixPntVec[j].m_NodeIndex[k] = GetMeshPtr()->m_PntShift[ind] + 1;
@@ -2649,7 +2650,7 @@ void FeaMeshMgrSingleton::ExportAssemblyMesh( const string &assembly_id )
 void FeaMeshMgrSingleton::WriteAssemblyCalculix( const string &assembly_id, const FeaCount &feacount )
 {
     string fn = m_AssemblySettings.GetExportFileName( vsp::FEA_CALCULIX_FILE_NAME );
-    FILE* fp = fopen( fn.c_str(), "w" );
+    FILE* fp = OpenExportFile( fn );
 
     if ( fp )
     {
@@ -2834,7 +2835,7 @@ void FeaMeshMgrSingleton::WriteAssemblyNASTRAN( const string &assembly_id, const
 {
     string fn = m_AssemblySettings.GetExportFileName( vsp::FEA_NASTRAN_FILE_NAME );
 
-    FILE* fp = fopen( fn.c_str(), "w" );
+    FILE* fp = OpenExportFile( fn );
 
     // Create temporary file to store NASTRAN bulk data. Case control information (SETs) will be
     //  defined in the *_NASTRAN.dat file prior to the bulk data (elements, gridpoints, etc.)
@@ -430,6 +430,10 @@ enum INTERSECT_EXPORT_TYPE { INTERSECT_SRF_FILE_NAME,
                              INTERSECT_NUM_FILE_NAMES
                            };
 
+enum INT_EXT_MODE { INT_EXT_PER_TRI = 0,    // One ray parity test per triangle
+                    INT_EXT_REGION,         // One ray parity vote per region bounded by intersection curves
+                  }; // CompGeom Interior/Exterior Classification ENUM
+
 enum LEN_UNITS { LEN_MM,
                  LEN_CM,
                  LEN_M,
@@ -439,6 +443,10 @@ enum LEN_UNITS { LEN_MM,
                  LEN_UNITLESS
                };
 
+enum MASS_PROP_ENGINE { MASS_PROP_SLICE = 0,            // Extruded prisms on slice planes
+                        MASS_PROP_SURFACE_INTEGRAL,     // Divergence theorem integrals over trimmed surfaces
+                      }; // Mass Properties Method ENUM
+
 enum MASS_UNIT { MASS_UNIT_G = 0,
                  MASS_UNIT_KG,
                  MASS_UNIT_TONNE,
@@ -471,6 +479,10 @@ enum PCURV_TYPE { LINEAR,
                   NUM_PCURV_TYPE
                 };
 
+enum PLANAR_SLICE_ENGINE { PLANAR_SLICE_MESH = 0,     // Slice mesh per station intersected with the vehicle
+                           PLANAR_SLICE_SWEEP,        // Vehicle trimmed once as in CompGeom, then one sweep for all stations, results only
+                         }; // Planar Slice Method ENUM
+
 enum PRES_UNITS { PRES_UNIT_PSF = 0,
                   PRES_UNIT_PSI,
                   PRES_UNIT_BA,
@@ -29,6 +29,7 @@
 #include "VKTAirfoil.h"
 #include "StructureMgr.h"
 #include "FeaMeshMgr.h"
+#include "UpdateProfileMgr.h"
 #include "main.h"
 
 #include "eli/mutil/quad/simpson.hpp"
@@ -152,6 +153,20 @@ void Update( bool update_managers )
     ErrorMgr.NoError();
 }
 
+void SetHeadlessMode( bool headless )
+{
+    Vehicle* veh = GetVehicle();
+    veh->SetHeadless( headless );
+    ErrorMgr.NoError();
+}
+
+bool GetHeadlessMode()
+{
+    Vehicle* veh = GetVehicle();
+    ErrorMgr.NoError();
+    return veh->IsHeadless();
+}
+
 
 void VSPExit( int error_code )
 {
@@ -1567,6 +1582,40 @@ void PrintResults( const string &results_id )
     ResultsMgr.PrintResults( results_id );
 }
 
+void StartUpdateProfile( bool trace_flag )
+{
+    UpdateProfileMgr.Start( trace_flag );
+    ErrorMgr.NoError();
+}
+
+void StopUpdateProfile()
+{
+    UpdateProfileMgr.Stop();
+    ErrorMgr.NoError();
+}
+
+string CreateUpdateProfileResults()
+{
+    string rid = UpdateProfileMgr.CreateResults();
+    if ( rid.size() == 0 )
+    {
+        ErrorMgr.AddError( VSP_INVALID_PTR, "CreateUpdateProfileResults::Unable to create Update_Profile results" );
+        return rid;
+    }
+    ErrorMgr.NoError();
+    return rid;
+}
+
+void WriteUpdateProfileTrace( const string & file_name )
+{
+    if ( !UpdateProfileMgr.WriteChromeTrace( file_name ) )
+    {
+        ErrorMgr.AddError( VSP_FILE_WRITE_FAILURE, "WriteUpdateProfileTrace::Unable to write " + file_name );
+        return;
+    }
+    ErrorMgr.NoError();
+}
+
 //===================================================================//
 //===============        GUI Functions            ===================//
 //===================================================================//
@@ -1574,6 +1623,7 @@ void PrintResults( const string &results_id )
 extern void StartGui( )
 {
 #ifdef VSP_USE_FLTK
+    GetVehicle()->SetHeadless( false );
     GuiInterface::getInstance().StartGuiAPI( );
 #endif
 }
@@ -1581,6 +1631,7 @@ extern void StartGui( )
 void ScreenGrab( const string & fname, int w, int h, bool transparentBG, bool autocrop )
 {
 #ifdef VSP_USE_FLTK
+    GetVehicle()->SetHeadless( false );
     GuiInterface::getInstance().ScreenGrab( fname, w, h, transparentBG, autocrop );
 #endif
 }
@@ -35,6 +35,8 @@ extern void VSPCheckSetup();
 extern void VSPRenew();
 
 extern void Update( bool update_managers = true );
+extern void SetHeadlessMode( bool headless );
+extern bool GetHeadlessMode();
 extern void VSPExit( int error_code );
 
 extern std::string GetVSPVersion();
@@ -131,6 +133,10 @@ extern void DeleteAllResults();
 extern void DeleteResult( const std::string & id );
 extern void WriteResultsCSVFile( const std::string & id, const std::string & file_name );
 extern void PrintResults( const std::string &results_id );
+extern void StartUpdateProfile( bool trace_flag = false );
+extern void StopUpdateProfile();
+extern std::string CreateUpdateProfileResults();
+extern void WriteUpdateProfileTrace( const std::string & file_name );
 
 //======================== GUI Functions ================================//
 extern void StartGui( );
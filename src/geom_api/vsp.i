@@ -2,4 +2,9 @@
 %module vsp
 %include vsp_common.i
 
+/* No GUI until StartGui, so skip display only work in updates */
+%init %{
+    vsp::SetHeadlessMode( true );
+%}
+
 
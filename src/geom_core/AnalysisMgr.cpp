@@ -810,10 +810,12 @@ void MassPropAnalysis::SetDefaults()
     if ( veh )
     {
         m_Inputs.Add( NameValData( "NumMassSlices", veh->m_NumMassSlices.Get() ) );
+        m_Inputs.Add( NameValData( "MassPropEngine", veh->m_MassPropEngine.Get() ) );
     }
     else
     {
         m_Inputs.Add( NameValData( "NumMassSlices", 20 ) );
+        m_Inputs.Add( NameValData( "MassPropEngine", vsp::MASS_PROP_SLICE ) );
     }
 }
 
@@ -842,8 +844,17 @@ string MassPropAnalysis::Execute()
             numMassSlice = nvd->GetInt( 0 );
         }
 
+        int engineOrig = veh->m_MassPropEngine.Get();
+        nvd = m_Inputs.FindPtr( "MassPropEngine", 0 );
+        if ( nvd )
+        {
+            veh->m_MassPropEngine.Set( nvd->GetInt( 0 ) );
+        }
+
         string geom = veh->MassPropsAndFlatten( geomSet, numMassSlice );
 
+        veh->m_MassPropEngine.Set( engineOrig );
+
         res = ResultsMgr.FindLatestResultsID( "Mass_Properties" );
     }
 
@@ -874,6 +885,7 @@ void PlanarSliceAnalysis::SetDefaults()
     m_Inputs.Add( NameValData( "AutoBoundFlag", veh->m_AutoBoundsFlag.Get() ) );
     m_Inputs.Add( NameValData( "StartVal", veh->m_PlanarStartLocation.Get() ) );
     m_Inputs.Add( NameValData( "EndVal", veh->m_PlanarEndLocation.Get() ) );
+    m_Inputs.Add( NameValData( "PlanarSliceEngine", veh->m_PlanarSliceEngine.Get() ) );
 }
 
 string PlanarSliceAnalysis::Execute()
@@ -936,7 +948,28 @@ string PlanarSliceAnalysis::Execute()
             end = nvd->GetDouble( 0 );
         }
 
-        string geom = veh->PSliceAndFlatten( geomSet, numSlice,  axis,  autobnd,  start,  end  );
+        int engineOrig = veh->m_PlanarSliceEngine.Get();
+        nvd = m_Inputs.FindPtr( "PlanarSliceEngine", 0 );
+        if ( nvd )
+        {
+            veh->m_PlanarSliceEngine.Set( nvd->GetInt( 0 ) );
+        }
+
+        if ( veh->m_PlanarSliceEngine() == vsp::PLANAR_SLICE_SWEEP )
+        {
+            // No slice meshes to keep, only the results.
+            string geom = veh->PSlice( geomSet, numSlice, axis, autobnd, start, end, false );
+            if ( veh->FindGeom( geom ) )
+            {
+                veh->DeleteGeomVec( vector< string >( 1, geom ) );
+            }
+        }
+        else
+        {
+            string geom = veh->PSliceAndFlatten( geomSet, numSlice,  axis,  autobnd,  start,  end  );
+        }
+
+        veh->m_PlanarSliceEngine.Set( engineOrig );
 
         res = ResultsMgr.FindLatestResultsID( "Slice" );
     }
@@ -0,0 +1,267 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// CompGeomCache.cpp
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "CompGeomCache.h"
+#include "Geom.h"
+#include "Vehicle.h"
+
+#include <string.h>
+
+//==== Exact Copy, Including Node Coordinate Info ====//
+static TMesh* CopyCachedTMesh( TMesh* tm )
+{
+    TMesh* new_tm = new TMesh();
+    new_tm->copy( tm );
+
+    for ( int t = 0 ; t < ( int )tm->m_TVec.size() ; t++ )
+    {
+        new_tm->m_TVec[t]->m_N0->CopyFrom( tm->m_TVec[t]->m_N0 );
+        new_tm->m_TVec[t]->m_N1->CopyFrom( tm->m_TVec[t]->m_N1 );
+        new_tm->m_TVec[t]->m_N2->CopyFrom( tm->m_TVec[t]->m_N2 );
+    }
+    return new_tm;
+}
+
+//===============================================================================//
+//===============================================================================//
+
+CompGeomCacheEntry::CompGeomCacheEntry()
+{
+    m_UpdateCount = -1;
+}
+
+void CompGeomCacheEntry::Clear()
+{
+    for ( int i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
+    {
+        delete m_TMeshVec[i];
+    }
+    m_TMeshVec.clear();
+    m_CacheIDVec.clear();
+    m_BvhVec.clear();
+    m_BvhScaleVec.clear();
+}
+
+//===============================================================================//
+//===============================================================================//
+
+CompGeomCache::CompGeomCache()
+{
+    m_NextCacheID = 0;
+    ResetStats();
+}
+
+CompGeomCache::~CompGeomCache()
+{
+    Clear();
+}
+
+void CompGeomCache::Clear()
+{
+    map< string, CompGeomCacheEntry >::iterator it;
+    for ( it = m_EntryMap.begin() ; it != m_EntryMap.end() ; ++it )
+    {
+        it->second.Clear();
+    }
+    m_EntryMap.clear();
+    m_MeshMap.clear();
+    m_PairMap.clear();
+}
+
+void CompGeomCache::ResetStats()
+{
+    m_MeshHits = 0;
+    m_MeshMisses = 0;
+    m_PairHits = 0;
+    m_PairMisses = 0;
+}
+
+vector< TMesh* > CompGeomCache::CreateTMeshVec( Geom* geom )
+{
+    vector< TMesh* > tMeshVec;
+
+    // MeshGeom meshes can be changed without an update.
+    if ( geom->GetType().m_Type == MESH_GEOM_TYPE )
+    {
+        return geom->CreateTMeshVec();
+    }
+
+    Matrix4d mat = geom->getModelMatrix();
+
+    map< string, CompGeomCacheEntry >::iterator it = m_EntryMap.find( geom->GetID() );
+    if ( it != m_EntryMap.end() )
+    {
+        CompGeomCacheEntry & entry = it->second;
+
+        if ( entry.m_UpdateCount == geom->m_UpdateCount &&
+             memcmp( entry.m_ModelMatrix.data(), mat.data(), 16 * sizeof( double ) ) == 0 )
+        {
+            m_MeshHits++;
+
+            for ( int i = 0 ; i < ( int )entry.m_TMeshVec.size() ; i++ )
+            {
+                TMesh* tm = CopyCachedTMesh( entry.m_TMeshVec[i] );
+
+                // Names and mass properties do not dirty the Geom, refresh them.
+                int cfdtype = tm->m_SurfCfdType;
+                tm->LoadGeomAttributes( geom );
+                tm->m_SurfCfdType = cfdtype;
+
+                tm->m_CacheID = entry.m_CacheIDVec[i];
+                tMeshVec.push_back( tm );
+            }
+            return tMeshVec;
+        }
+
+        //==== Stale - Drop Meshes And Any Pairs That Used Them ====//
+        RemovePairs( entry.m_CacheIDVec );
+        entry.Clear();
+        m_EntryMap.erase( it );
+    }
+
+    m_MeshMisses++;
+
+    tMeshVec = geom->CreateTMeshVec();
+
+    CompGeomCacheEntry entry;
+    entry.m_UpdateCount = geom->m_UpdateCount;
+    entry.m_ModelMatrix = mat;
+    entry.m_BvhVec.resize( tMeshVec.size() );
+    entry.m_BvhScaleVec.resize( tMeshVec.size(), 0.0 );
+
+    for ( int i = 0 ; i < ( int )tMeshVec.size() ; i++ )
+    {
+        int cache_id = m_NextCacheID++;
+
+        entry.m_TMeshVec.push_back( CopyCachedTMesh( tMeshVec[i] ) );
+        entry.m_CacheIDVec.push_back( cache_id );
+        m_MeshMap[ cache_id ] = pair< string, int >( geom->GetID(), i );
+
+        tMeshVec[i]->m_CacheID = cache_id;
+    }
+
+    m_EntryMap[ geom->GetID() ] = entry;
+
+    return tMeshVec;
+}
+
+void CompGeomCache::Prune( Vehicle* veh )
+{
+    vector< string > remove_vec;
+
+    map< string, CompGeomCacheEntry >::iterator it;
+    for ( it = m_EntryMap.begin() ; it != m_EntryMap.end() ; ++it )
+    {
+        if ( !veh->FindGeom( it->first ) )
+        {
+            remove_vec.push_back( it->first );
+        }
+    }
+
+    for ( int i = 0 ; i < ( int )remove_vec.size() ; i++ )
+    {
+        CompGeomCacheEntry & entry = m_EntryMap[ remove_vec[i] ];
+        RemovePairs( entry.m_CacheIDVec );
+        entry.Clear();
+        m_EntryMap.erase( remove_vec[i] );
+    }
+}
+
+void CompGeomCache::RemovePairs( const vector< int > & cache_id_vec )
+{
+    for ( int i = 0 ; i < ( int )cache_id_vec.size() ; i++ )
+    {
+        m_MeshMap.erase( cache_id_vec[i] );
+    }
+
+    map< pair< int, int >, CompGeomPairEntry >::iterator it = m_PairMap.begin();
+    while ( it != m_PairMap.end() )
+    {
+        bool remove = false;
+        for ( int i = 0 ; i < ( int )cache_id_vec.size() ; i++ )
+        {
+            if ( it->first.first == cache_id_vec[i] || it->first.second == cache_id_vec[i] )
+            {
+                remove = true;
+                break;
+            }
+        }
+
+        if ( remove )
+        {
+            m_PairMap.erase( it++ );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+const TBvh* CompGeomCache::FindBvh( int cache_id, double scale )
+{
+    map< int, pair< string, int > >::iterator mit = m_MeshMap.find( cache_id );
+    if ( mit == m_MeshMap.end() )
+    {
+        return NULL;
+    }
+
+    CompGeomCacheEntry & entry = m_EntryMap[ mit->second.first ];
+    int i = mit->second.second;
+
+    if ( entry.m_BvhScaleVec[i] != scale || entry.m_BvhVec[i].IsEmpty() )
+    {
+        return NULL;
+    }
+    return &entry.m_BvhVec[i];
+}
+
+void CompGeomCache::StoreBvh( int cache_id, double scale, const TBvh & bvh )
+{
+    map< int, pair< string, int > >::iterator mit = m_MeshMap.find( cache_id );
+    if ( mit == m_MeshMap.end() )
+    {
+        return;
+    }
+
+    CompGeomCacheEntry & entry = m_EntryMap[ mit->second.first ];
+    int i = mit->second.second;
+
+    entry.m_BvhVec[i] = bvh;
+    entry.m_BvhScaleVec[i] = scale;
+}
+
+const CompGeomPairEntry* CompGeomCache::FindPair( int cache_id0, int cache_id1, double scale )
+{
+    if ( cache_id0 < 0 || cache_id1 < 0 )
+    {
+        m_PairMisses++;
+        return NULL;
+    }
+
+    map< pair< int, int >, CompGeomPairEntry >::iterator it = m_PairMap.find( pair< int, int >( cache_id0, cache_id1 ) );
+    if ( it == m_PairMap.end() || it->second.m_Scale != scale )
+    {
+        m_PairMisses++;
+        return NULL;
+    }
+
+    m_PairHits++;
+    return &it->second;
+}
+
+void CompGeomCache::StorePair( int cache_id0, int cache_id1, const CompGeomPairEntry & pair_entry )
+{
+    if ( cache_id0 < 0 || cache_id1 < 0 )
+    {
+        return;
+    }
+
+    m_PairMap[ pair< int, int >( cache_id0, cache_id1 ) ] = pair_entry;
+}
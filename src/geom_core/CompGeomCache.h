@@ -0,0 +1,101 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// CompGeomCache.h: Reuse of tessellation and intersection work between CompGeom runs
+//
+// Each Geom's TMeshes are kept along with the Geom update count and model
+// matrix they were built for.  A Geom that has not been updated since is
+// handed copies instead of being tessellated again.  Every cached mesh gets a
+// cache ID, which is carried by the copies (TMesh::m_CacheID) until they are
+// modified.  Trees and intersection segments of meshes with cache IDs are
+// stored against the IDs and the CompGeom scale, so only pairs involving a
+// changed component are intersected again.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(COMPGEOMCACHE__INCLUDED_)
+#define COMPGEOMCACHE__INCLUDED_
+
+#include "TMesh.h"
+
+#include <map>
+
+class Geom;
+class Vehicle;
+
+//==== Cached Tessellation For One Geom ====//
+class CompGeomCacheEntry
+{
+public:
+    CompGeomCacheEntry();
+
+    // Entries are copied in and out of the cache map, so the meshes are only
+    // deleted here and never in a destructor.
+    void Clear();
+
+    int m_UpdateCount;
+    Matrix4d m_ModelMatrix;
+
+    vector< TMesh* > m_TMeshVec;        // Unscaled, untouched output of Geom::CreateTMeshVec
+    vector< int > m_CacheIDVec;
+
+    vector< TBvh > m_BvhVec;            // Built at m_BvhScaleVec, empty until first use
+    vector< double > m_BvhScaleVec;
+};
+
+//==== Cached Intersection Segments For One Mesh Pair ====//
+class CompGeomPairEntry
+{
+public:
+    CompGeomPairEntry()
+    {
+        m_Scale = 0.0;
+    }
+
+    double m_Scale;
+
+    vector< TISectSeg > m_SegVec;
+};
+
+class CompGeomCache
+{
+public:
+    CompGeomCache();
+    virtual ~CompGeomCache();
+
+    virtual void Clear();
+    virtual void ResetStats();
+
+    // Same result as geom->CreateTMeshVec(), from the cache when the Geom is unchanged.
+    virtual vector< TMesh* > CreateTMeshVec( Geom* geom );
+
+    // Drop entries for Geoms no longer in the vehicle.
+    virtual void Prune( Vehicle* veh );
+
+    // Returns NULL when no tree is stored for this mesh at this scale.
+    virtual const TBvh* FindBvh( int cache_id, double scale );
+    virtual void StoreBvh( int cache_id, double scale, const TBvh & bvh );
+
+    // Returns NULL on a miss.  Pairs are stored in the order they were intersected.
+    virtual const CompGeomPairEntry* FindPair( int cache_id0, int cache_id1, double scale );
+    virtual void StorePair( int cache_id0, int cache_id1, const CompGeomPairEntry & pair_entry );
+
+    int m_MeshHits;
+    int m_MeshMisses;
+    int m_PairHits;
+    int m_PairMisses;
+
+protected:
+
+    virtual void RemovePairs( const vector< int > & cache_id_vec );
+
+    map< string, CompGeomCacheEntry > m_EntryMap;                   // Keyed by Geom ID
+    map< int, pair< string, int > > m_MeshMap;                      // Cache ID to Geom ID and mesh index
+    map< pair< int, int >, CompGeomPairEntry > m_PairMap;
+
+    int m_NextCacheID;
+};
+
+#endif // !defined(COMPGEOMCACHE__INCLUDED_)
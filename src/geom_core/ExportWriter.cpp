@@ -0,0 +1,119 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// ExportWriter.cpp
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "ExportWriter.h"
+
+#include <stdarg.h>
+#include <string.h>
+#include <algorithm>
+
+// Blocks held in memory at once.
+static const int BLOCKS_PER_PASS = 64;
+
+ExportBuffer::ExportBuffer()
+{
+    m_Size = 0;
+}
+
+//==== Same Text As fprintf With The Same Arguments ====//
+void ExportBuffer::Printf( const char* format, ... )
+{
+    if ( m_Buf.size() < m_Size + 256 )
+    {
+        m_Buf.resize( std::max( 2 * m_Buf.size(), m_Size + 256 ) );
+    }
+
+    va_list args;
+    va_start( args, format );
+    int len = vsnprintf( &m_Buf[m_Size], m_Buf.size() - m_Size, format, args );
+    va_end( args );
+
+    if ( len < 0 )
+    {
+        return;
+    }
+
+    if ( m_Size + len >= m_Buf.size() )
+    {
+        m_Buf.resize( std::max( 2 * m_Buf.size(), m_Size + len + 1 ) );
+
+        va_start( args, format );
+        vsnprintf( &m_Buf[m_Size], m_Buf.size() - m_Size, format, args );
+        va_end( args );
+    }
+    m_Size += len;
+}
+
+void ExportBuffer::Append( const char* str )
+{
+    size_t len = strlen( str );
+    if ( m_Buf.size() < m_Size + len )
+    {
+        m_Buf.resize( std::max( 2 * m_Buf.size(), m_Size + len ) );
+    }
+    memcpy( &m_Buf[m_Size], str, len );
+    m_Size += len;
+}
+
+//===============================================================================//
+//===============================================================================//
+
+void ExportWriter::Write( FILE* fp, const ExportFormatter & formatter, int block_size )
+{
+    if ( !fp )
+    {
+        return;
+    }
+
+    int nitem = formatter.NumItems();
+    int nblock = ( nitem + block_size - 1 ) / block_size;
+
+    vector< ExportBuffer > buf_vec( std::min( nblock, BLOCKS_PER_PASS ) );
+
+    for ( int first = 0 ; first < nblock ; first += BLOCKS_PER_PASS )
+    {
+        int npass = std::min( BLOCKS_PER_PASS, nblock - first );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+        for ( int b = 0 ; b < npass ; b++ )
+        {
+            ExportBuffer & buf = buf_vec[b];
+            buf.Clear();
+
+            int start = ( first + b ) * block_size;
+            int end = std::min( start + block_size, nitem );
+            for ( int i = start ; i < end ; i++ )
+            {
+                formatter.Format( i, buf );
+            }
+        }
+
+        //==== Write In Block Order ====//
+        for ( int b = 0 ; b < npass ; b++ )
+        {
+            if ( buf_vec[b].Size() )
+            {
+                fwrite( buf_vec[b].Data(), 1, buf_vec[b].Size(), fp );
+            }
+        }
+    }
+}
+
+void ExportWriter::FormatSTLFacet( const vec3d & norm, const vec3d & v0, const vec3d & v1, const vec3d & v2, ExportBuffer & buf )
+{
+    buf.Printf( " facet normal  %2.10le %2.10le %2.10le\n",  norm.x(), norm.y(), norm.z() );
+    buf.Append( "   outer loop\n" );
+    buf.Printf( "     vertex %2.10le %2.10le %2.10le\n", v0.x(), v0.y(), v0.z() );
+    buf.Printf( "     vertex %2.10le %2.10le %2.10le\n", v1.x(), v1.y(), v1.z() );
+    buf.Printf( "     vertex %2.10le %2.10le %2.10le\n", v2.x(), v2.y(), v2.z() );
+    buf.Append( "   endloop\n" );
+    buf.Append( " endfacet\n" );
+}
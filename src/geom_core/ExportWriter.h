@@ -0,0 +1,79 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// ExportWriter.h: Block parallel text formatting for tessellated exports
+//
+// An export is described by an ExportFormatter that produces the text of one
+// item (node, tri, facet ...) at a time.  Blocks of items are formatted in
+// parallel into separate buffers, which are then written in item order.
+// Formatting goes through vsnprintf with the exporter's own format strings,
+// so the file is byte for byte what per item fprintf calls would give.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(EXPORTWRITER__INCLUDED_)
+#define EXPORTWRITER__INCLUDED_
+
+#include "Vec3d.h"
+
+#include <stdio.h>
+#include <vector>
+
+using std::vector;
+
+//==== Growable Text Buffer ====//
+class ExportBuffer
+{
+public:
+    ExportBuffer();
+
+    void Printf( const char* format, ... );
+    void Append( const char* str );
+    void Clear()
+    {
+        m_Size = 0;
+    }
+
+    const char* Data() const
+    {
+        return m_Buf.empty() ? NULL : &m_Buf[0];
+    }
+    size_t Size() const
+    {
+        return m_Size;
+    }
+
+protected:
+
+    vector< char > m_Buf;
+    size_t m_Size;
+};
+
+//==== Text Of Each Item Of An Export ====//
+class ExportFormatter
+{
+public:
+    virtual ~ExportFormatter()
+    {
+    }
+
+    virtual int NumItems() const = 0;
+
+    // Append the text of item i.  Called concurrently for different items.
+    virtual void Format( int i, ExportBuffer & buf ) const = 0;
+};
+
+namespace ExportWriter
+{
+const int DEFAULT_BLOCK_SIZE = 4096;
+
+// Formats all items of formatter and writes them to fp in order.
+void Write( FILE* fp, const ExportFormatter & formatter, int block_size = DEFAULT_BLOCK_SIZE );
+
+// One ASCII STL facet.
+void FormatSTLFacet( const vec3d & norm, const vec3d & v0, const vec3d & v1, const vec3d & v2, ExportBuffer & buf );
+}
+
+#endif // !defined(EXPORTWRITER__INCLUDED_)
@@ -555,6 +555,19 @@ void FeaStructure::UpdateFeaSubSurfs()
     }
 }
 
+void FeaStructure::UpdatePendingDrawObjs()
+{
+    for ( unsigned int i = 0; i < m_FeaPartVec.size(); i++ )
+    {
+        m_FeaPartVec[i]->UpdatePendingDrawObjs();
+    }
+
+    for ( unsigned int i = 0; i < m_FeaSubSurfVec.size(); i++ )
+    {
+        m_FeaSubSurfVec[i]->UpdatePendingDrawObjs();
+    }
+}
+
 void FeaStructure::UpdateFeaBCs()
 {
     for ( unsigned int i = 0; i < m_FeaBCVec.size(); i++ )
@@ -1066,6 +1079,7 @@ FeaPart::FeaPart( const string &geomID, const string &structID, int type )
     m_StructID = structID;
 
     m_MainSurfIndx = 0;
+    m_PendingDrawObjs = false;
 
     m_IncludedElements.Init( "IncludedElements", "FeaPart", this, vsp::FEA_SHELL, vsp::FEA_SHELL, vsp::FEA_NUM_ELEMENT_TYPES - 1 );
     m_IncludedElements.SetDescript( "Indicates the FeaElements to be Included for the FeaPart" );
@@ -1109,7 +1123,25 @@ void FeaPart::Update()
 
     UpdateSymmParts();
 
+    // Nothing is drawn in headless runs until something asks.
+    Vehicle* veh = VehicleMgr.GetVehicle();
+    if ( veh && veh->IsHeadless() )
+    {
+        m_PendingDrawObjs = true;
+        return;
+    }
+
     UpdateDrawObjs();
+    m_PendingDrawObjs = false;
+}
+
+void FeaPart::UpdatePendingDrawObjs()
+{
+    if ( m_PendingDrawObjs )
+    {
+        UpdateDrawObjs();
+        m_PendingDrawObjs = false;
+    }
 }
 
 void FeaPart::UpdateFlags()
@@ -1378,6 +1410,8 @@ void FeaPart::DeleteFeaPartSurf( int ind )
 
 void FeaPart::LoadDrawObjs( std::vector< DrawObj* > & draw_obj_vec )
 {
+    UpdatePendingDrawObjs();
+
     for ( int i = 0; i < (int)m_FeaPartDO.size(); i++ )
     {
         draw_obj_vec.push_back( &m_FeaPartDO[ i ] );
@@ -96,6 +96,7 @@ public:
     FeaPart* GetFeaSkin();
 
     void UpdateFeaSubSurfs();
+    void UpdatePendingDrawObjs(); // Draw objects left by headless updates
     void HighlightFeaParts( vector < int > active_ind_vec );
     void RecolorFeaSubSurfs( vector < int > active_ind_vec );
     SubSurface* AddFeaSubSurf( int type );
@@ -233,6 +234,7 @@ public:
 
     virtual void LoadDrawObjs( std::vector< DrawObj* > & draw_obj_vec );
     virtual void UpdateDrawObjs();
+    virtual void UpdatePendingDrawObjs(); // Draw objects left by a headless Update
     virtual void SetDrawObjHighlight ( bool highlight );
 
     virtual int GetType()
@@ -279,6 +281,7 @@ public:
 protected:
 
     int m_FeaPartType;
+    bool m_PendingDrawObjs;
 
     string m_ParentGeomID;
     string m_StructID;
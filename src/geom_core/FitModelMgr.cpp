@@ -1312,6 +1312,8 @@ void FitModelMgrSingleton::AddSelectedPts( string tgtGeomID )
     {
         vector < string > ptclouds = veh->GetPtCloudGeoms();
 
+        vector < PtCloudGeom* > shown_clouds;
+        long long nsel_total = 0;
         for ( int i = 0; i < ( int ) ptclouds.size(); i++ )
         {
             string gid = ptclouds[i];
@@ -1323,10 +1325,32 @@ void FitModelMgrSingleton::AddSelectedPts( string tgtGeomID )
 
                 if ( pt_cloud )
                 {
-                    pt_cloud->GetSelectedPoints( targetCandidates );
+                    shown_clouds.push_back( pt_cloud );
+                    nsel_total += pt_cloud->GetNumSelected();
                 }
             }
         }
+
+        //==== Large Selections Are Fit Through An Even Sample ====//
+        long long max_pts = veh->m_MaxFitPts();
+        long long nsel_before = 0;
+        for ( int i = 0; i < ( int ) shown_clouds.size(); i++ )
+        {
+            long long nsel = shown_clouds[i]->GetNumSelected();
+            if ( nsel_total > max_pts )
+            {
+                int quota = ( nsel_before + nsel ) * max_pts / nsel_total - nsel_before * max_pts / nsel_total;
+                if ( quota > 0 )
+                {
+                    shown_clouds[i]->GetSelectedPoints( targetCandidates, quota );
+                }
+            }
+            else
+            {
+                shown_clouds[i]->GetSelectedPoints( targetCandidates );
+            }
+            nsel_before += nsel;
+        }
     }
 
     for ( int i = 0; i < ( int )targetCandidates.size(); i++ )
@@ -15,6 +15,7 @@
 #include "SubSurfaceMgr.h"
 #include "HingeGeom.h"
 #include "VspUtil.h"
+#include "UpdateProfileMgr.h"
 using namespace vsp;
 
 #include <float.h>
@@ -110,6 +111,8 @@ GeomBase::GeomBase( Vehicle* vehicle_ptr )
     m_TessDirty = true;
     m_HighlightDirty = true;
     m_FeaDirty = true;
+
+    m_UpdateCount = 0;
 }
 
 //==== Destructor ====//
@@ -126,8 +129,9 @@ GeomBase::~GeomBase()
 // Surf - everything else (requires re-lofting m_MainSurfVec)
 // Tess - tessellation resolution (requires re-tessellation)
 // Highlight - active section highlighting
+// Attribute - no update stage at all (mass properties, wake settings, output Parms)
 //
-// This works in conjunction with strategic caching.  m_MainSurfVec, m_SurfVec, m_MainTessVec, m_TessVec are all
+// This works in conjunction with strategic caching.  m_MainSurfVec, m_SurfVec, m_MainTessVec, m_TessInstVec are all
 // cached to allow minimal updates according to the classified dirty flags.
 //
 // In the future, additional groups may be added.  In particular, a group that only updates the OpenGL visualization,
@@ -147,62 +151,95 @@ GeomBase::~GeomBase()
 //
 // Rob McDonald 11/6/2020
 //
-void GeomBase::SetDirtyFlags( Parm* parm_ptr )
+// Parms may now carry their classification (Parm::SetUpdateType), set where they are Init'ed.  The string
+// matching in ClassifyParm remains the fallback for Parms left as UPDATE_DEFAULT.
+//
+int GeomBase::ClassifyParm( Parm* parm_ptr )
 {
-    if ( !parm_ptr )
-    {
-        return;
-    }
-
     string gname = parm_ptr->GetGroupName();
     string pname = parm_ptr->GetName();
 
     if ( gname == string("XForm") && pname != string("Scale") && pname != string("Last_Scale") )
     {
-        m_XFormDirty = true;
+        return Parm::UPDATE_XFORM;
     }
     else if ( gname == string( "Attach") || gname == string( "Sym") )
     {
-        m_XFormDirty = true;
+        return Parm::UPDATE_XFORM;
     }
     else if ( gname == string("Shape") && ( pname == string("Tess_U") || pname == string("Tess_W") ) )
     {
-        m_TessDirty = true;
+        return Parm::UPDATE_TESS;
     }
     else if ( gname == string("XSec") && pname == string("SectTess_U") )
     {
-        m_TessDirty = true;
+        return Parm::UPDATE_TESS;
     }
     else if ( gname == string("EndCap") && pname == string("CapUMinTess") )
     {
         // This captures all geoms
-        m_TessDirty = true;
+        return Parm::UPDATE_TESS;
     }
     else if ( pname == string("LECluster") || pname == string("TECluster") ||
               pname == string("InCluster") || pname == string("OutCluster") )
     {
         // This captures wings, propellers, and bodies of revolution clustering
-        m_TessDirty = true;
+        return Parm::UPDATE_TESS;
     }
     else if ( gname == string("BBox") )
     {
         // Don't dirty anything, BBox Parms are output Parms and should not trigger updates.
+        return Parm::UPDATE_ATTRIBUTE;
     }
     else if ( gname == string("Index") )
     {
-        m_HighlightDirty = true;
         // GeomXSec::m_ActiveXSec
         // WingGeom::m_ActiveAirfoil
+        return Parm::UPDATE_HIGHLIGHT;
     }
     else if ( gname.substr(0, 3) == string("Fea") )
+    {
+        return Parm::UPDATE_FEA;
+    }
+
+    return Parm::UPDATE_SURF;
+}
+
+int GeomBase::SetDirtyFlags( Parm* parm_ptr )
+{
+    if ( !parm_ptr )
+    {
+        return Parm::UPDATE_DEFAULT;
+    }
+
+    int update_type = parm_ptr->GetUpdateType();
+    if ( update_type == Parm::UPDATE_DEFAULT )
+    {
+        update_type = ClassifyParm( parm_ptr );
+    }
+
+    if ( update_type == Parm::UPDATE_XFORM )
+    {
+        m_XFormDirty = true;
+    }
+    else if ( update_type == Parm::UPDATE_TESS )
+    {
+        m_TessDirty = true;
+    }
+    else if ( update_type == Parm::UPDATE_HIGHLIGHT )
+    {
+        m_HighlightDirty = true;
+    }
+    else if ( update_type == Parm::UPDATE_FEA )
     {
         m_FeaDirty = true;
     }
-    else
+    else if ( update_type == Parm::UPDATE_SURF )
     {
         m_SurfDirty = true;
     }
 
+    return update_type;
 }
 
 void GeomBase::SetDirtyFlag( int dflag )
@@ -232,11 +269,12 @@ void GeomBase::SetDirtyFlag( int dflag )
 //==== Parm Changed ====//
 void GeomBase::ParmChanged( Parm* parm_ptr, int type )
 {
+    int update_type = Parm::UPDATE_DEFAULT;
     if ( parm_ptr )
     {
         m_UpdatedParmVec.push_back( parm_ptr->GetID() );
 
-        SetDirtyFlags( parm_ptr );
+        update_type = SetDirtyFlags( parm_ptr );
     }
 
     if ( type == Parm::SET )
@@ -254,7 +292,11 @@ void GeomBase::ParmChanged( Parm* parm_ptr, int type )
         }
     }
 
-    Update();
+    // Nothing in this Geom or its children depends on attribute only Parms.
+    if ( update_type != Parm::UPDATE_ATTRIBUTE )
+    {
+        Update();
+    }
     m_Vehicle->ParmChanged( parm_ptr, type );
     m_UpdatedParmVec.clear();
 }
@@ -455,48 +497,68 @@ GeomXForm::GeomXForm( Vehicle* vehicle_ptr ) : GeomBase( vehicle_ptr )
 
     m_XLoc.Init( "X_Location", "XForm", this, 0.0, -1.0e12, 1.0e12 );
     m_XLoc.SetDescript( "Global X Location" );
+    m_XLoc.SetUpdateType( Parm::UPDATE_XFORM );
     m_YLoc.Init( "Y_Location", "XForm", this, 0.0, -1.0e12, 1.0e12 );
     m_YLoc.SetDescript( "Global Y Location" );
+    m_YLoc.SetUpdateType( Parm::UPDATE_XFORM );
     m_ZLoc.Init( "Z_Location", "XForm", this, 0.0, -1.0e12, 1.0e12 );
     m_ZLoc.SetDescript( "Global Z Location" );
+    m_ZLoc.SetUpdateType( Parm::UPDATE_XFORM );
     m_XRot.Init( "X_Rotation", "XForm", this, 0.0, -180, 180 );
     m_XRot.SetDescript( "Global X Rotation" );
+    m_XRot.SetUpdateType( Parm::UPDATE_XFORM );
     m_YRot.Init( "Y_Rotation", "XForm", this, 0.0, -180, 180 );
     m_YRot.SetDescript( "Global Y Rotation" );
+    m_YRot.SetUpdateType( Parm::UPDATE_XFORM );
     m_ZRot.Init( "Z_Rotation", "XForm", this, 0.0,  -180, 180 );
     m_ZRot.SetDescript( "Global Z Rotation" );
+    m_ZRot.SetUpdateType( Parm::UPDATE_XFORM );
     m_Origin.Init( "Origin", "XForm", this, 0.0, 0, 1 );
     m_Origin.SetDescript( "Rotation Origin" );
+    m_Origin.SetUpdateType( Parm::UPDATE_XFORM );
 
     m_XRelLoc.Init( "X_Rel_Location", "XForm", this, 0.0, -1.0e12, 1.0e12 );
     m_XRelLoc.SetDescript( "X Location Relative to Parent" );
+    m_XRelLoc.SetUpdateType( Parm::UPDATE_XFORM );
     m_YRelLoc.Init( "Y_Rel_Location", "XForm", this, 0.0, -1.0e12, 1.0e12 );
     m_YRelLoc.SetDescript( "Y Location Relative to Parent" );
+    m_YRelLoc.SetUpdateType( Parm::UPDATE_XFORM );
     m_ZRelLoc.Init( "Z_Rel_Location", "XForm", this, 0.0, -1.0e12, 1.0e12 );
     m_ZRelLoc.SetDescript( "Z Location Relative to Parent" );
+    m_ZRelLoc.SetUpdateType( Parm::UPDATE_XFORM );
     m_XRelRot.Init( "X_Rel_Rotation", "XForm", this, 0.0, -180, 180 );
     m_XRelRot.SetDescript( "X Rotation Relative to Parent" );
+    m_XRelRot.SetUpdateType( Parm::UPDATE_XFORM );
     m_YRelRot.Init( "Y_Rel_Rotation", "XForm", this, 0.0, -180, 180 );
     m_YRelRot.SetDescript( "Y Rotation Relative to Parent" );
+    m_YRelRot.SetUpdateType( Parm::UPDATE_XFORM );
     m_ZRelRot.Init( "Z_Rel_Rotation", "XForm", this, 0.0, -180, 180 );
     m_ZRelRot.SetDescript( "Z Rotation Relative to Parent" );
+    m_ZRelRot.SetUpdateType( Parm::UPDATE_XFORM );
 
     // Attachment Parms
     m_AbsRelFlag.Init( "Abs_Or_Relitive_flag", "XForm", this, vsp::REL, vsp::ABS, vsp::REL );
+    m_AbsRelFlag.SetUpdateType( Parm::UPDATE_XFORM );
     m_TransAttachFlag.Init( "Trans_Attach_Flag", "Attach", this, vsp::ATTACH_TRANS_NONE, vsp::ATTACH_TRANS_NONE, vsp::ATTACH_TRANS_UV );
     m_TransAttachFlag.SetDescript( "Determines relative translation coordinate system" );
+    m_TransAttachFlag.SetUpdateType( Parm::UPDATE_XFORM );
     m_RotAttachFlag.Init( "Rots_Attach_Flag", "Attach", this, vsp::ATTACH_ROT_NONE, vsp::ATTACH_ROT_NONE, vsp::ATTACH_ROT_UV );
     m_RotAttachFlag.SetDescript( "Determines relative rotation axes" );
+    m_RotAttachFlag.SetUpdateType( Parm::UPDATE_XFORM );
     m_ULoc.Init( "U_Attach_Location", "Attach", this, 1e-6, 1e-6, 1 - 1e-6 );
     m_ULoc.SetDescript( "U Location of Parent's Surface" );
+    m_ULoc.SetUpdateType( Parm::UPDATE_XFORM );
     m_WLoc.Init( "V_Attach_Location", "Attach", this, 1e-6, 1e-6, 1 - 1e-6 );
     m_WLoc.SetDescript( "V Location of Parent's Surface" );
+    m_WLoc.SetUpdateType( Parm::UPDATE_XFORM );
 
     m_Scale.Init( "Scale", "XForm", this, 1, 1.0e-3, 1.0e3 );
     m_Scale.SetDescript( "Scale Geometry Size" );
+    m_Scale.SetUpdateType( Parm::UPDATE_SURF );
 
     m_LastScale.Init( "Last_Scale", "XForm", this, 1, 1.0e-3, 1.0e3 );
     m_LastScale.SetDescript( "Last Scale Value" );
+    m_LastScale.SetUpdateType( Parm::UPDATE_SURF );
     m_LastScale = m_Scale();
 
     m_ignoreAbsFlag = false;
@@ -868,54 +930,82 @@ Geom::Geom( Vehicle* vehicle_ptr ) : GeomXForm( vehicle_ptr )
 {
     m_UpdateBlock = false;
 
+    m_DeferTessFlag = false;
+    m_PendingMainTess = false;
+    m_PendingTess = false;
+    m_PendingDrawObj = false;
+    m_PendingHighlightDrawObj = false;
+    m_PendingMainDegenPreview = false;
+    m_PendingDegenPreview = false;
+
     m_Name = "Geom";
     m_Type.m_Type = GEOM_GEOM_TYPE;
     m_Type.m_Name = m_Name;
 
     m_TessU.Init( "Tess_U", "Shape", this, 8, 2,  1000 );
     m_TessU.SetDescript( "Number of tessellated curves in the U direction" );
+    m_TessU.SetUpdateType( Parm::UPDATE_TESS );
     m_TessW.Init( "Tess_W", "Shape", this, 9, 2,  1001 );
     m_TessW.SetDescript( "Number of tessellated curves in the W direction" );
     m_TessW.SetMultShift( 4, 1 );
+    m_TessW.SetUpdateType( Parm::UPDATE_TESS );
 
     //==== Wake Parms ====//
     m_WakeActiveFlag.Init( "Wake", "Shape", this, false, 0, 1 );
     m_WakeActiveFlag.SetDescript( "Flag that indicates if this WingGeom has wakes attached" );
+    m_WakeActiveFlag.SetUpdateType( Parm::UPDATE_ATTRIBUTE );
 
     m_WakeScale.Init( "WakeScale", "WakeSettings", this, 2.0, 1.0, 1.0e12 ); // decrease min???
     m_WakeScale.SetDescript( "Wake length scale" );
+    m_WakeScale.SetUpdateType( Parm::UPDATE_ATTRIBUTE );
 
     m_WakeAngle.Init( "WakeAngle", "WakeSettings", this, 0.0, -89.9, 89.9 );
     m_WakeAngle.SetDescript( "Wake angle in degrees" );
+    m_WakeAngle.SetUpdateType( Parm::UPDATE_ATTRIBUTE );
 
     m_BbXLen.Init( "X_Len", "BBox", this, 0, 0, 1e12 );
     m_BbXLen.SetDescript( "X length of geom bounding box" );
+    m_BbXLen.SetUpdateType( Parm::UPDATE_ATTRIBUTE );
     m_BbYLen.Init( "Y_Len", "BBox", this, 0, 0, 1e12 );
     m_BbYLen.SetDescript( "Y length of geom bounding box" );
+    m_BbYLen.SetUpdateType( Parm::UPDATE_ATTRIBUTE );
     m_BbZLen.Init( "Z_Len", "BBox", this, 0, 0, 1e12 );
     m_BbZLen.SetDescript( "Z length of geom bounding box" );
+    m_BbZLen.SetUpdateType( Parm::UPDATE_ATTRIBUTE );
     m_BbXMin.Init( "X_Min", "BBox", this, 0, -1e12, 1e12 );
     m_BbXMin.SetDescript( "Minimum X coordinate of geom bounding box" );
+    m_BbXMin.SetUpdateType( Parm::UPDATE_ATTRIBUTE );
     m_BbYMin.Init( "Y_Min", "BBox", this, 0, -1e12, 1e12 );
     m_BbYMin.SetDescript( "Minimum Y coordinate of geom bounding box" );
+    m_BbYMin.SetUpdateType( Parm::UPDATE_ATTRIBUTE );
     m_BbZMin.Init( "Z_Min", "BBox", this, 0, -1e12, 1e12 );
     m_BbZMin.SetDescript( "Minimum Z coordinate of geom bounding box" );
+    m_BbZMin.SetUpdateType( Parm::UPDATE_ATTRIBUTE );
 
     m_SymAncestor.Init( "Sym_Ancestor", "Sym", this, 1, 0, 1e6 );
+    m_SymAncestor.SetUpdateType( Parm::UPDATE_XFORM );
     m_SymAncestOriginFlag.Init( "Sym_Ancestor_Origin_Flag", "Sym", this, true, 0, 1 );
+    m_SymAncestOriginFlag.SetUpdateType( Parm::UPDATE_XFORM );
     m_SymPlanFlag.Init( "Sym_Planar_Flag", "Sym", this, 0, 0, SYM_XY | SYM_XZ | SYM_YZ );
+    m_SymPlanFlag.SetUpdateType( Parm::UPDATE_XFORM );
     m_SymAxFlag.Init( "Sym_Axial_Flag", "Sym", this, 0, 0, SYM_ROT_Z );
+    m_SymAxFlag.SetUpdateType( Parm::UPDATE_XFORM );
     m_SymRotN.Init( "Sym_Rot_N", "Sym", this, 2, 2, 1000 );
+    m_SymRotN.SetUpdateType( Parm::UPDATE_XFORM );
 
     // Mass Properties
     m_Density.Init( "Density", "Mass_Props", this, 1, 0.0, 1e12 );
     m_Density.SetDescript("Volumetric density (mass/len^3)");
+    m_Density.SetUpdateType( Parm::UPDATE_ATTRIBUTE );
     m_MassArea.Init( "Mass_Area", "Mass_Props", this, 1, 0.0, 1e12 );
     m_MassArea.SetDescript("Areal density (mass/len^2)");
+    m_MassArea.SetUpdateType( Parm::UPDATE_ATTRIBUTE );
     m_MassPrior.Init( "Mass_Prior", "Mass_Props", this, 0, 0, 1e12 );
     m_MassPrior.SetDescript("Priority for volume overlap.  Highest priority wins.");
+    m_MassPrior.SetUpdateType( Parm::UPDATE_ATTRIBUTE );
     m_ShellFlag.Init( "Shell_Flag", "Mass_Props", this, false, 0, 1 );
     m_ShellFlag.SetDescript("Flag to turn on/off area-based mass contribution");
+    m_ShellFlag.SetUpdateType( Parm::UPDATE_ATTRIBUTE );
 
     // Negative Volume Properties
     m_NegativeVolumeFlag.Init( "Negative_Volume_Flag", "Negative_Volume_Props", this, false, 0, 1);
@@ -1126,6 +1216,11 @@ void Geom::Update( bool fullupdate )
 
     m_CappingDone = false;
 
+    if ( m_XFormDirty || m_SurfDirty || m_TessDirty )
+    {
+        m_UpdateCount++;
+    }
+
     if ( m_SurfDirty )
     {
         double sf = m_Scale() / m_LastScale();
@@ -1138,22 +1233,35 @@ void Geom::Update( bool fullupdate )
     UpdateSets();
 
     if ( m_SurfDirty )
+    {
+        UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::SURF_STAGE );
         UpdateSurf();       // Must be implemented by subclass.
+    }
 
     if ( m_XFormDirty )
+    {
+        UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::XFORM_STAGE );
         UpdateXForm();
+    }
 
     if ( m_SurfDirty )
+    {
+        UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::END_CAPS_STAGE );
         UpdateEndCaps();
+    }
 
     if ( fullupdate )
     {
         if ( m_SurfDirty )
+        {
+            UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::FEATURE_LINES_STAGE );
             UpdateFeatureLines();
+        }
     }
 
     if ( m_SurfDirty )
     {
+        UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::FLAGS_STAGE );
         UpdateFlags();  // Needs to be after m_MainSurfVec is populated, but before m_SurfVec
     }
 
@@ -1161,29 +1269,38 @@ void Geom::Update( bool fullupdate )
     // Needs to be before m_MainSurfVec is copied to m_SurfVec.
     if ( m_SurfDirty || m_TessDirty )
     {
+        UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::PRE_TESS_STAGE );
         UpdatePreTess();
     }
 
     if ( m_XFormDirty || m_SurfDirty )
     {
-        UpdateSymmAttach();  // Needs to happen for both XForm and Surf updates.
+        {
+            UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::SYMM_ATTACH_STAGE );
+            UpdateSymmAttach();  // Needs to happen for both XForm and Surf updates.
+        }
 
         // More aggressive optimization could eliminate this call, but at the complexity
         // of a lazy update any time m_SurfVec is accessed.  At this point, the speed
         // does not appear to be worth the complexity.  Typical worst case for this call
         // is 0.1 sec.  Typical cost is two orders smaller.
+        UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::SURF_VEC_STAGE );
         UpdateSurfVec();
     }
 
     if ( fullupdate ) // Option to make FitModel and similar things faster.
     {
-        for ( int i = 0 ; i < ( int )m_SubSurfVec.size() ; i++ )
         {
-            m_SubSurfVec[i]->Update();  // Can be protected by m_SurfDirty, except for call to UpdateDrawObj - perhaps should be split out.  Some may depend on m_SurfVec, but could be switched to m_MainSurfVec instead.
+            UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::SUB_SURF_STAGE );
+            for ( int i = 0 ; i < ( int )m_SubSurfVec.size() ; i++ )
+            {
+                m_SubSurfVec[i]->Update();  // Can be protected by m_SurfDirty, except for call to UpdateDrawObj - perhaps should be split out.  Some may depend on m_SurfVec, but could be switched to m_MainSurfVec instead.
+            }
         }
 
         if ( m_XFormDirty || m_SurfDirty || m_FeaDirty ) // Everything except m_TessDirty
         {
+            UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::FEA_STRUCT_STAGE );
             for ( int i = 0; i < (int)m_FeaStructVec.size(); i++ )
             {
                 m_FeaStructVec[i]->Update();
@@ -1196,20 +1313,27 @@ void Geom::Update( bool fullupdate )
         // Tessellate MainSurfVec
         if ( m_SurfDirty || m_TessDirty )
         {
-            UpdateMainTessVec();
-            UpdateMainDegenGeomPreview();
+            m_PendingMainTess = true;
+            m_PendingMainDegenPreview = true;
         }
 
         // Copy Tessellation for symmetry and XForm
         if ( m_XFormDirty || m_SurfDirty || m_TessDirty )
         {
-            UpdateTessVec();
-            UpdateDegenGeomPreview();
+            m_PendingTess = true;
+            m_PendingDegenPreview = true;
+        }
+
+        // Headless, tessellation is only for display and waits for a consumer.
+        if ( !m_DeferTessFlag && !m_Vehicle->IsHeadless() )
+        {
+            UpdatePendingTess();
         }
     }
 
     if ( m_XFormDirty || m_SurfDirty )
     {
+        UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::BBOX_STAGE );
         UpdateBBox();  // Needs to happen for both XForm and Surf updates.
     }
 
@@ -1217,12 +1341,17 @@ void Geom::Update( bool fullupdate )
     {
         if ( m_XFormDirty || m_SurfDirty || m_TessDirty )
         {
-            UpdateDrawObj();  // Needs to happen for both XForm and Surf updates.
+            m_PendingDrawObj = true;  // Needs to happen for both XForm and Surf updates.
         }
 
         if ( m_XFormDirty || m_SurfDirty || m_HighlightDirty )
         {
-            UpdateHighlightDrawObj();
+            m_PendingHighlightDrawObj = true;
+        }
+
+        if ( !m_DeferTessFlag && !m_Vehicle->IsHeadless() )
+        {
+            UpdatePendingDrawObj();
         }
     }
 
@@ -1248,6 +1377,82 @@ void Geom::Update( bool fullupdate )
     m_UpdateBlock = false;
 }
 
+void Geom::UpdatePendingTess()
+{
+    if ( m_PendingMainTess )
+    {
+        UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::MAIN_TESS_STAGE );
+        UpdateMainTessVec();
+    }
+
+    if ( m_PendingMainTess || m_PendingTess )
+    {
+        UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::TESS_VEC_STAGE );
+        UpdateTessVec();
+    }
+
+    m_PendingMainTess = false;
+    m_PendingTess = false;
+
+    // Keep the preview current only while it is displayed.
+    if ( m_GuiDraw.GetDisplayType() != DISPLAY_TYPE::DISPLAY_BEZIER )
+    {
+        UpdatePendingDegenPreview();
+    }
+}
+
+void Geom::UpdatePendingDegenPreview()
+{
+    if ( m_PendingMainDegenPreview )
+    {
+        UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::MAIN_DEGEN_PREVIEW_STAGE );
+        UpdateMainDegenGeomPreview();
+    }
+
+    if ( m_PendingMainDegenPreview || m_PendingDegenPreview )
+    {
+        UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::DEGEN_PREVIEW_STAGE );
+        UpdateDegenGeomPreview();
+    }
+
+    m_PendingMainDegenPreview = false;
+    m_PendingDegenPreview = false;
+}
+
+void Geom::UpdatePendingDrawObj()
+{
+    if ( IsTessPending() )
+    {
+        UpdatePendingTess();
+    }
+
+    if ( m_PendingDrawObj )
+    {
+        UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::DRAW_OBJ_STAGE );
+        UpdateDrawObj();
+    }
+
+    if ( m_PendingHighlightDrawObj )
+    {
+        UpdateStageTimer timer( m_ID, UpdateProfileMgrSingleton::HIGHLIGHT_DRAW_OBJ_STAGE );
+        UpdateHighlightDrawObj();
+    }
+
+    m_PendingDrawObj = false;
+    m_PendingHighlightDrawObj = false;
+
+    // Left pending by headless updates.
+    for ( int i = 0 ; i < ( int )m_SubSurfVec.size() ; i++ )
+    {
+        m_SubSurfVec[i]->UpdatePendingDrawObjs();
+    }
+
+    for ( int i = 0; i < (int)m_FeaStructVec.size(); i++ )
+    {
+        m_FeaStructVec[i]->UpdatePendingDrawObjs();
+    }
+}
+
 void Geom::GetUWTess01( int indx, vector < double > &u, vector < double > &w )
 {
     vector< vector< vec3d > > pnts;
@@ -1633,6 +1838,26 @@ void Geom::ApplySymm( vector<T> const &source, vector<T> &dest )
     }
 }
 
+//==== Check For A Pending Stage Here Or Below ====//
+bool Geom::IsBranchDirty()
+{
+    // Late update flag marks Geoms Vehicle::ForceUpdate asked to update.
+    if ( IsDirty() || m_LateUpdateFlag )
+    {
+        return true;
+    }
+
+    for ( int i = 0 ; i < (int)m_ChildIDVec.size() ; i++ )
+    {
+        Geom* child = m_Vehicle->FindGeom( m_ChildIDVec[i] );
+        if ( child && child->IsBranchDirty() )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 //==== Check If Children Exist and Update ====//
 void Geom::UpdateChildren( bool fullupdate )
 {
@@ -1675,11 +1900,15 @@ void Geom::UpdateChildren( bool fullupdate )
                 }
             }
 
-            // Ignore the abs location values and only use rel values for children so a child
-            // with abs button selected stays attached to parent if the parent moves
-            child->m_ignoreAbsFlag = true;
-            child->Update( fullupdate );
-            child->m_ignoreAbsFlag = false;
+            // Branches left clean by this update (e.g. after a Tess only change) are skipped.
+            if ( child->IsBranchDirty() )
+            {
+                // Ignore the abs location values and only use rel values for children so a child
+                // with abs button selected stays attached to parent if the parent moves
+                child->m_ignoreAbsFlag = true;
+                child->Update( fullupdate );
+                child->m_ignoreAbsFlag = false;
+            }
 
             updated_child_vec.push_back( m_ChildIDVec[i] );
         }
@@ -2259,6 +2488,29 @@ void Geom::WriteProjectionLinesSVG( xmlNodePtr root, const BndBox &svgbox )
     }
 }
 
+// Append src to dest, transforming points (or normals when norm is set) by mat.
+static void AppendTransformed( const vector< vector< vector< vec3d > > > & src, const Matrix4d & mat, bool norm,
+                               vector< vector< vector< vec3d > > > & dest )
+{
+    int n0 = dest.size();
+    dest.insert( dest.end(), src.begin(), src.end() );
+
+    for ( int i = n0 ; i < ( int )dest.size() ; i++ )
+    {
+        for ( int j = 0 ; j < ( int )dest[i].size() ; j++ )
+        {
+            if ( norm )
+            {
+                mat.xformnormvec( dest[i][j] );
+            }
+            else
+            {
+                mat.xformvec( dest[i][j] );
+            }
+        }
+    }
+}
+
 void Geom::UpdateDrawObj()
 {
     m_FeatureDrawObj_vec.clear();
@@ -2279,30 +2531,44 @@ void Geom::UpdateDrawObj()
     m_WireShadeDrawObj_vec[2].m_GeomChanged = true;
     m_WireShadeDrawObj_vec[3].m_GeomChanged = true;
 
+    int nsurf = GetNumTotalSurfs();
+    bool tess_ok = m_TessInstVec.size() == nsurf && m_SurfVec.size() == nsurf;
+    for ( int i = 0 ; i < ( int )m_TessInstVec.size() && tess_ok ; i++ )
+    {
+        int imain = m_TessInstVec[i].m_MainIndx;
+        tess_ok = imain >= 0 && imain < ( int )m_MainTessVec.size() && imain < ( int )m_MainFeatureTessVec.size();
+    }
+
     // Pre-calculate and allocate for number of feature line segments.
     // Identified by profiling as a substantial cost.
     int numfealineseg = 0;
-    for ( int i = 0 ; i < GetNumTotalSurfs() ; i++ )
+    for ( int i = 0 ; i < nsurf && tess_ok ; i++ )
     {
-        int nfl = m_FeatureTessVec[i].m_ptline.size();
+        const SimpleFeatureTess & ftess = m_MainFeatureTessVec[ m_TessInstVec[i].m_MainIndx ];
+        int nfl = ftess.m_ptline.size();
 
         for( int j = 0; j < nfl; j++ )
         {
-            int n = m_FeatureTessVec[i].m_ptline[j].size() - 1;
+            int n = ftess.m_ptline[j].size() - 1;
 
             numfealineseg += 2 * n;
         }
     }
     m_FeatureDrawObj_vec[0].m_PntVec.reserve( numfealineseg );
 
-    int nsurf = GetNumTotalSurfs();
-    if ( m_TessVec.size() == nsurf && m_SurfVec.size() == nsurf && m_FeatureTessVec.size() == nsurf )
+    if ( tess_ok )
     {
-        //==== Tesselate Surface ====//
+        //==== Place Each Copy Of The Main Tessellations ====//
+        // Points go straight from the shared tessellation to the draw object,
+        // so no world coordinate copy of the whole Geom is kept.
         for ( int i = 0 ; i < nsurf ; i++ )
         {
+            const SimpleTessInstance & inst = m_TessInstVec[i];
+            const SimpleTess & tess = m_MainTessVec[ inst.m_MainIndx ];
+            const SimpleFeatureTess & ftess = m_MainFeatureTessVec[ inst.m_MainIndx ];
+
             int iflip = 0;
-            if ( m_TessVec[i].GetFlipNormal() )
+            if ( inst.GetFlipNormal() )
             {
                 iflip = 1;
             }
@@ -2312,28 +2578,26 @@ void Geom::UpdateDrawObj()
                 iflip += 2;
             }
 
-            m_WireShadeDrawObj_vec[iflip].m_PntMesh.insert( m_WireShadeDrawObj_vec[iflip].m_PntMesh.end(),
-                    m_TessVec[i].m_pnts.begin(), m_TessVec[i].m_pnts.end() );
-            m_WireShadeDrawObj_vec[iflip].m_NormMesh.insert( m_WireShadeDrawObj_vec[iflip].m_NormMesh.end(),
-                    m_TessVec[i].m_norms.begin(), m_TessVec[i].m_norms.end() );
+            AppendTransformed( tess.m_pnts, inst.m_XForm, false, m_WireShadeDrawObj_vec[iflip].m_PntMesh );
+            AppendTransformed( tess.m_norms, inst.m_XForm, true, m_WireShadeDrawObj_vec[iflip].m_NormMesh );
 
             m_WireShadeDrawObj_vec[iflip].m_uTexMesh.insert( m_WireShadeDrawObj_vec[iflip].m_uTexMesh.end(),
-                    m_TessVec[i].m_utex.begin(), m_TessVec[i].m_utex.end() );
+                    tess.m_utex.begin(), tess.m_utex.end() );
             m_WireShadeDrawObj_vec[iflip].m_vTexMesh.insert( m_WireShadeDrawObj_vec[iflip].m_vTexMesh.end(),
-                    m_TessVec[i].m_vtex.begin(), m_TessVec[i].m_vtex.end() );
+                    tess.m_vtex.begin(), tess.m_vtex.end() );
 
             if( m_GuiDraw.GetDispFeatureFlag() )
             {
-                int nfl = m_FeatureTessVec[i].m_ptline.size();
+                int nfl = ftess.m_ptline.size();
 
                 for( int j = 0; j < nfl; j++ )
                 {
-                    int n = m_FeatureTessVec[i].m_ptline[j].size() - 1;
+                    int n = ftess.m_ptline[j].size() - 1;
 
                     for ( int k = 0; k < n; k++ )
                     {
-                        m_FeatureDrawObj_vec[0].m_PntVec.push_back( m_FeatureTessVec[i].m_ptline[j][ k ] );
-                        m_FeatureDrawObj_vec[0].m_PntVec.push_back( m_FeatureTessVec[i].m_ptline[j][ k + 1 ] );
+                        m_FeatureDrawObj_vec[0].m_PntVec.push_back( inst.m_XForm.xform( ftess.m_ptline[j][ k ] ) );
+                        m_FeatureDrawObj_vec[0].m_PntVec.push_back( inst.m_XForm.xform( ftess.m_ptline[j][ k + 1 ] ) );
                     }
                 }
 
@@ -2359,6 +2623,8 @@ void Geom::UpdateDrawObj()
 
 void Geom::UpdateDegenDrawObj()
 {
+    UpdatePendingDegenPreview();
+
     m_DegenSurfDrawObj_vec.clear();
     m_DegenPlateDrawObj_vec.clear();
     m_DegenCamberPlateDrawObj_vec.clear();
@@ -2676,8 +2942,8 @@ void Geom::UpdateDegenDrawObj()
 // Also compute the main surface feature line tessellations
 // firstonly is a flag to only operate on the first element of m_MainTessVec.  This is a trick to only
 // work on the first blade of a propeller.  PropGeom overrides UpdateMainTessVec with a routine that
-// calls this with firstonly=true and then copies and transforms the results of this operation for
-// multiple blades.
+// calls this with firstonly=true and then places the result once per blade with a rotated
+// SimpleTessInstance.
 void Geom::UpdateMainTessVec( bool firstonly )
 {
     double tol = 1e-3;
@@ -2691,6 +2957,8 @@ void Geom::UpdateMainTessVec( bool firstonly )
 
     m_MainTessVec.resize( nmain );
     m_MainFeatureTessVec.resize( nmain );
+    m_MainTessInstVec.clear();
+    m_MainTessInstVec.resize( nmain );
 
     for ( int i = 0 ; i < nmain ; i++ )
     {
@@ -2700,6 +2968,9 @@ void Geom::UpdateMainTessVec( bool firstonly )
         m_MainTessVec[i].m_FlipNormal = fn;
         m_MainFeatureTessVec[i].m_FlipNormal = fn;
 
+        m_MainTessInstVec[i].m_MainIndx = i;
+        m_MainTessInstVec[i].m_FlipNormal = fn;
+
         int nu = m_MainSurfVec[i].GetNumUFeature();
         int nw = m_MainSurfVec[i].GetNumWFeature();
 
@@ -2723,10 +2994,58 @@ void Geom::UpdateMainTessVec( bool firstonly )
 }
 
 // Propagate symmetry and position to tessellation and feature line tess.
+// Only the placements are copied, the tessellations stay with the main surfaces.
 void Geom::UpdateTessVec()
 {
-    ApplySymm( m_MainTessVec, m_TessVec );
-    ApplySymm( m_MainFeatureTessVec, m_FeatureTessVec );
+    ApplySymm( m_MainTessInstVec, m_TessInstVec );
+}
+
+bool Geom::ExpandTess( int indx, SimpleTess & tess )
+{
+    if ( IsTessPending() )
+    {
+        UpdatePendingTess();
+    }
+
+    if ( indx < 0 || indx >= ( int )m_TessInstVec.size() )
+    {
+        return false;
+    }
+
+    const SimpleTessInstance & inst = m_TessInstVec[indx];
+    if ( inst.m_MainIndx < 0 || inst.m_MainIndx >= ( int )m_MainTessVec.size() )
+    {
+        return false;
+    }
+
+    tess = m_MainTessVec[ inst.m_MainIndx ];
+    tess.m_FlipNormal = inst.m_FlipNormal;
+    tess.Transform( inst.m_XForm );
+    return true;
+}
+
+bool Geom::ExpandFeatureTess( int indx, SimpleFeatureTess & tess )
+{
+    if ( IsTessPending() )
+    {
+        UpdatePendingTess();
+    }
+
+    if ( indx < 0 || indx >= ( int )m_TessInstVec.size() )
+    {
+        return false;
+    }
+
+    const SimpleTessInstance & inst = m_TessInstVec[indx];
+    if ( inst.m_MainIndx < 0 || inst.m_MainIndx >= ( int )m_MainFeatureTessVec.size() )
+    {
+        return false;
+    }
+
+    tess = m_MainFeatureTessVec[ inst.m_MainIndx ];
+    tess.m_FlipNormal = inst.m_FlipNormal;
+    tess.Transform( inst.m_XForm );
+    return true;
 }
 
 void Geom::UpdateMainDegenGeomPreview()
@@ -3291,6 +3610,8 @@ void Geom::LoadDrawObjs( vector< DrawObj* > & draw_obj_vec )
 {
     char str[256];
 
+    UpdatePendingDrawObj();
+
     if ( m_GuiDraw.GetDisplayType() == DISPLAY_TYPE::DISPLAY_BEZIER )
     {
         LoadMainDrawObjs( draw_obj_vec );
@@ -4612,6 +4933,62 @@ void Geom::WritePovRayTri( FILE* fid, const vec3d& v, const vec3d& n, bool comma
     }
 }
 
+// Find rel such that surf is rel applied to src.  Both must tessellate alike
+// (same sections and skip flags), rel must be a rigid motion or reflection
+// whose handedness matches the change in normal flip, and a few sampled
+// points must agree.  Then tessellating src and transforming by rel gives the
+// tessellation of surf.
+static bool CompRelativeCopy( const VspSurf & surf, const Matrix4d & mat, const VspSurf & src, const Matrix4d & src_mat, Matrix4d & rel )
+{
+    if ( surf.GetNumSectU() != src.GetNumSectU() || surf.GetNumSectW() != src.GetNumSectW() ||
+         surf.GetSurfType() != src.GetSurfType() || surf.GetSurfCfdType() != src.GetSurfCfdType() ||
+         surf.GetUSkip() != src.GetUSkip() )
+    {
+        return false;
+    }
+
+    Matrix4d inv = src_mat;
+    inv.affineInverse();
+    rel = mat;
+    rel.matMult( inv );
+
+    double tol = 1e-9;
+    const double *m = rel.data();
+
+    // Orthonormal upper 3x3, columns m[0..2], m[4..6], m[8..10].
+    for ( int a = 0 ; a < 3 ; a++ )
+    {
+        for ( int b = 0 ; b < 3 ; b++ )
+        {
+            double d = m[4 * a] * m[4 * b] + m[4 * a + 1] * m[4 * b + 1] + m[4 * a + 2] * m[4 * b + 2];
+            if ( std::abs( d - ( a == b ? 1.0 : 0.0 ) ) > tol )
+            {
+                return false;
+            }
+        }
+    }
+
+    double det = m[0] * ( m[5] * m[10] - m[9] * m[6] )
+               - m[4] * ( m[1] * m[10] - m[9] * m[2] )
+               + m[8] * ( m[1] * m[6] - m[5] * m[2] );
+    if ( ( det < 0.0 ) != ( surf.GetFlipNormal() != src.GetFlipNormal() ) )
+    {
+        return false;
+    }
+
+    const double uw[3][2] = { { 0.13, 0.37 }, { 0.71, 0.59 }, { 0.42, 0.91 } };
+    for ( int k = 0 ; k < 3 ; k++ )
+    {
+        vec3d p = surf.CompPnt01( uw[k][0], uw[k][1] );
+        vec3d q = rel.xform( src.CompPnt01( uw[k][0], uw[k][1] ) );
+        if ( dist( p, q ) > 1e-6 * ( 1.0 + p.mag() ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 //==== Create TMesh Vector ====//
 vector< TMesh* > Geom::CreateTMeshVec() const
 {
@@ -4658,11 +5035,71 @@ vector< TMesh* > Geom::CreateTMeshVec( const vector<VspSurf> &surf_vec ) const
         }
     }
 
+    // Symmetric copies of a main surface with matching skip flags are placed
+    // from the first copy's tessellation instead of being tessellated again.
+    vector< int > src_vec( nsurf, -1 );
+    vector< Matrix4d > rel_vec( nsurf );
+    if ( nsurf == GetNumTotalSurfs() && m_SurfIndxVec.size() == nsurf && m_TransMatVec.size() == nsurf )
+    {
+        for ( int i = 1 ; i < nsurf ; i++ )
+        {
+            for ( int j = 0 ; j < i ; j++ )
+            {
+                if ( src_vec[j] < 0 && m_SurfIndxVec[i] == m_SurfIndxVec[j] &&
+                     CompRelativeCopy( surf_vec[i], m_TransMatVec[i], surf_vec[j], m_TransMatVec[j], rel_vec[i] ) )
+                {
+                    src_vec[i] = j;
+                    break;
+                }
+            }
+        }
+    }
+
+    vector< bool > keep_vec( nsurf, false );
+    for ( int i = 0 ; i < nsurf ; i++ )
+    {
+        if ( src_vec[i] >= 0 )
+        {
+            keep_vec[ src_vec[i] ] = true;
+        }
+    }
+
+    vector< vector< vector<vec3d> > > keep_pnts( nsurf );
+    vector< vector< vector<vec3d> > > keep_norms( nsurf );
+    vector< vector< vector<vec3d> > > keep_uw_pnts( nsurf );
+
     for ( int i = 0 ; i < nsurf ; i++ )
     {
         if ( surf_vec[i].GetNumSectU() != 0 && surf_vec[i].GetNumSectW() != 0 )
         {
-            UpdateTesselate( surf_vec, i, pnts, norms, uw_pnts, false );
+            int isrc = src_vec[i];
+            if ( isrc >= 0 )
+            {
+                //==== Place Source Tessellation ====//
+                pnts = keep_pnts[ isrc ];
+                norms = keep_norms[ isrc ];
+                uw_pnts = keep_uw_pnts[ isrc ];
+
+                for ( int j = 0 ; j < ( int )pnts.size() ; j++ )
+                {
+                    rel_vec[i].xformvec( pnts[j] );
+                }
+                for ( int j = 0 ; j < ( int )norms.size() ; j++ )
+                {
+                    rel_vec[i].xformnormvec( norms[j] );
+                }
+            }
+            else
+            {
+                UpdateTesselate( surf_vec, i, pnts, norms, uw_pnts, false );
+
+                if ( keep_vec[i] )
+                {
+                    keep_pnts[i] = pnts;
+                    keep_norms[i] = norms;
+                    keep_uw_pnts[i] = uw_pnts;
+                }
+            }
             surf_vec[i].ResetUSkip(); // Done with skip flags.
 
             bool thicksurf = true;
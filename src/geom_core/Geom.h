@@ -242,11 +242,22 @@ public:
     bool m_HighlightDirty;
     bool m_FeaDirty;
 
+    int m_UpdateCount;                                  // Bumped when Update runs an XForm, Surf or Tess stage
+
     void SetDirtyFlag( int dflag );
 
+    // Update type of a Parm left as Parm::UPDATE_DEFAULT, from its group and name.
+    static int ClassifyParm( Parm* parm_ptr );
+
+    // True when an update stage is pending on this Geom.
+    bool IsDirty() const
+    {
+        return m_XFormDirty || m_SurfDirty || m_TessDirty || m_HighlightDirty || m_FeaDirty;
+    }
+
 protected:
 
-    void SetDirtyFlags( Parm* parm_ptr );
+    int SetDirtyFlags( Parm* parm_ptr );
 
     Vehicle* m_Vehicle;
 
@@ -348,6 +359,38 @@ public:
     virtual ~Geom();
 
     virtual void Update( bool fullupdate = true );
+
+    // True when this Geom or one of its descendants has an update stage or a late update pending.
+    bool IsBranchDirty();
+
+    // While set, Update leaves tessellation and draw objects pending for
+    // UpdatePendingTess and UpdatePendingDrawObj.  Headless updates
+    // (Vehicle::IsHeadless) leave them pending too.
+    void SetDeferTessFlag( bool f )
+    {
+        m_DeferTessFlag = f;
+    }
+    bool IsTessPending() const
+    {
+        return m_PendingMainTess || m_PendingTess;
+    }
+    // Touches only this Geom, so different Geoms may run it concurrently.
+    void UpdatePendingTess();
+    void UpdatePendingDrawObj();
+
+    // The DegenGeom preview is only built while it is drawn or when asked for.
+    bool IsDegenPreviewPending() const
+    {
+        return m_PendingMainDegenPreview || m_PendingDegenPreview;
+    }
+    void UpdatePendingDegenPreview();
+
+    const vector< DegenGeom > & GetDegenGeomPreviewVec()
+    {
+        UpdatePendingDegenPreview();
+        return m_DegenGeomPreviewVec;
+    }
+
     virtual void LoadMainDrawObjs( vector< DrawObj* > & draw_obj_vec );
     virtual void LoadDrawObjs( vector< DrawObj* > & draw_obj_vec );
 
@@ -482,6 +525,20 @@ public:
     virtual vector< TMesh* > CreateTMeshVec() const;
     vector< TMesh* > CreateTMeshVec( const vector<VspSurf> &surf_vec ) const;
 
+    // World coordinate display tessellation of total surface indx, expanded
+    // from its main surface tessellation.  Tessellation left pending by a
+    // headless update is done first.  Returns false if indx is out of range.
+    bool ExpandTess( int indx, SimpleTess & tess );
+    bool ExpandFeatureTess( int indx, SimpleFeatureTess & tess );
+    int GetNumTessInstances()
+    {
+        if ( IsTessPending() )
+        {
+            UpdatePendingTess();
+        }
+        return m_TessInstVec.size();
+    }
+
     virtual BndBox GetBndBox()
     {
         return m_BBox;
@@ -706,6 +763,14 @@ protected:
 
     bool m_UpdateBlock;
 
+    bool m_DeferTessFlag;
+    bool m_PendingMainTess;
+    bool m_PendingTess;
+    bool m_PendingDrawObj;
+    bool m_PendingHighlightDrawObj;
+    bool m_PendingMainDegenPreview;
+    bool m_PendingDegenPreview;
+
     virtual void UpdateSurf() = 0;
     void UpdateEndCaps();
     virtual void UpdateFeatureLines();
@@ -752,10 +817,12 @@ protected:
     vector<DrawObj> m_DegenCamberPlateDrawObj_vec;
     vector<DrawObj> m_DegenSubSurfDrawObj_vec;
 
+    // Main surface tessellations are stored once.  Each total surface is an
+    // instance placing one of them (see ExpandTess).
     vector <SimpleTess> m_MainTessVec;
-    vector <SimpleTess> m_TessVec;
     vector <SimpleFeatureTess> m_MainFeatureTessVec;
-    vector <SimpleFeatureTess> m_FeatureTessVec;
+    vector <SimpleTessInstance> m_MainTessInstVec;
+    vector <SimpleTessInstance> m_TessInstVec;
 
     vector< DegenGeom > m_MainDegenGeomPreviewVec;
     vector< DegenGeom > m_DegenGeomPreviewVec;
@@ -0,0 +1,322 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "GeomCoreBenchSuite.h"
+#include "GeomCoreTestUtil.h"
+#include "MeshGeom.h"
+#include "ResultsMgr.h"
+#include <chrono>
+
+#ifdef VSP_USE_OPENMP
+#include <omp.h>
+#endif
+
+typedef std::chrono::high_resolution_clock BenchClock;
+
+static double SecondsSince( const BenchClock::time_point & start )
+{
+    return std::chrono::duration< double >( BenchClock::now() - start ).count();
+}
+
+//==== BVH Against Every Tri Pair ====//
+void GeomCoreBenchSuite::BvhIntersectBench()
+{
+    Vehicle veh;
+    Geom* wing = NULL;
+    Geom* pod = NULL;
+    if ( !AddFuseWingPod( veh, 4.0, wing, pod ) )
+    {
+        return;
+    }
+
+    string mesh_id = veh.AddMeshGeom( vsp::SET_ALL );
+    MeshGeom* mesh = ( MeshGeom* )veh.FindGeom( mesh_id );
+    if ( !mesh )
+    {
+        return;
+    }
+
+    vector< TMesh* > & tmv = mesh->m_TMeshVec;
+    int ntri = 0;
+    for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
+    {
+        tmv[i]->LoadBndBox();
+        ntri += tmv[i]->m_TVec.size();
+    }
+
+    BenchClock::time_point start = BenchClock::now();
+    for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
+    {
+        for ( int j = i + 1 ; j < ( int )tmv.size() ; j++ )
+        {
+            for ( int t0 = 0 ; t0 < ( int )tmv[i]->m_TVec.size() ; t0++ )
+            {
+                for ( int t1 = 0 ; t1 < ( int )tmv[j]->m_TVec.size() ; t1++ )
+                {
+                    TBndBox::IntersectTris( tmv[i]->m_TVec[t0], tmv[j]->m_TVec[t1], false );
+                }
+            }
+        }
+    }
+    double brute_time = SecondsSince( start );
+
+    for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
+    {
+        tmv[i]->RemoveIsectEdges();
+    }
+
+    start = BenchClock::now();
+    for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
+    {
+        for ( int j = i + 1 ; j < ( int )tmv.size() ; j++ )
+        {
+            tmv[i]->Intersect( tmv[j] );
+        }
+    }
+    double bvh_time = SecondsSince( start );
+
+    printf( "BvhIntersectBench: %d meshes %d tris, every tri pair %f s, bvh %f s\n",
+            ( int )tmv.size(), ntri, brute_time, bvh_time );
+}
+
+//==== Per Tri Metadata Memory Against The Former String/Vector Layout ====//
+void GeomCoreBenchSuite::TriMetadataMemoryBench()
+{
+    Vehicle veh;
+    Geom* wing = NULL;
+    Geom* pod = NULL;
+    if ( !AddFuseWingPod( veh, 4.0, wing, pod ) )
+    {
+        return;
+    }
+    wing->m_TessW = 41;
+    wing->Update();
+    pod->m_TessU = 41;
+    pod->m_TessW = 41;
+    pod->Update();
+
+    string mesh_id = veh.CompGeom( vsp::SET_ALL, vsp::SET_NONE, 0 );
+    MeshGeom* mesh = ( MeshGeom* )veh.FindGeom( mesh_id );
+    if ( !mesh )
+    {
+        return;
+    }
+
+    size_t ntri, old_bytes, new_bytes;
+    TriMetadataBytes( mesh->m_TMeshVec, ntri, old_bytes, new_bytes );
+
+    printf( "TriMetadataMemoryBench: %d meshes %d tris, former %.2f MB, compact %.2f MB (%.1f%% less)\n",
+            ( int )mesh->m_TMeshVec.size(), ( int )ntri, old_bytes / 1.0e6, new_bytes / 1.0e6,
+            100.0 * ( 1.0 - ( double )new_bytes / ( double )old_bytes ) );
+
+    CutTestMesh( veh, mesh_id );
+}
+
+//==== Slice Against Surface Integral Mass Properties ====//
+void GeomCoreBenchSuite::MassPropEngineBench()
+{
+    Vehicle veh;
+    Geom* wing = NULL;
+    Geom* pod = NULL;
+    if ( !AddFuseWingPod( veh, 0.0, wing, pod ) )
+    {
+        return;
+    }
+
+    int num_slices = 200;
+    int engine[2] = { vsp::MASS_PROP_SLICE, vsp::MASS_PROP_SURFACE_INTEGRAL };
+    double time[2];
+    double mass[2];
+    for ( int e = 0 ; e < 2 ; e++ )
+    {
+        veh.m_MassPropEngine = engine[e];
+
+        BenchClock::time_point start = BenchClock::now();
+        string mesh_id = veh.MassProps( vsp::SET_ALL, num_slices, false, false );
+        time[e] = SecondsSince( start );
+        mass[e] = veh.m_TotalMass;
+
+        CutTestMesh( veh, mesh_id );
+    }
+
+    printf( "MassPropEngineBench: slice (%d) %.3f s, surface integral %.3f s, speedup %.1fx, mass %g vs %g\n",
+            num_slices, time[0], time[1], time[0] / max( time[1], 1.0e-9 ), mass[0], mass[1] );
+}
+
+//==== Mesh Against Sweep Planar Slice Engine ====//
+static double TimePlanarSlice( Vehicle & veh, int engine, int num_slices )
+{
+    veh.m_PlanarSliceEngine = engine;
+
+    BenchClock::time_point start = BenchClock::now();
+    string mesh_id = veh.PSlice( vsp::SET_ALL, num_slices, vec3d( 1.0, 0.0, 0.0 ), true );
+    double time = SecondsSince( start );
+
+    CutTestMesh( veh, mesh_id );
+    return time;
+}
+
+void GeomCoreBenchSuite::PlanarSliceEngineBench()
+{
+    Vehicle veh;
+    Geom* wing = NULL;
+    Geom* pod = NULL;
+    if ( !AddFuseWingPod( veh, 0.0, wing, pod ) )
+    {
+        return;
+    }
+
+    int num_slices = 50;
+    double mesh_time = TimePlanarSlice( veh, vsp::PLANAR_SLICE_MESH, num_slices );
+    double sweep_time = TimePlanarSlice( veh, vsp::PLANAR_SLICE_SWEEP, num_slices );
+
+    // Area ruling station count
+    int num_stations = 2000;
+    double dense_time = TimePlanarSlice( veh, vsp::PLANAR_SLICE_SWEEP, num_stations );
+
+    printf( "PlanarSliceEngineBench: %d stations mesh %.3f s, sweep %.3f s; %d stations sweep %.3f s\n",
+            num_slices, mesh_time, sweep_time, num_stations, dense_time );
+}
+
+//==== Binary Tri Data Against Legacy Tri Lists On A Finely Tessellated Mesh ====//
+void GeomCoreBenchSuite::TMeshXmlBench()
+{
+    Vehicle veh;
+    Geom* pod = AddTestPod( veh, 0.0 );
+    if ( !pod )
+    {
+        return;
+    }
+    pod->m_TessU = 400;
+    pod->m_TessW = 400;
+    pod->Update();
+
+    vector< TMesh* > big_vec = pod->CreateTMeshVec();
+    size_t ntri = 0;
+    for ( int i = 0 ; i < ( int )big_vec.size() ; i++ )
+    {
+        ntri += big_vec[i]->m_TVec.size();
+    }
+
+    double layout_time[2];
+    long layout_size[2];
+    const char* file_name[2] = { "tmesh_bin_bench.xml", "tmesh_txt_bench.xml" };
+    for ( int legacy = 0 ; legacy < 2 ; legacy++ )
+    {
+        BenchClock::time_point start = BenchClock::now();
+        vector< TMesh* > out_vec = RoundTripTMeshXml( big_vec, !!legacy, file_name[legacy] );
+        layout_time[legacy] = SecondsSince( start );
+        layout_size[legacy] = TestFileSize( file_name[legacy] );
+
+        for ( int i = 0 ; i < ( int )out_vec.size() ; i++ )
+        {
+            delete out_vec[i];
+        }
+    }
+
+    for ( int i = 0 ; i < ( int )big_vec.size() ; i++ )
+    {
+        delete big_vec[i];
+    }
+
+    printf( "TMeshXmlBench: %d tris, binary %ld bytes %.3f s, tri list %ld bytes %.3f s\n",
+            ( int )ntri, layout_size[0], layout_time[0], layout_size[1], layout_time[1] );
+}
+
+static double TimeSurfUpdates( Vehicle & veh, int num_update )
+{
+    BenchClock::time_point start = BenchClock::now();
+    for ( int i = 0 ; i < num_update ; i++ )
+    {
+        veh.ForceUpdate( GeomBase::SURF );
+    }
+    return SecondsSince( start );
+}
+
+//==== DegenGeom Preview Built Every Update Against On Demand ====//
+void GeomCoreBenchSuite::LazyDegenPreviewBench()
+{
+    Vehicle veh;
+    string wing_id = veh.AddGeom( GeomType( MS_WING_GEOM_TYPE, "WING", true ) );
+    string prop_id = veh.AddGeom( GeomType( PROP_GEOM_TYPE, "PROP", true ) );
+
+    Geom* wing = veh.FindGeom( wing_id );
+    Geom* prop = veh.FindGeom( prop_id );
+    if ( !wing || !prop )
+    {
+        return;
+    }
+
+    int num_update = 10;
+    wing->m_GuiDraw.SetDisplayType( vsp::DISPLAY_TYPE::DISPLAY_DEGEN_SURF );
+    prop->m_GuiDraw.SetDisplayType( vsp::DISPLAY_TYPE::DISPLAY_DEGEN_SURF );
+    double eager_time = TimeSurfUpdates( veh, num_update );
+
+    wing->m_GuiDraw.SetDisplayType( vsp::DISPLAY_TYPE::DISPLAY_BEZIER );
+    prop->m_GuiDraw.SetDisplayType( vsp::DISPLAY_TYPE::DISPLAY_BEZIER );
+    double lazy_time = TimeSurfUpdates( veh, num_update );
+
+    printf( "LazyDegenPreviewBench: %d updates, preview every update %.3f s, on demand %.3f s, speedup %.1fx\n",
+            num_update, eager_time, lazy_time, eager_time / max( lazy_time, 1.0e-9 ) );
+}
+
+//==== Updates With Display Work Against Headless ====//
+void GeomCoreBenchSuite::HeadlessUpdateBench()
+{
+    Vehicle veh;
+    veh.AddGeom( GeomType( MS_WING_GEOM_TYPE, "WING", true ) );
+    veh.AddGeom( GeomType( FUSELAGE_GEOM_TYPE, "FUSELAGE", true ) );
+
+    int num_update = 10;
+    double display_time = TimeSurfUpdates( veh, num_update );
+
+    veh.SetHeadless( true );
+    double headless_time = TimeSurfUpdates( veh, num_update );
+    veh.SetHeadless( false );
+
+    printf( "HeadlessUpdateBench: %d updates, with display %.3f s, headless %.3f s, speedup %.1fx\n",
+            num_update, display_time, headless_time, display_time / max( headless_time, 1.0e-9 ) );
+}
+
+//==== CompGeom On One Thread Against All Threads ====//
+// Split allocates its nodes, edges and tris with new and creates one Triangle
+// context per tri, so this shows whether the allocator limits scaling.
+void GeomCoreBenchSuite::SplitThreadBench()
+{
+#ifdef VSP_USE_OPENMP
+    Vehicle veh;
+    Geom* wing = NULL;
+    Geom* pod = NULL;
+    if ( !AddFuseWingPod( veh, 4.0, wing, pod ) )
+    {
+        return;
+    }
+    wing->m_TessW = 41;
+    wing->Update();
+    pod->m_TessU = 41;
+    pod->m_TessW = 41;
+    pod->Update();
+
+    int max_threads = omp_get_max_threads();
+    int nthread[2] = { 1, max_threads };
+    double time[2];
+    for ( int i = 0 ; i < 2 ; i++ )
+    {
+        omp_set_num_threads( nthread[i] );
+
+        BenchClock::time_point start = BenchClock::now();
+        string mesh_id = veh.CompGeom( vsp::SET_ALL, vsp::SET_NONE, 0 );
+        time[i] = SecondsSince( start );
+
+        CutTestMesh( veh, mesh_id );
+    }
+    omp_set_num_threads( max_threads );
+
+    printf( "SplitThreadBench: CompGeom 1 thread %.3f s, %d threads %.3f s, speedup %.1fx\n",
+            time[0], max_threads, time[1], time[0] / max( time[1], 1.0e-9 ) );
+#endif
+}
@@ -0,0 +1,44 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// GeomCoreBenchSuite.h: Timing and memory benchmarks for geom_core.  Kept
+// apart from GeomCoreTestSuite so unit test runs do not time or print.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(VSPGEOMCOREBENCHSUITE__INCLUDED_)
+#define VSPGEOMCOREBENCHSUITE__INCLUDED_
+
+#include "cpptest.h"
+#include "Vehicle.h"
+
+class GeomCoreBenchSuite : public Test::Suite
+{
+public:
+    GeomCoreBenchSuite()
+    {
+        TEST_ADD( GeomCoreBenchSuite::BvhIntersectBench )
+        TEST_ADD( GeomCoreBenchSuite::TriMetadataMemoryBench )
+        TEST_ADD( GeomCoreBenchSuite::MassPropEngineBench )
+        TEST_ADD( GeomCoreBenchSuite::PlanarSliceEngineBench )
+        TEST_ADD( GeomCoreBenchSuite::TMeshXmlBench )
+        TEST_ADD( GeomCoreBenchSuite::LazyDegenPreviewBench )
+        TEST_ADD( GeomCoreBenchSuite::HeadlessUpdateBench )
+        TEST_ADD( GeomCoreBenchSuite::SplitThreadBench )
+    }
+
+private:
+    void BvhIntersectBench();
+    void TriMetadataMemoryBench();
+    void MassPropEngineBench();
+    void PlanarSliceEngineBench();
+    void TMeshXmlBench();
+    void LazyDegenPreviewBench();
+    void HeadlessUpdateBench();
+    void SplitThreadBench();
+
+};
+
+#endif // !defined(VSPGEOMCOREBENCHSUITE__INCLUDED_)
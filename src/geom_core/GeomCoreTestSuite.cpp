@@ -7,8 +7,22 @@
 
 #include "GeomCoreTestSuite.h"
 #include "MeshGeom.h"
+#include "MeshFileReader.h"
+#include "ExportWriter.h"
+#include "ProjectionMgr.h"
+#include "PtCloudGeom.h"
+#include "GeomUpdateGraph.h"
+#include "UpdateProfileMgr.h"
+#include "ResultsMgr.h"
+#include "ParmMgr.h"
+#include "GeomCoreTestUtil.h"
+#include "tri_tri_intersect.h"
 #include <cfloat>  //For DBL_EPSILON
 
+#ifdef VSP_USE_OPENMP
+#include <omp.h>
+#endif
+
 //==== Test GeomXForm ====//
 void GeomCoreTestSuite::GeomXFormTest()
 {
@@ -240,6 +254,309 @@ void GeomCoreTestSuite::MeshIOTest()
     veh.CutActiveGeomVec();
 }
 
+//==== Region Classification Must Match Per Tri Classification ====//
+void GeomCoreTestSuite::CompGeomIntExtModeTest()
+{
+    Vehicle veh;
+    TEST_ASSERT( AddTestPod( veh, 0.0 ) != NULL );
+    TEST_ASSERT( AddTestPod( veh, 2.0, 0.0, 0.3 ) != NULL );
+
+    double wet_area[2];
+    double wet_vol[2];
+    int mode[2] = { vsp::INT_EXT_PER_TRI, vsp::INT_EXT_REGION };
+
+    for ( int i = 0 ; i < 2 ; i++ )
+    {
+        veh.m_IntExtMode = mode[i];
+
+        string mesh_id = veh.CompGeom( 0, vsp::SET_NONE, 0 );
+        MeshGeom* mesh = ( MeshGeom* )veh.FindGeom( mesh_id );
+        TEST_ASSERT( mesh != NULL );
+        if ( !mesh )
+        {
+            return;
+        }
+        wet_area[i] = mesh->m_TotalWetArea;
+        wet_vol[i] = mesh->m_TotalWetVol;
+
+        CutTestMesh( veh, mesh_id );
+    }
+
+    TEST_ASSERT( wet_area[0] > 0 );
+    TEST_ASSERT_DELTA( wet_area[0], wet_area[1], 1.0e-6 * wet_area[0] );
+    TEST_ASSERT_DELTA( wet_vol[0], wet_vol[1], 1.0e-6 * wet_vol[0] );
+}
+
+//==== Closed Box Of 12 Tris From Corner lo To Corner hi ====//
+static void AddBoxTris( TMesh* tm, const vec3d & lo, const vec3d & hi )
+{
+    vec3d c[8];
+    for ( int i = 0 ; i < 8 ; i++ )
+    {
+        c[i] = vec3d( ( i & 1 ) ? hi.x() : lo.x(), ( i & 2 ) ? hi.y() : lo.y(), ( i & 4 ) ? hi.z() : lo.z() );
+    }
+
+    int quad[6][4] = { { 0, 4, 6, 2 }, { 1, 3, 7, 5 }, { 0, 1, 5, 4 },
+                       { 2, 6, 7, 3 }, { 0, 2, 3, 1 }, { 4, 5, 7, 6 } };
+    for ( int f = 0 ; f < 6 ; f++ )
+    {
+        vec3d norm = cross( c[ quad[f][1] ] - c[ quad[f][0] ], c[ quad[f][2] ] - c[ quad[f][0] ] );
+        norm.normalize();
+        tm->AddTri( c[ quad[f][0] ], c[ quad[f][1] ], c[ quad[f][2] ], norm );
+        tm->AddTri( c[ quad[f][0] ], c[ quad[f][2] ], c[ quad[f][3] ], norm );
+    }
+}
+
+//==== A Region Must Not Flood Across A Crossing Too Short To Split On ====//
+void GeomCoreTestSuite::TriRegionShortCrossingTest()
+{
+    // Box below z = 0.  A vertical sheet of narrow tris crosses its top face,
+    // every crossing segment shorter than the 1e-6 split tolerance.
+    TMesh* box = new TMesh();
+    box->m_PtrID = "BOX";
+    AddBoxTris( box, vec3d( -10.0, -10.0, -10.0 ), vec3d( 10.0, 10.0, 0.0 ) );
+
+    TMesh* sheet = new TMesh();
+    sheet->m_PtrID = "SHEET";
+    sheet->m_ThickSurf = false;
+
+    int ncol = 8;
+    double h = 1.0e-7;
+    double zrow[6] = { -1.0, -0.6, -0.2, 0.2, 0.6, 1.0 };
+    vec3d norm( 0.0, 1.0, 0.0 );
+    for ( int r = 0 ; r < 5 ; r++ )
+    {
+        for ( int c = 0 ; c < ncol ; c++ )
+        {
+            vec3d p0( 2.0 + c * h, 0.0, zrow[r] );
+            vec3d p1( 2.0 + ( c + 1 ) * h, 0.0, zrow[r] );
+            vec3d p2( 2.0 + ( c + 1 ) * h, 0.0, zrow[r + 1] );
+            vec3d p3( 2.0 + c * h, 0.0, zrow[r + 1] );
+            sheet->AddTri( p0, p1, p2, norm );
+            sheet->AddTri( p0, p2, p3, norm );
+        }
+    }
+
+    vector< TMesh* > meshVec;
+    meshVec.push_back( sheet );
+    meshVec.push_back( box );
+
+    box->LoadBndBox();
+    sheet->LoadBndBox();
+
+    vector< TISectSeg > segVec;
+    sheet->FindISectSegs( box, segVec );
+    TEST_ASSERT( segVec.size() == 2 * ncol );
+    sheet->AddISectSegs( box, segVec );
+    sheet->Split();
+    sheet->DeterIntExtRegions( meshVec );
+
+    for ( int t = 0 ; t < ( int )sheet->m_TVec.size() ; t++ )
+    {
+        TTri* tri = sheet->m_TVec[t];
+        double zmin = min( tri->m_N0->m_Pnt.z(), min( tri->m_N1->m_Pnt.z(), tri->m_N2->m_Pnt.z() ) );
+        double zmax = max( tri->m_N0->m_Pnt.z(), max( tri->m_N1->m_Pnt.z(), tri->m_N2->m_Pnt.z() ) );
+
+        // Too short to split on, but still a barrier
+        TEST_ASSERT( tri->m_ISectEdgeVec.empty() );
+        TEST_ASSERT( tri->m_ISectFlag == ( zmin < 0.0 && zmax > 0.0 ) );
+
+        if ( zmax < 0.0 )
+        {
+            TEST_ASSERT( tri->GetInsideSurf( 1 ) );
+        }
+        else if ( zmin > 0.0 )
+        {
+            TEST_ASSERT( !tri->GetInsideSurf( 1 ) );
+        }
+    }
+
+    delete sheet;
+    delete box;
+}
+
+//==== Cached CompGeom Must Match An Uncached Run ====//
+static double CutCompGeom( Vehicle & veh )
+{
+    string mesh_id = veh.CompGeom( 0, vsp::SET_NONE, 0 );
+    MeshGeom* mesh = ( MeshGeom* )veh.FindGeom( mesh_id );
+    if ( !mesh )
+    {
+        return 0.0;
+    }
+    double wet_area = mesh->m_TotalWetArea;
+
+    CutTestMesh( veh, mesh_id );
+
+    return wet_area;
+}
+
+void GeomCoreTestSuite::CompGeomCacheTest()
+{
+    Vehicle veh;
+    AddTestPod( veh, 0.0 );
+    Geom* geom1 = AddTestPod( veh, 2.0 );
+    Geom* geom2 = AddTestPod( veh, 1.0, 0.0, 0.3 );
+    TEST_ASSERT( geom1 != NULL && geom2 != NULL );
+    if ( !geom1 || !geom2 )
+    {
+        return;
+    }
+
+    CompGeomCache* cache = veh.GetCompGeomCachePtr();
+    veh.m_CompGeomCacheFlag = true;
+
+    //==== Cold Then Warm ====//
+    double cold_area = CutCompGeom( veh );
+    TEST_ASSERT( cold_area > 0 );
+    TEST_ASSERT( cache->m_MeshMisses == 3 );
+    TEST_ASSERT( cache->m_PairMisses == 3 );
+
+    double warm_area = CutCompGeom( veh );
+    TEST_ASSERT( cache->m_MeshHits == 3 );
+    TEST_ASSERT( cache->m_MeshMisses == 0 );
+    TEST_ASSERT( cache->m_PairHits == 3 );
+    TEST_ASSERT( cache->m_PairMisses == 0 );
+    TEST_ASSERT_DELTA( cold_area, warm_area, 1.0e-12 * cold_area );
+
+    //==== Move One Pod, Only Its Pairs Are Intersected Again ====//
+    geom2->m_ZRelLoc = 0.35;
+    geom2->Update();
+
+    double moved_area = CutCompGeom( veh );
+    TEST_ASSERT( cache->m_MeshHits == 2 );
+    TEST_ASSERT( cache->m_MeshMisses == 1 );
+    TEST_ASSERT( cache->m_PairHits == 1 );
+    TEST_ASSERT( cache->m_PairMisses == 2 );
+
+    veh.m_CompGeomCacheFlag = false;
+    double ref_area = CutCompGeom( veh );
+    TEST_ASSERT_DELTA( ref_area, moved_area, 1.0e-12 * ref_area );
+}
+
+//==== BVH Must Find The Same Intersections As Checking Every Tri Pair ====//
+static int CountISectEdges( TMesh* tm )
+{
+    int cnt = 0;
+    for ( int t = 0 ; t < ( int )tm->m_TVec.size() ; t++ )
+    {
+        cnt += tm->m_TVec[t]->m_ISectEdgeVec.size();
+    }
+    return cnt;
+}
+
+static void BruteRayCast( TMesh* tm, vec3d & orig, vec3d & dir, vector< double > & tParmVec )
+{
+    double tparm, uparm, vparm;
+    for ( int t = 0 ; t < ( int )tm->m_TVec.size() ; t++ )
+    {
+        TTri* tri = tm->m_TVec[t];
+        if ( intersect_triangle( orig.v, dir.v, tri->m_N0->m_Pnt.v, tri->m_N1->m_Pnt.v, tri->m_N2->m_Pnt.v,
+                                 &tparm, &uparm, &vparm ) && tparm > 0.0 )
+        {
+            bool dupFlag = false;
+            for ( int j = 0 ; j < ( int )tParmVec.size() ; j++ )
+            {
+                if ( std::abs( tparm - tParmVec[j] ) < 0.0000001 )
+                {
+                    dupFlag = true;
+                }
+            }
+            if ( !dupFlag )
+            {
+                tParmVec.push_back( tparm );
+            }
+        }
+    }
+}
+
+void GeomCoreTestSuite::BvhIntersectTest()
+{
+    Vehicle veh;
+    Geom* wing = NULL;
+    Geom* pod = NULL;
+    bool model_flag = AddFuseWingPod( veh, 4.0, wing, pod );
+    TEST_ASSERT( model_flag );
+    if ( !model_flag )
+    {
+        return;
+    }
+
+    string mesh_id = veh.AddMeshGeom( vsp::SET_ALL );
+    MeshGeom* mesh = ( MeshGeom* )veh.FindGeom( mesh_id );
+    TEST_ASSERT( mesh != NULL );
+    if ( !mesh )
+    {
+        return;
+    }
+
+    vector< TMesh* > & tmv = mesh->m_TMeshVec;
+    for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
+    {
+        tmv[i]->LoadBndBox();
+    }
+
+    //==== Every Tri Pair ====//
+    for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
+    {
+        for ( int j = i + 1 ; j < ( int )tmv.size() ; j++ )
+        {
+            for ( int t0 = 0 ; t0 < ( int )tmv[i]->m_TVec.size() ; t0++ )
+            {
+                for ( int t1 = 0 ; t1 < ( int )tmv[j]->m_TVec.size() ; t1++ )
+                {
+                    TBndBox::IntersectTris( tmv[i]->m_TVec[t0], tmv[j]->m_TVec[t1], false );
+                }
+            }
+        }
+    }
+
+    vector< int > brute_count( tmv.size() );
+    for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
+    {
+        brute_count[i] = CountISectEdges( tmv[i] );
+        tmv[i]->RemoveIsectEdges();
+    }
+
+    //==== BVH ====//
+    for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
+    {
+        for ( int j = i + 1 ; j < ( int )tmv.size() ; j++ )
+        {
+            tmv[i]->Intersect( tmv[j] );
+        }
+    }
+
+    int total = 0;
+    for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
+    {
+        TEST_ASSERT( CountISectEdges( tmv[i] ) == brute_count[i] );
+        total += brute_count[i];
+        tmv[i]->RemoveIsectEdges();
+    }
+    TEST_ASSERT( total > 0 );
+
+    //==== Ray Parity Must Agree ====//
+    for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
+    {
+        for ( int t = 0 ; t < ( int )tmv[i]->m_TVec.size() ; t += 97 )
+        {
+            TTri* tri = tmv[i]->m_TVec[t];
+            vec3d orig = ( tri->m_N0->m_Pnt + tri->m_N1->m_Pnt ) * 0.5;
+            orig = ( orig + tri->m_N2->m_Pnt ) * 0.5;
+            vec3d dir( 1.0, 0.000001, 0.000001 );
+
+            for ( int j = 0 ; j < ( int )tmv.size() ; j++ )
+            {
+                vector< double > brute_t, bvh_t;
+                BruteRayCast( tmv[j], orig, dir, brute_t );
+                tmv[j]->RayCast( orig, dir, bvh_t );
+                TEST_ASSERT( brute_t.size() == bvh_t.size() );
+            }
+        }
+    }
+}
+
 void GeomCoreTestSuite::CompareMeshes( Vehicle & veh, string mesh_a, string mesh_b )
 {
     MeshGeom* mesh_1 = ( MeshGeom* )veh.FindGeom( mesh_a );
@@ -279,3 +596,1384 @@ void GeomCoreTestSuite::CompareVec3ds( const vec3d & v1, const vec3d & v2, const
     sprintf( str, "v1[2]: %10.16g v%10.16g %s", v1[2], v2[2], msg );
     TEST_ASSERT_MSG( std::abs( v1[2] - v2[2] ) < 1e-5, str );
 }
+
+//==== Per Tri Metadata Must Take Less Memory Than The Former String/Vector Layout ====//
+void GeomCoreTestSuite::TriMetadataMemoryTest()
+{
+    Vehicle veh;
+    Geom* wing = NULL;
+    Geom* pod = NULL;
+    bool model_flag = AddFuseWingPod( veh, 4.0, wing, pod );
+    TEST_ASSERT( model_flag );
+    if ( !model_flag )
+    {
+        return;
+    }
+    wing->m_TessW = 41;
+    wing->Update();
+    pod->m_TessU = 41;
+    pod->m_TessW = 41;
+    pod->Update();
+
+    string mesh_id = veh.CompGeom( vsp::SET_ALL, vsp::SET_NONE, 0 );
+    MeshGeom* mesh = ( MeshGeom* )veh.FindGeom( mesh_id );
+    TEST_ASSERT( mesh != NULL );
+    if ( !mesh )
+    {
+        return;
+    }
+
+    size_t ntri, old_bytes, new_bytes;
+    TriMetadataBytes( mesh->m_TMeshVec, ntri, old_bytes, new_bytes );
+    TEST_ASSERT( ntri > 0 );
+    TEST_ASSERT( new_bytes < old_bytes );
+
+    CutTestMesh( veh, mesh_id );
+}
+
+//==== Tri Tables Only Clear Once No Tri Holds An Index ====//
+void GeomCoreTestSuite::TriTableResetTest()
+{
+    int ntri = TTriTable::NumTris();
+
+    TMesh* tm = new TMesh();
+    tm->AddTri( vec3d( 0.0, 0.0, 0.0 ), vec3d( 1.0, 0.0, 0.0 ), vec3d( 0.0, 1.0, 0.0 ), vec3d( 0.0, 0.0, 1.0 ) );
+    TTri* tri = tm->m_TVec.back();
+    tri->SetID( "TRI_TABLE_RESET" );
+    vector< int > tags( 1, 7 );
+    tri->SetTags( tags );
+    TEST_ASSERT( TTriTable::NumTris() == ntri + 1 );
+
+    //==== Live Tri Keeps Its Entries ====//
+    TEST_ASSERT( !TTriTable::Reset() );
+    TEST_ASSERT( tri->GetID() == "TRI_TABLE_RESET" );
+    TEST_ASSERT( tri->GetTags() == tags );
+
+    delete tm;
+    TEST_ASSERT( TTriTable::NumTris() == ntri );
+
+    //==== Other Tris May Still Be Alive In This Process ====//
+    bool reset = TTriTable::Reset();
+    TEST_ASSERT( reset == ( ntri == 0 ) );
+    if ( reset )
+    {
+        TEST_ASSERT( TTriTable::NumIDs() == 1 );
+        TEST_ASSERT( TTriTable::NumTagCombos() == 1 );
+        TEST_ASSERT( TTriTable::InternID( "TRI_TABLE_RESET" ) == 1 );
+    }
+}
+
+static void RunMassProps( Vehicle & veh, int engine, int num_slices )
+{
+    veh.m_MassPropEngine = engine;
+    string mesh_id = veh.MassProps( vsp::SET_ALL, num_slices, false, false );
+    CutTestMesh( veh, mesh_id );
+}
+
+void GeomCoreTestSuite::MassPropEngineTest()
+{
+    Vehicle veh;
+    Geom* wing = NULL;
+    Geom* pod = NULL;
+    bool model_flag = AddFuseWingPod( veh, 0.0, wing, pod );
+    TEST_ASSERT( model_flag );
+    if ( !model_flag )
+    {
+        return;
+    }
+    wing->m_Density = 2.0;
+    wing->Update();
+
+    // Overlaps the fuselage and outranks it.
+    pod->m_Density = 5.0;
+    pod->m_MassPrior = 2;
+    pod->Update();
+
+    int num_slices = 200;
+
+    RunMassProps( veh, vsp::MASS_PROP_SLICE, num_slices );
+    double slice_mass = veh.m_TotalMass;
+    vec3d slice_cg = veh.m_CG;
+    vec3d slice_inertia = veh.m_IxxIyyIzz;
+
+    RunMassProps( veh, vsp::MASS_PROP_SURFACE_INTEGRAL, num_slices );
+    double surf_mass = veh.m_TotalMass;
+    vec3d surf_cg = veh.m_CG;
+    vec3d surf_inertia = veh.m_IxxIyyIzz;
+
+    double len = veh.GetBndBox().GetLargestDist();
+    TEST_ASSERT( len > 0 );
+
+    // Slicing is converged to within a fraction of a percent at this count.
+    TEST_ASSERT( slice_mass > 0 );
+    TEST_ASSERT_DELTA( surf_mass, slice_mass, 0.01 * slice_mass );
+    TEST_ASSERT_DELTA( surf_cg.x(), slice_cg.x(), 0.01 * len );
+    TEST_ASSERT_DELTA( surf_cg.z(), slice_cg.z(), 0.01 * len );
+    for ( int i = 0 ; i < 3 ; i++ )
+    {
+        TEST_ASSERT_DELTA( surf_inertia[i], slice_inertia[i], 0.03 * slice_inertia[i] );
+    }
+}
+
+static void RunPlanarSlice( Vehicle & veh, int engine, int num_slices, vector< double > & area_vec )
+{
+    veh.m_PlanarSliceEngine = engine;
+    string mesh_id = veh.PSlice( vsp::SET_ALL, num_slices, vec3d( 1.0, 0.0, 0.0 ), true );
+    area_vec = ResultsMgr.GetDoubleResults( ResultsMgr.FindLatestResultsID( "Slice" ), "Slice_Area" );
+    CutTestMesh( veh, mesh_id );
+}
+
+static int MeshGeomNumSlices( MeshGeom* mesh )
+{
+    Results* res = ResultsMgr.CreateResults( "Test_Mesh_Slices" );
+    mesh->CreateGeomResults( res );
+
+    int num = 0;
+    if ( ResultsMgr.GetNumData( res->GetID(), "Num_Slices" ) > 0 )
+    {
+        num = ResultsMgr.GetIntResults( res->GetID(), "Num_Slices" )[0];
+    }
+    ResultsMgr.DeleteResult( res->GetID() );
+    return num;
+}
+
+void GeomCoreTestSuite::PlanarSliceEngineTest()
+{
+    Vehicle veh;
+    Geom* wing = NULL;
+    Geom* pod = NULL;
+    bool model_flag = AddFuseWingPod( veh, 0.0, wing, pod );
+    TEST_ASSERT( model_flag );
+    if ( !model_flag )
+    {
+        return;
+    }
+
+    //==== Same Stations From Both Engines ====//
+    int num_slices = 50;
+    vector< double > mesh_area;
+    vector< double > sweep_area;
+    RunPlanarSlice( veh, vsp::PLANAR_SLICE_MESH, num_slices, mesh_area );
+    RunPlanarSlice( veh, vsp::PLANAR_SLICE_SWEEP, num_slices, sweep_area );
+
+    TEST_ASSERT( ( int )mesh_area.size() == num_slices );
+    TEST_ASSERT( sweep_area.size() == mesh_area.size() );
+    if ( sweep_area.size() != mesh_area.size() )
+    {
+        return;
+    }
+
+    double max_area = 0.0;
+    for ( int s = 0 ; s < num_slices ; s++ )
+    {
+        max_area = max( max_area, mesh_area[s] );
+    }
+    TEST_ASSERT( max_area > 0 );
+
+    for ( int s = 0 ; s < num_slices ; s++ )
+    {
+        TEST_ASSERT_DELTA( sweep_area[s], mesh_area[s], 1.0e-3 * max_area );
+    }
+
+    //==== Sweep Leaves The MeshGeom Untrimmed ====//
+    veh.m_PlanarSliceEngine = vsp::PLANAR_SLICE_SWEEP;
+    string sweep_id = veh.PSlice( vsp::SET_ALL, num_slices, vec3d( 1.0, 0.0, 0.0 ), true );
+    MeshGeom* sweep_mesh = ( MeshGeom* )veh.FindGeom( sweep_id );
+    TEST_ASSERT( sweep_mesh != NULL );
+    if ( sweep_mesh )
+    {
+        TEST_ASSERT( MeshGeomNumSlices( sweep_mesh ) == 0 );
+        int nsplit = 0;
+        for ( int i = 0 ; i < ( int )sweep_mesh->m_TMeshVec.size() ; i++ )
+        {
+            for ( int t = 0 ; t < ( int )sweep_mesh->m_TMeshVec[i]->m_TVec.size() ; t++ )
+            {
+                nsplit += sweep_mesh->m_TMeshVec[i]->m_TVec[t]->m_SplitVec.size();
+            }
+        }
+        TEST_ASSERT( nsplit == 0 );
+    }
+    CutTestMesh( veh, sweep_id );
+
+    //==== Flattened Slices Always Come From The Mesh Engine ====//
+    string flat_id = veh.PSliceAndFlatten( vsp::SET_ALL, num_slices, vec3d( 1.0, 0.0, 0.0 ), true );
+    MeshGeom* flat_mesh = ( MeshGeom* )veh.FindGeom( flat_id );
+    TEST_ASSERT( flat_mesh != NULL );
+    if ( flat_mesh )
+    {
+        TEST_ASSERT( MeshGeomNumSlices( flat_mesh ) == num_slices );
+    }
+    CutTestMesh( veh, flat_id );
+    veh.m_PlanarSliceEngine = vsp::PLANAR_SLICE_MESH;
+}
+
+//==== Binary Tri Data Must Round Trip Exactly, Legacy Tri Lists Must Still Load ====//
+void GeomCoreTestSuite::TMeshXmlTest()
+{
+    Vehicle veh;
+    veh.AddGeom( GeomType( POD_GEOM_TYPE, "POD", true ) );
+    string wing_id = veh.AddGeom( GeomType( MS_WING_GEOM_TYPE, "WING", true ) );
+    Geom* wing = veh.FindGeom( wing_id );
+    TEST_ASSERT( wing != NULL );
+    if ( !wing )
+    {
+        return;
+    }
+    wing->m_XRelLoc = 2.0;
+    wing->Update();
+
+    string mesh_id = veh.CompGeom( vsp::SET_ALL, vsp::SET_NONE, 0 );
+    MeshGeom* mesh = ( MeshGeom* )veh.FindGeom( mesh_id );
+    TEST_ASSERT( mesh != NULL );
+    if ( !mesh )
+    {
+        return;
+    }
+
+    //==== Add A Mesh Whose Tris Share Node Objects ====//
+    vector< TMesh* > tmv = mesh->m_TMeshVec;
+    TMesh* shared_tm = new TMesh();
+    for ( int i = 0 ; i < 4 ; i++ )
+    {
+        shared_tm->m_NVec.push_back( new TNode() );
+    }
+    shared_tm->m_NVec[1]->m_Pnt.set_xyz( 1, 0, 0 );
+    shared_tm->m_NVec[2]->m_Pnt.set_xyz( 0, 1, 0 );
+    shared_tm->m_NVec[3]->m_Pnt.set_xyz( 1, 1, 0 );
+    for ( int i = 0 ; i < 2 ; i++ )
+    {
+        TTri* tri = new TTri( shared_tm );
+        tri->m_N0 = shared_tm->m_NVec[i];
+        tri->m_N1 = shared_tm->m_NVec[i + 1];
+        tri->m_N2 = shared_tm->m_NVec[i + 2];
+        tri->m_Norm = vec3d( 0, 0, 1 );
+        shared_tm->m_TVec.push_back( tri );
+    }
+    tmv.push_back( shared_tm );
+
+    vector< TMesh* > bin_vec = RoundTripTMeshXml( tmv, false, "tmesh_bin_test.xml" );
+    vector< TMesh* > txt_vec = RoundTripTMeshXml( tmv, true, "tmesh_txt_test.xml" );
+    TEST_ASSERT( bin_vec.size() == tmv.size() );
+    TEST_ASSERT( txt_vec.size() == tmv.size() );
+
+    bool tag_flag = false;
+    for ( int i = 0 ; i < ( int )tmv.size() && i < ( int )bin_vec.size() && i < ( int )txt_vec.size() ; i++ )
+    {
+        TEST_ASSERT( bin_vec[i]->m_TVec.size() == tmv[i]->m_TVec.size() );
+        TEST_ASSERT( txt_vec[i]->m_TVec.size() == tmv[i]->m_TVec.size() );
+        if ( bin_vec[i]->m_TVec.size() != tmv[i]->m_TVec.size() || txt_vec[i]->m_TVec.size() != tmv[i]->m_TVec.size() )
+        {
+            continue;
+        }
+
+        for ( int t = 0 ; t < ( int )tmv[i]->m_TVec.size() ; t++ )
+        {
+            TTri* tri = tmv[i]->m_TVec[t];
+            TTri* bin_tri = bin_vec[i]->m_TVec[t];
+            TTri* txt_tri = txt_vec[i]->m_TVec[t];
+
+            TEST_ASSERT( bin_tri->m_N0->m_Pnt == tri->m_N0->m_Pnt );
+            TEST_ASSERT( bin_tri->m_N1->m_Pnt == tri->m_N1->m_Pnt );
+            TEST_ASSERT( bin_tri->m_N2->m_Pnt == tri->m_N2->m_Pnt );
+            TEST_ASSERT( bin_tri->m_Norm == tri->m_Norm );
+            TEST_ASSERT( bin_tri->GetTags() == tri->GetTags() );
+            tag_flag = tag_flag || !tri->GetTags().empty();
+
+            CompareVec3ds( txt_tri->m_N0->m_Pnt, tri->m_N0->m_Pnt );
+            CompareVec3ds( txt_tri->m_N1->m_Pnt, tri->m_N1->m_Pnt );
+            CompareVec3ds( txt_tri->m_N2->m_Pnt, tri->m_N2->m_Pnt );
+            CompareVec3ds( txt_tri->m_Norm, tri->m_Norm, "Norm" );
+        }
+    }
+    TEST_ASSERT( tag_flag );
+    TEST_ASSERT( TestFileSize( "tmesh_bin_test.xml" ) < TestFileSize( "tmesh_txt_test.xml" ) );
+
+    if ( bin_vec.size() == tmv.size() )
+    {
+        TMesh* bin_shared = bin_vec.back();
+        TEST_ASSERT( bin_shared->m_NVec.size() == 4 );
+        TEST_ASSERT( bin_shared->m_TVec[0]->m_N1 == bin_shared->m_TVec[1]->m_N0 );
+    }
+
+    //==== Damaged Tri Data Falls Back To A Tri List, Or Leaves The Mesh Empty ====//
+    xmlNodePtr bad_root = xmlNewNode( NULL, ( const xmlChar * )"Vsp_Geometry" );
+    xmlNodePtr bad_node = shared_tm->EncodeXml( bad_root );
+    xmlNodePtr bad_data_node = XmlUtil::GetNode( bad_node, "Tri_Data", 0 );
+    xmlNodePtr bad_tris_node = XmlUtil::GetNode( bad_data_node, "Tris", 0 );
+    TEST_ASSERT( bad_tris_node != NULL );
+    if ( bad_tris_node )
+    {
+        xmlUnlinkNode( bad_tris_node );
+        xmlFreeNode( bad_tris_node );
+    }
+
+    TMesh empty_tm;
+    empty_tm.DecodeXml( bad_node );
+    TEST_ASSERT( empty_tm.m_TVec.empty() );
+    TEST_ASSERT( empty_tm.m_NVec.empty() );
+
+    shared_tm->EncodeTriList( bad_node );
+    TMesh list_tm;
+    list_tm.DecodeXml( bad_node );
+    TEST_ASSERT( list_tm.m_TVec.size() == shared_tm->m_TVec.size() );
+    for ( int t = 0 ; t < ( int )list_tm.m_TVec.size() && t < ( int )shared_tm->m_TVec.size() ; t++ )
+    {
+        CompareVec3ds( list_tm.m_TVec[t]->m_N0->m_Pnt, shared_tm->m_TVec[t]->m_N0->m_Pnt );
+        CompareVec3ds( list_tm.m_TVec[t]->m_N2->m_Pnt, shared_tm->m_TVec[t]->m_N2->m_Pnt );
+    }
+    xmlFreeNode( bad_root );
+
+    for ( int i = 0 ; i < ( int )bin_vec.size() ; i++ )
+    {
+        delete bin_vec[i];
+    }
+    for ( int i = 0 ; i < ( int )txt_vec.size() ; i++ )
+    {
+        delete txt_vec[i];
+    }
+    delete shared_tm;
+}
+
+//==== Small Chunks Must Give The Same Arrays As One Chunk ====//
+static bool SameChunkedRead( const string & file_name, int tokens_per_tri, MeshFileData & whole )
+{
+    MappedFile file;
+    if ( !file.Open( file_name ) )
+    {
+        return false;
+    }
+
+    bool whole_ok;
+    if ( tokens_per_tri )
+    {
+        whole_ok = MeshFileReader::ReadTri( file.Data(), file.Size(), tokens_per_tri, whole, file.Size() + 1 );
+    }
+    else
+    {
+        whole_ok = MeshFileReader::ReadSTL( file.Data(), file.Size(), false, whole, file.Size() + 1 );
+    }
+    if ( !whole_ok )
+    {
+        return false;
+    }
+
+    size_t chunk_size[3] = { 7, 1000, MeshFileReader::DEFAULT_CHUNK_SIZE };
+    for ( int i = 0 ; i < 3 ; i++ )
+    {
+        MeshFileData chunked;
+        bool ok;
+        if ( tokens_per_tri )
+        {
+            ok = MeshFileReader::ReadTri( file.Data(), file.Size(), tokens_per_tri, chunked, chunk_size[i] );
+        }
+        else
+        {
+            ok = MeshFileReader::ReadSTL( file.Data(), file.Size(), false, chunked, chunk_size[i] );
+        }
+
+        if ( !ok || chunked.m_Pnts != whole.m_Pnts || chunked.m_Norms != whole.m_Norms || chunked.m_Tris != whole.m_Tris )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//==== Mapped Readers On Exported Files ====//
+void GeomCoreTestSuite::MeshFileReaderTest()
+{
+    Vehicle veh;
+    veh.AddGeom( GeomType( POD_GEOM_TYPE, "POD", true ) );
+    string mesh_orig = veh.AddMeshGeom( 0 );
+    TEST_ASSERT( mesh_orig.compare( "NONE" ) != 0 );
+    MeshGeom* mesh = ( MeshGeom* )veh.FindGeom( mesh_orig );
+    TEST_ASSERT( mesh != NULL );
+    if ( !mesh )
+    {
+        return;
+    }
+
+    int num_tris = 0;
+    for ( int i = 0 ; i < ( int )mesh->m_TMeshVec.size() ; i++ )
+    {
+        num_tris += mesh->m_TMeshVec[i]->m_TVec.size();
+    }
+
+    //==== ASCII STL ====//
+    MeshFileData stl_data;
+    veh.WriteSTLFile( "reader_test.stl", 0 );
+    TEST_ASSERT( SameChunkedRead( "reader_test.stl", 0, stl_data ) );
+    TEST_ASSERT( stl_data.NumTris() == num_tris );
+
+    //==== Binary STL Holding The Same Floats ====//
+    FILE* fp = fopen( "reader_test_bin.stl", "wb" );
+    TEST_ASSERT( fp != NULL );
+    if ( fp )
+    {
+        char header[80] = {};
+        fwrite( header, 1, 80, fp );
+        unsigned int nfacet = stl_data.NumTris();
+        fwrite( &nfacet, 4, 1, fp );
+        for ( int t = 0 ; t < ( int )nfacet ; t++ )
+        {
+            unsigned short attribute = 0;
+            fwrite( &stl_data.m_Norms[ 3 * t ], sizeof( float ), 3, fp );
+            fwrite( &stl_data.m_Pnts[ 9 * t ], sizeof( float ), 9, fp );
+            fwrite( &attribute, 2, 1, fp );
+        }
+        fclose( fp );
+
+        MeshFileData bin_data;
+        TEST_ASSERT( SameChunkedRead( "reader_test_bin.stl", 0, bin_data ) );
+        TEST_ASSERT( bin_data.m_Pnts == stl_data.m_Pnts );
+        TEST_ASSERT( bin_data.m_Norms == stl_data.m_Norms );
+    }
+
+    //==== Cart3D TRI And Nascart ====//
+    MeshFileData tri_data;
+    veh.WriteTRIFile( "reader_test.tri", 0 );
+    TEST_ASSERT( SameChunkedRead( "reader_test.tri", 3, tri_data ) );
+    TEST_ASSERT( tri_data.NumTris() == num_tris );
+
+    MeshFileData nascart_data;
+    veh.WriteNascartFiles( "reader_test.dat", 0 );
+    TEST_ASSERT( SameChunkedRead( "reader_test.dat", 4, nascart_data ) );
+    TEST_ASSERT( nascart_data.NumTris() == num_tris );
+
+    //==== Truncated Files Are Rejected ====//
+    MappedFile file;
+    TEST_ASSERT( file.Open( "reader_test.tri" ) );
+    MeshFileData bad_data;
+    TEST_ASSERT( !MeshFileReader::ReadTri( file.Data(), file.Size() / 2, 3, bad_data ) );
+    TEST_ASSERT( bad_data.NumTris() == 0 );
+
+    //==== Imported Meshes Match The Arrays ====//
+    string mesh_stl = veh.ImportFile( "reader_test_bin.stl", vsp::IMPORT_STL );
+    MeshGeom* stl_mesh = ( MeshGeom* )veh.FindGeom( mesh_stl );
+    TEST_ASSERT( stl_mesh != NULL );
+    if ( stl_mesh && stl_mesh->m_TMeshVec.size() == 1 )
+    {
+        TMesh* tm = stl_mesh->m_TMeshVec[0];
+        TEST_ASSERT( ( int )tm->m_TVec.size() == stl_data.NumTris() );
+        TEST_ASSERT( tm->m_NVec.size() == 3 * tm->m_TVec.size() );
+    }
+    CompareMeshes( veh, mesh_orig, mesh_stl );
+}
+
+static string ReadWholeFile( const string & file_name )
+{
+    string text;
+    FILE* fp = fopen( file_name.c_str(), "rb" );
+    if ( fp )
+    {
+        char buf[4096];
+        size_t n;
+        while ( ( n = fread( buf, 1, sizeof( buf ), fp ) ) > 0 )
+        {
+            text.append( buf, n );
+        }
+        fclose( fp );
+    }
+    return text;
+}
+
+class TestNodeFormatter : public ExportFormatter
+{
+public:
+    TestNodeFormatter( const vector< TNode* > & node_vec ) : m_NodeVec( node_vec )
+    {
+    }
+
+    virtual int NumItems() const
+    {
+        return m_NodeVec.size();
+    }
+
+    virtual void Format( int i, ExportBuffer & buf ) const
+    {
+        const vec3d & p = m_NodeVec[i]->m_Pnt;
+        buf.Printf( "%d %16.10f %16.10f %16.10f\n", i + 1, p.x(), p.y(), p.z() );
+    }
+
+protected:
+    const vector< TNode* > & m_NodeVec;
+};
+
+//==== Block Formatted Exports Match Plain fprintf ====//
+void GeomCoreTestSuite::ExportWriterTest()
+{
+    Vehicle veh;
+    veh.AddGeom( GeomType( POD_GEOM_TYPE, "POD", true ) );
+    string mesh_id = veh.AddMeshGeom( 0 );
+    MeshGeom* mesh = ( MeshGeom* )veh.FindGeom( mesh_id );
+    TEST_ASSERT( mesh != NULL );
+    if ( !mesh || mesh->m_TMeshVec.empty() )
+    {
+        return;
+    }
+    TMesh* tm = mesh->m_TMeshVec[0];
+
+    //==== Reference Node Listing ====//
+    FILE* fp = fopen( "export_ref.txt", "w" );
+    TEST_ASSERT( fp != NULL );
+    if ( !fp )
+    {
+        return;
+    }
+    for ( int i = 0 ; i < ( int )tm->m_NVec.size() ; i++ )
+    {
+        const vec3d & p = tm->m_NVec[i]->m_Pnt;
+        fprintf( fp, "%d %16.10f %16.10f %16.10f\n", i + 1, p.x(), p.y(), p.z() );
+    }
+    fclose( fp );
+    string ref = ReadWholeFile( "export_ref.txt" );
+    TEST_ASSERT( !ref.empty() );
+
+    int block_size[3] = { 1, 7, ExportWriter::DEFAULT_BLOCK_SIZE };
+    for ( int b = 0 ; b < 3 ; b++ )
+    {
+        fp = fopen( "export_test.txt", "w" );
+        ExportWriter::Write( fp, TestNodeFormatter( tm->m_NVec ), block_size[b] );
+        fclose( fp );
+        TEST_ASSERT( ReadWholeFile( "export_test.txt" ) == ref );
+    }
+
+    //==== STL Facets ====//
+    Matrix4d mat;
+    mat.rotateX( 20.0 );
+    mat.translatef( 1.0, 2.0, 3.0 );
+
+    fp = fopen( "export_ref.stl", "w" );
+    for ( int t = 0 ; t < ( int )tm->m_TVec.size() ; t++ )
+    {
+        TTri* tri = tm->m_TVec[t];
+        vec3d v0 = mat.xform( tri->m_N0->m_Pnt );
+        vec3d v1 = mat.xform( tri->m_N1->m_Pnt );
+        vec3d v2 = mat.xform( tri->m_N2->m_Pnt );
+        vec3d d21 = v2 - v1;
+        if ( !tri->m_IgnoreTriFlag && d21.mag() > 0.000001 )
+        {
+            vec3d norm = cross( d21, v0 - v1 );
+            norm.normalize();
+            fprintf( fp, " facet normal  %2.10le %2.10le %2.10le\n",  norm.x(), norm.y(), norm.z() );
+            fprintf( fp, "   outer loop\n" );
+            fprintf( fp, "     vertex %2.10le %2.10le %2.10le\n", v0.x(), v0.y(), v0.z() );
+            fprintf( fp, "     vertex %2.10le %2.10le %2.10le\n", v1.x(), v1.y(), v1.z() );
+            fprintf( fp, "     vertex %2.10le %2.10le %2.10le\n", v2.x(), v2.y(), v2.z() );
+            fprintf( fp, "   endloop\n" );
+            fprintf( fp, " endfacet\n" );
+        }
+    }
+    fclose( fp );
+
+    fp = fopen( "export_test.stl", "w" );
+    tm->WriteSTLTris( fp, mat );
+    fclose( fp );
+    TEST_ASSERT( ReadWholeFile( "export_test.stl" ) == ReadWholeFile( "export_ref.stl" ) );
+}
+
+//==== Min Distance Over All Tri Pairs, No Hierarchy ====//
+static double BruteMinDistance( const vector< TMesh* > & tmesh_vec, const vector< TMesh* > & other_tmesh_vec )
+{
+    double min_dist = 1.0e12;
+    for ( int i = 0 ; i < ( int )tmesh_vec.size() ; i++ )
+    {
+        for ( int j = 0 ; j < ( int )other_tmesh_vec.size() ; j++ )
+        {
+            for ( int s = 0 ; s < ( int )tmesh_vec[i]->m_TVec.size() ; s++ )
+            {
+                TTri* t0 = tmesh_vec[i]->m_TVec[s];
+                for ( int t = 0 ; t < ( int )other_tmesh_vec[j]->m_TVec.size() ; t++ )
+                {
+                    TTri* t1 = other_tmesh_vec[j]->m_TVec[t];
+                    double d = tri_tri_min_dist( t0->m_N0->m_Pnt, t0->m_N1->m_Pnt, t0->m_N2->m_Pnt,
+                                                 t1->m_N0->m_Pnt, t1->m_N1->m_Pnt, t1->m_N2->m_Pnt );
+                    min_dist = min( d, min_dist );
+                }
+            }
+        }
+    }
+    return min_dist;
+}
+
+void GeomCoreTestSuite::SnapToTest()
+{
+    //==== Closest Points Of Two Tris On Their Edges, Not Their Vertices ====//
+    vec3d a0( -1, 0, 0 ), a1( 1, 0, 0 ), a2( 0, -1, -1 );
+    vec3d b0( 0, -1, 1 ), b1( 0, 1, 1 ), b2( 0.5, 0, 3 );
+    TEST_ASSERT_DELTA( tri_tri_min_dist( a0, a1, a2, b0, b1, b2 ), 1.0, 1.0e-12 );
+
+    //==== Degenerate Tri ====//
+    vec3d p( 0.5, 1, 0 );
+    vec3d d0( 0, 0, 0 ), d1( 1, 0, 0 ), d2( 2, 0, 0 );
+    TEST_ASSERT_DELTA( pnt_tri_min_dist( d0, d1, d2, p ), 1.0, 1.0e-12 );
+
+    Vehicle veh;
+    GeomType type;
+    type.m_Type = POD_GEOM_TYPE;
+    type.m_Name = "POD";
+
+    string id1 = veh.AddGeom( type );
+    string id2 = veh.AddGeom( type );
+    Geom* geom1 = veh.FindGeom( id1 );
+    Geom* geom2 = veh.FindGeom( id2 );
+    TEST_ASSERT( geom1 != NULL && geom2 != NULL );
+    if ( !geom1 || !geom2 )
+    {
+        return;
+    }
+    geom2->m_XRelLoc = 1.0;
+    geom2->m_ZRelLoc = 2.0;
+    geom2->Update();
+
+    SnapToCache cache;
+
+    //==== Hierarchy Distance Matches Every Tri Pair ====//
+    const vector< TMesh* > & tvec1 = cache.GetTMeshVec( geom1 );
+    const vector< TMesh* > & tvec2 = cache.GetTMeshVec( geom2 );
+    TEST_ASSERT( cache.m_Misses == 2 );
+
+    bool iflag;
+    double d = SnapTo::FindMinDistance( tvec2, tvec1, iflag );
+    TEST_ASSERT( !iflag );
+    TEST_ASSERT( d > 0.0 );
+    TEST_ASSERT_DELTA( d, BruteMinDistance( tvec2, tvec1 ), 1.0e-12 );
+
+    //==== Point Query Matches Every Tri ====//
+    vec3d pnt( 3.0, 0.5, 1.5 );
+    vec3d near_pnt;
+    double pd = tvec1[0]->MinDistance( pnt, 1.0e12, near_pnt );
+    double brute_pd = 1.0e12;
+    for ( int t = 0 ; t < ( int )tvec1[0]->m_TVec.size() ; t++ )
+    {
+        TTri* tri = tvec1[0]->m_TVec[t];
+        brute_pd = min( brute_pd, pnt_tri_min_dist( tri->m_N0->m_Pnt, tri->m_N1->m_Pnt, tri->m_N2->m_Pnt, pnt ) );
+    }
+    TEST_ASSERT_DELTA( pd, brute_pd, 1.0e-12 );
+    TEST_ASSERT_DELTA( dist( pnt, near_pnt ), pd, 1.0e-12 );
+
+    //==== Unchanged Geoms Come From The Cache ====//
+    cache.GetTMeshVec( geom1 );
+    cache.GetTMeshVec( geom2 );
+    TEST_ASSERT( cache.m_Hits == 2 );
+    TEST_ASSERT( cache.m_Misses == 2 );
+
+    //==== Move Into The Other Pod, Only It Is Tessellated Again ====//
+    geom2->m_ZRelLoc = 0.1;
+    geom2->Update();
+
+    const vector< TMesh* > & moved_vec = cache.GetTMeshVec( geom2 );
+    TEST_ASSERT( cache.m_Misses == 3 );
+
+    d = SnapTo::FindMinDistance( moved_vec, cache.GetTMeshVec( geom1 ), iflag );
+    TEST_ASSERT( iflag );
+    TEST_ASSERT_DELTA( d, 0.0, 1.0e-12 );
+    TEST_ASSERT( cache.m_Hits == 3 );
+}
+
+//==== Tiled Union Must Cover The Same Area As One Union ====//
+static double PathsArea( const ClipperLib::Paths & pths )
+{
+    double a = 0.0;
+    for ( int i = 0 ; i < ( int )pths.size() ; i++ )
+    {
+        a += ClipperLib::Area( pths[i] );
+    }
+    return a;
+}
+
+void GeomCoreTestSuite::ProjectionUnionTest()
+{
+    srand( 1 );
+
+    ClipperLib::Paths pths;
+    for ( int i = 0 ; i < 3000 ; i++ )
+    {
+        double x = 1.0e6 * ( double )rand() / RAND_MAX;
+        double y = 1.0e6 * ( double )rand() / RAND_MAX;
+
+        ClipperLib::Path pth( 3 );
+        for ( int k = 0 ; k < 3 ; k++ )
+        {
+            pth[k] = ClipperLib::IntPoint( ( ClipperLib::cInt )( x + 2.0e4 * rand() / RAND_MAX ),
+                                           ( ClipperLib::cInt )( y + 2.0e4 * rand() / RAND_MAX ) );
+        }
+        if ( !ClipperLib::Orientation( pth ) )
+        {
+            ClipperLib::ReversePath( pth );
+        }
+        pths.push_back( pth );
+    }
+
+    ClipperLib::Paths ref;
+    ProjectionMgrSingleton::UnionTiled( pths, ref, 0 );
+    double ref_area = PathsArea( ref );
+    TEST_ASSERT( ref_area > 0.0 );
+
+    int tile_size[3] = { 1, 64, 1000 };
+    for ( int t = 0 ; t < 3 ; t++ )
+    {
+        ClipperLib::Paths sol;
+        ProjectionMgrSingleton::UnionTiled( pths, sol, tile_size[t] );
+        TEST_ASSERT_DELTA( PathsArea( sol ), ref_area, 1.0e-9 * ref_area );
+    }
+}
+
+void GeomCoreTestSuite::PtCloudTest()
+{
+    //==== Chunked PTS Parse ====//
+    string pts_text = "1 2 3\n4.5 5 -6e2\n  7 8 9 10\n";
+    vector< double > whole;
+    TEST_ASSERT( MeshFileReader::ReadPts( pts_text.c_str(), pts_text.size(), whole, pts_text.size() + 1 ) );
+    TEST_ASSERT( whole.size() == 9 );
+    size_t chunk_size[2] = { 1, 5 };
+    for ( int c = 0 ; c < 2 ; c++ )
+    {
+        vector< double > chunked;
+        TEST_ASSERT( MeshFileReader::ReadPts( pts_text.c_str(), pts_text.size(), chunked, chunk_size[c] ) );
+        TEST_ASSERT( chunked == whole );
+    }
+    if ( whole.size() == 9 )
+    {
+        TEST_ASSERT_DELTA( whole[5], -600.0, 1.0e-12 );
+    }
+
+    //==== Tiled Store ====//
+    Vehicle veh;
+    string id = veh.AddGeom( GeomType( PT_CLOUD_GEOM_TYPE, "PTS", true ) );
+    PtCloudGeom* cloud = dynamic_cast< PtCloudGeom* >( veh.FindGeom( id ) );
+    TEST_ASSERT( cloud != NULL );
+    if ( !cloud )
+    {
+        return;
+    }
+
+    int nside = 40;
+    double key_sum = 0;
+    for ( int i = 0 ; i < nside ; i++ )
+    {
+        for ( int j = 0 ; j < nside ; j++ )
+        {
+            for ( int k = 0 ; k < nside ; k++ )
+            {
+                cloud->m_Pts.push_back( vec3d( i, 2 * j, 3 * k ) );
+                key_sum += i + 1000.0 * j + 1.0e6 * k;
+            }
+        }
+    }
+    int npts = cloud->m_Pts.size();
+    cloud->InitPts();
+
+    TEST_ASSERT( ( int )cloud->m_Pts.size() == npts );
+    TEST_ASSERT( cloud->GetNumTiles() > 1 );
+    TEST_ASSERT( cloud->GetTileEnd( cloud->GetNumTiles() - 1 ) == npts );
+
+    // Same points, each tile smaller than the cloud
+    double tiled_sum = 0;
+    for ( int t = 0 ; t < cloud->GetNumTiles() ; t++ )
+    {
+        BndBox box;
+        for ( int i = cloud->GetTileBegin( t ) ; i < cloud->GetTileEnd( t ) ; i++ )
+        {
+            box.Update( cloud->m_Pts[i] );
+            tiled_sum += cloud->m_Pts[i].x() + 500.0 * cloud->m_Pts[i].y() + 1.0e6 / 3.0 * cloud->m_Pts[i].z();
+        }
+        TEST_ASSERT( box.GetLargestDist() < 0.75 * 3 * nside );
+    }
+    TEST_ASSERT_DELTA( tiled_sum, key_sum, 1.0e-6 * key_sum );
+
+    //==== Level Of Detail ====//
+    cloud->m_MaxDrawPts = 5000;
+    cloud->Update();
+    vector< DrawObj* > draw_obj_vec;
+    cloud->LoadDrawObjs( draw_obj_vec );
+    TEST_ASSERT( !draw_obj_vec.empty() );
+    if ( !draw_obj_vec.empty() )
+    {
+        int ndraw = draw_obj_vec[0]->m_PntVec.size();
+        TEST_ASSERT( ndraw >= 5000 && ndraw <= 5000 + cloud->GetNumTiles() );
+    }
+
+    //==== Subsampled Selection Covers The Cloud ====//
+    cloud->SelectAllShown();
+    vector< vec3d > sel;
+    cloud->GetSelectedPoints( sel, 1000 );
+    TEST_ASSERT( sel.size() == 1000 );
+
+    BndBox sel_box;
+    for ( int i = 0 ; i < ( int )sel.size() ; i++ )
+    {
+        sel_box.Update( sel[i] );
+    }
+    TEST_ASSERT( sel_box.GetMax().z() - sel_box.GetMin().z() > 0.9 * 3 * ( nside - 1 ) );
+
+    sel.clear();
+    cloud->GetSelectedPoints( sel, npts + 1 );
+    TEST_ASSERT( ( int )sel.size() == npts );
+}
+
+void GeomCoreTestSuite::SymmTessInstanceTest()
+{
+    Vehicle veh;
+    GeomType type;
+    type.m_Type = POD_GEOM_TYPE;
+    type.m_Name = "POD";
+
+    string id = veh.AddGeom( type );
+    Geom* geom = veh.FindGeom( id );
+    TEST_ASSERT( geom != NULL );
+    if ( !geom )
+    {
+        return;
+    }
+    geom->m_YRelLoc = 2.0;
+    geom->m_XRelRot = 15.0;
+    geom->m_SymPlanFlag = vsp::SYM_XZ;
+    geom->Update();
+
+    TEST_ASSERT( geom->GetNumTotalSurfs() == 2 );
+    TEST_ASSERT( geom->GetNumTessInstances() == 2 );
+
+    //==== Display Copy Is The Mirror Of The Main Tessellation ====//
+    SimpleTess main_tess, copy_tess;
+    TEST_ASSERT( geom->ExpandTess( 0, main_tess ) );
+    TEST_ASSERT( geom->ExpandTess( 1, copy_tess ) );
+    TEST_ASSERT( main_tess.GetFlipNormal() != copy_tess.GetFlipNormal() );
+    TEST_ASSERT( !main_tess.m_pnts.empty() && main_tess.m_pnts.size() == copy_tess.m_pnts.size() );
+    if ( !main_tess.m_pnts.empty() && !main_tess.m_pnts[0].empty() && !main_tess.m_pnts[0][0].empty() )
+    {
+        vec3d p = main_tess.m_pnts[0][0][0];
+        vec3d q = copy_tess.m_pnts[0][0][0];
+        TEST_ASSERT_DELTA( p.x(), q.x(), 1.0e-12 );
+        TEST_ASSERT_DELTA( p.y(), -q.y(), 1.0e-12 );
+        TEST_ASSERT_DELTA( p.z(), q.z(), 1.0e-12 );
+    }
+    SimpleFeatureTess feature_tess;
+    TEST_ASSERT( geom->ExpandFeatureTess( 1, feature_tess ) );
+    TEST_ASSERT( !geom->ExpandTess( 2, copy_tess ) );
+
+    //==== TMesh Of The Placed Copy Lies On Its Own Surface ====//
+    vector< TMesh* > tmv = geom->CreateTMeshVec();
+    TEST_ASSERT( tmv.size() == 2 );
+    if ( tmv.size() == 2 )
+    {
+        TEST_ASSERT( tmv[0]->m_TVec.size() == tmv[1]->m_TVec.size() );
+
+        double max_err = 0;
+        for ( int m = 0 ; m < 2 ; m++ )
+        {
+            const VspSurf* surf = geom->GetSurfPtr( m );
+            for ( int t = 0 ; t < ( int )tmv[m]->m_TVec.size() ; t++ )
+            {
+                TTri* tri = tmv[m]->m_TVec[t];
+                vec3d p = surf->CompPnt( tri->m_N0->m_UWPnt.x(), tri->m_N0->m_UWPnt.y() );
+                max_err = std::max( max_err, dist( p, tri->m_N0->m_Pnt ) );
+            }
+        }
+        TEST_ASSERT( max_err < 1.0e-6 );
+
+        // Same enclosed volume, so the copy's tris face outward too.
+        double vol0 = tmv[0]->ComputeTheoVol();
+        double vol1 = tmv[1]->ComputeTheoVol();
+        TEST_ASSERT( vol0 > 0 );
+        TEST_ASSERT_DELTA( vol0, vol1, 1.0e-9 * vol0 );
+    }
+
+    for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
+    {
+        delete tmv[i];
+    }
+}
+
+// Every tessellated point and normal, DegenGeom preview surface and bounding
+// box of the vehicle, in Geom order.
+static void GetUpdateOutput( Vehicle & veh, vector< double > & out )
+{
+    out.clear();
+    vector< Geom* > geom_vec = veh.GetGeomStoreVec();
+    for ( int g = 0 ; g < ( int )geom_vec.size() ; g++ )
+    {
+        for ( int i = 0 ; i < geom_vec[g]->GetNumTessInstances() ; i++ )
+        {
+            SimpleTess tess;
+            geom_vec[g]->ExpandTess( i, tess );
+            for ( int a = 0 ; a < ( int )tess.m_pnts.size() ; a++ )
+            {
+                for ( int b = 0 ; b < ( int )tess.m_pnts[a].size() ; b++ )
+                {
+                    for ( int c = 0 ; c < ( int )tess.m_pnts[a][b].size() ; c++ )
+                    {
+                        out.push_back( tess.m_pnts[a][b][c].x() );
+                        out.push_back( tess.m_pnts[a][b][c].y() );
+                        out.push_back( tess.m_pnts[a][b][c].z() );
+                        out.push_back( tess.m_norms[a][b][c].x() );
+                        out.push_back( tess.m_norms[a][b][c].y() );
+                        out.push_back( tess.m_norms[a][b][c].z() );
+                    }
+                }
+            }
+        }
+
+        const vector< DegenGeom > & dg_vec = geom_vec[g]->GetDegenGeomPreviewVec();
+        for ( int i = 0 ; i < ( int )dg_vec.size() ; i++ )
+        {
+            DegenGeom dg = dg_vec[i];
+            DegenSurface ds = dg.getDegenSurf();
+            for ( int a = 0 ; a < ( int )ds.x.size() ; a++ )
+            {
+                for ( int b = 0 ; b < ( int )ds.x[a].size() ; b++ )
+                {
+                    out.push_back( ds.x[a][b].x() );
+                    out.push_back( ds.x[a][b].y() );
+                    out.push_back( ds.x[a][b].z() );
+                }
+            }
+        }
+
+        BndBox box = geom_vec[g]->GetBndBox();
+        out.push_back( box.GetMin( 0 ) );
+        out.push_back( box.GetMax( 2 ) );
+    }
+}
+
+void GeomCoreTestSuite::ParallelUpdateTest()
+{
+    Vehicle veh;
+    string pod_id = veh.AddGeom( GeomType( POD_GEOM_TYPE, "POD", true ) );
+    string wing_id = veh.AddGeom( GeomType( MS_WING_GEOM_TYPE, "WING", true ) );
+    veh.SetActiveGeom( wing_id );
+    string store_id = veh.AddGeom( GeomType( POD_GEOM_TYPE, "POD", true ) );
+    string conf_id = veh.AddGeom( GeomType( CONFORMAL_GEOM_TYPE, "CONFORMAL", true ) );
+    veh.ClearActiveGeom();
+    string fuse_id = veh.AddGeom( GeomType( FUSELAGE_GEOM_TYPE, "FUSELAGE", true ) );
+    string prop_id = veh.AddGeom( GeomType( PROP_GEOM_TYPE, "PROP", true ) );
+
+    Geom* store = veh.FindGeom( store_id );
+    Geom* fuse = veh.FindGeom( fuse_id );
+    TEST_ASSERT( store != NULL && fuse != NULL && veh.FindGeom( conf_id ) != NULL );
+    if ( !store || !fuse )
+    {
+        return;
+    }
+    store->m_TransAttachFlag = vsp::ATTACH_TRANS_UV;
+    store->m_ULoc = 0.4;
+    fuse->m_SymPlanFlag = vsp::SYM_XZ;
+    fuse->m_YRelLoc = 3.0;
+
+    //==== Dependency Graph ====//
+    vector< string > top_vec;
+    top_vec.push_back( pod_id );
+    top_vec.push_back( wing_id );
+    top_vec.push_back( fuse_id );
+    top_vec.push_back( prop_id );
+
+    GeomUpdateGraph graph;
+    graph.Build( &veh, top_vec );
+    TEST_ASSERT( graph.GetNumNodes() == 6 );
+    TEST_ASSERT( graph.m_NumGroups == 4 );
+    TEST_ASSERT( graph.IsAcyclic() );
+
+    int wing_node = graph.FindNode( wing_id );
+    int store_node = graph.FindNode( store_id );
+    int conf_node = graph.FindNode( conf_id );
+    TEST_ASSERT( wing_node >= 0 && store_node > wing_node && conf_node > wing_node );
+    if ( wing_node >= 0 && store_node >= 0 && conf_node >= 0 )
+    {
+        TEST_ASSERT( graph.m_GroupVec[ store_node ] == graph.m_GroupVec[ wing_node ] );
+        TEST_ASSERT( graph.m_GroupVec[ conf_node ] == graph.m_GroupVec[ wing_node ] );
+
+        int nattach = 0;
+        int nconformal = 0;
+        for ( int e = 0 ; e < ( int )graph.m_EdgeVec.size() ; e++ )
+        {
+            const GeomUpdateEdge & edge = graph.m_EdgeVec[e];
+            if ( edge.m_From == wing_node && edge.m_To == store_node && edge.m_Type == GeomUpdateGraph::ATTACH_EDGE )
+            {
+                nattach++;
+            }
+            if ( edge.m_From == wing_node && edge.m_To == conf_node && edge.m_Type == GeomUpdateGraph::CONFORMAL_EDGE )
+            {
+                nconformal++;
+            }
+        }
+        TEST_ASSERT( nattach == 1 );
+        TEST_ASSERT( nconformal == 1 );
+    }
+
+    // A link joins two top Geoms, a link back closes a loop.
+    int pod_node = graph.FindNode( pod_id );
+    int fuse_node = graph.FindNode( fuse_id );
+    graph.AddEdge( pod_node, fuse_node, GeomUpdateGraph::LINK_EDGE );
+    graph.UpdateGroups();
+    TEST_ASSERT( graph.m_NumGroups == 3 );
+    TEST_ASSERT( graph.m_GroupVec[ pod_node ] == graph.m_GroupVec[ fuse_node ] );
+    TEST_ASSERT( graph.IsAcyclic() );
+    graph.AddEdge( fuse_node, pod_node, GeomUpdateGraph::LINK_EDGE );
+    TEST_ASSERT( !graph.IsAcyclic() );
+
+    //==== Serial And Parallel Updates Agree Exactly ====//
+    vector< double > serial_out, parallel_out;
+
+    veh.m_ParallelUpdateFlag = false;
+    veh.ForceUpdate( GeomBase::SURF );
+    GetUpdateOutput( veh, serial_out );
+
+    veh.m_ParallelUpdateFlag = true;
+    veh.ForceUpdate( GeomBase::SURF );
+    GetUpdateOutput( veh, parallel_out );
+
+    TEST_ASSERT( !serial_out.empty() );
+    TEST_ASSERT( serial_out == parallel_out );
+
+    // Only transforms dirty, tessellation is placed again from the main surfaces.
+    veh.m_ParallelUpdateFlag = false;
+    veh.ForceUpdate( GeomBase::XFORM );
+    GetUpdateOutput( veh, serial_out );
+
+    veh.m_ParallelUpdateFlag = true;
+    veh.ForceUpdate( GeomBase::XFORM );
+    GetUpdateOutput( veh, parallel_out );
+
+    TEST_ASSERT( serial_out == parallel_out );
+}
+
+void GeomCoreTestSuite::UpdateProfileTest()
+{
+    UpdateProfileMgr.Start( true );
+
+    Vehicle veh;
+    string pod_id = veh.AddGeom( GeomType( POD_GEOM_TYPE, "POD", true ) );
+    veh.ForceUpdate( GeomBase::SURF );
+
+    UpdateProfileMgr.Stop();
+
+    // Nothing is added while stopped.
+    veh.ForceUpdate( GeomBase::SURF );
+
+    string rid = UpdateProfileMgr.CreateResults();
+    Results* res = ResultsMgr.FindResultsPtr( rid );
+    TEST_ASSERT( res != NULL );
+    if ( !res )
+    {
+        return;
+    }
+
+    NameValData* id_nvd = res->FindPtr( "Geom_ID" );
+    NameValData* stage_nvd = res->FindPtr( "Stage" );
+    NameValData* count_nvd = res->FindPtr( "Num_Calls" );
+    NameValData* total_nvd = res->FindPtr( "Total_Time" );
+    TEST_ASSERT( id_nvd && stage_nvd && count_nvd && total_nvd );
+    if ( !id_nvd || !stage_nvd || !count_nvd || !total_nvd )
+    {
+        return;
+    }
+
+    int nsurf = 0;
+    int ndraw = 0;
+    for ( int i = 0 ; i < ( int )id_nvd->GetStringData().size() ; i++ )
+    {
+        if ( id_nvd->GetStringData()[i] != pod_id )
+        {
+            continue;
+        }
+        TEST_ASSERT( total_nvd->GetDoubleData()[i] >= 0.0 );
+        if ( stage_nvd->GetStringData()[i] == "UpdateSurf" )
+        {
+            nsurf = count_nvd->GetIntData()[i];
+        }
+        if ( stage_nvd->GetStringData()[i] == "UpdateDrawObj" )
+        {
+            ndraw = count_nvd->GetIntData()[i];
+        }
+    }
+    TEST_ASSERT( nsurf >= 1 );
+    TEST_ASSERT( ndraw >= 1 );
+
+    NameValData* geom_nvd = res->FindPtr( "Geom_Total_ID" );
+    TEST_ASSERT( geom_nvd && !geom_nvd->GetStringData().empty() );
+
+    //==== Chrome Trace ====//
+    TEST_ASSERT( UpdateProfileMgr.WriteChromeTrace( "update_profile_trace.json" ) );
+    FILE* fp = fopen( "update_profile_trace.json", "r" );
+    TEST_ASSERT( fp != NULL );
+    if ( fp )
+    {
+        char buf[32] = {};
+        TEST_ASSERT( fgets( buf, sizeof( buf ), fp ) != NULL );
+        TEST_ASSERT( string( buf ).find( "{\"traceEvents\":[" ) == 0 );
+        fclose( fp );
+    }
+
+    ResultsMgr.DeleteResult( rid );
+    UpdateProfileMgr.Reset();
+}
+
+void GeomCoreTestSuite::ParmUpdateTypeTest()
+{
+    Vehicle veh;
+    string pod_id = veh.AddGeom( GeomType( POD_GEOM_TYPE, "POD", true ) );
+    veh.SetActiveGeom( pod_id );
+    string child_id = veh.AddGeom( GeomType( POD_GEOM_TYPE, "POD", true ) );
+    veh.ClearActiveGeom();
+
+    Geom* pod = veh.FindGeom( pod_id );
+    Geom* child = veh.FindGeom( child_id );
+    TEST_ASSERT( pod != NULL && child != NULL );
+    if ( !pod || !child )
+    {
+        return;
+    }
+    child->m_TransAttachFlag = vsp::ATTACH_TRANS_COMP;
+    veh.Update();
+
+    Parm* length = ParmMgr.FindParm( pod->FindParm( "Length", "Design" ) );
+    TEST_ASSERT( length != NULL );
+    if ( !length )
+    {
+        return;
+    }
+
+    //==== Classification ====//
+    TEST_ASSERT( pod->m_XRelLoc.GetUpdateType() == Parm::UPDATE_XFORM );
+    TEST_ASSERT( pod->m_TessU.GetUpdateType() == Parm::UPDATE_TESS );
+    TEST_ASSERT( pod->m_Density.GetUpdateType() == Parm::UPDATE_ATTRIBUTE );
+    TEST_ASSERT( GeomBase::ClassifyParm( length ) == Parm::UPDATE_SURF );
+
+    //==== Transform Only, Attached Child Follows ====//
+    UpdateProfileMgr.Start();
+    pod->m_XRelLoc = 2.0;
+    veh.Update();
+    UpdateProfileMgr.Stop();
+
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( pod_id, UpdateProfileMgrSingleton::XFORM_STAGE ) >= 1 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( pod_id, UpdateProfileMgrSingleton::SURF_STAGE ) == 0 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( pod_id, UpdateProfileMgrSingleton::MAIN_TESS_STAGE ) == 0 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( child_id, UpdateProfileMgrSingleton::XFORM_STAGE ) >= 1 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( child_id, UpdateProfileMgrSingleton::SURF_STAGE ) == 0 );
+
+    //==== Tess Only, Child Skipped ====//
+    UpdateProfileMgr.Start();
+    pod->m_TessU = 12;
+    veh.Update();
+    UpdateProfileMgr.Stop();
+
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( pod_id, UpdateProfileMgrSingleton::MAIN_TESS_STAGE ) >= 1 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( pod_id, UpdateProfileMgrSingleton::SURF_STAGE ) == 0 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( pod_id, UpdateProfileMgrSingleton::XFORM_STAGE ) == 0 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( child_id, UpdateProfileMgrSingleton::SUB_SURF_STAGE ) == 0 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( child_id, UpdateProfileMgrSingleton::MAIN_TESS_STAGE ) == 0 );
+
+    //==== Surface, Child Attached By Transform Only ====//
+    UpdateProfileMgr.Start();
+    length->Set( 12.0 );
+    veh.Update();
+    UpdateProfileMgr.Stop();
+
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( pod_id, UpdateProfileMgrSingleton::SURF_STAGE ) >= 1 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( child_id, UpdateProfileMgrSingleton::SURF_STAGE ) == 0 );
+
+    //==== Attribute Only ====//
+    UpdateProfileMgr.Start();
+    pod->m_Density = 2.0;
+    veh.Update();
+    UpdateProfileMgr.Stop();
+
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( pod_id, UpdateProfileMgrSingleton::SURF_STAGE ) == 0 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( pod_id, UpdateProfileMgrSingleton::XFORM_STAGE ) == 0 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( pod_id, UpdateProfileMgrSingleton::MAIN_TESS_STAGE ) == 0 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( pod_id, UpdateProfileMgrSingleton::DRAW_OBJ_STAGE ) == 0 );
+
+    UpdateProfileMgr.Reset();
+}
+
+//==== Vehicle::ForceUpdate Reaches Children With Nothing Dirty ====//
+void GeomCoreTestSuite::ForceUpdateChildrenTest()
+{
+    Vehicle veh;
+    string pod_id = veh.AddGeom( GeomType( POD_GEOM_TYPE, "POD", true ) );
+    veh.SetActiveGeom( pod_id );
+    string child_id = veh.AddGeom( GeomType( POD_GEOM_TYPE, "POD", true ) );
+    veh.SetActiveGeom( child_id );
+    string grandchild_id = veh.AddGeom( GeomType( POD_GEOM_TYPE, "POD", true ) );
+    veh.ClearActiveGeom();
+
+    Geom* child = veh.FindGeom( child_id );
+    TEST_ASSERT( child != NULL && veh.FindGeom( grandchild_id ) != NULL );
+    if ( !child )
+    {
+        return;
+    }
+    child->m_TransAttachFlag = vsp::ATTACH_TRANS_COMP;
+    veh.Update();
+
+    //==== Surface Rebuild Of Every Geom ====//
+    UpdateProfileMgr.Start();
+    veh.ForceUpdate( GeomBase::SURF );
+    UpdateProfileMgr.Stop();
+
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( pod_id, UpdateProfileMgrSingleton::SURF_STAGE ) >= 1 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( child_id, UpdateProfileMgrSingleton::SURF_STAGE ) >= 1 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( grandchild_id, UpdateProfileMgrSingleton::SURF_STAGE ) >= 1 );
+
+    //==== No Dirty Flag, Children Still Visited ====//
+    UpdateProfileMgr.Start();
+    veh.ForceUpdate();
+    UpdateProfileMgr.Stop();
+
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( child_id, UpdateProfileMgrSingleton::SUB_SURF_STAGE ) >= 1 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( grandchild_id, UpdateProfileMgrSingleton::SUB_SURF_STAGE ) >= 1 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( child_id, UpdateProfileMgrSingleton::SURF_STAGE ) == 0 );
+
+    UpdateProfileMgr.Reset();
+}
+
+// Seconds for num_update surface updates of the whole vehicle.
+void GeomCoreTestSuite::LazyDegenPreviewTest()
+{
+    Vehicle veh;
+    string wing_id = veh.AddGeom( GeomType( MS_WING_GEOM_TYPE, "WING", true ) );
+    string prop_id = veh.AddGeom( GeomType( PROP_GEOM_TYPE, "PROP", true ) );
+
+    Geom* wing = veh.FindGeom( wing_id );
+    Geom* prop = veh.FindGeom( prop_id );
+    TEST_ASSERT( wing != NULL && prop != NULL );
+    if ( !wing || !prop )
+    {
+        return;
+    }
+
+    //==== Not Built By Update ====//
+    UpdateProfileMgr.Start();
+    veh.ForceUpdate( GeomBase::SURF );
+
+    TEST_ASSERT( wing->IsDegenPreviewPending() );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( wing_id, UpdateProfileMgrSingleton::MAIN_DEGEN_PREVIEW_STAGE ) == 0 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( wing_id, UpdateProfileMgrSingleton::MAIN_TESS_STAGE ) >= 1 );
+
+    //==== Built Once When Asked For ====//
+    TEST_ASSERT( !wing->GetDegenGeomPreviewVec().empty() );
+    TEST_ASSERT( !wing->IsDegenPreviewPending() );
+    wing->GetDegenGeomPreviewVec();
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( wing_id, UpdateProfileMgrSingleton::MAIN_DEGEN_PREVIEW_STAGE ) == 1 );
+
+    //==== Kept Current While Displayed ====//
+    wing->m_GuiDraw.SetDisplayType( vsp::DISPLAY_TYPE::DISPLAY_DEGEN_SURF );
+    veh.ForceUpdate( GeomBase::SURF );
+    TEST_ASSERT( !wing->IsDegenPreviewPending() );
+    TEST_ASSERT( prop->IsDegenPreviewPending() );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( wing_id, UpdateProfileMgrSingleton::MAIN_DEGEN_PREVIEW_STAGE ) == 2 );
+    UpdateProfileMgr.Stop();
+    UpdateProfileMgr.Reset();
+}
+
+void GeomCoreTestSuite::HeadlessUpdateTest()
+{
+    Vehicle veh;
+    string wing_id = veh.AddGeom( GeomType( MS_WING_GEOM_TYPE, "WING", true ) );
+    string fuse_id = veh.AddGeom( GeomType( FUSELAGE_GEOM_TYPE, "FUSELAGE", true ) );
+
+    Geom* wing = veh.FindGeom( wing_id );
+    Geom* fuse = veh.FindGeom( fuse_id );
+    TEST_ASSERT( wing != NULL && fuse != NULL );
+    if ( !wing || !fuse )
+    {
+        return;
+    }
+
+    //==== Nothing For Display Built ====//
+    veh.SetHeadless( true );
+    UpdateProfileMgr.Start();
+    veh.ForceUpdate( GeomBase::SURF );
+
+    TEST_ASSERT( wing->IsTessPending() );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( wing_id, UpdateProfileMgrSingleton::SURF_STAGE ) >= 1 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( wing_id, UpdateProfileMgrSingleton::MAIN_TESS_STAGE ) == 0 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( wing_id, UpdateProfileMgrSingleton::DRAW_OBJ_STAGE ) == 0 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( wing_id, UpdateProfileMgrSingleton::HIGHLIGHT_DRAW_OBJ_STAGE ) == 0 );
+
+    //==== Tessellation Built When Asked For ====//
+    TEST_ASSERT( wing->GetNumTessInstances() == wing->GetNumTotalSurfs() );
+    TEST_ASSERT( !wing->IsTessPending() );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( wing_id, UpdateProfileMgrSingleton::MAIN_TESS_STAGE ) == 1 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( wing_id, UpdateProfileMgrSingleton::DRAW_OBJ_STAGE ) == 0 );
+
+    //==== Draw Objects Caught Up When Display Returns ====//
+    TEST_ASSERT( fuse->IsTessPending() );
+    veh.SetHeadless( false );
+    TEST_ASSERT( !fuse->IsTessPending() );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( wing_id, UpdateProfileMgrSingleton::DRAW_OBJ_STAGE ) == 1 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( fuse_id, UpdateProfileMgrSingleton::DRAW_OBJ_STAGE ) == 1 );
+    TEST_ASSERT( UpdateProfileMgr.GetNumCalls( wing_id, UpdateProfileMgrSingleton::MAIN_TESS_STAGE ) == 1 );
+    UpdateProfileMgr.Stop();
+    UpdateProfileMgr.Reset();
+}
+
+// Corners of every tri CompGeom keeps, in mesh and tri order.
+static void CompGeomTriPnts( Vehicle & veh, vector< vec3d > & pnt_vec )
+{
+    pnt_vec.clear();
+
+    string mesh_id = veh.CompGeom( vsp::SET_ALL, vsp::SET_NONE, 0 );
+    MeshGeom* mesh = ( MeshGeom* )veh.FindGeom( mesh_id );
+    if ( !mesh )
+    {
+        return;
+    }
+
+    mesh->FlattenTMeshVec();
+    for ( int i = 0 ; i < ( int )mesh->m_TMeshVec.size() ; i++ )
+    {
+        vector< TTri* > & tvec = mesh->m_TMeshVec[i]->m_TVec;
+        for ( int t = 0 ; t < ( int )tvec.size() ; t++ )
+        {
+            pnt_vec.push_back( tvec[t]->m_N0->m_Pnt );
+            pnt_vec.push_back( tvec[t]->m_N1->m_Pnt );
+            pnt_vec.push_back( tvec[t]->m_N2->m_Pnt );
+        }
+    }
+
+    CutTestMesh( veh, mesh_id );
+}
+
+//==== Parallel Intersect And Split Must Match A Serial Run Tri By Tri ====//
+void GeomCoreTestSuite::CompGeomParallelSplitTest()
+{
+    Vehicle veh;
+    Geom* wing = NULL;
+    Geom* pod = NULL;
+    bool model_flag = AddFuseWingPod( veh, 4.0, wing, pod );
+    TEST_ASSERT( model_flag );
+    if ( !model_flag )
+    {
+        return;
+    }
+
+    vector< vec3d > par_vec, ser_vec;
+    CompGeomTriPnts( veh, par_vec );
+
+#ifdef VSP_USE_OPENMP
+    int nthread = omp_get_max_threads();
+    omp_set_num_threads( 1 );
+#endif
+    CompGeomTriPnts( veh, ser_vec );
+#ifdef VSP_USE_OPENMP
+    omp_set_num_threads( nthread );
+#endif
+
+    TEST_ASSERT( par_vec.size() > 0 );
+    TEST_ASSERT( par_vec.size() == ser_vec.size() );
+    if ( par_vec.size() != ser_vec.size() )
+    {
+        return;
+    }
+
+    int ndiff = 0;
+    for ( int i = 0 ; i < ( int )par_vec.size() ; i++ )
+    {
+        if ( par_vec[i].x() != ser_vec[i].x() || par_vec[i].y() != ser_vec[i].y() || par_vec[i].z() != ser_vec[i].z() )
+        {
+            ndiff++;
+        }
+    }
+    TEST_ASSERT( ndiff == 0 );
+}
@@ -27,6 +27,28 @@ public:
         TEST_ADD( GeomCoreTestSuite::PodTest )
         TEST_ADD( GeomCoreTestSuite::XmlTest )
         TEST_ADD( GeomCoreTestSuite::MeshIOTest )
+        TEST_ADD( GeomCoreTestSuite::CompGeomIntExtModeTest )
+        TEST_ADD( GeomCoreTestSuite::TriRegionShortCrossingTest )
+        TEST_ADD( GeomCoreTestSuite::CompGeomCacheTest )
+        TEST_ADD( GeomCoreTestSuite::BvhIntersectTest )
+        TEST_ADD( GeomCoreTestSuite::TriMetadataMemoryTest )
+        TEST_ADD( GeomCoreTestSuite::TriTableResetTest )
+        TEST_ADD( GeomCoreTestSuite::MassPropEngineTest )
+        TEST_ADD( GeomCoreTestSuite::PlanarSliceEngineTest )
+        TEST_ADD( GeomCoreTestSuite::TMeshXmlTest )
+        TEST_ADD( GeomCoreTestSuite::MeshFileReaderTest )
+        TEST_ADD( GeomCoreTestSuite::ExportWriterTest )
+        TEST_ADD( GeomCoreTestSuite::SnapToTest )
+        TEST_ADD( GeomCoreTestSuite::ProjectionUnionTest )
+        TEST_ADD( GeomCoreTestSuite::PtCloudTest )
+        TEST_ADD( GeomCoreTestSuite::SymmTessInstanceTest )
+        TEST_ADD( GeomCoreTestSuite::ParallelUpdateTest )
+        TEST_ADD( GeomCoreTestSuite::UpdateProfileTest )
+        TEST_ADD( GeomCoreTestSuite::ParmUpdateTypeTest )
+        TEST_ADD( GeomCoreTestSuite::ForceUpdateChildrenTest )
+        TEST_ADD( GeomCoreTestSuite::LazyDegenPreviewTest )
+        TEST_ADD( GeomCoreTestSuite::HeadlessUpdateTest )
+        TEST_ADD( GeomCoreTestSuite::CompGeomParallelSplitTest )
     }
 
 private:
@@ -36,6 +58,28 @@ private:
     void PodTest();
     void XmlTest();
     void MeshIOTest();
+    void CompGeomIntExtModeTest();
+    void TriRegionShortCrossingTest();
+    void CompGeomCacheTest();
+    void BvhIntersectTest();
+    void TriMetadataMemoryTest();
+    void TriTableResetTest();
+    void MassPropEngineTest();
+    void PlanarSliceEngineTest();
+    void TMeshXmlTest();
+    void MeshFileReaderTest();
+    void ExportWriterTest();
+    void SnapToTest();
+    void ProjectionUnionTest();
+    void PtCloudTest();
+    void SymmTessInstanceTest();
+    void ParallelUpdateTest();
+    void UpdateProfileTest();
+    void ParmUpdateTypeTest();
+    void ForceUpdateChildrenTest();
+    void LazyDegenPreviewTest();
+    void HeadlessUpdateTest();
+    void CompGeomParallelSplitTest();
     void CompareMeshes( Vehicle & veh, string mesh_a, string mesh_b );
     void CompareVec3ds( const vec3d & v1, const vec3d & v2, const char * msg = NULL );
 
@@ -0,0 +1,143 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "GeomCoreTestUtil.h"
+#include "XmlUtil.h"
+
+Geom* AddTestPod( Vehicle & veh, double x, double y, double z )
+{
+    string pod_id = veh.AddGeom( GeomType( POD_GEOM_TYPE, "POD", true ) );
+    Geom* pod = veh.FindGeom( pod_id );
+    if ( !pod )
+    {
+        return NULL;
+    }
+    pod->m_XRelLoc = x;
+    pod->m_YRelLoc = y;
+    pod->m_ZRelLoc = z;
+    pod->Update();
+    return pod;
+}
+
+bool AddFuseWingPod( Vehicle & veh, double pod_y, Geom* & wing, Geom* & pod )
+{
+    veh.AddGeom( GeomType( FUSELAGE_GEOM_TYPE, "FUSELAGE", true ) );
+    string wing_id = veh.AddGeom( GeomType( MS_WING_GEOM_TYPE, "WING", true ) );
+
+    wing = veh.FindGeom( wing_id );
+    pod = AddTestPod( veh, 12.0, pod_y );
+    if ( !wing || !pod )
+    {
+        return false;
+    }
+    wing->m_XRelLoc = 10.0;
+    wing->Update();
+    return true;
+}
+
+void CutTestMesh( Vehicle & veh, const string & mesh_id )
+{
+    veh.ClearActiveGeom();
+    veh.AddActiveGeom( mesh_id );
+    veh.CutActiveGeomVec();
+}
+
+vector< TMesh* > RoundTripTMeshXml( const vector< TMesh* > & tmv, bool legacy, const char* file_name )
+{
+    xmlDocPtr doc = xmlNewDoc( ( const xmlChar * )"1.0" );
+    xmlNodePtr root = xmlNewNode( NULL, ( const xmlChar * )"Vsp_Geometry" );
+    xmlDocSetRootElement( doc, root );
+
+    for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
+    {
+        if ( legacy )
+        {
+            xmlNodePtr tmesh_node = xmlNewChild( root, NULL, BAD_CAST "TMesh", NULL );
+            XmlUtil::AddIntNode( tmesh_node, "Num_Tris", ( int )tmv[i]->m_TVec.size() );
+            tmv[i]->EncodeTriList( tmesh_node );
+        }
+        else
+        {
+            tmv[i]->EncodeXml( root );
+        }
+    }
+    xmlSaveFormatFile( file_name, doc, 1 );
+    xmlFreeDoc( doc );
+
+    vector< TMesh* > ret_vec;
+    doc = xmlParseFile( file_name );
+    if ( !doc )
+    {
+        return ret_vec;
+    }
+    root = xmlDocGetRootElement( doc );
+
+    xmlNodePtr iter_node = root->xmlChildrenNode;
+    while ( iter_node != NULL )
+    {
+        if ( !xmlStrcmp( iter_node->name, ( const xmlChar * )"TMesh" ) )
+        {
+            TMesh* tm = new TMesh();
+            tm->DecodeXml( iter_node );
+            ret_vec.push_back( tm );
+        }
+        iter_node = iter_node->next;
+    }
+    xmlFreeDoc( doc );
+
+    return ret_vec;
+}
+
+long TestFileSize( const char* file_name )
+{
+    long size = 0;
+    FILE* fp = fopen( file_name, "rb" );
+    if ( fp )
+    {
+        fseek( fp, 0, SEEK_END );
+        size = ftell( fp );
+        fclose( fp );
+    }
+    return size;
+}
+
+void TriMetadataBytes( const vector< TMesh* > & tmv, size_t & ntri, size_t & old_bytes, size_t & new_bytes )
+{
+    ntri = 0;
+    size_t nclassified = 0;
+    size_t ntag = 0;
+    size_t inside_bytes = 0;
+    for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
+    {
+        inside_bytes += tmv[i]->m_InsideBits.capacity() * sizeof( uint32_t );
+        for ( int t = 0 ; t < ( int )tmv[i]->m_TVec.size() ; t++ )
+        {
+            TTri* tri = tmv[i]->m_TVec[t];
+            vector< TTri* > tris( 1, tri );
+            tris.insert( tris.end(), tri->m_SplitVec.begin(), tri->m_SplitVec.end() );
+            for ( int s = 0 ; s < ( int )tris.size() ; s++ )
+            {
+                ntri++;
+                ntag += tris[s]->GetTags().size();
+                if ( tris[s]->m_InsideIndex >= 0 )
+                {
+                    nclassified++;
+                }
+            }
+        }
+    }
+
+    // Former layout: string ID, vector<bool> sized to the mesh count and vector<int> tags
+    // inline in every tri, plus one heap block per non-empty vector.
+    size_t heap_block = 2 * sizeof( void* );
+    size_t bool_words = ( tmv.size() + 8 * sizeof( size_t ) - 1 ) / ( 8 * sizeof( size_t ) );
+    old_bytes = ntri * ( sizeof( string ) + sizeof( vector< bool > ) + sizeof( vector< int > ) ) +
+                nclassified * ( heap_block + bool_words * sizeof( size_t ) ) +
+                ntri * heap_block + ntag * sizeof( int );
+
+    new_bytes = ntri * 3 * sizeof( int ) + inside_bytes + TTriTable::MemoryUsage();
+}
@@ -0,0 +1,42 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// GeomCoreTestUtil.h: Models and helpers shared by the geom_core test and
+// benchmark suites
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(VSPGEOMCORETESTUTIL__INCLUDED_)
+#define VSPGEOMCORETESTUTIL__INCLUDED_
+
+#include "Vehicle.h"
+#include "TMesh.h"
+
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+// Pod moved to x, y, z.  NULL if it could not be added.
+Geom* AddTestPod( Vehicle & veh, double x, double y = 0.0, double z = 0.0 );
+
+// Fuselage, a wing at x = 10 and a pod at x = 12, y = pod_y.  The pod overlaps
+// the fuselage for pod_y = 0 and crosses the wing for pod_y = 4.
+bool AddFuseWingPod( Vehicle & veh, double pod_y, Geom* & wing, Geom* & pod );
+
+// Remove a MeshGeom made by CompGeom, MassProps or PSlice.
+void CutTestMesh( Vehicle & veh, const string & mesh_id );
+
+// Write tmv to file_name, legacy Tri_List or binary Tri_Data, and read it back.
+vector< TMesh* > RoundTripTMeshXml( const vector< TMesh* > & tmv, bool legacy, const char* file_name );
+
+long TestFileSize( const char* file_name );
+
+// Per tri metadata of split meshes: the former string, vector<bool> and
+// vector<int> layout against the compact index layout.
+void TriMetadataBytes( const vector< TMesh* > & tmv, size_t & ntri, size_t & old_bytes, size_t & new_bytes );
+
+#endif // !defined(VSPGEOMCORETESTUTIL__INCLUDED_)
@@ -0,0 +1,255 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// GeomUpdateGraph.cpp: Update dependencies between the Geoms of a Vehicle
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "GeomUpdateGraph.h"
+#include "Vehicle.h"
+#include "LinkMgr.h"
+#include "AdvLinkMgr.h"
+#include "ParmMgr.h"
+
+GeomUpdateGraph::GeomUpdateGraph()
+{
+    Clear();
+}
+
+void GeomUpdateGraph::Clear()
+{
+    m_GeomVec.clear();
+    m_TopNodeVec.clear();
+    m_EdgeVec.clear();
+    m_NodeMap.clear();
+
+    m_NumGroups = 0;
+    m_GroupVec.clear();
+    m_GroupNodeVec.clear();
+}
+
+void GeomUpdateGraph::Build( Vehicle* veh, const vector< string > & top_ids )
+{
+    Clear();
+
+    if ( !veh )
+    {
+        return;
+    }
+
+    //==== Nodes And Child Edges, In Update Order ====//
+    for ( int i = 0 ; i < ( int )top_ids.size() ; i++ )
+    {
+        Geom* geom = veh->FindGeom( top_ids[i] );
+        if ( geom && m_NodeMap.find( geom->GetID() ) == m_NodeMap.end() )
+        {
+            AddSubTree( veh, geom );
+        }
+        m_TopNodeVec.push_back( geom ? FindNode( geom->GetID() ) : -1 );
+    }
+
+    //==== Parm Links ====//
+    for ( int i = 0 ; i < LinkMgr.GetNumLinks() ; i++ )
+    {
+        Link* link = LinkMgr.GetLink( i );
+        if ( link )
+        {
+            AddLinkEdge( link->GetParmA(), link->GetParmB() );
+        }
+    }
+
+    vector< AdvLink* > adv_link_vec = AdvLinkMgr.GetLinks();
+    for ( int i = 0 ; i < ( int )adv_link_vec.size() ; i++ )
+    {
+        vector< VarDef > in_vec = adv_link_vec[i]->GetInputVars();
+        vector< VarDef > out_vec = adv_link_vec[i]->GetOutputVars();
+        for ( int j = 0 ; j < ( int )in_vec.size() ; j++ )
+        {
+            for ( int k = 0 ; k < ( int )out_vec.size() ; k++ )
+            {
+                AddLinkEdge( in_vec[j].m_ParmID, out_vec[k].m_ParmID );
+            }
+        }
+    }
+
+    UpdateGroups();
+}
+
+void GeomUpdateGraph::AddSubTree( Vehicle* veh, Geom* geom )
+{
+    int node = m_GeomVec.size();
+    m_GeomVec.push_back( geom );
+    m_NodeMap[ geom->GetID() ] = node;
+
+    vector< string > child_vec = geom->GetChildIDVec();
+    for ( int i = 0 ; i < ( int )child_vec.size() ; i++ )
+    {
+        Geom* child = veh->FindGeom( child_vec[i] );
+        if ( !child || m_NodeMap.find( child->GetID() ) != m_NodeMap.end() )
+        {
+            continue;
+        }
+
+        int type = CHILD_EDGE;
+        if ( geom->GetType().m_Type == HINGE_GEOM_TYPE )
+        {
+            type = HINGE_EDGE;
+        }
+        else if ( child->GetType().m_Type == CONFORMAL_GEOM_TYPE )
+        {
+            type = CONFORMAL_EDGE;
+        }
+        else if ( child->m_RotAttachFlag() != vsp::ATTACH_ROT_NONE ||
+                  child->m_TransAttachFlag() != vsp::ATTACH_TRANS_NONE )
+        {
+            type = ATTACH_EDGE;
+        }
+
+        int child_node = m_GeomVec.size();
+        AddSubTree( veh, child );
+        AddEdge( node, child_node, type );
+    }
+}
+
+int GeomUpdateGraph::FindParmNode( const string & parm_id ) const
+{
+    Parm* parm = ParmMgr.FindParm( parm_id );
+    if ( !parm )
+    {
+        return -1;
+    }
+    return FindNode( parm->GetLinkContainerID() );
+}
+
+void GeomUpdateGraph::AddLinkEdge( const string & parm_a, const string & parm_b )
+{
+    int from = FindParmNode( parm_a );
+    int to = FindParmNode( parm_b );
+
+    // Links from or to Vehicle and user parms do not join Geoms.
+    if ( from >= 0 && to >= 0 && from != to )
+    {
+        AddEdge( from, to, LINK_EDGE );
+    }
+}
+
+void GeomUpdateGraph::AddEdge( int from, int to, int type )
+{
+    m_EdgeVec.push_back( GeomUpdateEdge( from, to, type ) );
+}
+
+int GeomUpdateGraph::FindNode( const string & geom_id ) const
+{
+    map< string, int >::const_iterator it = m_NodeMap.find( geom_id );
+    if ( it == m_NodeMap.end() )
+    {
+        return -1;
+    }
+    return it->second;
+}
+
+//==== Connected Nodes By Union Find, Numbered By First Node ====//
+void GeomUpdateGraph::UpdateGroups()
+{
+    int nnode = m_GeomVec.size();
+
+    vector< int > root( nnode );
+    for ( int n = 0 ; n < nnode ; n++ )
+    {
+        root[n] = n;
+    }
+
+    for ( int e = 0 ; e < ( int )m_EdgeVec.size() ; e++ )
+    {
+        int a = m_EdgeVec[e].m_From;
+        int b = m_EdgeVec[e].m_To;
+        while ( root[a] != a )
+        {
+            a = root[a];
+        }
+        while ( root[b] != b )
+        {
+            b = root[b];
+        }
+
+        // Lower node is the root, so groups keep update order.
+        if ( a < b )
+        {
+            root[b] = a;
+        }
+        else if ( b < a )
+        {
+            root[a] = b;
+        }
+    }
+
+    m_NumGroups = 0;
+    m_GroupVec.assign( nnode, -1 );
+    m_GroupNodeVec.clear();
+
+    for ( int n = 0 ; n < nnode ; n++ )
+    {
+        int r = n;
+        while ( root[r] != r )
+        {
+            r = root[r];
+        }
+
+        if ( r == n )
+        {
+            m_GroupVec[n] = m_NumGroups;
+            m_GroupNodeVec.push_back( vector< int >() );
+            m_NumGroups++;
+        }
+        else
+        {
+            m_GroupVec[n] = m_GroupVec[r];
+        }
+        m_GroupNodeVec[ m_GroupVec[n] ].push_back( n );
+    }
+}
+
+//==== Kahn's Algorithm ====//
+bool GeomUpdateGraph::IsAcyclic() const
+{
+    int nnode = m_GeomVec.size();
+
+    vector< int > in_count( nnode, 0 );
+    vector< vector< int > > out_vec( nnode );
+    for ( int e = 0 ; e < ( int )m_EdgeVec.size() ; e++ )
+    {
+        in_count[ m_EdgeVec[e].m_To ]++;
+        out_vec[ m_EdgeVec[e].m_From ].push_back( m_EdgeVec[e].m_To );
+    }
+
+    vector< int > ready;
+    for ( int n = 0 ; n < nnode ; n++ )
+    {
+        if ( in_count[n] == 0 )
+        {
+            ready.push_back( n );
+        }
+    }
+
+    int nvisit = 0;
+    while ( !ready.empty() )
+    {
+        int n = ready.back();
+        ready.pop_back();
+        nvisit++;
+
+        for ( int i = 0 ; i < ( int )out_vec[n].size() ; i++ )
+        {
+            int m = out_vec[n][i];
+            in_count[m]--;
+            if ( in_count[m] == 0 )
+            {
+                ready.push_back( m );
+            }
+        }
+    }
+
+    return nvisit == nnode;
+}
@@ -0,0 +1,92 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// GeomUpdateGraph.h: Update dependencies between the Geoms of a Vehicle
+//
+// Nodes are Geoms, listed parents first in the order Vehicle::Update visits
+// them.  An edge A -> B means updating A can change B: B is a child of A
+// (attached, Conformal or under a Hinge) or a parameter of A drives one of B
+// through a link or advanced link.  Geoms joined by any chain of edges form
+// one group.  Separate groups share no data, so the Geom-local part of their
+// updates can run at the same time.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(GEOMUPDATEGRAPH__INCLUDED_)
+#define GEOMUPDATEGRAPH__INCLUDED_
+
+#include <vector>
+#include <string>
+#include <map>
+
+using std::vector;
+using std::string;
+using std::map;
+
+class Geom;
+class Vehicle;
+
+//==== Directed Dependency ====//
+class GeomUpdateEdge
+{
+public:
+    GeomUpdateEdge( int from, int to, int type ) : m_From( from ), m_To( to ), m_Type( type ) {}
+
+    int m_From;
+    int m_To;
+    int m_Type;
+};
+
+class GeomUpdateGraph
+{
+public:
+    GeomUpdateGraph();
+
+    enum { CHILD_EDGE,          // Child updated after parent, not attached
+           ATTACH_EDGE,         // Child placed by parent's transform or surface
+           CONFORMAL_EDGE,      // Child surface built from parent surface
+           HINGE_EDGE,          // Child moved by a Hinge
+           LINK_EDGE,           // Parm link or advanced link
+           NUM_EDGE_TYPES
+         };
+
+    void Clear();
+
+    // Walk children from top_ids, then add link edges between the Geoms found.
+    void Build( Vehicle* veh, const vector< string > & top_ids );
+
+    void AddEdge( int from, int to, int type );
+
+    // Recompute groups after edges are added.
+    void UpdateGroups();
+
+    int FindNode( const string & geom_id ) const;
+
+    int GetNumNodes() const
+    {
+        return m_GeomVec.size();
+    }
+
+    // True when following edges never returns to a Geom (links may close loops).
+    bool IsAcyclic() const;
+
+    vector< Geom* > m_GeomVec;                  // Nodes, parents before children
+    vector< int > m_TopNodeVec;                 // Node of each top Geom, -1 if not found
+    vector< GeomUpdateEdge > m_EdgeVec;
+
+    int m_NumGroups;
+    vector< int > m_GroupVec;                   // Group of each node, numbered in node order
+    vector< vector< int > > m_GroupNodeVec;     // Nodes of each group, ascending
+
+protected:
+
+    void AddSubTree( Vehicle* veh, Geom* geom );
+    void AddLinkEdge( const string & parm_a, const string & parm_b );
+    int FindParmNode( const string & parm_id ) const;
+
+    map< string, int > m_NodeMap;
+};
+
+#endif // !defined(GEOMUPDATEGRAPH__INCLUDED_)
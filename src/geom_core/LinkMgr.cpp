@@ -12,6 +12,7 @@
 #include "ParmMgr.h"
 #include "Vehicle.h"
 #include "StlHelper.h"
+#include "UpdateProfileMgr.h"
 
 bool LinkMgrSingleton::m_firsttime = true;
 
@@ -421,6 +422,7 @@ void LinkMgrSingleton::ParmChanged( const string& pid, bool start_flag  )
     m_UpdatedParmVec.push_back( parm_ptr->GetID() );
 
     //==== Update Linked Parms ====//
+    UpdateStageTimer link_timer( parm_ptr->GetLinkContainerID(), UpdateProfileMgrSingleton::LINK_STAGE );
     for ( int i = 0 ; i < ( int )parm_link_vec.size() ; i++ )
     {
         Link* pl = parm_link_vec[i];
@@ -458,6 +460,7 @@ void LinkMgrSingleton::ParmChanged( const string& pid, bool start_flag  )
     //==== Update Adv Link ===//
     if ( adv_link_flag )
     {
+        UpdateStageTimer adv_link_timer( parm_ptr->GetLinkContainerID(), UpdateProfileMgrSingleton::ADV_LINK_STAGE );
         AdvLinkMgr.UpdateLinks( pid );
     }
 
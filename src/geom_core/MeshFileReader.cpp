@@ -0,0 +1,675 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// MeshFileReader.cpp
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "MeshFileReader.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+//==== Constructor ====//
+MappedFile::MappedFile()
+{
+    m_Data = NULL;
+    m_Size = 0;
+#ifdef WIN32
+    m_File = INVALID_HANDLE_VALUE;
+    m_Mapping = NULL;
+#else
+    m_File = -1;
+#endif
+}
+
+//==== Destructor ====//
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+//==== Map Whole File, Empty Files Open With No Data ====//
+bool MappedFile::Open( const string & file_name )
+{
+    Close();
+
+#ifdef WIN32
+    m_File = CreateFileA( file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+    if ( m_File == INVALID_HANDLE_VALUE )
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if ( !GetFileSizeEx( m_File, &size ) )
+    {
+        Close();
+        return false;
+    }
+    m_Size = ( size_t )size.QuadPart;
+
+    if ( m_Size > 0 )
+    {
+        m_Mapping = CreateFileMappingA( m_File, NULL, PAGE_READONLY, 0, 0, NULL );
+        if ( !m_Mapping )
+        {
+            Close();
+            return false;
+        }
+        m_Data = ( const char* )MapViewOfFile( m_Mapping, FILE_MAP_READ, 0, 0, 0 );
+        if ( !m_Data )
+        {
+            Close();
+            return false;
+        }
+    }
+#else
+    m_File = open( file_name.c_str(), O_RDONLY );
+    if ( m_File < 0 )
+    {
+        return false;
+    }
+
+    struct stat st;
+    if ( fstat( m_File, &st ) != 0 )
+    {
+        Close();
+        return false;
+    }
+    m_Size = ( size_t )st.st_size;
+
+    if ( m_Size > 0 )
+    {
+        void* ptr = mmap( NULL, m_Size, PROT_READ, MAP_PRIVATE, m_File, 0 );
+        if ( ptr == MAP_FAILED )
+        {
+            Close();
+            return false;
+        }
+        m_Data = ( const char* )ptr;
+        madvise( ptr, m_Size, MADV_SEQUENTIAL );
+    }
+#endif
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef WIN32
+    if ( m_Data )
+    {
+        UnmapViewOfFile( m_Data );
+    }
+    if ( m_Mapping )
+    {
+        CloseHandle( m_Mapping );
+    }
+    if ( m_File != INVALID_HANDLE_VALUE )
+    {
+        CloseHandle( m_File );
+    }
+    m_File = INVALID_HANDLE_VALUE;
+    m_Mapping = NULL;
+#else
+    if ( m_Data )
+    {
+        munmap( ( void* )m_Data, m_Size );
+    }
+    if ( m_File >= 0 )
+    {
+        close( m_File );
+    }
+    m_File = -1;
+#endif
+    m_Data = NULL;
+    m_Size = 0;
+}
+
+//===============================================================================//
+//===============================================================================//
+
+static inline bool IsSpace( char c )
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+//==== Next Whitespace Delimited Token At Or After pos ====//
+static bool NextToken( const char* data, size_t size, size_t & pos, size_t & tok_start, size_t & tok_len )
+{
+    while ( pos < size && IsSpace( data[pos] ) )
+    {
+        pos++;
+    }
+    if ( pos >= size )
+    {
+        return false;
+    }
+
+    tok_start = pos;
+    while ( pos < size && !IsSpace( data[pos] ) )
+    {
+        pos++;
+    }
+    tok_len = pos - tok_start;
+    return true;
+}
+
+static bool TokenIs( const char* data, size_t tok_start, size_t tok_len, const char* word )
+{
+    size_t len = strlen( word );
+    return tok_len == len && strncmp( data + tok_start, word, len ) == 0;
+}
+
+// The mapping is not null terminated, so numbers are copied out before
+// conversion.  Conversion is the same as fscanf %f / %d.
+static float TokenFloat( const char* data, size_t tok_start, size_t tok_len )
+{
+    char buff[64];
+    size_t len = std::min( tok_len, sizeof( buff ) - 1 );
+    memcpy( buff, data + tok_start, len );
+    buff[len] = '\0';
+    return strtof( buff, NULL );
+}
+
+static double TokenDouble( const char* data, size_t tok_start, size_t tok_len )
+{
+    char buff[64];
+    size_t len = std::min( tok_len, sizeof( buff ) - 1 );
+    memcpy( buff, data + tok_start, len );
+    buff[len] = '\0';
+    return strtod( buff, NULL );
+}
+
+static long TokenInt( const char* data, size_t tok_start, size_t tok_len )
+{
+    char buff[64];
+    size_t len = std::min( tok_len, sizeof( buff ) - 1 );
+    memcpy( buff, data + tok_start, len );
+    buff[len] = '\0';
+    return strtol( buff, NULL, 10 );
+}
+
+static bool NextFloat( const char* data, size_t size, size_t & pos, float & val )
+{
+    size_t tok_start, tok_len;
+    if ( !NextToken( data, size, pos, tok_start, tok_len ) )
+    {
+        return false;
+    }
+    val = TokenFloat( data, tok_start, tok_len );
+    return true;
+}
+
+static void SkipLine( const char* data, size_t size, size_t & pos )
+{
+    while ( pos < size && data[pos] != '\n' )
+    {
+        pos++;
+    }
+}
+
+static float SwapFloat( float val )
+{
+    unsigned char *cptr = ( unsigned char * )&val;
+    std::swap( cptr[0], cptr[3] );
+    std::swap( cptr[1], cptr[2] );
+    return val;
+}
+
+//===============================================================================//
+//===============================================================================//
+
+//==== Bytes Above 127 Before Any Null In Each 255 Byte fgets Read ====//
+bool MeshFileReader::IsBinarySTL( const char* data, size_t size )
+{
+    int col = 0;
+    bool null_flag = false;
+    for ( size_t i = 0 ; i < size ; i++ )
+    {
+        unsigned char c = ( unsigned char )data[i];
+        if ( !null_flag && c > 127 )
+        {
+            return true;
+        }
+        if ( c == '\0' )
+        {
+            null_flag = true;
+        }
+        col++;
+        if ( c == '\n' || col == 254 )
+        {
+            col = 0;
+            null_flag = false;
+        }
+    }
+    return false;
+}
+
+//==== Start Of The First Line At Or After pos Beginning With facet ====//
+static size_t FindFacetLine( const char* data, size_t size, size_t pos )
+{
+    if ( pos > 0 )
+    {
+        SkipLine( data, size, pos );
+    }
+
+    while ( pos < size )
+    {
+        size_t line = pos;
+        while ( pos < size && ( data[pos] == ' ' || data[pos] == '\t' || data[pos] == '\n' || data[pos] == '\r' ) )
+        {
+            if ( data[pos] == '\n' )
+            {
+                line = pos + 1;
+            }
+            pos++;
+        }
+        if ( pos + 5 < size && strncmp( data + pos, "facet", 5 ) == 0 && IsSpace( data[pos + 5] ) )
+        {
+            return line;
+        }
+        SkipLine( data, size, pos );
+    }
+    return size;
+}
+
+//==== Facets Starting In [begin, end) ====//
+// A facet that starts before end is read to its finish.
+static void ReadSTLASCIIRange( const char* data, size_t size, size_t begin, size_t end, vector< float > & pnts, vector< float > & norms )
+{
+    size_t pos = begin;
+    size_t tok_start, tok_len;
+
+    bool facet_flag = false;
+    int nvert = 0;
+    float norm[3] = { 0, 0, 0 };
+    float vert[9];
+
+    while ( NextToken( data, size, pos, tok_start, tok_len ) )
+    {
+        if ( tok_start >= end && !facet_flag )
+        {
+            break;
+        }
+
+        if ( TokenIs( data, tok_start, tok_len, "facet" ) )
+        {
+            facet_flag = true;
+            nvert = 0;
+            size_t normal_pos = pos;
+            if ( NextToken( data, size, normal_pos, tok_start, tok_len ) && TokenIs( data, tok_start, tok_len, "normal" ) )
+            {
+                pos = normal_pos;
+                for ( int i = 0 ; i < 3 ; i++ )
+                {
+                    NextFloat( data, size, pos, norm[i] );
+                }
+            }
+        }
+        else if ( TokenIs( data, tok_start, tok_len, "vertex" ) )
+        {
+            float v[3] = { 0, 0, 0 };
+            for ( int i = 0 ; i < 3 ; i++ )
+            {
+                NextFloat( data, size, pos, v[i] );
+            }
+            if ( nvert < 3 )
+            {
+                vert[ 3 * nvert ] = v[0];
+                vert[ 3 * nvert + 1 ] = v[1];
+                vert[ 3 * nvert + 2 ] = v[2];
+            }
+            nvert++;
+        }
+        else if ( TokenIs( data, tok_start, tok_len, "endfacet" ) )
+        {
+            if ( facet_flag && nvert == 3 )
+            {
+                pnts.insert( pnts.end(), vert, vert + 9 );
+                norms.insert( norms.end(), norm, norm + 3 );
+            }
+            facet_flag = false;
+        }
+        else if ( TokenIs( data, tok_start, tok_len, "solid" ) || TokenIs( data, tok_start, tok_len, "endsolid" ) )
+        {
+            // Solid names are free text
+            SkipLine( data, size, pos );
+            facet_flag = false;
+        }
+    }
+}
+
+bool MeshFileReader::ReadSTL( const char* data, size_t size, bool big_endian, MeshFileData & mesh_data, size_t chunk_size )
+{
+    mesh_data.Clear();
+
+    if ( !data || size == 0 )
+    {
+        return false;
+    }
+
+    if ( !IsBinarySTL( data, size ) )
+    {
+        //==== Chunks Begin On facet Lines ====//
+        int nchunk = ( int )( size / chunk_size ) + 1;
+        vector< size_t > start_vec( nchunk + 1 );
+        start_vec[0] = 0;
+        start_vec[nchunk] = size;
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for
+#endif
+        for ( int c = 1 ; c < nchunk ; c++ )
+        {
+            start_vec[c] = FindFacetLine( data, size, c * chunk_size );
+        }
+
+        vector< vector< float > > pnt_chunks( nchunk );
+        vector< vector< float > > norm_chunks( nchunk );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+        for ( int c = 0 ; c < nchunk ; c++ )
+        {
+            ReadSTLASCIIRange( data, size, start_vec[c], start_vec[c + 1], pnt_chunks[c], norm_chunks[c] );
+        }
+
+        //==== Join In Chunk Order ====//
+        size_t ntri = 0;
+        for ( int c = 0 ; c < nchunk ; c++ )
+        {
+            ntri += norm_chunks[c].size() / 3;
+        }
+        mesh_data.m_Pnts.reserve( 9 * ntri );
+        mesh_data.m_Norms.reserve( 3 * ntri );
+        for ( int c = 0 ; c < nchunk ; c++ )
+        {
+            mesh_data.m_Pnts.insert( mesh_data.m_Pnts.end(), pnt_chunks[c].begin(), pnt_chunks[c].end() );
+            mesh_data.m_Norms.insert( mesh_data.m_Norms.end(), norm_chunks[c].begin(), norm_chunks[c].end() );
+        }
+    }
+    else
+    {
+        //==== 80 Byte Header, Facet Count, 50 Byte Facets ====//
+        if ( size < 84 )
+        {
+            return false;
+        }
+
+        unsigned int num_facet;
+        memcpy( &num_facet, data + 80, 4 );
+        if ( big_endian )
+        {
+            unsigned char *cptr = ( unsigned char * )&num_facet;
+            std::swap( cptr[0], cptr[3] );
+            std::swap( cptr[1], cptr[2] );
+        }
+        int ntri = ( int )std::min( ( size_t )num_facet, ( size - 84 ) / 50 );
+
+        mesh_data.m_Pnts.resize( 9 * ntri );
+        mesh_data.m_Norms.resize( 3 * ntri );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for
+#endif
+        for ( int t = 0 ; t < ntri ; t++ )
+        {
+            float vals[12];
+            memcpy( vals, data + 84 + 50 * ( size_t )t, 12 * sizeof( float ) );
+            if ( big_endian )
+            {
+                for ( int i = 0 ; i < 12 ; i++ )
+                {
+                    vals[i] = SwapFloat( vals[i] );
+                }
+            }
+            for ( int i = 0 ; i < 3 ; i++ )
+            {
+                mesh_data.m_Norms[ 3 * t + i ] = vals[i];
+            }
+            for ( int i = 0 ; i < 9 ; i++ )
+            {
+                mesh_data.m_Pnts[ 9 * t + i ] = vals[ 3 + i ];
+            }
+        }
+    }
+
+    return mesh_data.NumTris() > 0;
+}
+
+//==== Count Tokens Starting In [begin, end) ====//
+static size_t CountTokens( const char* data, size_t size, size_t begin, size_t end )
+{
+    size_t count = 0;
+    size_t pos = begin;
+    size_t tok_start, tok_len;
+    while ( NextToken( data, size, pos, tok_start, tok_len ) && tok_start < end )
+    {
+        count++;
+    }
+    return count;
+}
+
+bool MeshFileReader::ReadTri( const char* data, size_t size, int tokens_per_tri, MeshFileData & mesh_data, size_t chunk_size )
+{
+    mesh_data.Clear();
+
+    if ( !data || size == 0 || tokens_per_tri < 3 )
+    {
+        return false;
+    }
+
+    //==== Header ====//
+    size_t pos = 0;
+    size_t tok_start, tok_len;
+    if ( !NextToken( data, size, pos, tok_start, tok_len ) )
+    {
+        return false;
+    }
+    long num_nodes = TokenInt( data, tok_start, tok_len );
+    if ( !NextToken( data, size, pos, tok_start, tok_len ) )
+    {
+        return false;
+    }
+    long num_tris = TokenInt( data, tok_start, tok_len );
+
+    if ( num_nodes <= 0 || num_tris <= 0 )
+    {
+        return false;
+    }
+
+    size_t num_pnt_tokens = 3 * ( size_t )num_nodes;
+    size_t num_tri_tokens = tokens_per_tri * ( size_t )num_tris;
+
+    //==== Chunks Begin On Whitespace ====//
+    size_t body = pos;
+    int nchunk = ( int )( ( size - body ) / chunk_size ) + 1;
+    vector< size_t > start_vec( nchunk + 1 );
+    start_vec[0] = body;
+    start_vec[nchunk] = size;
+    for ( int c = 1 ; c < nchunk ; c++ )
+    {
+        size_t p = body + c * chunk_size;
+        while ( p < size && !IsSpace( data[p] ) )
+        {
+            p++;
+        }
+        start_vec[c] = p;
+    }
+
+    //==== Token Offset Of Each Chunk ====//
+    vector< size_t > count_vec( nchunk );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( int c = 0 ; c < nchunk ; c++ )
+    {
+        count_vec[c] = CountTokens( data, size, start_vec[c], start_vec[c + 1] );
+    }
+
+    vector< size_t > offset_vec( nchunk + 1, 0 );
+    for ( int c = 0 ; c < nchunk ; c++ )
+    {
+        offset_vec[c + 1] = offset_vec[c] + count_vec[c];
+    }
+    if ( offset_vec[nchunk] < num_pnt_tokens + num_tri_tokens )
+    {
+        return false;
+    }
+
+    mesh_data.m_Pnts.resize( num_pnt_tokens );
+    mesh_data.m_Tris.resize( 3 * ( size_t )num_tris );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( int c = 0 ; c < nchunk ; c++ )
+    {
+        size_t g = offset_vec[c];
+        size_t p = start_vec[c];
+        size_t ts, tl;
+        while ( g < num_pnt_tokens + num_tri_tokens && NextToken( data, size, p, ts, tl ) && ts < start_vec[c + 1] )
+        {
+            if ( g < num_pnt_tokens )
+            {
+                mesh_data.m_Pnts[g] = TokenFloat( data, ts, tl );
+            }
+            else
+            {
+                size_t h = g - num_pnt_tokens;
+                size_t t = h / tokens_per_tri;
+                size_t j = h % tokens_per_tri;
+                if ( j < 3 )
+                {
+                    mesh_data.m_Tris[ 3 * t + j ] = ( int )TokenInt( data, ts, tl );
+                }
+            }
+            g++;
+        }
+    }
+
+    //==== Node Numbers Are One Based ====//
+    for ( size_t i = 0 ; i < mesh_data.m_Tris.size() ; i++ )
+    {
+        if ( mesh_data.m_Tris[i] < 1 || mesh_data.m_Tris[i] > num_nodes )
+        {
+            mesh_data.Clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool MeshFileReader::ReadPts( const char* data, size_t size, vector< double > & xyz, size_t chunk_size )
+{
+    xyz.clear();
+
+    if ( !data || size == 0 )
+    {
+        return false;
+    }
+
+    //==== Chunks Begin On Whitespace ====//
+    int nchunk = ( int )( size / chunk_size ) + 1;
+    vector< size_t > start_vec( nchunk + 1 );
+    start_vec[0] = 0;
+    start_vec[nchunk] = size;
+    for ( int c = 1 ; c < nchunk ; c++ )
+    {
+        size_t p = c * chunk_size;
+        while ( p < size && !IsSpace( data[p] ) )
+        {
+            p++;
+        }
+        start_vec[c] = p;
+    }
+
+    //==== Token Offset Of Each Chunk ====//
+    vector< size_t > count_vec( nchunk );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( int c = 0 ; c < nchunk ; c++ )
+    {
+        count_vec[c] = CountTokens( data, size, start_vec[c], start_vec[c + 1] );
+    }
+
+    vector< size_t > offset_vec( nchunk + 1, 0 );
+    for ( int c = 0 ; c < nchunk ; c++ )
+    {
+        offset_vec[c + 1] = offset_vec[c] + count_vec[c];
+    }
+
+    // A trailing partial point is dropped, as the fscanf loop did.
+    size_t num_tokens = 3 * ( offset_vec[nchunk] / 3 );
+    xyz.resize( num_tokens );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( int c = 0 ; c < nchunk ; c++ )
+    {
+        size_t g = offset_vec[c];
+        size_t p = start_vec[c];
+        size_t ts, tl;
+        while ( g < num_tokens && NextToken( data, size, p, ts, tl ) && ts < start_vec[c + 1] )
+        {
+            xyz[g] = TokenDouble( data, ts, tl );
+            g++;
+        }
+    }
+
+    return !xyz.empty();
+}
+
+bool MeshFileReader::ReadSTLFile( const string & file_name, bool big_endian, MeshFileData & mesh_data )
+{
+    MappedFile file;
+    if ( !file.Open( file_name ) )
+    {
+        mesh_data.Clear();
+        return false;
+    }
+    return ReadSTL( file.Data(), file.Size(), big_endian, mesh_data );
+}
+
+bool MeshFileReader::ReadTriFile( const string & file_name, int tokens_per_tri, MeshFileData & mesh_data )
+{
+    MappedFile file;
+    if ( !file.Open( file_name ) )
+    {
+        mesh_data.Clear();
+        return false;
+    }
+    return ReadTri( file.Data(), file.Size(), tokens_per_tri, mesh_data );
+}
+
+bool MeshFileReader::ReadPtsFile( const string & file_name, vector< double > & xyz )
+{
+    MappedFile file;
+    if ( !file.Open( file_name ) )
+    {
+        xyz.clear();
+        return false;
+    }
+    return ReadPts( file.Data(), file.Size(), xyz );
+}
@@ -0,0 +1,110 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// MeshFileReader.h: Memory mapped, chunk parallel readers for STL, TRI and PTS files
+//
+// Files are mapped read only and cut into chunks on record boundaries.
+// Chunks are parsed in parallel into flat arrays, which are then joined in
+// chunk order, so the result is in file order whatever the thread count.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(MESHFILEREADER__INCLUDED_)
+#define MESHFILEREADER__INCLUDED_
+
+#include <vector>
+#include <string>
+#include <stddef.h>
+
+using std::vector;
+using std::string;
+
+//==== Read Only View Of A Whole File ====//
+class MappedFile
+{
+public:
+    MappedFile();
+    virtual ~MappedFile();
+
+    bool Open( const string & file_name );
+    void Close();
+
+    const char* Data() const
+    {
+        return m_Data;
+    }
+    size_t Size() const
+    {
+        return m_Size;
+    }
+
+protected:
+
+    const char* m_Data;
+    size_t m_Size;
+
+#ifdef WIN32
+    void* m_File;
+    void* m_Mapping;
+#else
+    int m_File;
+#endif
+
+private:
+
+    MappedFile( const MappedFile & );
+    MappedFile & operator=( const MappedFile & );
+};
+
+//==== Triangle Arrays In File Order ====//
+class MeshFileData
+{
+public:
+    void Clear()
+    {
+        m_Pnts.clear();
+        m_Norms.clear();
+        m_Tris.clear();
+    }
+
+    int NumTris() const
+    {
+        return m_Tris.empty() ? m_Norms.size() / 3 : m_Tris.size() / 3;
+    }
+
+    vector< float > m_Pnts;     // x, y, z per node.  STL has three nodes per tri.
+    vector< float > m_Norms;    // x, y, z per tri, STL only
+    vector< int > m_Tris;       // Three node numbers per tri as written, TRI and Nascart only
+};
+
+namespace MeshFileReader
+{
+// Default chunk size in bytes.  Smaller chunks are only useful for testing.
+const size_t DEFAULT_CHUNK_SIZE = 1 << 22;
+
+// Same ASCII/binary test as the former fgets based reader.
+bool IsBinarySTL( const char* data, size_t size );
+
+// ASCII and binary STL.  Binary values are byte swapped when big_endian is set.
+bool ReadSTL( const char* data, size_t size, bool big_endian, MeshFileData & mesh_data,
+              size_t chunk_size = DEFAULT_CHUNK_SIZE );
+
+// Node count, tri count, node coordinates, then tokens_per_tri values per tri
+// of which the first three are node numbers (Cart3D TRI: 3, Nascart: 4).
+// Anything after the tris (component numbers) is ignored.
+bool ReadTri( const char* data, size_t size, int tokens_per_tri, MeshFileData & mesh_data,
+              size_t chunk_size = DEFAULT_CHUNK_SIZE );
+
+// Whitespace separated x y z triples, in double precision.
+bool ReadPts( const char* data, size_t size, vector< double > & xyz,
+              size_t chunk_size = DEFAULT_CHUNK_SIZE );
+
+// Map the file and call the above.
+bool ReadSTLFile( const string & file_name, bool big_endian, MeshFileData & mesh_data );
+bool ReadTriFile( const string & file_name, int tokens_per_tri, MeshFileData & mesh_data );
+bool ReadPtsFile( const string & file_name, vector< double > & xyz );
+}
+
+#endif // !defined(MESHFILEREADER__INCLUDED_)
@@ -14,6 +14,8 @@
 //******************************************************************************
 
 #include "MeshGeom.h"
+#include "MeshFileReader.h"
+#include "ExportWriter.h"
 #include "PtCloudGeom.h"
 #include "LinkMgr.h"
 #include "Vehicle.h"
@@ -234,164 +236,37 @@ int MeshGeom::ReadXSec( const char* file_name )
 
 int MeshGeom::ReadSTL( const char* file_name )
 {
-    FILE* file_id = fopen( file_name, "r" );
-
-    char str[256];
-    float nx, ny, nz;
-    float v0[3];
-    float v1[3];
-    float v2[3];
-    TTri*  tPtr;
-    TMesh*  tMesh = new TMesh();
-
-    if ( file_id )
+    MeshFileData data;
+    if ( !MeshFileReader::ReadSTLFile( file_name, !!m_BigEndianFlag, data ) )
     {
-        //==== Cheesy ASCII/Binary Test ====//
-        int binaryFlag = 0;
-        while ( fgets( str, 255, file_id ) )
-        {
-            for ( int i = 0 ; i < ( int )strlen( str ) ; i++ )
-            {
-                if ( ( unsigned char )str[i] > 127 )
-                {
-                    binaryFlag = 1;
-                    break;
-                }
-            }
-        }
-
-        rewind( file_id );
-
-        if ( !binaryFlag )
-        {
-            fgets( str, 255, file_id );
-
-            int stopFlag = 0;
-
-            while ( !stopFlag )
-            {
-                if ( EOF == fscanf( file_id, "%*s %*s %f %f %f\n", &nx, &ny, &nz ) )
-                {
-                    break;
-                }
-
-                if ( EOF == fscanf( file_id, "%*s %*s" ) )
-                {
-                    break;
-                }
-
-                if ( EOF == fscanf( file_id, "%*s %f %f %f\n", &v0[0], &v0[1], &v0[2] ) )
-                {
-                    break;
-                }
-                if ( EOF == fscanf( file_id, "%*s %f %f %f\n", &v1[0], &v1[1], &v1[2] ) )
-                {
-                    break;
-                }
-                if ( EOF == fscanf( file_id, "%*s %f %f %f\n", &v2[0], &v2[1], &v2[2] ) )
-                {
-                    break;
-                }
-                if ( EOF == fscanf( file_id, "%*s" ) )
-                {
-                    break;
-                }
-                if ( EOF == fscanf( file_id, "%*s" ) )
-                {
-                    break;
-                }
-
-                //==== Add Valid Facet ====//
-                tPtr = new TTri( tMesh );
-                tPtr->m_Norm = vec3d( nx, ny, nz );
-                tMesh->m_TVec.push_back( tPtr );
-
-                //==== Put Nodes Into Tri ====//
-                tPtr->m_N0 = new TNode();
-                tPtr->m_N1 = new TNode();
-                tPtr->m_N2 = new TNode();
-                tPtr->m_N0->m_Pnt = vec3d( v0[0], v0[1], v0[2] );
-                tPtr->m_N1->m_Pnt = vec3d( v1[0], v1[1], v1[2] );
-                tPtr->m_N2->m_Pnt = vec3d( v2[0], v2[1], v2[2] );
-                tMesh->m_NVec.push_back( tPtr->m_N0 );
-                tMesh->m_NVec.push_back( tPtr->m_N1 );
-                tMesh->m_NVec.push_back( tPtr->m_N2 );
-
-                fpos_t pos;
-                fgetpos( file_id, &pos );
-
-                if ( EOF == fscanf( file_id, "%s %*s\n", str ) )
-                {
-                    break;
-                }
-
-                if ( strcmp( str, "endsolid" ) == 0 )
-                {
-                    fgets( str, 255, file_id );
-                    if ( feof( file_id ) )
-                    {
-                        break;
-                    }
-                }
-                else
-                {
-                    fsetpos( file_id, &pos );
-                }
-            }
-        }
-        else
-        {
-            fclose( file_id );
-            file_id = fopen( file_name, "rb" );         // Reopen as Binary
-
-            //==== Header ====//
-            fread( str, sizeof( char ), 80, file_id );
-
-            int numFacet = ReadBinInt( file_id );
-
-            for ( int i = 0 ; i < numFacet ; i++ )
-            {
-                nx = ReadBinFloat( file_id );
-                ny = ReadBinFloat( file_id );
-                nz = ReadBinFloat( file_id );
-
-                v0[0] = ReadBinFloat( file_id );
-                v0[1] = ReadBinFloat( file_id );
-                v0[2] = ReadBinFloat( file_id );
-                v1[0] = ReadBinFloat( file_id );
-                v1[1] = ReadBinFloat( file_id );
-                v1[2] = ReadBinFloat( file_id );
-                v2[0] = ReadBinFloat( file_id );
-                v2[1] = ReadBinFloat( file_id );
-                v2[2] = ReadBinFloat( file_id );
-
-                //==== Padding ====//
-                fgetc( file_id );
-                fgetc( file_id );
-
-                //==== Add Valid Facet ====//
-                tPtr = new TTri( tMesh );
-                tPtr->m_Norm = vec3d( nx, ny, nz );
-                tMesh->m_TVec.push_back( tPtr );
-
-                //==== Put Nodes Into Tri ====//
-                tPtr->m_N0 = new TNode();
-                tPtr->m_N1 = new TNode();
-                tPtr->m_N2 = new TNode();
-                tPtr->m_N0->m_Pnt = vec3d( v0[0], v0[1], v0[2] );
-                tPtr->m_N1->m_Pnt = vec3d( v1[0], v1[1], v1[2] );
-                tPtr->m_N2->m_Pnt = vec3d( v2[0], v2[1], v2[2] );
-
-            }
-        }
-        fclose( file_id );
+        return 0;
     }
 
+    TMesh*  tMesh = new TMesh();
+    int num_tris = data.NumTris();
+    tMesh->m_TVec.resize( num_tris );
+    tMesh->m_NVec.resize( 3 * num_tris );
 
-    if ( tMesh->m_TVec.size() == 0 )
+    for ( int i = 0 ; i < num_tris ; i++ )
     {
-        delete tMesh;
-        return 0;
+        const float* n = &data.m_Norms[ 3 * i ];
+        const float* v = &data.m_Pnts[ 9 * i ];
+
+        //==== Add Valid Facet ====//
+        TTri* tPtr = new TTri( tMesh );
+        tPtr->m_Norm = vec3d( n[0], n[1], n[2] );
+        tMesh->m_TVec[i] = tPtr;
+
+        //==== Put Nodes Into Tri ====//
+        tPtr->m_N0 = new TNode();
+        tPtr->m_N1 = new TNode();
+        tPtr->m_N2 = new TNode();
+        tPtr->m_N0->m_Pnt = vec3d( v[0], v[1], v[2] );
+        tPtr->m_N1->m_Pnt = vec3d( v[3], v[4], v[5] );
+        tPtr->m_N2->m_Pnt = vec3d( v[6], v[7], v[8] );
+        tMesh->m_NVec[ 3 * i ] = tPtr->m_N0;
+        tMesh->m_NVec[ 3 * i + 1 ] = tPtr->m_N1;
+        tMesh->m_NVec[ 3 * i + 2 ] = tPtr->m_N2;
     }
 
     m_TMeshVec.push_back( tMesh );
@@ -466,16 +341,24 @@ void MeshGeom::WriteStl( FILE* file_id )
     }
 }
 
-void MeshGeom::WriteStl( FILE* file_id, int tag )
+//==== Indexed Tris Of One Tag As STL Facets ====//
+class TagSTLFormatter : public ExportFormatter
 {
-    //==== Write Out Tris ====//
-    for ( int i = 0 ; i < ( int )m_IndexedTriVec.size() ; i++ )
+public:
+    TagSTLFormatter( const vector< TTri* > & tri_vec, int tag ) : m_TriVec( tri_vec ), m_Tag( tag )
+    {
+    }
+
+    virtual int NumItems() const
     {
-        TTri* ttri = m_IndexedTriVec[i];
+        return m_TriVec.size();
+    }
 
-        int t = SubSurfaceMgr.GetTag( ttri->m_Tags );
+    virtual void Format( int i, ExportBuffer & buf ) const
+    {
+        TTri* ttri = m_TriVec[i];
 
-        if ( t == tag )
+        if ( SubSurfaceMgr.GetTag( ttri->GetTags() ) == m_Tag )
         {
             vec3d p0 = ttri->m_N0->m_Pnt;
             vec3d p1 = ttri->m_N1->m_Pnt;
@@ -485,52 +368,45 @@ void MeshGeom::WriteStl( FILE* file_id, int tag )
             vec3d norm = cross( v10, v20 );
             norm.normalize();
 
-            fprintf( file_id, " facet normal  %2.10le %2.10le %2.10le\n",  norm.x(), norm.y(), norm.z() );
-            fprintf( file_id, "   outer loop\n" );
-
-            fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p0.x(), p0.y(), p0.z() );
-            fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p1.x(), p1.y(), p1.z() );
-            fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p2.x(), p2.y(), p2.z() );
-
-            fprintf( file_id, "   endloop\n" );
-            fprintf( file_id, " endfacet\n" );
+            ExportWriter::FormatSTLFacet( norm, p0, p1, p2, buf );
         }
     }
+
+protected:
+    const vector< TTri* > & m_TriVec;
+    int m_Tag;
+};
+
+void MeshGeom::WriteStl( FILE* file_id, int tag )
+{
+    //==== Write Out Tris ====//
+    ExportWriter::Write( file_id, TagSTLFormatter( m_IndexedTriVec, tag ) );
 }
 
 int MeshGeom::ReadNascart( const char* file_name )
 {
-    int i;
-    FILE* file_id = fopen( file_name, "r" );
-
-    if ( !file_id )
+    //==== Nodes, Then n0 n2 n1 col Per Tri ====//
+    MeshFileData data;
+    if ( !MeshFileReader::ReadTriFile( file_name, 4, data ) )
     {
         return 0;
     }
 
     TMesh*  tMesh = new TMesh();
 
-    //==== Read Number Tris and Nodes ====//
-    float x, y, z;
-    int n0, n1, n2;
-    float col;
-    int num_tris, num_nodes;
-
-    fscanf( file_id, "%d", &num_nodes );
-    fscanf( file_id, "%d", &num_tris  );
-
-    vec3d p;
-    vector< vec3d > pVec;
-    for ( i = 0 ; i < num_nodes ; i++ )
+    int num_nodes = data.m_Pnts.size() / 3;
+    vector< vec3d > pVec( num_nodes );
+    for ( int i = 0 ; i < num_nodes ; i++ )
     {
-        fscanf( file_id, "%f %f %f", &x, &y, &z );
-        p.set_xyz( x, -z, y );
-        pVec.push_back( p );
+        pVec[i].set_xyz( data.m_Pnts[ 3 * i ], -data.m_Pnts[ 3 * i + 2 ], data.m_Pnts[ 3 * i + 1 ] );
     }
 
-    for ( i = 0 ; i < num_tris ; i++ )
+    int num_tris = data.NumTris();
+    for ( int i = 0 ; i < num_tris ; i++ )
     {
-        fscanf( file_id, "%d %d %d %f", &n0, &n2, &n1, &col );
+        int n0 = data.m_Tris[ 3 * i ];
+        int n2 = data.m_Tris[ 3 * i + 1 ];
+        int n1 = data.m_Tris[ 3 * i + 2 ];
 
         //==== Compute Normal ====//
         vec3d p10 = pVec[n1 - 1] - pVec[n0 - 1];
@@ -542,14 +418,6 @@ int MeshGeom::ReadNascart( const char* file_name )
         tMesh->AddTri( pVec[n0 - 1], pVec[n1 - 1], pVec[n2 - 1], norm );
     }
 
-    fclose( file_id );
-
-    if ( tMesh->m_TVec.size() == 0 )
-    {
-        delete tMesh;
-        return 0;
-    }
-
     m_TMeshVec.push_back( tMesh );
 
     UpdateBBox();
@@ -562,37 +430,27 @@ int MeshGeom::ReadNascart( const char* file_name )
 //==== Read Tri File ====//
 int MeshGeom::ReadTriFile( const char * file_name )
 {
-    int i;
-    FILE* file_id = fopen( file_name, "r" );
-
-    if ( !file_id )
+    MeshFileData data;
+    if ( !MeshFileReader::ReadTriFile( file_name, 3, data ) )
     {
         return 0;
     }
 
     TMesh*  tMesh = new TMesh();
 
-    //==== Read Number Tris and Nodes ====//
-    float x, y, z;
-    int n0, n1, n2;
-    unsigned int num_tris, num_nodes;
-
-    fscanf( file_id, "%u", &num_nodes );
-    fscanf( file_id, "%u", &num_tris  );
-
-    vec3d p;
-    vector< vec3d > pVec;
-    pVec.resize( num_nodes );
-    for ( i = 0 ; i < num_nodes ; i++ )
+    int num_nodes = data.m_Pnts.size() / 3;
+    vector< vec3d > pVec( num_nodes );
+    for ( int i = 0 ; i < num_nodes ; i++ )
     {
-        fscanf( file_id, "%f %f %f", &x, &y, &z );
-        p.set_xyz( x, y, z );
-        pVec[i] = p;
+        pVec[i].set_xyz( data.m_Pnts[ 3 * i ], data.m_Pnts[ 3 * i + 1 ], data.m_Pnts[ 3 * i + 2 ] );
     }
 
-    for ( i = 0 ; i < num_tris ; i++ )
+    int num_tris = data.NumTris();
+    for ( int i = 0 ; i < num_tris ; i++ )
     {
-        fscanf( file_id, "%d %d %d", &n0, &n1, &n2 );
+        int n0 = data.m_Tris[ 3 * i ];
+        int n1 = data.m_Tris[ 3 * i + 1 ];
+        int n2 = data.m_Tris[ 3 * i + 2 ];
 
         //==== Compute Normal ====//
         vec3d p10 = pVec[n1 - 1] - pVec[n0 - 1];
@@ -604,14 +462,6 @@ int MeshGeom::ReadTriFile( const char * file_name )
         tMesh->AddTri( pVec[n0 - 1], pVec[n1 - 1], pVec[n2 - 1], norm );
     }
 
-    fclose( file_id );
-
-    if ( tMesh->m_TVec.size() == 0 )
-    {
-        delete tMesh;
-        return 0;
-    }
-
     m_TMeshVec.push_back( tMesh );
 
     UpdateBBox();
@@ -636,7 +486,7 @@ void MeshGeom::InitIndexedMesh( const vector < TMesh* > &meshvec, int & offset )
                     {
                         char str[80];
                         sprintf( str, "%d", offset );
-                        tri->m_SplitVec[s]->m_ID = string( str );
+                        tri->m_SplitVec[s]->SetID( string( str ) );
                         m_IndexedTriVec.push_back( tri->m_SplitVec[s] );
                     }
                 }
@@ -645,7 +495,7 @@ void MeshGeom::InitIndexedMesh( const vector < TMesh* > &meshvec, int & offset )
             {
                 char str[80];
                 sprintf( str, "%d", offset );
-                tri->m_ID = string( str );
+                tri->SetID( string( str ) );
                 m_IndexedTriVec.push_back( tri );
             }
         }
@@ -702,8 +552,8 @@ void MeshGeom::BuildIndexedMesh( int partOffset )
     BndBox bb = m_Vehicle->GetBndBox();
     double tol = bb.GetLargestDist() * 1.0e-10;
 
-    //==== Use NanoFlann to Find Close Points and Group ====//
-    IndexPntNodes( pnCloud, tol );
+    //==== Use Hash Grid to Find Close Points and Group ====//
+    WeldPntNodes( pnCloud, tol );
 
     //==== Load Used Nodes ====//
     m_IndexedNodeVec.reserve( pnCloud.m_NumUsedPts );
@@ -745,115 +595,207 @@ void MeshGeom::BuildIndexedMesh( int partOffset )
     Update();
 }
 
-void MeshGeom::WriteNascartPnts( FILE* fp )
+//==== Indexed Node Export Formats ====//
+enum
 {
-    vec3d v;
-    Matrix4d XFormMat = GetTotalTransMat();
-    //==== Write Out Nodes ====//
-    for ( int i = 0 ; i < ( int )m_IndexedNodeVec.size() ; i++ )
+    PNT_FORMAT_XYZ,
+    PNT_FORMAT_NASCART,
+    PNT_FORMAT_OBJ,
+    PNT_FORMAT_GMSH,
+};
+
+class IndexedPntFormatter : public ExportFormatter
+{
+public:
+    IndexedPntFormatter( const vector< TNode* > & node_vec, const Matrix4d & mat, int format, int offset = 0 ) :
+        m_NodeVec( node_vec ), m_Mat( mat ), m_Format( format ), m_Offset( offset )
+    {
+    }
+
+    virtual int NumItems() const
+    {
+        return m_NodeVec.size();
+    }
+
+    virtual void Format( int i, ExportBuffer & buf ) const
     {
-        TNode* tnode = m_IndexedNodeVec[i];
+        TNode* tnode = m_NodeVec[i];
+        if ( !tnode )
+        {
+            return;
+        }
+
         // Apply Transformations
-        if( tnode )
+        vec3d v = m_Mat.xform( tnode->m_Pnt );
+
+        switch ( m_Format )
         {
-            v = XFormMat.xform( tnode->m_Pnt );
-            fprintf( fp, "%16.10g %16.10g %16.10g\n", v.x(), v.z(), -v.y() );
+        case PNT_FORMAT_XYZ:
+            buf.Printf( "%16.10g %16.10g %16.10g\n", v.x(), v.y(), v.z() );
+            break;
+        case PNT_FORMAT_NASCART:
+            buf.Printf( "%16.10g %16.10g %16.10g\n", v.x(), v.z(), -v.y() );
+            break;
+        case PNT_FORMAT_OBJ:
+            buf.Printf( "v %16.10g %16.10g %16.10g\n", v.x(), v.y(),  v.z() );
+            break;
+        case PNT_FORMAT_GMSH:
+            buf.Printf( "%d %16.10f %16.10f %16.10f\n", i + m_Offset + 1, v.x(), v.y(), v.z() );
+            break;
         }
     }
-}
 
-void MeshGeom::WriteCart3DPnts( FILE* fp )
+protected:
+    const vector< TNode* > & m_NodeVec;
+    Matrix4d m_Mat;
+    int m_Format;
+    int m_Offset;
+};
+
+//==== Indexed Tri Export Formats ====//
+enum
 {
-    //==== Write Out Nodes ====//
-    vec3d v;
-    Matrix4d XFormMat = GetTotalTransMat();
-    for ( int i = 0 ; i < ( int )m_IndexedNodeVec.size() ; i++ )
+    TRI_FORMAT_CART3D,
+    TRI_FORMAT_NASCART,
+    TRI_FORMAT_OBJ,
+    TRI_FORMAT_VSPGEOM,
+    TRI_FORMAT_GMSH,
+    TRI_FORMAT_CART3D_PARTS,
+    TRI_FORMAT_VSPGEOM_PARTS,
+};
+
+class IndexedTriFormatter : public ExportFormatter
+{
+public:
+    IndexedTriFormatter( const vector< TTri* > & tri_vec, int format, int offset = 0, int tri_offset = 0 ) :
+        m_TriVec( tri_vec ), m_Format( format ), m_Offset( offset ), m_TriOffset( tri_offset )
     {
-        TNode* tnode = m_IndexedNodeVec[i];
-        // Apply Transformations
-        if( tnode )
+    }
+
+    virtual int NumItems() const
+    {
+        return m_TriVec.size();
+    }
+
+    virtual void Format( int t, ExportBuffer & buf ) const
+    {
+        TTri* ttri = m_TriVec[t];
+        if ( !ttri )
         {
-            v = XFormMat.xform( tnode->m_Pnt );
-            fprintf( fp, "%16.10g %16.10g %16.10g\n", v.x(), v.y(),  v.z() );
+            return;
         }
+
+        int n0 = ttri->m_N0->m_ID + 1 + m_Offset;
+        int n1 = ttri->m_N1->m_ID + 1 + m_Offset;
+        int n2 = ttri->m_N2->m_ID + 1 + m_Offset;
+
+        switch ( m_Format )
+        {
+        case TRI_FORMAT_CART3D:
+            buf.Printf( "%d %d %d\n", n0, n1, n2 );
+            break;
+        case TRI_FORMAT_NASCART:
+            buf.Printf( "%d %d %d %d.0\n", n0, n2, n1, SubSurfaceMgr.GetTag( ttri->GetTags() ) );
+            break;
+        case TRI_FORMAT_OBJ:
+            buf.Printf( "f %d %d %d\n", n0, n1, n2 );
+            break;
+        case TRI_FORMAT_VSPGEOM:
+            buf.Printf( "3 %d %d %d\n", n0, n1, n2 );
+            break;
+        case TRI_FORMAT_GMSH:
+            buf.Printf( "%d 2 0 %d %d %d\n", t + m_TriOffset + 1, n0, n2, n1 );
+            break;
+        case TRI_FORMAT_CART3D_PARTS:
+            buf.Printf( "%d \n", SubSurfaceMgr.GetTag( ttri->GetTags() ) );
+            break;
+        case TRI_FORMAT_VSPGEOM_PARTS:
+            buf.Printf( "%d %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g\n", SubSurfaceMgr.GetTag( ttri->GetTags() ),
+                        ttri->m_N0->m_UWPnt.x(), ttri->m_N0->m_UWPnt.y(),
+                        ttri->m_N1->m_UWPnt.x(), ttri->m_N1->m_UWPnt.y(),
+                        ttri->m_N2->m_UWPnt.x(), ttri->m_N2->m_UWPnt.y() );
+            break;
+        }
+    }
+
+protected:
+    const vector< TTri* > & m_TriVec;
+    int m_Format;
+    int m_Offset;
+    int m_TriOffset;
+};
+
+//==== Facets Of One Facet File Part ====//
+class FacetTriFormatter : public ExportFormatter
+{
+public:
+    FacetTriFormatter( const vector< TTri* > & tri_vec, int offset, int material_id, int part_id, int first_tri ) :
+        m_TriVec( tri_vec ), m_Offset( offset ), m_MaterialID( material_id ), m_PartID( part_id ), m_FirstTri( first_tri )
+    {
     }
+
+    virtual int NumItems() const
+    {
+        return m_TriVec.size();
+    }
+
+    virtual void Format( int t, ExportBuffer & buf ) const
+    {
+        TTri* ttri = m_TriVec[t];
+
+        // 3 nodes of facet, material ID, component ID, running facet #:
+        buf.Printf( "%d %d %d %d %u %d\n", ttri->m_N0->m_ID + 1 + m_Offset, ttri->m_N1->m_ID + 1 + m_Offset, ttri->m_N2->m_ID + 1 + m_Offset,
+                    m_MaterialID, m_PartID, m_FirstTri + t );
+    }
+
+protected:
+    const vector< TTri* > & m_TriVec;
+    int m_Offset;
+    int m_MaterialID;
+    unsigned int m_PartID;
+    int m_FirstTri;
+};
+
+void MeshGeom::WriteNascartPnts( FILE* fp )
+{
+    //==== Write Out Nodes ====//
+    ExportWriter::Write( fp, IndexedPntFormatter( m_IndexedNodeVec, GetTotalTransMat(), PNT_FORMAT_NASCART ) );
+}
+
+void MeshGeom::WriteCart3DPnts( FILE* fp )
+{
+    //==== Write Out Nodes ====//
+    ExportWriter::Write( fp, IndexedPntFormatter( m_IndexedNodeVec, GetTotalTransMat(), PNT_FORMAT_XYZ ) );
 }
 
 void MeshGeom::WriteOBJPnts( FILE* fp )
 {
     //==== Write Out Nodes ====//
-    vec3d v;
-    Matrix4d XFormMat = GetTotalTransMat();
-    for ( int i = 0 ; i < ( int )m_IndexedNodeVec.size() ; i++ )
-    {
-        TNode* tnode = m_IndexedNodeVec[i];
-        // Apply Transformations
-        if( tnode )
-        {
-            v = XFormMat.xform( tnode->m_Pnt );
-            fprintf( fp, "v %16.10g %16.10g %16.10g\n", v.x(), v.y(),  v.z() );
-        }
-    }
+    ExportWriter::Write( fp, IndexedPntFormatter( m_IndexedNodeVec, GetTotalTransMat(), PNT_FORMAT_OBJ ) );
 }
 
 void MeshGeom::WriteVSPGeomPnts( FILE* file_id )
 {
     //==== Write Out Nodes ====//
-    vec3d v;
-    Matrix4d XFormMat = GetTotalTransMat();
-    for ( int i = 0 ; i < ( int )m_IndexedNodeVec.size() ; i++ )
-    {
-        TNode* tnode = m_IndexedNodeVec[i];
-        // Apply Transformations
-        v = XFormMat.xform( tnode->m_Pnt );
-        fprintf( file_id, "%16.10g %16.10g %16.10g\n", v.x(), v.y(), v.z() ); // , tnode->m_UWPnt.x(), tnode->m_UWPnt.y() );
-    }
+    ExportWriter::Write( file_id, IndexedPntFormatter( m_IndexedNodeVec, GetTotalTransMat(), PNT_FORMAT_XYZ ) );
 }
 
 int MeshGeom::WriteGMshNodes( FILE* fp, int node_offset )
 {
-    vec3d v;
-    Matrix4d XFormMat = GetTotalTransMat();
-    for ( int i = 0 ; i < ( int )m_IndexedNodeVec.size() ; i++ )
-    {
-        TNode* tnode = m_IndexedNodeVec[i];
-        // Apply Transformations
-        if( tnode )
-        {
-            v = XFormMat.xform( tnode->m_Pnt );
-            fprintf( fp, "%d %16.10f %16.10f %16.10f\n", i + node_offset + 1,
-                     v.x(), v.y(), v.z() );
-        }
-    }
+    ExportWriter::Write( fp, IndexedPntFormatter( m_IndexedNodeVec, GetTotalTransMat(), PNT_FORMAT_GMSH, node_offset ) );
     return node_offset + ( int )m_IndexedNodeVec.size();
 }
 
 void MeshGeom::WriteFacetNodes( FILE* fp )
 {
     //==== Write Out Nodes ====//
-    vec3d v;
-    Matrix4d XFormMat = GetTotalTransMat();
-    for ( int i = 0; i < (int)m_IndexedNodeVec.size(); i++ )
-    {
-        TNode* tnode = m_IndexedNodeVec[i];
-        // Apply Transformations
-        v = XFormMat.xform( tnode->m_Pnt );
-        fprintf( fp, "%16.10g %16.10g %16.10g\n", v.x(), v.y(), v.z() );
-    }
+    ExportWriter::Write( fp, IndexedPntFormatter( m_IndexedNodeVec, GetTotalTransMat(), PNT_FORMAT_XYZ ) );
 }
 
 int MeshGeom::WriteNascartTris( FILE* fp, int off )
 {
     //==== Write Out Tris ====//
-    for ( int t = 0 ; t < ( int )m_IndexedTriVec.size() ; t++ )
-    {
-        TTri* ttri = m_IndexedTriVec[t];
-        if( ttri )
-        {
-            fprintf( fp, "%d %d %d %d.0\n", ttri->m_N0->m_ID + 1 + off,  ttri->m_N2->m_ID + 1 + off,
-                     ttri->m_N1->m_ID + 1 + off, SubSurfaceMgr.GetTag( ttri->m_Tags ) );
-        }
-    }
+    ExportWriter::Write( fp, IndexedTriFormatter( m_IndexedTriVec, TRI_FORMAT_NASCART, off ) );
 
     return ( off + m_IndexedNodeVec.size() );
 }
@@ -861,14 +803,7 @@ int MeshGeom::WriteNascartTris( FILE* fp, int off )
 int MeshGeom::WriteCart3DTris( FILE* fp, int off )
 {
     //==== Write Out Tris ====//
-    for ( int t = 0 ; t < ( int )m_IndexedTriVec.size() ; t++ )
-    {
-        TTri* ttri = m_IndexedTriVec[t];
-        if( ttri )
-        {
-            fprintf( fp, "%d %d %d\n", ttri->m_N0->m_ID + 1 + off,  ttri->m_N1->m_ID + 1 + off, ttri->m_N2->m_ID + 1 + off );
-        }
-    }
+    ExportWriter::Write( fp, IndexedTriFormatter( m_IndexedTriVec, TRI_FORMAT_CART3D, off ) );
 
     return ( off + m_IndexedNodeVec.size() );
 }
@@ -876,14 +811,7 @@ int MeshGeom::WriteCart3DTris( FILE* fp, int off )
 int MeshGeom::WriteOBJTris( FILE* fp, int off )
 {
     //==== Write Out Tris ====//
-    for ( int t = 0 ; t < ( int )m_IndexedTriVec.size() ; t++ )
-    {
-        TTri* ttri = m_IndexedTriVec[t];
-        if( ttri )
-        {
-            fprintf( fp, "f %d %d %d\n", ttri->m_N0->m_ID + 1 + off,  ttri->m_N1->m_ID + 1 + off, ttri->m_N2->m_ID + 1 + off );
-        }
-    }
+    ExportWriter::Write( fp, IndexedTriFormatter( m_IndexedTriVec, TRI_FORMAT_OBJ, off ) );
 
     return ( off + m_IndexedNodeVec.size() );
 }
@@ -891,11 +819,7 @@ int MeshGeom::WriteOBJTris( FILE* fp, int off )
 int MeshGeom::WriteVSPGeomTris( FILE* file_id, int offset )
 {
     //==== Write Out Tris ====//
-    for ( int t = 0 ; t < ( int )m_IndexedTriVec.size() ; t++ )
-    {
-        TTri* ttri = m_IndexedTriVec[t];
-        fprintf(file_id, "3 %d %d %d\n", ttri->m_N0->m_ID + 1 + offset, ttri->m_N1->m_ID + 1 + offset, ttri->m_N2->m_ID + 1 + offset );
-    }
+    ExportWriter::Write( file_id, IndexedTriFormatter( m_IndexedTriVec, TRI_FORMAT_VSPGEOM, offset ) );
 
     return ( offset + m_IndexedNodeVec.size() );
 }
@@ -903,94 +827,54 @@ int MeshGeom::WriteVSPGeomTris( FILE* file_id, int offset )
 int MeshGeom::WriteGMshTris( FILE* fp, int node_offset, int tri_offset )
 {
     //==== Write Out Tris ====//
-    for ( int t = 0 ; t < ( int )m_IndexedTriVec.size() ; t++ )
-    {
-        TTri* ttri = m_IndexedTriVec[t];
-        if( ttri )
-        {
-            fprintf( fp, "%d 2 0 %d %d %d\n", t + tri_offset + 1,
-                     ttri->m_N0->m_ID + 1 + node_offset,  ttri->m_N2->m_ID + 1 + node_offset, ttri->m_N1->m_ID + 1 + node_offset );
-        }
-    }
+    ExportWriter::Write( fp, IndexedTriFormatter( m_IndexedTriVec, TRI_FORMAT_GMSH, node_offset, tri_offset ) );
+
     return ( tri_offset + m_IndexedTriVec.size() );
 }
 
 void MeshGeom::WriteFacetTriParts( FILE* fp, int &offset, int &tri_count, int &part_count )
 {
-    vector < string > geom_ID_vec;
-    geom_ID_vec.resize( m_TMeshVec.size() );
-
-    for ( unsigned int i = 0; i < m_TMeshVec.size(); i++ )
-    {
-        geom_ID_vec[i] = m_TMeshVec[i]->m_PtrID;
-    }
-
-    vector < int > tri_offset; // vector of number of tris for each tag
-
     int materialID = 0; // Default Material ID of PEC (Referred to as "iCoat" in XPatch facet file documentation)
 
     vector < int > all_tag_vec = SubSurfaceMgr.GetAllTags(); // vector of tags, where each tag identifies a part or group of facets
 
-    //==== Get # of facets for each part ====//
-    for ( unsigned int i = 0; i < all_tag_vec.size(); i++ )
+    //==== Sort Tris By Part, Keeping Their Order Within Each Part ====//
+    map < int, vector < TTri* > > tag_tri_map;
+    for ( unsigned int j = 0; j < m_IndexedTriVec.size(); j++ )
     {
-        int tag_count = 0;
-
-        for ( unsigned int j = 0; j < m_IndexedTriVec.size(); j++ )
-        {
-            if ( all_tag_vec[i] == SubSurfaceMgr.GetTag( m_IndexedTriVec[j]->m_Tags ) )
-            {
-                tag_count++;
-            }
-        }
-
-        tri_offset.push_back( tag_count );
+        tag_tri_map[ SubSurfaceMgr.GetTag( m_IndexedTriVec[j]->GetTags() ) ].push_back( m_IndexedTriVec[j] );
     }
 
-    // Remove indexes of tri_offset that contain no tris
-    for ( unsigned int j = 0; j < tri_offset.size(); j++ )
+    // Remove tags that contain no tris to avoid writing and counting parts with no tris
+    vector < vector < TTri* > * > part_tri_vec;
+    for ( unsigned int i = 0; i < all_tag_vec.size(); i++ )
     {
-        if ( tri_offset[j] == 0 ) // This indicates no tris for the tag index. 
+        map < int, vector < TTri* > >::iterator it = tag_tri_map.find( all_tag_vec[i] );
+        if ( it != tag_tri_map.end() )
         {
-            // Erase to avoid writing and counting parts with no tris
-            tri_offset.erase( tri_offset.begin() + j );
-            all_tag_vec.erase( all_tag_vec.begin() + j );
-            j--;
+            part_tri_vec.push_back( &it->second );
         }
     }
 
-    fprintf( fp, "%ld \n", tri_offset.size() ); // # of "Small" parts, based on the total number of tags
+    int num_parts = part_tri_vec.size();
+    fprintf( fp, "%d \n", num_parts ); // # of "Small" parts, based on the total number of tags
 
     //==== Write Out Tris ====//
-    for ( unsigned int i = 0; i < all_tag_vec.size(); i++ )
+    for ( int i = 0; i < num_parts; i++ )
     {
-        int curr_tag = all_tag_vec[i];
-        bool new_section = true; // flag to write small part section header
+        const vector < TTri* > & tri_vec = *part_tri_vec[i];
 
-        for ( unsigned int j = 0; j < m_IndexedTriVec.size(); j++ )
-        {
-            if ( curr_tag == SubSurfaceMgr.GetTag( m_IndexedTriVec[j]->m_Tags ) ) // only write out current tris for surrent tag
-            {
-                if ( new_section ) // write small part header and get material ID for small part
-                {
-                    string name = SubSurfaceMgr.GetTagNames( m_IndexedTriVec[j]->m_Tags );
-                    fprintf( fp, "%s\n", name.c_str() ); // Write name of small part
-                    fprintf( fp, "%d 3\n", tri_offset[i] ); // Number of facets for the part, 3 nodes per facet
-
-                    new_section = false;
-                }
-
-                TTri* ttri = m_IndexedTriVec[j];
+        // Write small part header, named after its first tri
+        string name = SubSurfaceMgr.GetTagNames( tri_vec[0]->GetTags() );
+        fprintf( fp, "%s\n", name.c_str() ); // Write name of small part
+        fprintf( fp, "%d 3\n", ( int )tri_vec.size() ); // Number of facets for the part, 3 nodes per facet
 
-                tri_count++; // counter for number of tris/facets
+        ExportWriter::Write( fp, FacetTriFormatter( tri_vec, offset, materialID, i + 1 + part_count, tri_count + 1 ) );
 
-                // 3 nodes of facet, material ID, component ID, running facet #:
-                fprintf( fp, "%d %d %d %d %u %d\n", ttri->m_N0->m_ID + 1 + offset, ttri->m_N1->m_ID + 1 + offset, ttri->m_N2->m_ID + 1 + offset, materialID, i + 1 + part_count, tri_count );
-            }
-        }
+        tri_count += tri_vec.size(); // counter for number of tris/facets
     }
 
-    part_count += tri_offset.size();
+    part_count += num_parts;
     offset += m_IndexedNodeVec.size();
 }
 
@@ -1007,30 +891,14 @@ int MeshGeom::WriteNascartParts( FILE* fp, int off )
 int MeshGeom::WriteCart3DParts( FILE* fp  )
 {
     //==== Write Component IDs for each Tri =====//
-    int tag;
-    for ( int t = 0 ; t < ( int )m_IndexedTriVec.size() ; t++ )
-    {
-        tag = SubSurfaceMgr.GetTag( m_IndexedTriVec[t]->m_Tags );
-
-        fprintf( fp, "%d \n",  tag );
-    }
+    ExportWriter::Write( fp, IndexedTriFormatter( m_IndexedTriVec, TRI_FORMAT_CART3D_PARTS ) );
     return 0;
 }
 
 int MeshGeom::WriteVSPGeomParts( FILE* file_id  )
 {
     //==== Write Component IDs for each Tri =====//
-    int tag;
-    for ( int t = 0 ; t < ( int )m_IndexedTriVec.size() ; t++ )
-    {
-        TTri* ttri = m_IndexedTriVec[t];
-        tag = SubSurfaceMgr.GetTag( ttri->m_Tags );
-
-        fprintf( file_id, "%d %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g\n", tag,
-                 ttri->m_N0->m_UWPnt.x(), ttri->m_N0->m_UWPnt.y(),
-                 ttri->m_N1->m_UWPnt.x(), ttri->m_N1->m_UWPnt.y(),
-                 ttri->m_N2->m_UWPnt.x(), ttri->m_N2->m_UWPnt.y() );
-    }
+    ExportWriter::Write( file_id, IndexedTriFormatter( m_IndexedTriVec, TRI_FORMAT_VSPGEOM_PARTS ) );
     return 0;
 }
 
@@ -1422,7 +1290,7 @@ void MeshGeom::UpdateDrawObj()
                 vector<TTri*>& tris = m_TMeshVec[m]->m_TVec;
                 for ( int t = 0 ; t < ( int ) num_tris ; t++ )
                 {
-                    DrawObj* d_obj = tag_dobj_map[ SubSurfaceMgr.GetTag( tris[t]->m_Tags ) ];
+                    DrawObj* d_obj = tag_dobj_map[ SubSurfaceMgr.GetTag( tris[t]->GetTags() ) ];
                     d_obj->m_PntVec.push_back( trans.xform( tris[t]->m_N0->m_Pnt ) );
                     d_obj->m_PntVec.push_back( trans.xform( tris[t]->m_N1->m_Pnt ) );
                     d_obj->m_PntVec.push_back( trans.xform( tris[t]->m_N2->m_Pnt ) );
@@ -1821,6 +1689,109 @@ void MeshGeom::TransformMeshVec( vector<TMesh*> & meshVec, const Matrix4d & Tran
     }
 }
 
+//==== Intersect Every Pair Of Meshes, Split And Classify The Tris ====//
+// Pair segments are found in parallel and added in pair order, so the result
+// matches a serial run.  Splitting is parallel over tris within each mesh and
+// classification is parallel over meshes.  With a cache, unchanged meshes and
+// pairs reuse their trees and segments at the current scale.
+void MeshGeom::IntersectSplit( vector< TMesh* > & meshVec, bool regionFlag, CompGeomCache* cache )
+{
+    int i, j;
+
+    //==== Mesh Pairs To Intersect, In Serial Loop Order ====//
+    vector< pair< int, int > > pairVec;
+    for ( i = 0 ; i < ( int )meshVec.size() ; i++ )
+    {
+        for ( j = i + 1 ; j < ( int )meshVec.size() ; j++ )
+        {
+            pairVec.push_back( pair< int, int >( i, j ) );
+        }
+    }
+
+    //==== Pairs Of Unchanged Meshes Reuse Their Cached Segments ====//
+    vector< const CompGeomPairEntry* > pairHitVec( pairVec.size(), NULL );
+    if ( cache )
+    {
+        for ( int p = 0 ; p < ( int )pairVec.size() ; p++ )
+        {
+            pairHitVec[p] = cache->FindPair( meshVec[ pairVec[p].first ]->m_CacheID,
+                                             meshVec[ pairVec[p].second ]->m_CacheID, m_Scale() );
+        }
+    }
+
+    //==== Create Bnd Box for  Mesh Geoms ====//
+    for ( i = 0 ; i < ( int )meshVec.size() ; i++ )
+    {
+        const TBvh* bvh = NULL;
+        if ( cache )
+        {
+            bvh = cache->FindBvh( meshVec[i]->m_CacheID, m_Scale() );
+        }
+        meshVec[i]->LoadBndBox( bvh );
+        if ( cache && !bvh )
+        {
+            cache->StoreBvh( meshVec[i]->m_CacheID, m_Scale(), meshVec[i]->m_Bvh );
+        }
+    }
+
+    //==== Intersect All Mesh Geoms Into Per Pair Buffers ====//
+    vector< vector< TISectSeg > > segBufVec( pairVec.size() );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( int p = 0 ; p < ( int )pairVec.size() ; p++ )
+    {
+        if ( !pairHitVec[p] )
+        {
+            meshVec[ pairVec[p].first ]->FindISectSegs( meshVec[ pairVec[p].second ], segBufVec[p] );
+        }
+    }
+
+    //==== Create Edges In Pair Order, Same As A Serial Run ====//
+    for ( int p = 0 ; p < ( int )pairVec.size() ; p++ )
+    {
+        if ( pairHitVec[p] )
+        {
+            meshVec[ pairVec[p].first ]->AddISectSegs( meshVec[ pairVec[p].second ], pairHitVec[p]->m_SegVec );
+            continue;
+        }
+
+        meshVec[ pairVec[p].first ]->AddISectSegs( meshVec[ pairVec[p].second ], segBufVec[p] );
+
+        if ( cache )
+        {
+            CompGeomPairEntry pair_entry;
+            pair_entry.m_Scale = m_Scale();
+            pair_entry.m_SegVec = segBufVec[p];
+            cache->StorePair( meshVec[ pairVec[p].first ]->m_CacheID, meshVec[ pairVec[p].second ]->m_CacheID, pair_entry );
+        }
+    }
+    segBufVec.clear();
+
+    //==== Split Intersected Tri in Mesh - Parallel Over Tris Within Split ====//
+    for ( i = 0 ; i < ( int )meshVec.size() ; i++ )
+    {
+        meshVec[i]->Split();
+    }
+
+    //==== Determine Which Triangle Are Interior/Exterior ====//
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( i = 0 ; i < ( int )meshVec.size() ; i++ )
+    {
+        if ( regionFlag )
+        {
+            meshVec[i]->DeterIntExtRegions( meshVec );
+        }
+        else
+        {
+            meshVec[i]->DeterIntExt( meshVec );
+        }
+    }
+}
+
 void MeshGeom::IntersectTrim( vector< DegenGeom > &degenGeom, bool degen, int intSubsFlag )
 {
     int i, j;
@@ -1939,40 +1910,12 @@ void MeshGeom::IntersectTrim( vector< DegenGeom > &degenGeom, bool degen, int in
         MergeRemoveOpenMeshes( &info, deleteopen );
     }
 
-    //==== Create Bnd Box for  Mesh Geoms ====//
-    for ( i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
-    {
-        m_TMeshVec[i]->LoadBndBox();
-    }
-
-    //==== Update Bnd Box for  Combined ====//
-    BndBox b;
-    for ( i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
-    {
-        b.Update( m_TMeshVec[i]->m_TBox.m_Box );
-    }
-    m_BBox = b;
-    //update_xformed_bbox();          // Load Xform BBox
-
-    //==== Intersect All Mesh Geoms ====//
-    for ( i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
-    {
-        for ( j = i + 1 ; j < ( int )m_TMeshVec.size() ; j++ )
-        {
-            m_TMeshVec[i]->Intersect( m_TMeshVec[j] );
-        }
-    }
-
-    //==== Split Intersected Tri in Mesh ====//
-    for ( i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
-    {
-        m_TMeshVec[i]->Split();
-    }
+    bool regionFlag = m_Vehicle && m_Vehicle->m_IntExtMode() == vsp::INT_EXT_REGION;
 
-    //==== Determine Which Triangle Are Interior/Exterior ====//
-    for ( i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
+    CompGeomCache* cache = NULL;
+    if ( m_Vehicle && m_Vehicle->m_CompGeomCacheFlag() )
     {
-        m_TMeshVec[i]->DeterIntExt( m_TMeshVec );
+        cache = m_Vehicle->GetCompGeomCachePtr();
     }
 
     // Fill vector of cfdtypes so we don't have to pass TMeshVec all the way down.
@@ -1984,6 +1927,17 @@ void MeshGeom::IntersectTrim( vector< DegenGeom > &degenGeom, bool degen, int in
         thicksurf[i] = m_TMeshVec[i]->m_ThickSurf;
     }
 
+    IntersectSplit( m_TMeshVec, regionFlag, cache );
+
+    //==== Update Bnd Box for  Combined ====//
+    BndBox b;
+    for ( i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
+    {
+        b.Update( m_TMeshVec[i]->m_TBox.m_Box );
+    }
+    m_BBox = b;
+    //update_xformed_bbox();          // Load Xform BBox
+
     //==== Mark which triangles to ignore ====//
     for ( i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
     {
@@ -1997,6 +1951,8 @@ void MeshGeom::IntersectTrim( vector< DegenGeom > &degenGeom, bool degen, int in
 
     //==== Compute Areas ====//
     m_TotalTheoArea = m_TotalWetArea = 0.0;
+    m_TotalTheoVol = 0;
+    m_TotalWetVol = 0.0;
     for ( i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
     {
         m_TotalTheoArea += m_TMeshVec[i]->ComputeTheoArea();
@@ -2004,14 +1960,12 @@ void MeshGeom::IntersectTrim( vector< DegenGeom > &degenGeom, bool degen, int in
     }
 
     //==== Compute Theo Vols ====//
-    m_TotalTheoVol = 0;
     for ( i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
     {
         m_TotalTheoVol += m_TMeshVec[i]->ComputeTheoVol();
     }
 
     //==== Compute Total Volume ====//
-    m_TotalWetVol = 0.0;
     for ( i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
     {
         m_TotalWetVol += m_TMeshVec[i]->ComputeTrimVol();
@@ -2185,6 +2139,14 @@ void MeshGeom::IntersectTrim( vector< DegenGeom > &degenGeom, bool degen, int in
         res->Add( NameValData( "Meshes_Removed_Names", info.m_DeletedMeshes ) );
         res->Add( NameValData( "Meshes_Merged_Names", info.m_MergedMeshes ) );
 
+        if ( cache )
+        {
+            res->Add( NameValData( "Cache_Mesh_Hits", cache->m_MeshHits ) );
+            res->Add( NameValData( "Cache_Mesh_Misses", cache->m_MeshMisses ) );
+            res->Add( NameValData( "Cache_Pair_Hits", cache->m_PairHits ) );
+            res->Add( NameValData( "Cache_Pair_Misses", cache->m_PairMisses ) );
+        }
+
         string txtfn = m_Vehicle->getExportFileName( vsp::COMP_GEOM_TXT_TYPE );
         res->WriteCompGeomTxtFile( txtfn );
 
@@ -2200,7 +2162,7 @@ void MeshGeom::IntersectTrim( vector< DegenGeom > &degenGeom, bool degen, int in
 
 //==== Call After BndBoxes Have Been Create But Before Intersect ====//
 void MeshGeom::AreaSlice( int numSlices , vec3d norm_axis,
-                          bool autoBounds, double start, double end )
+                          bool autoBounds, double start, double end, int engine )
 {
     int tesselate = 0; // WARNING: Always false
     int i, j, s;
@@ -2342,18 +2304,26 @@ void MeshGeom::AreaSlice( int numSlices , vec3d norm_axis,
         dxSlice = ( xMax - xMin ) / ( double )( numSlices - 1 );
     }
 
+    //==== Sweep Engine Cuts Trimmed Copies Of The Meshes, No Slice Meshes ====//
+    bool sweepFlag = engine == vsp::PLANAR_SLICE_SWEEP;
+
     vector< double > loc_vec;
     for ( s = 0 ; s < numSlices ; s++ )
     {
+        double x = xMin + ( double )s * dxSlice;
+        loc_vec.push_back( x );
+
+        if ( sweepFlag )
+        {
+            continue;
+        }
+
         TMesh* tm = new TMesh();
         m_SliceVec.push_back( tm );
 
         tm->m_ThickSurf = false;
         tm->m_SurfCfdType = vsp::CFD_STRUCTURE;
 
-        double x = xMin + ( double )s * dxSlice;
-        loc_vec.push_back( x );
-
         double ydel = 1.02 * ( m_BBox.GetMax( 1 ) - m_BBox.GetMin( 1 ) );
         double ys   = m_BBox.GetMin( 1 ) - 0.01 * ydel;
         double zdel = 1.02 * ( m_BBox.GetMax( 2 ) - m_BBox.GetMin( 2 ) );
@@ -2421,14 +2391,43 @@ void MeshGeom::AreaSlice( int numSlices , vec3d norm_axis,
 
     vector< double > area_vec;
     vector < vec3d > AreaCenter;
-    for ( s = 0 ; s < ( int )m_SliceVec.size() ; s++ )
+    if ( sweepFlag )
     {
-        m_SliceVec[s]->ComputeWetArea();
-        area_vec.push_back( m_SliceVec[s]->m_WetArea );
-        AreaCenter.push_back( TransMat.xform( m_SliceVec[s]->m_AreaCenter ) );
+        //==== Trim Copies Against Each Other Once For All Stations, As CompGeom Does ====//
+        vector< TMesh* > trimVec( m_TMeshVec.size() );
+        for ( i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
+        {
+            trimVec[i] = new TMesh();
+            trimVec[i]->CopyFlatten( m_TMeshVec[i] );
+        }
+
+        bool regionFlag = m_Vehicle && m_Vehicle->m_IntExtMode() == vsp::INT_EXT_REGION;
+        IntersectSplit( trimVec, regionFlag, NULL );
+
+        vector < vec3d > sliceCenter;
+        SweepSliceAreas( trimVec, loc_vec, bTypes, thicksurf, area_vec, sliceCenter );
+
+        for ( s = 0 ; s < ( int )sliceCenter.size() ; s++ )
+        {
+            AreaCenter.push_back( TransMat.xform( sliceCenter[s] ) );
+        }
+
+        for ( i = 0 ; i < ( int )trimVec.size() ; i++ )
+        {
+            delete trimVec[i];
+        }
+    }
+    else
+    {
+        for ( s = 0 ; s < ( int )m_SliceVec.size() ; s++ )
+        {
+            m_SliceVec[s]->ComputeWetArea();
+            area_vec.push_back( m_SliceVec[s]->m_WetArea );
+            AreaCenter.push_back( TransMat.xform( m_SliceVec[s]->m_AreaCenter ) );
+        }
     }
     res->Add( NameValData( "Slice_Area_Center", AreaCenter ) );
-    res->Add( NameValData( "Num_Slices", ( int )m_SliceVec.size() ) );
+    res->Add( NameValData( "Num_Slices", ( int )loc_vec.size() ) );
     res->Add( NameValData( "Slice_Loc", loc_vec ) );
     res->Add( NameValData( "Slice_Area", area_vec ) );
 
@@ -2440,6 +2439,164 @@ void MeshGeom::AreaSlice( int numSlices , vec3d norm_axis,
     TransformMeshVec( m_TMeshVec, TransMat );
 }
 
+//==== Cut Areas Of All Stations In One Sweep Along X ====//
+// Meshes must already be trimmed against each other and classified.  A piece
+// of a thick mesh bounds the sliced area where being inside that mesh changes
+// whether a slice tri would be kept (DecideIgnoreTri).  Pieces are sorted by
+// their start along x and kept in an active list while they span the station.
+// The cut segments are oriented with the material on their left, so Green's
+// theorem gives area and centroid of each station without building polygons.
+// Stations must be in increasing order.
+void MeshGeom::SweepSliceAreas( const vector < TMesh* > & meshVec, const vector < double > & loc_vec,
+                                const vector < int > & bTypes, const vector < bool > & thicksurf,
+                                vector < double > & area_vec, vector < vec3d > & center_vec )
+{
+    int nmesh = meshVec.size();
+
+    //==== Collect Pieces That Bound The Sliced Region ====//
+    vector< TTri* > pieceVec;
+    vector< int > signVec;
+    vector< bool > outVec;
+    vector< bool > inVec;
+    for ( int m = 0 ; m < nmesh ; m++ )
+    {
+        TMesh* tm = meshVec[m];
+        if ( !tm->m_ThickSurf )
+        {
+            continue;
+        }
+
+        for ( int t = 0 ; t < ( int )tm->m_TVec.size() ; t++ )
+        {
+            TTri* tri = tm->m_TVec[t];
+
+            vector< TTri* > triVec;
+            if ( tri->m_SplitVec.size() )
+            {
+                triVec = tri->m_SplitVec;
+            }
+            else
+            {
+                triVec.push_back( tri );
+            }
+
+            for ( int p = 0 ; p < ( int )triVec.size() ; p++ )
+            {
+                tm->GetInsideVec( triVec[p]->m_InsideIndex, outVec );
+                outVec.resize( nmesh, false );
+                inVec = outVec;
+                inVec[m] = true;
+
+                bool keepIn = !tm->DecideIgnoreTri( vsp::CFD_STRUCTURE, bTypes, thicksurf, inVec );
+                bool keepOut = !tm->DecideIgnoreTri( vsp::CFD_STRUCTURE, bTypes, thicksurf, outVec );
+
+                if ( keepIn != keepOut )
+                {
+                    pieceVec.push_back( triVec[p] );
+                    signVec.push_back( keepIn ? 1 : -1 );
+                }
+            }
+        }
+    }
+
+    //==== Sort By Start Along X ====//
+    int npiece = pieceVec.size();
+    vector< pair< double, int > > startVec( npiece );
+    vector< double > endVec( npiece );
+    for ( int p = 0 ; p < npiece ; p++ )
+    {
+        TTri* tri = pieceVec[p];
+        double x0 = tri->m_N0->m_Pnt.x();
+        double x1 = tri->m_N1->m_Pnt.x();
+        double x2 = tri->m_N2->m_Pnt.x();
+        startVec[p] = pair< double, int >( min( x0, min( x1, x2 ) ), p );
+        endVec[p] = max( x0, max( x1, x2 ) );
+    }
+    sort( startVec.begin(), startVec.end() );
+
+    //==== Sweep Stations In Order ====//
+    area_vec.assign( loc_vec.size(), 0.0 );
+    center_vec.assign( loc_vec.size(), vec3d() );
+
+    vector< int > activeVec;
+    int next = 0;
+    for ( int s = 0 ; s < ( int )loc_vec.size() ; s++ )
+    {
+        double x = loc_vec[s];
+
+        while ( next < npiece && startVec[next].first <= x )
+        {
+            activeVec.push_back( startVec[next].second );
+            next++;
+        }
+
+        double area2 = 0.0;
+        double ymom = 0.0;
+        double zmom = 0.0;
+
+        int nactive = 0;
+        for ( int a = 0 ; a < ( int )activeVec.size() ; a++ )
+        {
+            int p = activeVec[a];
+            if ( endVec[p] < x )
+            {
+                continue;       // Done with this piece for all later stations
+            }
+            activeVec[ nactive ] = p;
+            nactive++;
+
+            TTri* tri = pieceVec[p];
+            vec3d pnt[3] = { tri->m_N0->m_Pnt, tri->m_N1->m_Pnt, tri->m_N2->m_Pnt };
+
+            // Nodes on the plane count as ahead of it, so neighbors agree on the cut.
+            vec3d cut[2];
+            int ncut = 0;
+            for ( int e = 0 ; e < 3 ; e++ )
+            {
+                const vec3d & p0 = pnt[e];
+                const vec3d & p1 = pnt[ ( e + 1 ) % 3 ];
+                if ( ( p0.x() >= x ) != ( p1.x() >= x ) && ncut < 2 )
+                {
+                    double u = ( x - p0.x() ) / ( p1.x() - p0.x() );
+                    cut[ ncut ] = p0 + ( p1 - p0 ) * u;
+                    ncut++;
+                }
+            }
+
+            if ( ncut != 2 )
+            {
+                continue;
+            }
+
+            //==== Material Left Of Segment, Looking Down -X ====//
+            vec3d norm = cross( pnt[1] - pnt[0], pnt[2] - pnt[0] );
+            vec3d dir = cross( vec3d( 1, 0, 0 ), norm );
+            if ( dot( cut[1] - cut[0], dir ) < 0.0 )
+            {
+                vec3d tmp = cut[0];
+                cut[0] = cut[1];
+                cut[1] = tmp;
+            }
+
+            double c = signVec[p] * ( cut[0].y() * cut[1].z() - cut[1].y() * cut[0].z() );
+            area2 += c;
+            ymom += c * ( cut[0].y() + cut[1].y() );
+            zmom += c * ( cut[0].z() + cut[1].z() );
+        }
+        activeVec.resize( nactive );
+
+        area_vec[s] = 0.5 * area2;
+        if ( area2 != 0.0 )
+        {
+            center_vec[s] = vec3d( x, ymom / ( 3.0 * area2 ), zmom / ( 3.0 * area2 ) );
+        }
+        else
+        {
+            center_vec[s] = vec3d( x, 0.0, 0.0 );
+        }
+    }
+}
+
 void MeshGeom::WaveStartEnd( const double &sliceAngle, const vec3d &center )
 {
     int ntheta = WaveDragMgr.m_NTheta;
@@ -2697,9 +2854,9 @@ void MeshGeom::WaveDragSlice( int numSlices, double sliceAngle, int coneSections
     {
         for ( int j = 0; j < m_TMeshVec[i]->m_TVec.size(); j++ )
         {
-            for ( int k = 0; k < m_TMeshVec[i]->m_TVec[j]->m_Tags.size(); k++ )
+            for ( int k = 0; k < m_TMeshVec[i]->m_TVec[j]->GetTags().size(); k++ )
             {
-                int tag_num = m_TMeshVec[i]->m_TVec[j]->m_Tags[k];
+                int tag_num = m_TMeshVec[i]->m_TVec[j]->GetTags()[k];
                 bool fwd_test = vector_contains_val( fwd_ss_tags, tag_num );
                 bool bwd_test = vector_contains_val( bwd_ss_tags, tag_num );
                 if ( fwd_test )
@@ -2895,8 +3052,17 @@ void MeshGeom::WaveDragSlice( int numSlices, double sliceAngle, int coneSections
         thicksurf[i] = m_TMeshVec[i]->m_ThickSurf;
     }
 
-    //==== Load Bnding Box ====//
-    for ( int islice = 0 ; islice < ( int )m_SliceVec.size() ; islice++ )
+    //==== Slice Every Rotation Against The Same Trimmed Mesh ====//
+    // The trimmed meshes and their trees are only read from here on, edges
+    // are added to the slice tris alone.  Each slice is independent and the
+    // results are gathered by slice index below.  The Triangle contexts
+    // created by Split do not share state (TTri::TriangulateSplit), so each
+    // slice is split as in a serial run.
+    int nslice = ( int )m_SliceVec.size();
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( int islice = 0 ; islice < nslice ; islice++ )
     {
         TMesh* tm = m_SliceVec[islice];
         tm->LoadBndBox();
@@ -2904,9 +3070,9 @@ void MeshGeom::WaveDragSlice( int numSlices, double sliceAngle, int coneSections
         //==== Intersect All Mesh Geoms ====//
         for ( int i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
         {
-            tm->Intersect( m_TMeshVec[i] );
-
-            m_TMeshVec[i]->RemoveIsectEdges();
+            vector< TISectSeg > segVec;
+            tm->FindISectSegs( m_TMeshVec[i], segVec );
+            tm->AddOwnISectSegs( segVec );
         }
 
         //==== Split Intersected Tri in Mesh ====//
@@ -3008,13 +3174,22 @@ void MeshGeom::MassSliceX( int numSlices, bool writefile )
 
     double sliceW = ( xMax - xMin ) / ( double )( numSlices );
 
+    //==== Surface Integral Engine Needs No Slices ====//
+    bool surfFlag = m_Vehicle && m_Vehicle->m_MassPropEngine() == vsp::MASS_PROP_SURFACE_INTEGRAL;
+
     //==== Build Slice Mesh Object =====//
     if ( numSlices < 3 )
     {
         numSlices = 3;
     }
 
-    for ( s = 0 ; s < numSlices ; s++ )
+    int numSliceMeshes = numSlices;
+    if ( surfFlag )
+    {
+        numSliceMeshes = 0;
+    }
+
+    for ( s = 0 ; s < numSliceMeshes ; s++ )
     {
         TMesh* tm = new TMesh();
         m_SliceVec.push_back( tm );
@@ -3168,6 +3343,12 @@ void MeshGeom::MassSliceX( int numSlices, bool writefile )
         }
     }
 
+    //==== Or One Lumped Mass Per Component From The Trimmed Surfaces ====//
+    if ( surfFlag )
+    {
+        SurfIntegralMassProps( tetraVec, bTypes, thicksurf );
+    }
+
     //==== Add in Point Masses ====//
     for ( i = 0 ; i < ( int )m_PointMassVec.size() ; i++ )
     {
@@ -3805,14 +3986,204 @@ void MeshGeom::CreatePrism( vector< TetraMassProp* >& tetraVec, TTri* tri, doubl
     p4.offset_x( -len / 2.0 );
     p5.offset_x( -len / 2.0 );
 
-    tetraVec.push_back( new TetraMassProp( tri->m_ID, tri->m_Density, cnt, p0, p1, p2 ) );
-    tetraVec.push_back( new TetraMassProp( tri->m_ID, tri->m_Density, cnt, p3, p4, p5 ) );
-    tetraVec.push_back( new TetraMassProp( tri->m_ID, tri->m_Density, cnt, p0, p1, p3 ) );
-    tetraVec.push_back( new TetraMassProp( tri->m_ID, tri->m_Density, cnt, p3, p4, p1 ) );
-    tetraVec.push_back( new TetraMassProp( tri->m_ID, tri->m_Density, cnt, p1, p2, p4 ) );
-    tetraVec.push_back( new TetraMassProp( tri->m_ID, tri->m_Density, cnt, p4, p5, p2 ) );
-    tetraVec.push_back( new TetraMassProp( tri->m_ID, tri->m_Density, cnt, p0, p2, p3 ) );
-    tetraVec.push_back( new TetraMassProp( tri->m_ID, tri->m_Density, cnt, p3, p5, p2 ) );
+    tetraVec.push_back( new TetraMassProp( tri->GetID(), tri->m_Density, cnt, p0, p1, p2 ) );
+    tetraVec.push_back( new TetraMassProp( tri->GetID(), tri->m_Density, cnt, p3, p4, p5 ) );
+    tetraVec.push_back( new TetraMassProp( tri->GetID(), tri->m_Density, cnt, p0, p1, p3 ) );
+    tetraVec.push_back( new TetraMassProp( tri->GetID(), tri->m_Density, cnt, p3, p4, p1 ) );
+    tetraVec.push_back( new TetraMassProp( tri->GetID(), tri->m_Density, cnt, p1, p2, p4 ) );
+    tetraVec.push_back( new TetraMassProp( tri->GetID(), tri->m_Density, cnt, p4, p5, p2 ) );
+    tetraVec.push_back( new TetraMassProp( tri->GetID(), tri->m_Density, cnt, p0, p2, p3 ) );
+    tetraVec.push_back( new TetraMassProp( tri->GetID(), tri->m_Density, cnt, p3, p5, p2 ) );
+}
+
+//==== Mass Properties From Divergence Theorem Surface Integrals ====//
+// Every point in the trimmed volume belongs to the thick mesh that contains
+// it with the highest mass priority, the same owner a slice tri gets.  Across
+// each trimmed surface piece of mesh m the owner can change, so the piece
+// adds its tetra (to the integration origin) integrals to the owner on the
+// inside and subtracts them from the owner on the outside.  Summed over all
+// pieces this leaves exact volume, first and second moments per owner.
+// Results are one TetraMassProp per component, with inertia about its CG.
+void MeshGeom::SurfIntegralMassProps( vector< TetraMassProp* >& tetraVec, const vector < int > & bTypes, const vector < bool > & thicksurf )
+{
+    int i, m;
+    int nmesh = m_TMeshVec.size();
+    const int nint = 10;            // Vol, X, Y, Z, XX, YY, ZZ, XY, XZ, YZ
+
+    if ( nmesh == 0 )
+    {
+        return;
+    }
+
+    //==== Integrate About Box Center To Limit Cancellation ====//
+    vec3d orig = m_BBox.GetCenter();
+
+    //==== Work Is Blocks Of Base Tris, Summed In Block Order ====//
+    const int blockSize = 256;
+    vector< int > blockMesh;
+    vector< int > blockStart;
+    for ( m = 0 ; m < nmesh ; m++ )
+    {
+        if ( !m_TMeshVec[m]->m_ThickSurf )
+        {
+            continue;
+        }
+        for ( i = 0 ; i < ( int )m_TMeshVec[m]->m_TVec.size() ; i += blockSize )
+        {
+            blockMesh.push_back( m );
+            blockStart.push_back( i );
+        }
+    }
+
+    int nblock = blockMesh.size();
+    vector< vector< double > > blockSum( nblock );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( int b = 0 ; b < nblock ; b++ )
+    {
+        TMesh* tm = m_TMeshVec[ blockMesh[b] ];
+        int mi = blockMesh[b];
+        int tend = min( blockStart[b] + blockSize, ( int )tm->m_TVec.size() );
+
+        vector< double > & sum = blockSum[b];
+        sum.resize( nmesh * nint, 0.0 );
+
+        vector< bool > outVec;
+        vector< bool > inVec;
+        vector< TTri* > pieceVec;
+
+        for ( int t = blockStart[b] ; t < tend ; t++ )
+        {
+            TTri* tri = tm->m_TVec[t];
+
+            pieceVec.clear();
+            if ( tri->m_SplitVec.size() )
+            {
+                pieceVec = tri->m_SplitVec;
+            }
+            else
+            {
+                pieceVec.push_back( tri );
+            }
+
+            for ( int p = 0 ; p < ( int )pieceVec.size() ; p++ )
+            {
+                TTri* piece = pieceVec[p];
+
+                tm->GetInsideVec( piece->m_InsideIndex, outVec );
+                outVec.resize( nmesh, false );
+                inVec = outVec;
+                inVec[ mi ] = true;
+
+                int ownerIn = MassPropOwner( inVec, bTypes, thicksurf );
+                int ownerOut = MassPropOwner( outVec, bTypes, thicksurf );
+
+                if ( ownerIn == ownerOut )
+                {
+                    continue;
+                }
+
+                vec3d a = piece->m_N0->m_Pnt - orig;
+                vec3d c1 = piece->m_N1->m_Pnt - orig;
+                vec3d c2 = piece->m_N2->m_Pnt - orig;
+
+                double v = tetra_volume( a, c1, c2 );
+
+                double val[nint];
+                val[0] = v;
+                for ( int k = 0 ; k < 3 ; k++ )
+                {
+                    val[ 1 + k ] = v * ( a[k] + c1[k] + c2[k] ) / 4.0;
+                    val[ 4 + k ] = v / 10.0 * ( a[k] * a[k] + c1[k] * c1[k] + c2[k] * c2[k] +
+                                                a[k] * c1[k] + a[k] * c2[k] + c1[k] * c2[k] );
+                }
+
+                int ij[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+                for ( int k = 0 ; k < 3 ; k++ )
+                {
+                    int ii = ij[k][0];
+                    int jj = ij[k][1];
+                    val[ 7 + k ] = v / 20.0 * ( 2.0 * ( a[ii] * a[jj] + c1[ii] * c1[jj] + c2[ii] * c2[jj] ) +
+                                                a[ii] * c1[jj] + c1[ii] * a[jj] + a[ii] * c2[jj] + c2[ii] * a[jj] +
+                                                c1[ii] * c2[jj] + c2[ii] * c1[jj] );
+                }
+
+                for ( int k = 0 ; k < nint ; k++ )
+                {
+                    if ( ownerIn >= 0 )
+                    {
+                        sum[ ownerIn * nint + k ] += val[k];
+                    }
+                    if ( ownerOut >= 0 )
+                    {
+                        sum[ ownerOut * nint + k ] -= val[k];
+                    }
+                }
+            }
+        }
+    }
+
+    vector< double > total( nmesh * nint, 0.0 );
+    for ( int b = 0 ; b < nblock ; b++ )
+    {
+        for ( i = 0 ; i < nmesh * nint ; i++ )
+        {
+            total[i] += blockSum[b][i];
+        }
+    }
+
+    //==== Lumped Mass For Each Owning Component ====//
+    for ( m = 0 ; m < nmesh ; m++ )
+    {
+        double* sm = &total[ m * nint ];
+        if ( sm[0] <= 0.0 )
+        {
+            continue;
+        }
+
+        double den = m_TMeshVec[m]->m_Density;
+        vec3d c( sm[1] / sm[0], sm[2] / sm[0], sm[3] / sm[0] );
+
+        TetraMassProp* pm = new TetraMassProp();
+        pm->m_CompId = m_TMeshVec[m]->m_PtrID;
+        pm->m_Density = den;
+        pm->m_Vol = sm[0];
+        pm->m_Mass = den * sm[0];
+        pm->m_CG = c + orig;
+
+        pm->m_Ixx = den * ( sm[5] + sm[6] ) - pm->m_Mass * ( c.y() * c.y() + c.z() * c.z() );
+        pm->m_Iyy = den * ( sm[4] + sm[6] ) - pm->m_Mass * ( c.x() * c.x() + c.z() * c.z() );
+        pm->m_Izz = den * ( sm[4] + sm[5] ) - pm->m_Mass * ( c.x() * c.x() + c.y() * c.y() );
+        pm->m_Ixy = den * sm[7] - pm->m_Mass * c.x() * c.y();
+        pm->m_Ixz = den * sm[8] - pm->m_Mass * c.x() * c.z();
+        pm->m_Iyz = den * sm[9] - pm->m_Mass * c.y() * c.z();
+
+        tetraVec.push_back( pm );
+    }
+}
+
+//==== Mesh Whose Density Applies At A Point Inside The Given Meshes, -1 If Not Solid ====//
+int MeshGeom::MassPropOwner( const vector < bool > & inVec, const vector < int > & bTypes, const vector < bool > & thicksurf )
+{
+    // Same rule that keeps or ignores a slice tri.
+    if ( m_TMeshVec[0]->DecideIgnoreTri( vsp::CFD_STRUCTURE, bTypes, thicksurf, inVec ) )
+    {
+        return -1;
+    }
+
+    int owner = -1;
+    int prior = -1;
+    for ( int m = 0 ; m < ( int )inVec.size() ; m++ )
+    {
+        if ( inVec[m] && thicksurf[m] && m_TMeshVec[m]->m_MassPrior > prior )
+        {
+            prior = m_TMeshVec[m]->m_MassPrior;
+            owner = m;
+        }
+    }
+    return owner;
 }
 
 //==== Create a Prism Made of DegenGeomTetras - Extrude Tri +- len/2 ====//
@@ -3834,14 +4205,14 @@ void MeshGeom::createDegenGeomPrism( vector< DegenGeomTetraMassProp* >& tetraVec
     p4.offset_x( -len / 2.0 );
     p5.offset_x( -len / 2.0 );
 
-    tetraVec.push_back( new DegenGeomTetraMassProp( tri->m_ID, cnt, p0, p1, p2 ) );
-    tetraVec.push_back( new DegenGeomTetraMassProp( tri->m_ID, cnt, p3, p4, p5 ) );
-    tetraVec.push_back( new DegenGeomTetraMassProp( tri->m_ID, cnt, p0, p1, p3 ) );
-    tetraVec.push_back( new DegenGeomTetraMassProp( tri->m_ID, cnt, p3, p4, p1 ) );
-    tetraVec.push_back( new DegenGeomTetraMassProp( tri->m_ID, cnt, p1, p2, p4 ) );
-    tetraVec.push_back( new DegenGeomTetraMassProp( tri->m_ID, cnt, p4, p5, p2 ) );
-    tetraVec.push_back( new DegenGeomTetraMassProp( tri->m_ID, cnt, p0, p2, p3 ) );
-    tetraVec.push_back( new DegenGeomTetraMassProp( tri->m_ID, cnt, p3, p5, p2 ) );
+    tetraVec.push_back( new DegenGeomTetraMassProp( tri->GetID(), cnt, p0, p1, p2 ) );
+    tetraVec.push_back( new DegenGeomTetraMassProp( tri->GetID(), cnt, p3, p4, p5 ) );
+    tetraVec.push_back( new DegenGeomTetraMassProp( tri->GetID(), cnt, p0, p1, p3 ) );
+    tetraVec.push_back( new DegenGeomTetraMassProp( tri->GetID(), cnt, p3, p4, p1 ) );
+    tetraVec.push_back( new DegenGeomTetraMassProp( tri->GetID(), cnt, p1, p2, p4 ) );
+    tetraVec.push_back( new DegenGeomTetraMassProp( tri->GetID(), cnt, p4, p5, p2 ) );
+    tetraVec.push_back( new DegenGeomTetraMassProp( tri->GetID(), cnt, p0, p2, p3 ) );
+    tetraVec.push_back( new DegenGeomTetraMassProp( tri->GetID(), cnt, p3, p5, p2 ) );
 }
 
 //==== Check Current Geom For Problems ====//
@@ -26,6 +26,8 @@
 #include <set>
 #include <map>
 
+class CompGeomCache;
+
 class MeshInfo
 {
 public:
@@ -148,10 +150,20 @@ public:
 
     //==== Intersection, Splitting and Trimming ====//
     virtual void IntersectTrim( vector< DegenGeom > &degenGeom, bool degen = true, int intSubsFlag = 1 );
+    virtual void IntersectSplit( vector< TMesh* > & meshVec, bool regionFlag, CompGeomCache* cache );
 
     virtual void MassSliceX( int numSlice, bool writefile = true );
     virtual void degenGeomMassSliceX( vector< DegenGeom > &degenGeom );
-    virtual void AreaSlice( int numSlices, vec3d norm, bool autoBounds, double start = 0, double end = 0 );
+    // PLANAR_SLICE_SWEEP trims copies of the meshes against each other with
+    // IntersectSplit, the same cost as a CompGeom trim, then cuts every station
+    // in one sweep.  The trim dominates, so for a few stations the slice mesh
+    // engine can be faster.  No slice meshes are built, m_TMeshVec is left
+    // untrimmed and m_SliceVec empty.
+    virtual void AreaSlice( int numSlices, vec3d norm, bool autoBounds, double start = 0, double end = 0,
+                            int engine = vsp::PLANAR_SLICE_MESH );
+    virtual void SweepSliceAreas( const vector < TMesh* > & meshVec, const vector < double > & loc_vec,
+                                  const vector < int > & bTypes, const vector < bool > & thicksurf,
+                                  vector < double > & area_vec, vector < vec3d > & center_vec );
 
     virtual void WaveStartEnd( const double &sliceAngle, const vec3d &center );
     virtual void WaveDragSlice( int numSlices, double sliceAngle, int coneSections,
@@ -160,6 +172,8 @@ public:
     virtual void MergeRemoveOpenMeshes( MeshInfo* info, bool deleteopen = true );
 
     virtual void CreatePrism( vector< TetraMassProp* >& tetraVec, TTri* tri, double len );
+    virtual void SurfIntegralMassProps( vector< TetraMassProp* >& tetraVec, const vector < int > & bTypes, const vector < bool > & thicksurf );
+    virtual int MassPropOwner( const vector < bool > & inVec, const vector < int > & bTypes, const vector < bool > & thicksurf );
     virtual void createDegenGeomPrism( vector< DegenGeomTetraMassProp* >& tetraVec, TTri* tri, double len );
 
     virtual void AddPointMass( TetraMassProp* pm )
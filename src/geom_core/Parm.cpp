@@ -33,6 +33,7 @@ Parm::Parm()
     m_LowerLimit = -1.0e16;
     m_ActiveFlag = true;
     m_LinkUpdateFlag = false;
+    m_UpdateType = UPDATE_DEFAULT;
     m_ChangeCnt = 0;
 }
 
@@ -134,6 +134,20 @@ public:
         return m_ActiveFlag;
     }
 
+    // What a change of this Parm makes its Geom update.  UPDATE_DEFAULT leaves
+    // it to GeomBase::SetDirtyFlags to classify by group and name.
+    enum { UPDATE_DEFAULT, UPDATE_XFORM, UPDATE_TESS, UPDATE_SURF, UPDATE_HIGHLIGHT, UPDATE_FEA,
+           UPDATE_ATTRIBUTE,    // No update stage, e.g. mass properties and output Parms
+         };
+    virtual void SetUpdateType( int type )
+    {
+        m_UpdateType = type;
+    }
+    virtual int GetUpdateType() const
+    {
+        return m_UpdateType;
+    }
+
     virtual void SetLinkUpdateFlag( bool flag )
     {
         m_LinkUpdateFlag = flag;
@@ -178,6 +192,7 @@ protected:
 
     bool m_ActiveFlag;
     bool m_LinkUpdateFlag;  // Used to identify actively updating Parms to prevent circular updates.
+    int m_UpdateType;
     string m_LinkContainerID;
 
     virtual string GenerateID();
@@ -11,10 +11,13 @@
 #include "ParmMgr.h"
 #include "Vehicle.h"
 #include "MeshGeom.h"
+#include "PntNodeMerge.h"
 
 #include "triangle.h"
 #include "triangle_api.h"
 
+#include <stdint.h>
+
 //==== Constructor ====//
 ProjectionMgrSingleton::ProjectionMgrSingleton()
 {
@@ -653,6 +656,77 @@ void ProjectionMgrSingleton::UpdateBBox( vector < TMesh* > & tmv )
     }
 }
 
+//==== Closed And Consistently Oriented - Every Edge Is Matched By A Reversed One ====//
+// Any line crosses such a surface as many times front to back as back to
+// front, so the tris facing one way cover the whole projection.
+static bool IsClosedMesh( TMesh* tm )
+{
+    int ntri = tm->m_TVec.size();
+    if ( ntri == 0 )
+    {
+        return false;
+    }
+
+    BndBox bb;
+    vector< vec3d > cornerVec( 3 * ntri );
+    for ( int j = 0 ; j < ntri ; j++ )
+    {
+        for ( int k = 0 ; k < 3 ; k++ )
+        {
+            cornerVec[ 3 * j + k ] = tm->m_TVec[j]->GetTriNode( k )->m_Pnt;
+            bb.Update( cornerVec[ 3 * j + k ] );
+        }
+    }
+
+    //==== Merge Coincident Corners ====//
+    PntNodeCloud pnCloud;
+    pnCloud.AddPntNodes( cornerVec );
+    WeldPntNodes( pnCloud, bb.GetLargestDist() * 1.0e-10 );
+
+    vector< pair< int, int > > edgeVec( 3 * ntri );
+    vector< pair< int, int > > revVec( 3 * ntri );
+    for ( int j = 0 ; j < ntri ; j++ )
+    {
+        for ( int k = 0 ; k < 3 ; k++ )
+        {
+            int n0 = pnCloud.GetNodeBaseIndex( 3 * j + k );
+            int n1 = pnCloud.GetNodeBaseIndex( 3 * j + ( k + 1 ) % 3 );
+            edgeVec[ 3 * j + k ] = pair< int, int >( n0, n1 );
+            revVec[ 3 * j + k ] = pair< int, int >( n1, n0 );
+        }
+    }
+
+    std::sort( edgeVec.begin(), edgeVec.end() );
+    std::sort( revVec.begin(), revVec.end() );
+
+    return edgeVec == revVec;
+}
+
+//==== Tri Path In The Projection Plane, Culled If Empty Or Facing Away ====//
+static bool TriToPath( TTri* tri, bool frontonly, const int keepdir1, const int keepdir2, ClipperLib::Path & pth )
+{
+    pth.resize( 3 );
+
+    for ( int k = 0; k < 3; k++ )
+    {
+        vec3d p = tri->GetTriNode( k )->m_Pnt;
+        pth[k] = ClipperLib::IntPoint( (int) p.v[keepdir1], (int) p.v[keepdir2] );
+    }
+
+    double a = ClipperLib::Area( pth );
+
+    if ( a == 0.0 || ( frontonly && a < 0.0 ) )
+    {
+        return false;
+    }
+
+    if ( a < 0.0 )
+    {
+        ClipperLib::ReversePath( pth );
+    }
+    return true;
+}
+
 void ProjectionMgrSingleton::MeshToPaths( const vector < TMesh* > & tmv, ClipperLib::Paths & pths )
 {
     unsigned int ntri = 0;
@@ -660,27 +734,20 @@ void ProjectionMgrSingleton::MeshToPaths( const vector < TMesh* > & tmv, Clipper
     {
         ntri += tmv[i]->m_TVec.size();
     }
-    pths.resize( ntri );
+    pths.clear();
+    pths.reserve( ntri );
 
-    unsigned int itri = 0;
+    ClipperLib::Path pth;
     for ( unsigned int i = 0 ; i < ( int )tmv.size() ; i++ )
     {
+        bool frontonly = IsClosedMesh( tmv[i] );
+
         for ( int j = 0 ; j < ( int )tmv[i]->m_TVec.size() ; j++ )
         {
-            pths[itri].resize(3);
-
-            for ( int k = 0; k < 3; k++ )
+            if ( TriToPath( tmv[i]->m_TVec[j], frontonly, 1, 2, pth ) )
             {
-                vec3d p = tmv[i]->m_TVec[j]->GetTriNode( k )->m_Pnt;
-                pths[itri][k] = ClipperLib::IntPoint( (int) p.y(), (int) p.z() );
+                pths.push_back( pth );
             }
-
-            if ( !ClipperLib::Orientation( pths[itri] ) )
-            {
-                ClipperLib::ReversePath( pths[itri] );
-            }
-
-            itri++;
         }
     }
 }
@@ -690,25 +757,24 @@ void ProjectionMgrSingleton::MeshToPathsVec( const vector < TMesh* > & tmv, vect
     pthvec.resize( tmv.size() );
     ids.resize( tmv.size() );
 
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
     for ( int i = 0 ; i < ( int )tmv.size() ; i++ )
     {
-        pthvec[i].resize( tmv[i]->m_TVec.size() );
         ids[i] = tmv[i]->m_PtrID;
 
-        for ( int j = 0 ; j < ( int )tmv[i]->m_TVec.size() ; j++ )
-        {
-            ClipperLib::Path pth;
-            pthvec[i][j].resize( 3 );
+        bool frontonly = IsClosedMesh( tmv[i] );
 
-            for ( int k = 0; k < 3; k++ )
-            {
-                vec3d p = tmv[i]->m_TVec[j]->GetTriNode( k )->m_Pnt;
-                pthvec[i][j][k] = ClipperLib::IntPoint( (int) p.v[keepdir1], (int) p.v[keepdir2] );
-            }
+        pthvec[i].clear();
+        pthvec[i].reserve( tmv[i]->m_TVec.size() );
 
-            if ( !ClipperLib::Orientation( pthvec[i][j] ) )
+        ClipperLib::Path pth;
+        for ( int j = 0 ; j < ( int )tmv[i]->m_TVec.size() ; j++ )
+        {
+            if ( TriToPath( tmv[i]->m_TVec[j], frontonly, keepdir1, keepdir2, pth ) )
             {
-                ClipperLib::ReversePath( pthvec[i][j] );
+                pthvec[i].push_back( pth );
             }
         }
     }
@@ -789,32 +855,212 @@ void ProjectionMgrSingleton::ClosePaths( ClipperLib::Paths & pths )
     }
 }
 
-void ProjectionMgrSingleton::Union( ClipperLib::Paths & pths, ClipperLib::Paths & sol )
+//==== Union Without Clean Up, For Intermediate Results ====//
+static void ExecuteUnion( const ClipperLib::Paths & pthA, const ClipperLib::Paths & pthB, ClipperLib::Paths & sol )
 {
     ClipperLib::Clipper clpr;
-    clpr.AddPaths( pths, ClipperLib::ptSubject, true );
+    clpr.AddPaths( pthA, ClipperLib::ptSubject, true );
+    clpr.AddPaths( pthB, ClipperLib::ptSubject, true );
 
     if ( !clpr.Execute( ClipperLib::ctUnion, sol, ClipperLib::pftPositive, ClipperLib::pftPositive ) )
     {
         printf( "Clipper error\n" );
     }
+}
+
+//==== Spread Low 32 Bits To Even Bit Positions ====//
+static uint64_t SpreadBits( uint64_t x )
+{
+    x &= 0xFFFFFFFFULL;
+    x = ( x | ( x << 16 ) ) & 0x0000FFFF0000FFFFULL;
+    x = ( x | ( x << 8 ) ) & 0x00FF00FF00FF00FFULL;
+    x = ( x | ( x << 4 ) ) & 0x0F0F0F0F0F0F0F0FULL;
+    x = ( x | ( x << 2 ) ) & 0x3333333333333333ULL;
+    x = ( x | ( x << 1 ) ) & 0x5555555555555555ULL;
+    return x;
+}
+
+//==== Cut Paths Into Tiles Along A Z-Order Curve Through Their First Points ====//
+static void SplitTiles( const ClipperLib::Paths & pths, int tile_size, vector < ClipperLib::Paths > & tilevec )
+{
+    tilevec.clear();
+
+    if ( pths.empty() )
+    {
+        return;
+    }
+
+    if ( tile_size <= 0 || ( int )pths.size() <= tile_size )
+    {
+        tilevec.push_back( pths );
+        return;
+    }
+
+    ClipperLib::cInt xmin = 0, xmax = 0, ymin = 0, ymax = 0;
+    bool first = true;
+    for ( int i = 0; i < ( int )pths.size(); i++ )
+    {
+        if ( pths[i].empty() )
+        {
+            continue;
+        }
+        const ClipperLib::IntPoint & p = pths[i][0];
+        if ( first )
+        {
+            xmin = xmax = p.X;
+            ymin = ymax = p.Y;
+            first = false;
+        }
+        xmin = std::min( xmin, p.X );
+        xmax = std::max( xmax, p.X );
+        ymin = std::min( ymin, p.Y );
+        ymax = std::max( ymax, p.Y );
+    }
+
+    double sx = xmax > xmin ? 65535.0 / ( double )( xmax - xmin ) : 0.0;
+    double sy = ymax > ymin ? 65535.0 / ( double )( ymax - ymin ) : 0.0;
+
+    vector < pair < uint64_t, int > > keyvec( pths.size() );
+    for ( int i = 0; i < ( int )pths.size(); i++ )
+    {
+        uint64_t key = 0;
+        if ( !pths[i].empty() )
+        {
+            uint64_t qx = ( uint64_t )( ( double )( pths[i][0].X - xmin ) * sx );
+            uint64_t qy = ( uint64_t )( ( double )( pths[i][0].Y - ymin ) * sy );
+            key = SpreadBits( qx ) | ( SpreadBits( qy ) << 1 );
+        }
+        keyvec[i] = pair < uint64_t, int >( key, i );
+    }
+    std::sort( keyvec.begin(), keyvec.end() );
+
+    int ntile = ( pths.size() + tile_size - 1 ) / tile_size;
+    tilevec.resize( ntile );
+    for ( int i = 0; i < ( int )keyvec.size(); i++ )
+    {
+        tilevec[ i / tile_size ].push_back( pths[ keyvec[i].second ] );
+    }
+}
+
+//==== Union Each Set Of Tiles Down To One Tile ====//
+// Work from all sets goes into one task list so one large set does not run
+// alone.  Pairs are always merged in the same order, so the result does not
+// depend on the thread count.
+static void ReduceUnion( vector < vector < ClipperLib::Paths > > & setvec, bool unionleaves )
+{
+    vector < pair < int, int > > taskvec;
+
+    if ( unionleaves )
+    {
+        for ( int s = 0; s < ( int )setvec.size(); s++ )
+        {
+            for ( int i = 0; i < ( int )setvec[s].size(); i++ )
+            {
+                taskvec.push_back( pair < int, int >( s, i ) );
+            }
+        }
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+        for ( int t = 0; t < ( int )taskvec.size(); t++ )
+        {
+            ClipperLib::Paths & tile = setvec[ taskvec[t].first ][ taskvec[t].second ];
+            ClipperLib::Paths sol;
+            ExecuteUnion( tile, ClipperLib::Paths(), sol );
+            tile.swap( sol );
+        }
+    }
+
+    while ( true )
+    {
+        taskvec.clear();
+        for ( int s = 0; s < ( int )setvec.size(); s++ )
+        {
+            for ( int i = 0; i + 1 < ( int )setvec[s].size(); i += 2 )
+            {
+                taskvec.push_back( pair < int, int >( s, i ) );
+            }
+        }
+
+        if ( taskvec.empty() )
+        {
+            break;
+        }
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+        for ( int t = 0; t < ( int )taskvec.size(); t++ )
+        {
+            vector < ClipperLib::Paths > & tilevec = setvec[ taskvec[t].first ];
+            int i = taskvec[t].second;
+
+            ClipperLib::Paths sol;
+            ExecuteUnion( tilevec[i], tilevec[i + 1], sol );
+            tilevec[i].swap( sol );
+            tilevec[i + 1].clear();
+        }
+
+        //==== Keep Merged Tiles And Any Odd One Out ====//
+        for ( int s = 0; s < ( int )setvec.size(); s++ )
+        {
+            vector < ClipperLib::Paths > & tilevec = setvec[s];
+            int n = 0;
+            for ( int i = 0; i < ( int )tilevec.size(); i += 2 )
+            {
+                tilevec[n].swap( tilevec[i] );
+                n++;
+            }
+            tilevec.resize( n );
+        }
+    }
+}
+
+void ProjectionMgrSingleton::UnionTiled( const ClipperLib::Paths & pths, ClipperLib::Paths & sol, int tile_size )
+{
+    vector < vector < ClipperLib::Paths > > setvec( 1 );
+    SplitTiles( pths, tile_size, setvec[0] );
+
+    ReduceUnion( setvec, true );
+
+    sol.clear();
+    if ( !setvec[0].empty() )
+    {
+        sol.swap( setvec[0][0] );
+    }
 
     CleanPolygons( sol );
     SimplifyPolygons( sol );
 }
 
-void ProjectionMgrSingleton::Union( vector < ClipperLib::Paths > & pthsvec,  ClipperLib::Paths & sol )
+void ProjectionMgrSingleton::Union( ClipperLib::Paths & pths, ClipperLib::Paths & sol )
 {
-    // Append all paths into one path.
-    ClipperLib::Paths pth;
+    UnionTiled( pths, sol );
+}
 
+void ProjectionMgrSingleton::Union( vector < ClipperLib::Paths > & pthsvec,  ClipperLib::Paths & sol )
+{
+    // Each entry is already a union, merge them pairwise.
+    vector < vector < ClipperLib::Paths > > setvec( 1 );
     for ( int j = 0; j < pthsvec.size(); j++ )
     {
-        pth.insert( pth.end(), pthsvec[j].begin(), pthsvec[j].end() );
+        if ( !pthsvec[j].empty() )
+        {
+            setvec[0].push_back( pthsvec[j] );
+        }
     }
 
-    // Then union into solution.
-    Union( pth, sol );
+    ReduceUnion( setvec, false );
+
+    sol.clear();
+    if ( !setvec[0].empty() )
+    {
+        sol.swap( setvec[0][0] );
+    }
+
+    CleanPolygons( sol );
+    SimplifyPolygons( sol );
 }
 
 void ProjectionMgrSingleton::Union( vector < ClipperLib::Paths > & pthsvec, vector < ClipperLib::Paths > & solvec, vector < string > & ids )
@@ -828,6 +1074,9 @@ void ProjectionMgrSingleton::Union( vector < ClipperLib::Paths > & pthsvec, vect
 
     solvec.resize( uids.size() );
 
+    // Tiles of every Geom are unioned together.
+    vector < vector < ClipperLib::Paths > > setvec( uids.size() );
+
     for ( int i = 0; i < uids.size(); i++ )
     {
         // Append all matching paths into one path.
@@ -841,8 +1090,24 @@ void ProjectionMgrSingleton::Union( vector < ClipperLib::Paths > & pthsvec, vect
             }
         }
 
-        // Then union into its own set.
-        Union( pth, solvec[i] );
+        SplitTiles( pth, UNION_TILE_SIZE, setvec[i] );
+    }
+
+    ReduceUnion( setvec, true );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( int i = 0; i < ( int )uids.size(); i++ )
+    {
+        solvec[i].clear();
+        if ( !setvec[i].empty() )
+        {
+            solvec[i].swap( setvec[i][0] );
+        }
+
+        CleanPolygons( solvec[i] );
+        SimplifyPolygons( solvec[i] );
     }
 
     // Copy unique ids over passed in id vector.
@@ -868,7 +1133,10 @@ void ProjectionMgrSingleton::Intersect( vector < ClipperLib::Paths > & pthsvecA,
 {
     solvec.resize( pthsvecA.size() );
 
-    for ( int i = 0; i < pthsvecA.size(); i++ )
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( int i = 0; i < ( int )pthsvecA.size(); i++ )
     {
         Intersect( pthsvecA[i], pthB, solvec[i] );
     }
@@ -84,6 +84,12 @@ public:
 
     vector < bool > m_IsHole;
 
+    //==== Divide And Conquer Union ====//
+    // Paths are sorted into spatially coherent tiles of tile_size paths.  Tiles
+    // are unioned in parallel and the results merged pairwise, also in parallel.
+    static const int UNION_TILE_SIZE = 2048;
+    static void UnionTiled( const ClipperLib::Paths & pths, ClipperLib::Paths & sol, int tile_size = UNION_TILE_SIZE );
+
 
 protected:
 
@@ -1266,8 +1266,8 @@ void PropGeom::UpdateMainTessVec()
 
     int nmain = GetNumMainSurfs();
 
-    m_MainTessVec.resize( nmain, m_MainTessVec[0] );
-    m_MainFeatureTessVec.resize( nmain, m_MainFeatureTessVec[0] );
+    // Every blade places the first blade's tessellation.
+    m_MainTessInstVec.resize( nmain, m_MainTessInstVec[0] );
 
     Matrix4d rot;
     for ( int i = 1; i < m_Nblade(); i++ )
@@ -1276,8 +1276,7 @@ void PropGeom::UpdateMainTessVec()
         rot.loadIdentity();
         rot.rotateX( theta );
 
-        m_MainTessVec[i].Transform( rot );
-        m_MainFeatureTessVec[i].Transform( rot );
+        m_MainTessInstVec[i].Transform( rot );
     }
 }
 
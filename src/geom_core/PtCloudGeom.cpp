@@ -9,6 +9,45 @@
 #include "PntNodeMerge.h"
 #include "Vehicle.h"
 #include "FitModelMgr.h"
+#include "MeshFileReader.h"
+
+#ifdef max
+#undef max
+#endif
+
+#ifdef min
+#undef min
+#endif
+
+#include "nanoflann.hpp"
+
+//==== Surface Samples Seen Along A Projection Direction ====//
+// nanoflann dataset of sample positions with the idir component dropped.
+struct PtCloudSeedSet
+{
+    vector< vec3d > m_Pnts;
+    vector< double > m_U;
+    vector< double > m_W;
+    int m_Dir;
+
+    inline size_t kdtree_get_point_count() const
+    {
+        return m_Pnts.size();
+    }
+
+    inline double kdtree_get_pt( const size_t idx, int dim ) const
+    {
+        return m_Pnts[idx].v[ ( m_Dir + 1 + dim ) % 3 ];
+    }
+
+    template <class BBOX>
+    bool kdtree_get_bbox( BBOX &bb ) const
+    {
+        return false;
+    }
+};
+
+typedef nanoflann::KDTreeSingleIndexAdaptor< nanoflann::L2_Simple_Adaptor< double, PtCloudSeedSet >, PtCloudSeedSet, 2 > PtCloudSeedTree;
 
 //==== Constructor ====//
 PtCloudGeom::PtCloudGeom( Vehicle* vehicle_ptr ) : Geom( vehicle_ptr )
@@ -29,6 +68,12 @@ PtCloudGeom::PtCloudGeom( Vehicle* vehicle_ptr ) : Geom( vehicle_ptr )
     m_ScaleMatrix.loadIdentity();
     m_ScaleFromOrig.Init( "Scale_From_Original", "XForm", this, 1, 1.0e-5, 1.0e12 );
 
+    m_MaxDrawPts.Init( "Max_Draw_Pts", "PtCloud", this, 2000000, 1000, 1.0e9 );
+    m_MaxDrawPts.SetDescript( "Most points drawn, larger clouds are drawn as an even sample" );
+
+    m_NumSelected = 0;
+    m_LastSelected = -1;
+
     Update();
 }
 
@@ -51,11 +96,41 @@ void PtCloudGeom::UpdateDrawObj()
 
     m_HighlightDrawObj.m_PntVec = m_BBox.GetBBoxDrawLines();
 
+    //==== Level Of Detail ====//
+    // The leading part of every tile, in proportion to its size.
+    int npts = m_Pts.size();
+    double frac = 1.0;
+    if ( npts > m_MaxDrawPts() )
+    {
+        frac = ( double ) m_MaxDrawPts() / npts;
+    }
+
+    m_DrawIndx.clear();
+    for ( int t = 0 ; t < GetNumTiles() ; t++ )
+    {
+        int s = GetTileBegin( t );
+        int n = GetTileEnd( t ) - s;
+        int ndraw = n;
+        if ( frac < 1.0 )
+        {
+            ndraw = std::min( n, ( int ) ceil( n * frac ) );
+        }
+
+        for ( int k = 0 ; k < ndraw ; k++ )
+        {
+            m_DrawIndx.push_back( s + k );
+        }
+    }
+
     Matrix4d transMat = GetTotalTransMat();
-    m_XformPts.resize( m_Pts.size() );
-    for ( int i = 0 ; i < ( int )m_Pts.size() ; i++ )
+    m_XformPts.resize( m_DrawIndx.size() );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for ( int i = 0 ; i < ( int )m_DrawIndx.size() ; i++ )
     {
-        m_XformPts[i] = transMat.xform( m_Pts[i] );
+        m_XformPts[i] = transMat.xform( m_Pts[ m_DrawIndx[i] ] );
     }
 }
 
@@ -82,17 +157,18 @@ void PtCloudGeom::LoadDrawObjs(vector< DrawObj* > & draw_obj_vec)
 
     if ( FitModelMgr.IsGUIShown() )
     {
-        for ( int j = 0; j < ( int ) m_XformPts.size(); j++ )
+        for ( int i = 0; i < ( int ) m_XformPts.size(); i++ )
         {
+            int j = m_DrawIndx[i];
             if ( !m_Hidden[j] && !m_Selected[j] )
             {
-                m_PtsDrawObj.m_PntVec.push_back( m_XformPts[j] );
+                m_PtsDrawObj.m_PntVec.push_back( m_XformPts[i] );
                 m_ShownIndx.push_back( j );
             }
 
             if ( m_Selected[j] )
             {
-                m_SelDrawObj.m_PntVec.push_back( m_XformPts[j] );
+                m_SelDrawObj.m_PntVec.push_back( m_XformPts[i] );
             }
         }
         m_SelDrawObj.m_Visible = GetSetFlag( vsp::SET_SHOWN );
@@ -100,11 +176,8 @@ void PtCloudGeom::LoadDrawObjs(vector< DrawObj* > & draw_obj_vec)
     }
     else
     {
-        for ( int j = 0; j < ( int ) m_XformPts.size(); j++ )
-        {
-            m_PtsDrawObj.m_PntVec.push_back( m_XformPts[j] );
-            m_ShownIndx.push_back( j );
-        }
+        m_PtsDrawObj.m_PntVec = m_XformPts;
+        m_ShownIndx = m_DrawIndx;
         m_SelDrawObj.m_Visible = false;
         m_PickDrawObj.m_Visible = false;
     }
@@ -151,15 +224,29 @@ void PtCloudGeom::Scale()
 
 void PtCloudGeom::UpdateBBox()
 {
-    int i;
     m_BBox.Reset();
     Matrix4d transMat = GetTotalTransMat();
 
     if ( m_Pts.size() > 0 )
     {
-        for ( i = 0 ; i < ( int )m_Pts.size() ; i++ )
+        //==== Tile Boxes In Parallel ====//
+        int ntile = GetNumTiles();
+        vector< BndBox > tile_box( ntile );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+        for ( int t = 0 ; t < ntile ; t++ )
+        {
+            for ( int i = GetTileBegin( t ) ; i < GetTileEnd( t ) ; i++ )
+            {
+                tile_box[t].Update( transMat.xform( m_Pts[i] ) );
+            }
+        }
+
+        for ( int t = 0 ; t < ntile ; t++ )
         {
-            m_BBox.Update( transMat.xform( m_Pts[i] ) );
+            m_BBox.Update( tile_box[t] );
         }
     }
     else
@@ -170,31 +257,21 @@ void PtCloudGeom::UpdateBBox()
 
 int PtCloudGeom::ReadPTS( const char* file_name )
 {
-    FILE* file_id = fopen( file_name, "r" );
-
-    if ( !file_id )
+    vector< double > xyz;
+    if ( !MeshFileReader::ReadPtsFile( file_name, xyz ) )
     {
         return 0;
     }
-    else
-    {
-        m_Pts.clear();
-        int stopFlag = 0;
-        while ( !stopFlag )
-        {
-            double x, y, z;
-            if ( EOF == fscanf( file_id, "%lf %lf %lf\n", &x, &y, &z ) )
-            {
-                break;
-            }
-            m_Pts.push_back( vec3d( x, y, z ) );
-        }
-        fclose( file_id );
-    }
 
-    if ( m_Pts.size() == 0 )
+    m_Pts.resize( xyz.size() / 3 );
+    m_TileStart.clear();
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for ( int i = 0 ; i < ( int )m_Pts.size() ; i++ )
     {
-        return 0;
+        m_Pts[i] = vec3d( xyz[ 3 * i ], xyz[ 3 * i + 1 ], xyz[ 3 * i + 2 ] );
     }
 
     InitPts();
@@ -216,8 +293,8 @@ void PtCloudGeom::UniquePts()
         tol = 1.0e-10;
     }
 
-    //==== Use NanoFlann to Find Close Points and Group ====//
-    IndexPntNodes( pnCloud, tol );
+    //==== Use Hash Grid to Find Close Points and Group ====//
+    WeldPntNodes( pnCloud, tol );
 
     vector < vec3d > newpts;
     //==== Load Used Nodes ====//
@@ -233,14 +310,182 @@ void PtCloudGeom::UniquePts()
 
 void PtCloudGeom::InitPts()
 {
+    m_TileStart.clear();
     UpdateBBox();
     UniquePts();
+    BuildTiles();
 
     m_SurfDirty = true;
 
     unsigned int n = m_Pts.size();
     m_Selected.assign( n, false );
     m_Hidden.assign( n, false );
+    m_NumSelected = 0;
+    m_LastSelected = -1;
+}
+
+//==== Interleave The Low Ten Bits Of Three Cell Indices ====//
+static unsigned int MortonCell( unsigned int i, unsigned int j, unsigned int k )
+{
+    unsigned int code = 0;
+    for ( int b = 0 ; b < 10 ; b++ )
+    {
+        code |= ( ( i >> b ) & 1u ) << ( 3 * b );
+        code |= ( ( j >> b ) & 1u ) << ( 3 * b + 1 );
+        code |= ( ( k >> b ) & 1u ) << ( 3 * b + 2 );
+    }
+    return code;
+}
+
+//==== Scrambled Index, The Sort Key For Even Samples Within A Tile ====//
+static unsigned int SampleKey( unsigned int i )
+{
+    i ^= i >> 16;
+    i *= 0x7feb352dU;
+    i ^= i >> 15;
+    i *= 0x846ca68bU;
+    i ^= i >> 16;
+    return i;
+}
+
+void PtCloudGeom::BuildTiles()
+{
+    m_TileStart.clear();
+
+    int npts = m_Pts.size();
+    if ( npts == 0 )
+    {
+        return;
+    }
+
+    //==== Octree Level With About TILE_PTS Points Per Cell ====//
+    int level = 0;
+    while ( level < 7 && ( ( long long ) 1 << ( 3 * level ) ) * TILE_PTS < npts )
+    {
+        level++;
+    }
+    int naxis = 1 << level;
+    unsigned int ncell = 1u << ( 3 * level );
+
+    BndBox box;
+    for ( int i = 0 ; i < npts ; i++ )
+    {
+        box.Update( m_Pts[i] );
+    }
+    vec3d pmin = box.GetMin();
+    vec3d ext = box.GetMax() - pmin;
+
+    //==== Cell Of Each Point ====//
+    vector< unsigned int > cell_vec( npts );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for ( int i = 0 ; i < npts ; i++ )
+    {
+        unsigned int ind[3];
+        for ( int d = 0 ; d < 3 ; d++ )
+        {
+            int c = 0;
+            if ( ext.v[d] > 0.0 )
+            {
+                c = ( int )( ( m_Pts[i].v[d] - pmin.v[d] ) / ext.v[d] * naxis );
+                c = std::max( 0, std::min( naxis - 1, c ) );
+            }
+            ind[d] = c;
+        }
+        cell_vec[i] = MortonCell( ind[0], ind[1], ind[2] );
+    }
+
+    //==== Counting Sort By Cell ====//
+    vector< int > cell_start( ncell + 1, 0 );
+    for ( int i = 0 ; i < npts ; i++ )
+    {
+        cell_start[ cell_vec[i] + 1 ]++;
+    }
+    for ( unsigned int c = 0 ; c < ncell ; c++ )
+    {
+        cell_start[c + 1] += cell_start[c];
+    }
+
+    vector< int > fill( cell_start.begin(), cell_start.end() - 1 );
+    vector< int > order( npts );
+    for ( int i = 0 ; i < npts ; i++ )
+    {
+        order[ fill[ cell_vec[i] ]++ ] = i;
+    }
+
+    //==== Occupied Cells Are The Tiles ====//
+    m_TileStart.push_back( 0 );
+    for ( unsigned int c = 0 ; c < ncell ; c++ )
+    {
+        if ( cell_start[c + 1] > cell_start[c] )
+        {
+            m_TileStart.push_back( cell_start[c + 1] );
+        }
+    }
+
+    //==== Scramble Each Tile So Any Leading Part Is An Even Sample ====//
+    int ntile = m_TileStart.size() - 1;
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( int t = 0 ; t < ntile ; t++ )
+    {
+        vector< pair< unsigned int, int > > key_vec;
+        key_vec.reserve( m_TileStart[t + 1] - m_TileStart[t] );
+        for ( int k = m_TileStart[t] ; k < m_TileStart[t + 1] ; k++ )
+        {
+            key_vec.push_back( pair< unsigned int, int >( SampleKey( order[k] ), order[k] ) );
+        }
+        std::sort( key_vec.begin(), key_vec.end() );
+        for ( int k = 0 ; k < ( int )key_vec.size() ; k++ )
+        {
+            order[ m_TileStart[t] + k ] = key_vec[k].second;
+        }
+    }
+
+    vector< vec3d > tiled_pts( npts );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for ( int i = 0 ; i < npts ; i++ )
+    {
+        tiled_pts[i] = m_Pts[ order[i] ];
+    }
+    m_Pts.swap( tiled_pts );
+}
+
+int PtCloudGeom::GetNumTiles() const
+{
+    int npts = m_Pts.size();
+    if ( m_TileStart.size() >= 2 && m_TileStart.back() == npts )
+    {
+        return m_TileStart.size() - 1;
+    }
+    return ( npts + TILE_PTS - 1 ) / TILE_PTS;
+}
+
+int PtCloudGeom::GetTileBegin( int t ) const
+{
+    int npts = m_Pts.size();
+    if ( m_TileStart.size() >= 2 && m_TileStart.back() == npts )
+    {
+        return m_TileStart[t];
+    }
+    return t * TILE_PTS;
+}
+
+int PtCloudGeom::GetTileEnd( int t ) const
+{
+    int npts = m_Pts.size();
+    if ( m_TileStart.size() >= 2 && m_TileStart.back() == npts )
+    {
+        return m_TileStart[t + 1];
+    }
+    return std::min( npts, ( t + 1 ) * TILE_PTS );
 }
 
 //==== Encode XML ====//
@@ -437,6 +682,47 @@ void PtCloudGeom::GetSelectedPoints( vector < vec3d > &selpts )
     }
 }
 
+void PtCloudGeom::GetSelectedPoints( vector < vec3d > &selpts, int max_pts )
+{
+    //==== Selected Points Per Tile ====//
+    int ntile = GetNumTiles();
+    vector< long long > sel_start( ntile + 1, 0 );
+    for ( int t = 0 ; t < ntile ; t++ )
+    {
+        int nsel = 0;
+        for ( int i = GetTileBegin( t ) ; i < GetTileEnd( t ) ; i++ )
+        {
+            if ( m_Selected[i] )
+            {
+                nsel++;
+            }
+        }
+        sel_start[t + 1] = sel_start[t] + nsel;
+    }
+
+    long long nsel_total = sel_start[ ntile ];
+    if ( max_pts <= 0 || nsel_total <= max_pts )
+    {
+        GetSelectedPoints( selpts );
+        return;
+    }
+
+    //==== Each Tile Gives Its Share, From Its Leading (Evenly Sampled) Part ====//
+    Matrix4d transMat = GetTotalTransMat();
+    for ( int t = 0 ; t < ntile ; t++ )
+    {
+        long long quota = sel_start[t + 1] * max_pts / nsel_total - sel_start[t] * max_pts / nsel_total;
+        for ( int i = GetTileBegin( t ) ; i < GetTileEnd( t ) && quota > 0 ; i++ )
+        {
+            if ( m_Selected[i] )
+            {
+                selpts.push_back( transMat.xform( m_Pts[i] ) );
+                quota--;
+            }
+        }
+    }
+}
+
 void PtCloudGeom::ProjectPts( string geomid, int surfid, int idir )
 {
     Matrix4d transMat = GetTotalTransMat();
@@ -449,13 +735,56 @@ void PtCloudGeom::ProjectPts( string geomid, int surfid, int idir )
     {
         VspSurf *surf = g->GetSurfPtr( surfid );
 
+        //==== Sample The Surface ====//
+        PtCloudSeedSet seeds;
+        seeds.m_Dir = idir;
+
+        int nu = 8 * ( int ) ceil( surf->GetUMax() ) + 1;
+        int nw = 8 * ( int ) ceil( surf->GetWMax() ) + 1;
+        for ( int i = 0 ; i < nu ; i++ )
+        {
+            double u = surf->GetUMax() * i / ( nu - 1 );
+            for ( int j = 0 ; j < nw ; j++ )
+            {
+                double w = surf->GetWMax() * j / ( nw - 1 );
+                seeds.m_Pnts.push_back( surf->CompPnt( u, w ) );
+                seeds.m_U.push_back( u );
+                seeds.m_W.push_back( w );
+            }
+        }
+
+        //==== Samples Nearest Each Projection Line Seed The Search ====//
+        // Of the few samples closest to the line through a point, the one
+        // closest along the line is the start for the local intersection.
+        PtCloudSeedTree index( 2, seeds, nanoflann::KDTreeSingleIndexAdaptorParams( 10 ) );
+        index.buildIndex();
+
+        const int nseed = 8;
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic, 256 )
+#endif
         for ( int i = 0 ; i < ( int )m_Pts.size() ; i++ )
         {
             vec3d pin = transMat.xform( m_Pts[i] );
             vec3d pout;
 
+            double query[2] = { pin.v[ ( idir + 1 ) % 3 ], pin.v[ ( idir + 2 ) % 3 ] };
+            unsigned int ind[nseed];
+            double dist[nseed];
+            int nfound = index.knnSearch( query, nseed, ind, dist );
+
+            int best = 0;
+            for ( int k = 1 ; k < nfound ; k++ )
+            {
+                if ( std::abs( seeds.m_Pnts[ ind[k] ].v[idir] - pin.v[idir] ) < std::abs( seeds.m_Pnts[ ind[best] ].v[idir] - pin.v[idir] ) )
+                {
+                    best = k;
+                }
+            }
+
             double u, w;
-            surf->ProjectPt( pin, idir, u, w, pout );
+            surf->ProjectPt( pin, idir, seeds.m_U[ ind[best] ], seeds.m_W[ ind[best] ], u, w, pout );
 
             m_Pts[i] = invMat.xform( pout );
         }
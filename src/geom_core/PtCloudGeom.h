@@ -18,6 +18,9 @@ public:
     PtCloudGeom( Vehicle* vehicle_ptr );
     virtual ~PtCloudGeom();
 
+    // Points per tile, on average.
+    static const int TILE_PTS = 4096;
+
     virtual int GetNumMainSurfs() const
     {
         return 0;
@@ -36,6 +39,7 @@ public:
 
     virtual void UniquePts();
     virtual void InitPts();
+    virtual void BuildTiles();
 
     virtual xmlNodePtr EncodeXml( xmlNodePtr & node );
     virtual xmlNodePtr DecodeXml( xmlNodePtr & node );
@@ -54,6 +58,8 @@ public:
     void ShowAll();
 
     void GetSelectedPoints( vector < vec3d > &selpts );
+    // At most max_pts, spread over the cloud.
+    void GetSelectedPoints( vector < vec3d > &selpts, int max_pts );
 
 
     int GetNumSelected()
@@ -63,7 +69,15 @@ public:
 
     void ProjectPts( string geomid, int surfid, int idir );
 
+    // Points not yet tiled by BuildTiles are taken in blocks of TILE_PTS.
+    int GetNumTiles() const;
+    int GetTileBegin( int t ) const;
+    int GetTileEnd( int t ) const;
+
+    // Points are stored tile by tile.  Tile t is m_Pts[ m_TileStart[t] ] ... m_Pts[ m_TileStart[t + 1] - 1 ],
+    // in an order where every leading part of a tile is an even sample of it.
     vector < vec3d > m_Pts;
+    vector < int > m_TileStart;
     vector < int > m_ShownIndx;
     vector < bool > m_Selected;
     vector < bool > m_Hidden;
@@ -74,8 +88,12 @@ public:
     Matrix4d m_ScaleMatrix;
     Parm m_ScaleFromOrig;
 
+    // Level of detail for drawing
+    IntParm m_MaxDrawPts;
+
 protected:
 
+    vector < int > m_DrawIndx;          // Points drawn, m_XformPts[i] is m_Pts[ m_DrawIndx[i] ] transformed
     vector < vec3d > m_XformPts;
 
     DrawObj m_PtsDrawObj;
@@ -4138,6 +4138,38 @@ void ScriptMgrSingleton::RegisterAPI( asIScriptEngine* se )
     r = se->RegisterGlobalFunction( "void Update( bool update_managers = true)", vspFUNCTION( vsp::Update ), vspCALL_CDECL, doc_struct );
     assert( r >= 0 );
 
+    doc_struct.comment = R"(
+/*!
+    Set headless update mode. While headless, updates skip the draw objects and display tessellation that only the GUI
+    uses; they are built when something draws or asks for them. Batch scripts and the Python API start headless.
+    \code{.cpp}
+    SetHeadlessMode( true );
+
+    string wid = AddGeom( "WING", "" );                 // Add Wing
+
+    Update();       // No draw objects built
+    \endcode
+    \sa GetHeadlessMode
+    \param [in] headless Flag to skip display only work during updates
+*/)";
+    r = se->RegisterGlobalFunction( "void SetHeadlessMode( bool headless )", vspFUNCTION( vsp::SetHeadlessMode ), vspCALL_CDECL, doc_struct );
+    assert( r >= 0 );
+
+    doc_struct.comment = R"(
+/*!
+    Get the headless update mode
+    \code{.cpp}
+    if ( GetHeadlessMode() )
+    {
+        Print( "Updates skip display only work" );
+    }
+    \endcode
+    \sa SetHeadlessMode
+    \return True if updates skip display only work
+*/)";
+    r = se->RegisterGlobalFunction( "bool GetHeadlessMode()", vspFUNCTION( vsp::GetHeadlessMode ), vspCALL_CDECL, doc_struct );
+    assert( r >= 0 );
+
     doc_struct.comment = R"(
 /*!
     Exit the program with a specific error code
@@ -4302,6 +4334,9 @@ void ScriptMgrSingleton::RegisterAPI( asIScriptEngine* se )
 /*!
     Export a file from OpenVSP. Many formats are available, such as STL, IGES, and SVG. If a mesh is generated for a particular export, 
     the ID of the MeshGeom will be returned. If no mesh is generated an empty string will be returned. 
+    Text mesh formats (STL, Cart3D, OBJ, VSPGEOM, Nascart, Gmsh, Facet, PLOT3D, XSec, DXF, PMARC) are written gzip compressed 
+    as they are generated when file_name ends in .gz (e.g. "Example_Mesh.tri.gz"). The same applies to CFD Mesh, FEA Mesh and 
+    DegenGeom output file names.
     \code{.cpp}
     string wid = AddGeom( "WING" );             // Add Wing
 
@@ -5364,6 +5399,57 @@ void ScriptMgrSingleton::RegisterAPI( asIScriptEngine* se )
     r = se->RegisterGlobalFunction( "void PrintResults( const string & in id )", vspFUNCTION( vsp::PrintResults ), vspCALL_CDECL, doc_struct );
     assert( r >= 0 );
 
+    doc_struct.comment = R"(
+/*!
+    Start timing each stage of each Geom update and each link update.  Any previous timings are cleared.
+    \code{.cpp}
+    StartUpdateProfile( true );
+
+    string pid = AddGeom( "POD" );
+
+    SetParmVal( FindParm( pid, "Length", "Design" ), 12.0 );
+    Update();
+
+    StopUpdateProfile();
+
+    string rid = CreateUpdateProfileResults();
+
+    PrintResults( rid );
+
+    WriteUpdateProfileTrace( "update_trace.json" );
+    \endcode
+    \param [in] trace_flag Flag to also keep every timed stage for WriteUpdateProfileTrace
+*/)";
+    r = se->RegisterGlobalFunction( "void StartUpdateProfile( bool trace_flag = false )", vspFUNCTION( vsp::StartUpdateProfile ), vspCALL_CDECL, doc_struct );
+    assert( r >= 0 );
+
+    doc_struct.comment = R"(
+/*!
+    Stop timing Geom and link updates.  Timings are kept until the next StartUpdateProfile.
+    \sa StartUpdateProfile
+*/)";
+    r = se->RegisterGlobalFunction( "void StopUpdateProfile()", vspFUNCTION( vsp::StopUpdateProfile ), vspCALL_CDECL, doc_struct );
+    assert( r >= 0 );
+
+    doc_struct.comment = R"(
+/*!
+    Create an "Update_Profile" result with the number of calls, total and maximum seconds of each update stage of each Geom,
+    and the total seconds of each Geom.  Link stages include the updates they set off, so are not part of the Geom totals.
+    \sa StartUpdateProfile
+    \return Result ID
+*/)";
+    r = se->RegisterGlobalFunction( "string CreateUpdateProfileResults()", vspFUNCTION( vsp::CreateUpdateProfileResults ), vspCALL_CDECL, doc_struct );
+    assert( r >= 0 );
+
+    doc_struct.comment = R"(
+/*!
+    Write the stages timed since StartUpdateProfile( true ) as a Chrome trace JSON file (chrome://tracing or Perfetto)
+    \sa StartUpdateProfile
+    \param [in] file_name Trace output file name
+*/)";
+    r = se->RegisterGlobalFunction( "void WriteUpdateProfileTrace( const string & in file_name )", vspFUNCTION( vsp::WriteUpdateProfileTrace ), vspCALL_CDECL, doc_struct );
+    assert( r >= 0 );
+
     doc_struct.comment = R"(
 /*!
     Create two sets of test results, each containing int, string, vec3d, double, and vector< double > data types. 
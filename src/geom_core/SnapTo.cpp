@@ -9,6 +9,107 @@
 #include "Vehicle.h"
 #include "ParmMgr.h"
 #include <cfloat>  //For DBL_EPSILON
+#include <string.h>
+
+//===============================================================================//
+//===============================================================================//
+
+SnapToCacheEntry::SnapToCacheEntry()
+{
+    m_UpdateCount = -1;
+    m_QueryCount = -1;
+}
+
+void SnapToCacheEntry::Clear()
+{
+    for ( int i = 0 ; i < ( int )m_TMeshVec.size() ; i++ )
+    {
+        delete m_TMeshVec[i];
+    }
+    m_TMeshVec.clear();
+}
+
+//===============================================================================//
+//===============================================================================//
+
+SnapToCache::SnapToCache()
+{
+    m_Hits = 0;
+    m_Misses = 0;
+    m_QueryCount = 0;
+}
+
+SnapToCache::~SnapToCache()
+{
+    Clear();
+}
+
+void SnapToCache::Clear()
+{
+    map< string, SnapToCacheEntry >::iterator it;
+    for ( it = m_EntryMap.begin() ; it != m_EntryMap.end() ; ++it )
+    {
+        it->second.Clear();
+    }
+    m_EntryMap.clear();
+}
+
+const vector< TMesh* > & SnapToCache::GetTMeshVec( Geom* geom )
+{
+    Matrix4d mat = geom->getModelMatrix();
+
+    SnapToCacheEntry & entry = m_EntryMap[ geom->GetID() ];
+
+    bool valid = entry.m_UpdateCount == geom->m_UpdateCount &&
+                 memcmp( entry.m_ModelMatrix.data(), mat.data(), 16 * sizeof( double ) ) == 0;
+
+    // MeshGeom meshes can be changed without an update.
+    if ( geom->GetType().m_Type == MESH_GEOM_TYPE && entry.m_QueryCount != m_QueryCount )
+    {
+        valid = false;
+    }
+
+    if ( valid )
+    {
+        m_Hits++;
+        return entry.m_TMeshVec;
+    }
+
+    m_Misses++;
+
+    entry.Clear();
+    entry.m_UpdateCount = geom->m_UpdateCount;
+    entry.m_QueryCount = m_QueryCount;
+    entry.m_ModelMatrix = mat;
+    entry.m_TMeshVec = geom->CreateTMeshVec();
+
+    for ( int i = 0 ; i < ( int )entry.m_TMeshVec.size() ; i++ )
+    {
+        entry.m_TMeshVec[i]->LoadBndBox();
+    }
+
+    return entry.m_TMeshVec;
+}
+
+void SnapToCache::Prune( Vehicle* veh )
+{
+    map< string, SnapToCacheEntry >::iterator it = m_EntryMap.begin();
+    while ( it != m_EntryMap.end() )
+    {
+        if ( !veh->FindGeom( it->first ) )
+        {
+            it->second.Clear();
+            m_EntryMap.erase( it++ );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+//===============================================================================//
+//===============================================================================//
 
 SnapTo::SnapTo() : ParmContainer()
 {
@@ -61,70 +162,97 @@ void SnapTo::PreventCollision( const string & geom_id, const string & parm_id )
     AdjParmToMinDist( parm_id, inc_flag );
 }
 
-//===== Vectors of TMeshs with Bounding Boxes Already Set Up ====//
-bool SnapTo::CheckIntersect( Geom* geom_ptr, const vector<TMesh*> & other_tmesh_vec )
+//==== Other Geoms In Collision Set, Meshes Owned By The Cache ====//
+void SnapTo::LoadOtherTMeshVec( const string & geom_id, vector< TMesh* > & other_tmesh_vec )
+{
+    other_tmesh_vec.clear();
+
+    Vehicle* veh = VehicleMgr.GetVehicle();
+    vector< string > geom_id_vec = veh->GetGeomSet( m_CollisionSet );
+    for ( int i = 0 ; i < (int)geom_id_vec.size() ; i++ )
+    {
+        if ( geom_id == geom_id_vec[i] )
+            continue;
+
+        Geom* g_ptr = veh->FindGeom( geom_id_vec[i] );
+        if ( g_ptr )
+        {
+            const vector< TMesh* > & tvec = m_Cache.GetTMeshVec( g_ptr );
+            other_tmesh_vec.insert( other_tmesh_vec.end(), tvec.begin(), tvec.end() );
+        }
+    }
+}
+
+void SnapTo::SetParmVal( Parm* parm_ptr, double val )
 {
-    bool intsect_flag = false;
+    parm_ptr->Set( val );
+    VehicleMgr.GetVehicle()->Update( false );
+}
 
-    vector< TMesh* > tmesh_vec = geom_ptr->CreateTMeshVec();
+//===== Vectors of TMeshs with Bounding Boxes Already Set Up ====//
+bool SnapTo::CheckIntersect( const vector< TMesh* > & tmesh_vec, const vector< TMesh* > & other_tmesh_vec )
+{
     for ( int i = 0 ; i < (int)tmesh_vec.size() ; i++ )
     {
-        tmesh_vec[i]->LoadBndBox();
         for ( int j = 0 ; j < (int)other_tmesh_vec.size() ; j++ )
         {
             if ( tmesh_vec[i]->CheckIntersect( other_tmesh_vec[j] ) )
             {
-                    intsect_flag = true;
-                    break;
+                return true;
             }
         }
-        if ( intsect_flag )
-            break;
-    }
-
-    for ( int i = 0 ; i < (int)tmesh_vec.size() ; i++ )
-    {
-        delete tmesh_vec[i];
     }
-
-    return intsect_flag;
+    return false;
 }
 
-//==== Returns Large Neg Number If Error and 0.0 If Collision ====//
-double SnapTo::FindMinDistance( const string & geom_id, const vector< TMesh* > & other_tmesh_vec, bool & intersect_flag )
+//==== Returns 0.0 If Collision ====//
+double SnapTo::FindMinDistance( const vector< TMesh* > & tmesh_vec, const vector< TMesh* > & other_tmesh_vec, bool & intersect_flag )
 {
     intersect_flag = false;
-    Geom* geom_ptr = VehicleMgr.GetVehicle()->FindGeom( geom_id );
-    if ( !geom_ptr )    return -1.0e12;
 
-    if ( CheckIntersect( geom_ptr, other_tmesh_vec ) )
+    if ( CheckIntersect( tmesh_vec, other_tmesh_vec ) )
     {
         intersect_flag = true;
         return 0.0;
     }
 
-    vector< TMesh* > tmesh_vec = geom_ptr->CreateTMeshVec();        // Must Delete!!!
-
     //==== Find Min Dist ====//
     double min_dist = 1.0e12;
     for ( int i = 0 ; i < (int)tmesh_vec.size() ; i++ )
     {
-        tmesh_vec[i]->LoadBndBox();
         for ( int j = 0 ; j < (int)other_tmesh_vec.size() ; j++ )
         {
-            double d =  tmesh_vec[i]->MinDistance(  other_tmesh_vec[j], min_dist );
-            min_dist = min( d, min_dist );
+            min_dist = tmesh_vec[i]->MinDistance( other_tmesh_vec[j], min_dist );
         }
     }
 
-    for ( int i = 0 ; i < (int)tmesh_vec.size() ; i++ )
-    {
-        delete tmesh_vec[i];
-    }
-
     return min_dist;
 }
 
+bool SnapTo::CheckIntersect( const string & geom_id )
+{
+    Geom* geom_ptr = VehicleMgr.GetVehicle()->FindGeom( geom_id );
+    if ( !geom_ptr )    return false;
+
+    vector< TMesh* > other_tmesh_vec;
+    LoadOtherTMeshVec( geom_id, other_tmesh_vec );
+
+    return CheckIntersect( m_Cache.GetTMeshVec( geom_ptr ), other_tmesh_vec );
+}
+
+//==== Returns Large Neg Number If Error and 0.0 If Collision ====//
+double SnapTo::FindMinDistance( const string & geom_id, bool & intersect_flag )
+{
+    intersect_flag = false;
+    Geom* geom_ptr = VehicleMgr.GetVehicle()->FindGeom( geom_id );
+    if ( !geom_ptr )    return -1.0e12;
+
+    vector< TMesh* > other_tmesh_vec;
+    LoadOtherTMeshVec( geom_id, other_tmesh_vec );
+
+    return FindMinDistance( m_Cache.GetTMeshVec( geom_ptr ), other_tmesh_vec, intersect_flag );
+}
+
 //===== Find The Min Distance For Each Point And Returns Max =====//
 double SnapTo::FindMaxMinDistance( const vector< TMesh* > & mesh_vec_1, const vector< TMesh* > & mesh_vec_2 )
 {
@@ -161,30 +289,9 @@ void SnapTo::AdjParmToMinDist( const string & parm_id, bool inc_flag )
 
     Vehicle* veh = VehicleMgr.GetVehicle();
 
-    //==== Find Other Geoms ====//
-    vector< string > geom_id_vec = veh->GetGeomSet( m_CollisionSet );
-    vector< string > other_geom_vec;
-    for ( int i = 0 ; i < (int)geom_id_vec.size() ; i++ )
-    {
-        if ( geom_id != geom_id_vec[i] )
-            other_geom_vec.push_back( geom_id_vec[i] );
-    }
-
-    //==== Create TMeshes =====//
-    vector< TMesh* > other_tmesh_vec;
-    for ( int i = 0 ; i < (int)other_geom_vec.size() ; i++ )
-    {
-        Geom* g_ptr = veh->FindGeom( other_geom_vec[i] );
-        if ( g_ptr )
-        {
-             vector< TMesh* > tvec = g_ptr->CreateTMeshVec();       /////////// MUST DELETE!!!
-             for ( int j = 0 ; j < (int)tvec.size() ; j++ )
-             {
-                tvec[j]->LoadBndBox();
-                other_tmesh_vec.push_back( tvec[j] );
-             }
-        }
-    }
+    //==== Other Geoms Are Tessellated Once And Reused For Every Step ====//
+    m_Cache.Prune( veh );
+    m_Cache.StartQuery();
 
     double direction = 1.0;
     if ( !inc_flag )
@@ -196,8 +303,7 @@ void SnapTo::AdjParmToMinDist( const string & parm_id, bool inc_flag )
     //==== Create Geom TMesh Vec. Adjust Parm And Create Again ====//
     double del_val = 0.01;
     vector< TMesh* > tmesh_orig = geom_ptr->CreateTMeshVec();       // Must Delete
-    parm_ptr->Set( orig_val + del_val );
-    VehicleMgr.GetVehicle()->Update( false );
+    SetParmVal( parm_ptr, orig_val + del_val );
     vector< TMesh* > tmesh_adj  = geom_ptr->CreateTMeshVec();       // Must Delete
 
     double max_min = FindMaxMinDistance( tmesh_orig, tmesh_adj );   // Find Max Dist Change Of Mesh 
@@ -210,8 +316,9 @@ void SnapTo::AdjParmToMinDist( const string & parm_id, bool inc_flag )
         delete tmesh_adj[i];
 
     //==== Restore Value ====//
-    parm_ptr->Set( orig_val );                                     
-    veh->Update( false );
+    SetParmVal( parm_ptr, orig_val );
+
+    bool iflag;
 
    //==== Check If Current Input Matches Last Input ====//
     if ( (parm_id == m_LastParmID) && (inc_flag == m_LastIncFlag)  )
@@ -220,15 +327,13 @@ void SnapTo::AdjParmToMinDist( const string & parm_id, bool inc_flag )
         {
             if ( std::abs( m_LastParmVal - orig_val ) < 1.0e-12 )
             {
-                bool iflag;
-                double d = FindMinDistance( geom_id, other_tmesh_vec, iflag );
+                double d = FindMinDistance( geom_id, iflag );
                 if ( !iflag && std::abs( d - m_LastMinDist ) < 1.0e-12 )
                 {
                     //==== Nudge Parm In Inc Direction To Make Sure Collision ====//
                     double nudge = 2.0*m_LastMinDist*del_val/max_min;
-                    parm_ptr->Set( parm_ptr->Get() + direction*nudge );
+                    SetParmVal( parm_ptr, parm_ptr->Get() + direction*nudge );
                     orig_val = parm_ptr->Get();
-                    veh->Update( false );
                 }
             }
         }
@@ -250,11 +355,10 @@ void SnapTo::AdjParmToMinDist( const string & parm_id, bool inc_flag )
     val_range = min( std::abs(limit - orig_val), val_range );
 
     //==== Move Geom Close To Other Body In Correct Direction ====//
-    int cnt = 0;
     double v_in  = orig_val;
     double v_out = orig_val;       
 
-    bool init_col_flag = CheckIntersect( geom_ptr, other_tmesh_vec );
+    bool init_col_flag = CheckIntersect( geom_id );
 
     //==== Step Forward To Find First Opposite of Collision Flag (col_flag)      ====//
     //==== This Could Be Faster But Might Skip Over Possible Solns (Still Might) ====//
@@ -263,9 +367,8 @@ void SnapTo::AdjParmToMinDist( const string & parm_id, bool inc_flag )
     {
         double fract = (double)(i*i)/400.0;     // Closer Spaced Near Init Point
         double val = orig_val + direction*val_range*fract;
-        parm_ptr->Set( val );
-        veh->Update( false );
-        bool col_flag =  CheckIntersect( geom_ptr, other_tmesh_vec );
+        SetParmVal( parm_ptr, val );
+        bool col_flag = CheckIntersect( geom_id );
 
         if ( !col_flag )
         {
@@ -294,101 +397,109 @@ void SnapTo::AdjParmToMinDist( const string & parm_id, bool inc_flag )
             m_CollisionErrorFlag = vsp::COLLISION_INTERSECT_NO_SOLUTION;
         else
             m_CollisionErrorFlag = vsp::COLLISION_CLEAR_NO_SOLUTION;
-        parm_ptr->Set( revert_val );              // Restore Val
-        veh->Update( false );
-        for ( int i = 0 ; i < (int)other_tmesh_vec.size() ; i++ )
-            delete other_tmesh_vec[i];
+        SetParmVal( parm_ptr, revert_val );              // Restore Val
         return;
     }
 
-    //==== Use BiSection To Refine In/Out Solutions ====//
-    for ( int i = 0 ; i < 5 ; i++ )
-    {
-        double val = (v_in + v_out)*0.5;
-        parm_ptr->Set( val );
-        veh->Update( false );
-        bool col_flag =  CheckIntersect( geom_ptr, other_tmesh_vec );
+    //==== Bracket MinDist = Target Between v_in (Intersecting) And A Val Clear Of Target ====//
+    double target = m_CollisionTargetDist();
 
-        if( col_flag )
-            v_in = val;
-        else
-            v_out = val;
+    if ( std::abs( parm_ptr->Get() - v_out ) > DBL_EPSILON )
+    {
+        SetParmVal( parm_ptr, v_out );
     }
+    double f_out = FindMinDistance( geom_id, iflag ) - target;
 
-    //==== Find Del Min Dist to Del Val And Iterate Soln ====//
-    bool iflag;
-    double v0 = v_out;
-    double closest_err = 1.0e12;
-    for ( int i = 0 ; i < 5 ; i++ )
-    {
-        parm_ptr->Set( v0 );
-        veh->Update( false );
-        double d0 = FindMinDistance( geom_id, other_tmesh_vec, iflag );
+    double v_lo = v_in;
+    double f_lo = -target;
+    double v_hi = v_out;
+    double f_hi = f_out;
+
+    double best_val = v_out;
+    double best_err = std::abs( f_out );
 
-        //==== Check For Intersect ====//
-        if ( iflag )
+    //==== Step Away From v_in While Still Closer Than Target ====//
+    double step = v_out - v_in;
+    for ( int i = 0 ; i < 20 && f_hi < 0.0 ; i++ )
+    {
+        double val = v_hi + step;
+        if ( val > parm_ptr->GetUpperLimit() || val < parm_ptr->GetLowerLimit() )
+        {
             break;
+        }
+
+        v_lo = v_hi;
+        f_lo = f_hi;
+        v_hi = val;
+        step *= 2.0;
+
+        SetParmVal( parm_ptr, v_hi );
+        f_hi = FindMinDistance( geom_id, iflag ) - target;
 
-        //==== Save Best Soln ====//
-        double err = std::abs( d0 - m_CollisionTargetDist() );
-        if ( err < closest_err )
+        if ( !iflag && std::abs( f_hi ) < best_err )
         {
-            v_out = v0;
-            closest_err = err;
+            best_val = v_hi;
+            best_err = std::abs( f_hi );
+        }
+    }
 
-            //==== Good Enough Soln? ====//
-            if ( closest_err < 1.0e-06*model_size ) 
-            {
-                break;
-            }
+    //==== Bisection, Taking The Secant Guess When It Lands Well Inside The Bracket ====//
+    for ( int i = 0 ; i < 50 && f_hi >= 0.0 && best_err >= 1.0e-06*model_size ; i++ )
+    {
+        double width = v_hi - v_lo;
+        if ( std::abs( width ) < 1.0e-12*max( 1.0, std::abs( v_hi ) ) )
+        {
+            break;
         }
 
-        //==== Slightly Offset v_out ====// 
-        double v1 = (v_out - v_in)*0.0001 + v_out;        // Away From v_in
-        parm_ptr->Set( v1 );
-        veh->Update( false );
-        double d1 = FindMinDistance( geom_id, other_tmesh_vec, iflag );
+        double val = v_lo + 0.5*width;
 
-        //==== Check For Intersect ====//
-        if ( iflag )
-            break;
+        double denom = f_hi - f_lo;
+        if ( denom > 1.0e-12 )
+        {
+            double s = -f_lo/denom;
+            if ( s > 0.1 && s < 0.9 )
+            {
+                val = v_lo + s*width;
+            }
+        }
 
-        double denom = d1 - d0;
-        if ( std::abs( denom ) < 1.0e-12 )
-            break;
+        SetParmVal( parm_ptr, val );
+        double f = FindMinDistance( geom_id, iflag ) - target;
 
-        double fract = ( m_CollisionTargetDist() - d0 )/denom;
-        double val = v0 + fract*(v1 - v0);
+        if ( !iflag && std::abs( f ) < best_err )
+        {
+            best_val = val;
+            best_err = std::abs( f );
+        }
 
-        //==== Check If Predicted Point Intersects ====//
-        parm_ptr->Set( val );
-        veh->Update( false );
-        if ( CheckIntersect( geom_ptr, other_tmesh_vec ) )
+        if ( f < 0.0 )
         {
-            val = v0 + 0.5*fract*(v1 - v0);         // Only go half way            
+            v_lo = val;
+            f_lo = f;
+        }
+        else
+        {
+            v_hi = val;
+            f_hi = f;
         }
-        v0 = val;
     }
 
-    //==== Best Soln is v_out ====//
-    if ( std::abs( parm_ptr->Get() - v_out ) < DBL_EPSILON )
+    //==== Best Soln Is best_val ====//
+    if ( std::abs( parm_ptr->Get() - best_val ) < DBL_EPSILON )
     {
         geom_ptr->ParmChanged( parm_ptr, Parm::SET );
     }
     else
     {
-        parm_ptr->Set( v_out );
+        parm_ptr->Set( best_val );
     }
 
     veh->Update( true );
 
-    m_CollisionMinDist = FindMinDistance( geom_id, other_tmesh_vec, iflag );
+    m_CollisionMinDist = FindMinDistance( geom_id, iflag );
     m_CollisionErrorFlag = vsp::COLLISION_OK;
 
-    //==== Delete Created TMeshes ====//
-    for ( int i = 0 ; i < (int)other_tmesh_vec.size() ; i++ )
-        delete other_tmesh_vec[i];
-
     //==== Store Last Results ====//
     m_LastParmID = parm_id;
     m_LastParmVal = parm_ptr->Get();
@@ -410,39 +521,10 @@ void SnapTo::CheckClearance( )
 
     Geom* geom_ptr = select_vec[0];
     if ( !geom_ptr )    return;
-    string geom_id = geom_ptr->GetID();
- 
-    //==== Find Other Geoms ====//
-    vector< string > geom_id_vec = veh->GetGeomSet( m_CollisionSet );
-    vector< string > other_geom_vec;
-    for ( int i = 0 ; i < (int)geom_id_vec.size() ; i++ )
-    {
-        if ( geom_id != geom_id_vec[i] )
-            other_geom_vec.push_back( geom_id_vec[i] );
-    }
 
-    //==== Create TMeshes =====//
-    vector< TMesh* > other_tmesh_vec;
-    for ( int i = 0 ; i < (int)other_geom_vec.size() ; i++ )
-    {
-        Geom* g_ptr = veh->FindGeom( other_geom_vec[i] );
-        if ( g_ptr )
-        {
-             vector< TMesh* > tvec = g_ptr->CreateTMeshVec();       /////////// MUST DELETE!!!
-             for ( int j = 0 ; j < (int)tvec.size() ; j++ )
-             {
-                tvec[j]->LoadBndBox();
-                other_tmesh_vec.push_back( tvec[j] );
-             }
-        }
-    }
+    m_Cache.Prune( veh );
+    m_Cache.StartQuery();
 
     bool iflag;
-    m_CollisionMinDist = FindMinDistance( geom_id, other_tmesh_vec, iflag );
-
-    //==== Delete Created TMeshes ====//
-    for ( int i = 0 ; i < (int)other_tmesh_vec.size() ; i++ )
-        delete other_tmesh_vec[i];
-
-
-}
\ No newline at end of file
+    m_CollisionMinDist = FindMinDistance( geom_ptr->GetID(), iflag );
+}
@@ -15,6 +15,62 @@
 #include "ParmContainer.h"
 #include "TMesh.h"
 
+#include <map>
+
+class Geom;
+class Vehicle;
+
+//==== Cached TMeshes Of One Geom, Bounding Hierarchies Loaded ====//
+class SnapToCacheEntry
+{
+public:
+    SnapToCacheEntry();
+
+    // Entries are copied in and out of the cache map, so the meshes are only
+    // deleted here and never in a destructor.
+    void Clear();
+
+    int m_UpdateCount;
+    int m_QueryCount;
+    Matrix4d m_ModelMatrix;
+    vector< TMesh* > m_TMeshVec;
+};
+
+//==== Per Geom TMesh Cache For Collision And Clearance Queries ====//
+// A Geom's meshes are kept with the Geom update count and model matrix they
+// were built for, so Geoms that do not move are only tessellated once over
+// any number of snap steps and clearance checks.  MeshGeom meshes can be
+// changed without an update, so they are only reused within one query.
+class SnapToCache
+{
+public:
+    SnapToCache();
+    virtual ~SnapToCache();
+
+    virtual void Clear();
+
+    // Start of a snap or clearance check.
+    virtual void StartQuery()
+    {
+        m_QueryCount++;
+    }
+
+    // Meshes stay owned by the cache and are valid until the next call for
+    // the same Geom.
+    virtual const vector< TMesh* > & GetTMeshVec( Geom* geom );
+
+    // Drop entries for Geoms no longer in the vehicle.
+    virtual void Prune( Vehicle* veh );
+
+    int m_Hits;
+    int m_Misses;
+
+protected:
+
+    map< string, SnapToCacheEntry > m_EntryMap;           // Keyed by Geom ID
+    int m_QueryCount;
+};
+
 //==== SnapTo ====//
 class SnapTo : public ParmContainer
 {
@@ -24,12 +80,28 @@ public:
     virtual void ParmChanged( Parm* parm_ptr, int type );
 
     void PreventCollision( const string & geom_id, const string & parm_id );
-    static double FindMinDistance(const string & geom_id, const vector< TMesh* > & other_tmesh_vec, bool & intersect_flag );
+
+    //==== Against The Other Geoms In The Collision Set ====//
+    // Returns large neg number if error and 0.0 if collision
+    double FindMinDistance( const string & geom_id, bool & intersect_flag );
+    bool CheckIntersect( const string & geom_id );
+
+    //==== Meshes With Bounding Hierarchies Already Loaded ====//
+    static double FindMinDistance( const vector< TMesh* > & tmesh_vec, const vector< TMesh* > & other_tmesh_vec, bool & intersect_flag );
+    static bool CheckIntersect( const vector< TMesh* > & tmesh_vec, const vector< TMesh* > & other_tmesh_vec );
+
     static double FindMaxMinDistance( const vector< TMesh* > & mesh_1, const vector< TMesh* > & mesh_2 );
-    static bool CheckIntersect( Geom* geom_ptr, const vector<TMesh*> & other_tmesh_vec );
     void AdjParmToMinDist( const string & parm_id, bool inc_flag );
     void CheckClearance(  );
 
+    void ClearCache()
+    {
+        m_Cache.Clear();
+    }
+    SnapToCache* GetCachePtr()
+    {
+        return &m_Cache;
+    }
 
     //==== Collision Stuff ====//
     BoolParm m_CollisionDetection;
@@ -40,6 +112,12 @@ public:
 
 protected:
 
+    // Meshes of the other Geoms in the collision set, from the cache.
+    void LoadOtherTMeshVec( const string & geom_id, vector< TMesh* > & other_tmesh_vec );
+    void SetParmVal( Parm* parm_ptr, double val );
+
+    SnapToCache m_Cache;
+
     //===== Store Last Values ====//
     string m_LastParmID;
     double m_LastParmVal;
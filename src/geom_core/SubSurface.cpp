@@ -25,6 +25,7 @@ SubSurface::SubSurface( const string& compID, int type )
     m_Tag = 0;
     m_LineColor = vec3d( 0, 0, 0 );
     m_PolyPntsReadyFlag = false;
+    m_PendingDrawObjs = false;
     m_FirstSplit = true;
     m_PolyFlag = true;
 
@@ -111,6 +112,8 @@ void SubSurface::SetDisplaySuffix( int num )
 
 void SubSurface::LoadDrawObjs( std::vector< DrawObj* > & draw_obj_vec )
 {
+    UpdatePendingDrawObjs();
+
     m_SubSurfDO.m_LineColor = m_LineColor;
 
     draw_obj_vec.push_back( &m_SubSurfDO );
@@ -124,6 +127,8 @@ void SubSurface::LoadPartialColoredDrawObjs( const string & ss_id, int surf_num,
         return;
     }
 
+    UpdatePendingDrawObjs();
+
     m_SubSurfHighlightDO[surf_num].m_LineColor = color;
     m_SubSurfHighlightDO[surf_num].m_GeomID = (m_ID + to_string((long long)surf_num));
     draw_obj_vec.push_back(&m_SubSurfHighlightDO[surf_num]);
@@ -198,7 +203,26 @@ void SubSurface::Update()
     UpdateOrientation();
 
     m_PolyPntsReadyFlag = false;
+
+    // Nothing is drawn in headless runs until something asks.
+    Vehicle* veh = VehicleMgr.GetVehicle();
+    if ( veh && veh->IsHeadless() )
+    {
+        m_PendingDrawObjs = true;
+        return;
+    }
+
     UpdateDrawObjs();
+    m_PendingDrawObjs = false;
+}
+
+void SubSurface::UpdatePendingDrawObjs()
+{
+    if ( m_PendingDrawObjs )
+    {
+        UpdateDrawObjs();
+        m_PendingDrawObjs = false;
+    }
 }
 
 void SubSurface::UpdateOrientation()
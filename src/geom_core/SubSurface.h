@@ -128,6 +128,7 @@ public:
     virtual void UpdatePolygonPnts();
     virtual std::vector< TMesh* > CreateTMeshVec() const; // Method to create a TMeshVector
     virtual void UpdateDrawObjs(); // Method to create lines to draw
+    virtual void UpdatePendingDrawObjs(); // Draw objects left by a headless Update
     virtual void SplitSegsU( const double & u ); // Split line segments that cross a constant U value
     virtual void SplitSegsW( const double & w ); // Split line segments that cross a constant W value
     virtual void SplitSegsU( const double & u, vector<SSLineSeg> &splitvec ); // Split line segments that cross a constant U value
@@ -176,6 +177,7 @@ protected:
     //std::vector< vec2d > m_PolyPnts;
     std::vector< std::vector< vec2d > > m_PolyPntsVec;
     bool m_PolyPntsReadyFlag;
+    bool m_PendingDrawObjs;
     bool m_FirstSplit;
     bool m_PolyFlag; // Flag to indicate if the SubSurface is a Polygon ( this affects how it is treated in CFDMesh )
 
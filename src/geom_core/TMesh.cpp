@@ -24,6 +24,8 @@
 #include "Geom.h"
 #include "SubSurfaceMgr.h"
 #include "PntNodeMerge.h"
+#include "ExportWriter.h"
+#include "MeshTopology.h"
 #include "VspCurve.h" // for #define TMAGIC
 
 #include "triangle.h"
@@ -31,6 +33,20 @@
 
 
 #include <math.h>
+#include <deque>
+
+//==== Triangle Computes Its Exact Arithmetic Constants With The First Context ====//
+// Done here at load time, before any parallel region can create contexts.
+class TriangleLibInit
+{
+public:
+    TriangleLibInit()
+    {
+        triangle_context_destroy( triangle_context_create() );
+    }
+};
+
+static TriangleLibInit s_TriangleLibInit;
 
 //===============================================//
 //                  TNode
@@ -388,6 +404,9 @@ TMesh::TMesh()
     m_SurfNum = 0;
     m_AreaCenter = vec3d(0,0,0);
     m_GuessVol = 0;
+    m_CacheID = -1;
+    m_InsideWords = 0;
+    m_NumInsideMeshes = 0;
 }
 
 TMesh::~TMesh()
@@ -457,7 +476,7 @@ void TMesh::CopyFlatten( TMesh* m )
                 if ( !s_tri->m_IgnoreTriFlag )
                 {
                     AddTri( s_tri->m_N0, s_tri->m_N1, s_tri->m_N2, s_tri->m_Norm );
-                    m_TVec.back()->m_Tags = s_tri->m_Tags;
+                    m_TVec.back()->m_TagIndex = s_tri->m_TagIndex;
                 }
             }
         }
@@ -466,7 +485,7 @@ void TMesh::CopyFlatten( TMesh* m )
             if ( !orig_tri->m_IgnoreTriFlag )
             {
                 AddTri( orig_tri->m_N0, orig_tri->m_N1, orig_tri->m_N2, orig_tri->m_Norm );
-                m_TVec.back()->m_Tags = orig_tri->m_Tags;
+                m_TVec.back()->m_TagIndex = orig_tri->m_TagIndex;
             }
         }
     }
@@ -505,7 +524,7 @@ xmlNodePtr TMesh::EncodeXml( xmlNodePtr & node )
 {
     xmlNodePtr tmesh_node = xmlNewChild( node, NULL, BAD_CAST "TMesh", NULL );
     XmlUtil::AddIntNode( tmesh_node, "Num_Tris", ( int )m_TVec.size() );
-    EncodeTriList( tmesh_node );
+    EncodeTriData( tmesh_node );
     return tmesh_node;
 }
 
@@ -525,18 +544,301 @@ xmlNodePtr TMesh::EncodeTriList( xmlNodePtr & node )
     return tri_list_node;
 }
 
+//==== Order Tri Corners By Coordinates, Then By Corner ====//
+class CornerPntLess
+{
+public:
+    CornerPntLess( const vector< TTri* > & tvec ) : m_TVec( tvec ) {}
+
+    const vec3d & Pnt( int c ) const
+    {
+        TTri* tri = m_TVec[ c / 3 ];
+        return ( c % 3 == 0 ) ? tri->m_N0->m_Pnt : ( ( c % 3 == 1 ) ? tri->m_N1->m_Pnt : tri->m_N2->m_Pnt );
+    }
+
+    bool operator()( int a, int b ) const
+    {
+        const vec3d & pa = Pnt( a );
+        const vec3d & pb = Pnt( b );
+        for ( int i = 0 ; i < 3 ; i++ )
+        {
+            if ( pa[i] != pb[i] )
+            {
+                return pa[i] < pb[i];
+            }
+        }
+        return a < b;
+    }
+
+    const vector< TTri* > & m_TVec;
+};
+
+xmlNodePtr TMesh::EncodeTriData( xmlNodePtr & node )
+{
+    xmlNodePtr tri_data_node = xmlNewChild( node, NULL, BAD_CAST "Tri_Data", NULL );
+
+    int num_corner = 3 * m_TVec.size();
+
+    //==== Do Any Tris Share Node Objects? ====//
+    vector< TNode* > corner_ptr_vec( num_corner );
+    for ( int i = 0 ; i < ( int )m_TVec.size() ; i++ )
+    {
+        corner_ptr_vec[ 3 * i ] = m_TVec[i]->m_N0;
+        corner_ptr_vec[ 3 * i + 1 ] = m_TVec[i]->m_N1;
+        corner_ptr_vec[ 3 * i + 2 ] = m_TVec[i]->m_N2;
+    }
+    vector< TNode* > unique_ptr_vec = corner_ptr_vec;
+    std::sort( unique_ptr_vec.begin(), unique_ptr_vec.end() );
+    bool shared_flag = std::unique( unique_ptr_vec.begin(), unique_ptr_vec.end() ) != unique_ptr_vec.end();
+
+    //==== Group Corners Into Stored Nodes ====//
+    // Shared meshes keep their node objects.  Otherwise every corner has its
+    // own node, and corners at identical coordinates are stored once and
+    // split apart again when read.
+    vector< int > group_vec( num_corner );
+    if ( shared_flag )
+    {
+        map< TNode*, int > node_group_map;
+        for ( int c = 0 ; c < num_corner ; c++ )
+        {
+            map< TNode*, int >::iterator it = node_group_map.find( corner_ptr_vec[c] );
+            if ( it == node_group_map.end() )
+            {
+                node_group_map[ corner_ptr_vec[c] ] = c;
+                group_vec[c] = c;
+            }
+            else
+            {
+                group_vec[c] = it->second;
+            }
+        }
+    }
+    else
+    {
+        vector< int > order_vec( num_corner );
+        for ( int c = 0 ; c < num_corner ; c++ )
+        {
+            order_vec[c] = c;
+        }
+        CornerPntLess less( m_TVec );
+        std::sort( order_vec.begin(), order_vec.end(), less );
+
+        for ( int k = 0 ; k < num_corner ; k++ )
+        {
+            if ( k > 0 && less.Pnt( order_vec[k] ) == less.Pnt( order_vec[k - 1] ) )
+            {
+                group_vec[ order_vec[k] ] = group_vec[ order_vec[k - 1] ];
+            }
+            else
+            {
+                group_vec[ order_vec[k] ] = order_vec[k];   // First corner in the group
+            }
+        }
+    }
+
+    //==== Number Nodes In Order Of First Use ====//
+    vector< int > node_index_vec( num_corner, -1 );
+    vector< double > pnt_vec;
+    vector< int > tri_vec( num_corner );
+    vector< double > norm_vec( num_corner );
+
+    //==== Tag Combinations Local To This Mesh ====//
+    map< int, int > tag_index_map;
+    vector< int > tag_combo_vec;
+    vector< int > tri_tag_vec( m_TVec.size() );
+    bool tag_flag = false;
+
+    for ( int i = 0 ; i < ( int )m_TVec.size() ; i++ )
+    {
+        TTri* tri = m_TVec[i];
+
+        for ( int j = 0 ; j < 3 ; j++ )
+        {
+            int c = 3 * i + j;
+            int g = group_vec[c];
+            if ( node_index_vec[g] < 0 )
+            {
+                node_index_vec[g] = pnt_vec.size() / 3;
+                const vec3d & pnt = corner_ptr_vec[c]->m_Pnt;
+                pnt_vec.push_back( pnt.x() );
+                pnt_vec.push_back( pnt.y() );
+                pnt_vec.push_back( pnt.z() );
+            }
+            tri_vec[c] = node_index_vec[g];
+            norm_vec[c] = tri->m_Norm[j];
+        }
+
+        map< int, int >::iterator tit = tag_index_map.find( tri->m_TagIndex );
+        if ( tit == tag_index_map.end() )
+        {
+            const vector< int > & tags = tri->GetTags();
+            int index = tag_index_map.size();
+            tag_index_map[ tri->m_TagIndex ] = index;
+            tag_combo_vec.push_back( tags.size() );
+            tag_combo_vec.insert( tag_combo_vec.end(), tags.begin(), tags.end() );
+            tri_tag_vec[i] = index;
+            tag_flag = tag_flag || !tags.empty();
+        }
+        else
+        {
+            tri_tag_vec[i] = tit->second;
+        }
+    }
+
+    XmlUtil::AddIntNode( tri_data_node, "Shared_Nodes", shared_flag );
+    XmlUtil::AddIntNode( tri_data_node, "Num_Nodes", ( int )pnt_vec.size() / 3 );
+    XmlUtil::AddVectorDoubleBase64Node( tri_data_node, "Nodes", pnt_vec );
+    XmlUtil::AddVectorIntBase64Node( tri_data_node, "Tris", tri_vec );
+    XmlUtil::AddVectorDoubleBase64Node( tri_data_node, "Norms", norm_vec );
+
+    if ( tag_flag )
+    {
+        XmlUtil::AddVectorIntBase64Node( tri_data_node, "Tag_Combos", tag_combo_vec );
+        XmlUtil::AddVectorIntBase64Node( tri_data_node, "Tri_Tags", tri_tag_vec );
+    }
+
+    return tri_data_node;
+}
+
+//==== Returns False And Leaves The Mesh Empty If The Arrays Do Not Agree ====//
+bool TMesh::DecodeTriData( xmlNodePtr & node, int expected_tris )
+{
+    vector< double > pnt_vec = XmlUtil::ExtractVectorDoubleBase64Node( node, "Nodes" );
+    vector< int > tri_vec = XmlUtil::ExtractVectorIntBase64Node( node, "Tris" );
+    vector< double > norm_vec = XmlUtil::ExtractVectorDoubleBase64Node( node, "Norms" );
+
+    int num_nodes = pnt_vec.size() / 3;
+    int num_tris = tri_vec.size() / 3;
+
+    if ( pnt_vec.size() % 3 || tri_vec.size() % 3 || norm_vec.size() != tri_vec.size() )
+    {
+        return false;
+    }
+
+    if ( expected_tris >= 0 && num_tris != expected_tris )
+    {
+        return false;
+    }
+
+    for ( int i = 0 ; i < ( int )tri_vec.size() ; i++ )
+    {
+        if ( tri_vec[i] < 0 || tri_vec[i] >= num_nodes )
+        {
+            return false;
+        }
+    }
+
+    //==== Tags Are Optional ====//
+    vector< int > tag_index_vec;
+    vector< int > tri_tag_vec = XmlUtil::ExtractVectorIntBase64Node( node, "Tri_Tags" );
+    if ( ( int )tri_tag_vec.size() == num_tris )
+    {
+        vector< int > tag_combo_vec = XmlUtil::ExtractVectorIntBase64Node( node, "Tag_Combos" );
+        int k = 0;
+        while ( k < ( int )tag_combo_vec.size() )
+        {
+            int ntag = tag_combo_vec[k];
+            if ( ntag < 0 || k + 1 + ntag > ( int )tag_combo_vec.size() )
+            {
+                break;
+            }
+            vector< int > tags( tag_combo_vec.begin() + k + 1, tag_combo_vec.begin() + k + 1 + ntag );
+            tag_index_vec.push_back( TTriTable::InternTags( tags ) );
+            k += 1 + ntag;
+        }
+
+        for ( int i = 0 ; i < num_tris ; i++ )
+        {
+            if ( tri_tag_vec[i] < 0 || tri_tag_vec[i] >= ( int )tag_index_vec.size() )
+            {
+                tag_index_vec.clear();
+                break;
+            }
+        }
+    }
+
+    bool shared_flag = !!XmlUtil::FindInt( node, "Shared_Nodes", 0 );
+
+    if ( shared_flag )
+    {
+        m_NVec.resize( num_nodes );
+        for ( int i = 0 ; i < num_nodes ; i++ )
+        {
+            m_NVec[i] = new TNode();
+            m_NVec[i]->m_Pnt.set_xyz( pnt_vec[ 3 * i ], pnt_vec[ 3 * i + 1 ], pnt_vec[ 3 * i + 2 ] );
+        }
+    }
+    else
+    {
+        m_NVec.resize( tri_vec.size() );
+        for ( int c = 0 ; c < ( int )tri_vec.size() ; c++ )
+        {
+            int n = tri_vec[c];
+            m_NVec[c] = new TNode();
+            m_NVec[c]->m_Pnt.set_xyz( pnt_vec[ 3 * n ], pnt_vec[ 3 * n + 1 ], pnt_vec[ 3 * n + 2 ] );
+        }
+    }
+
+    m_TVec.resize( num_tris );
+    for ( int i = 0 ; i < num_tris ; i++ )
+    {
+        TTri* tri = new TTri( this );
+        if ( shared_flag )
+        {
+            tri->m_N0 = m_NVec[ tri_vec[ 3 * i ] ];
+            tri->m_N1 = m_NVec[ tri_vec[ 3 * i + 1 ] ];
+            tri->m_N2 = m_NVec[ tri_vec[ 3 * i + 2 ] ];
+        }
+        else
+        {
+            tri->m_N0 = m_NVec[ 3 * i ];
+            tri->m_N1 = m_NVec[ 3 * i + 1 ];
+            tri->m_N2 = m_NVec[ 3 * i + 2 ];
+        }
+        tri->m_Norm.set_xyz( norm_vec[ 3 * i ], norm_vec[ 3 * i + 1 ], norm_vec[ 3 * i + 2 ] );
+
+        if ( !tag_index_vec.empty() )
+        {
+            tri->m_TagIndex = tag_index_vec[ tri_tag_vec[i] ];
+        }
+        m_TVec[i] = tri;
+    }
+
+    return true;
+}
+
 void TMesh::DecodeXml( xmlNodePtr & node )
 {
+    int num_tris = -1;
+    xmlNodePtr num_tri_node = XmlUtil::GetNode( node, "Num_Tris", 0 );
+    if ( num_tri_node )
+    {
+        num_tris = XmlUtil::ExtractInt( num_tri_node );
+    }
+
     xmlNodePtr tri_list_node = XmlUtil::GetNode( node, "Tri_List", 0 );
-    if ( tri_list_node )
+
+    xmlNodePtr tri_data_node = XmlUtil::GetNode( node, "Tri_Data", 0 );
+    if ( tri_data_node )
     {
-        int num_tris = 0;
-        xmlNodePtr num_tri_node = XmlUtil::GetNode( node, "Num_Tris", 0 );
-        if ( num_tri_node )
+        if ( DecodeTriData( tri_data_node, num_tris ) )
+        {
+            return;
+        }
+
+        if ( tri_list_node )
         {
-            num_tris = XmlUtil::ExtractInt( num_tri_node );
+            fprintf( stderr, "TMesh::DecodeXml: invalid Tri_Data, reading Tri_List\n" );
         }
         else
+        {
+            fprintf( stderr, "TMesh::DecodeXml: invalid Tri_Data, mesh is empty\n" );
+        }
+    }
+
+    if ( tri_list_node )
+    {
+        if ( num_tris < 0 )
         {
             num_tris = XmlUtil::GetNumNames( tri_list_node, "Tri" );
         }
@@ -617,6 +919,7 @@ void TMesh::RemoveIsectEdges()
             delete tri->m_ISectEdgeVec[e];
         }
         tri->m_ISectEdgeVec.erase( tri->m_ISectEdgeVec.begin(), tri->m_ISectEdgeVec.end() );
+        tri->m_ISectFlag = false;
     }
 }
 
@@ -756,6 +1059,8 @@ void TMesh::MergeNonClosed( TMesh* tm )
 
 void TMesh::MergeTMeshes( TMesh* tm )
 {
+    m_CacheID = -1;
+
     for ( int t = 0 ; t < ( int )tm->m_TVec.size() ; t++ )
     {
         TTri* tri = tm->m_TVec[t];
@@ -772,25 +1077,355 @@ void TMesh::MergeTMeshes( TMesh* tm )
 
 void TMesh::Intersect( TMesh* tm, bool UWFlag )
 {
-    m_TBox.Intersect( &tm->m_TBox, UWFlag );
+    vector< pair< int, int > > leafPairVec;
+    m_Bvh.FindLeafPairs( tm->m_Bvh, leafPairVec );
+
+    for ( int p = 0 ; p < ( int )leafPairVec.size() ; p++ )
+    {
+        const TBvhNode & n0 = m_Bvh.m_NodeVec[ leafPairVec[p].first ];
+        const TBvhNode & n1 = tm->m_Bvh.m_NodeVec[ leafPairVec[p].second ];
+
+        for ( int i = n0.m_Start ; i < n0.m_Start + n0.m_Count ; i++ )
+        {
+            TTri* t0 = m_TVec[ m_Bvh.m_TriIndex[i] ];
+            for ( int j = n1.m_Start ; j < n1.m_Start + n1.m_Count ; j++ )
+            {
+                TBndBox::IntersectTris( t0, tm->m_TVec[ tm->m_Bvh.m_TriIndex[j] ], UWFlag );
+            }
+        }
+    }
+}
+
+void TMesh::FindISectSegs( TMesh* tm, vector< TISectSeg > & segVec )
+{
+    vector< pair< int, int > > leafPairVec;
+    m_Bvh.FindLeafPairs( tm->m_Bvh, leafPairVec );
+
+    for ( int p = 0 ; p < ( int )leafPairVec.size() ; p++ )
+    {
+        const TBvhNode & n0 = m_Bvh.m_NodeVec[ leafPairVec[p].first ];
+        const TBvhNode & n1 = tm->m_Bvh.m_NodeVec[ leafPairVec[p].second ];
+
+        for ( int i = n0.m_Start ; i < n0.m_Start + n0.m_Count ; i++ )
+        {
+            TTri* t0 = m_TVec[ m_Bvh.m_TriIndex[i] ];
+            for ( int j = n1.m_Start ; j < n1.m_Start + n1.m_Count ; j++ )
+            {
+                TTri* t1 = tm->m_TVec[ tm->m_Bvh.m_TriIndex[j] ];
+
+                int coplanarFlag = 0; // Must be initialized to 0 before use in tri_tri_intersection_test_3d
+                TISectSeg seg;
+
+                int iflag = tri_tri_intersection_test_3d(
+                                t0->m_N0->m_Pnt.v, t0->m_N1->m_Pnt.v, t0->m_N2->m_Pnt.v,
+                                t1->m_N0->m_Pnt.v, t1->m_N1->m_Pnt.v, t1->m_N2->m_Pnt.v,
+                                &coplanarFlag, seg.m_E0.v, seg.m_E1.v );
+
+                if ( iflag && !coplanarFlag )
+                {
+                    seg.m_T0 = m_Bvh.m_TriIndex[i];
+                    seg.m_T1 = tm->m_Bvh.m_TriIndex[j];
+                    segVec.push_back( seg );
+                }
+            }
+        }
+    }
+}
+
+void TMesh::AddISectSegs( TMesh* tm, const vector< TISectSeg > & segVec )
+{
+    for ( int i = 0 ; i < ( int )segVec.size() ; i++ )
+    {
+        TBndBox::AddISectEdges( m_TVec[ segVec[i].m_T0 ], tm->m_TVec[ segVec[i].m_T1 ], segVec[i].m_E0, segVec[i].m_E1 );
+    }
+}
+
+void TMesh::AddOwnISectSegs( const vector< TISectSeg > & segVec )
+{
+    for ( int i = 0 ; i < ( int )segVec.size() ; i++ )
+    {
+        TBndBox::AddISectEdge( m_TVec[ segVec[i].m_T0 ], segVec[i].m_E0, segVec[i].m_E1 );
+    }
 }
 
 bool TMesh::CheckIntersect( TMesh* tm )
 {
-    return m_TBox.CheckIntersect( &tm->m_TBox );
+    vector< pair< int, int > > leafPairVec;
+    m_Bvh.FindLeafPairs( tm->m_Bvh, leafPairVec );
+
+    int coplanarFlag = 0; // Must be initialized to 0 before use in tri_tri_intersection_test_3d
+    vec3d e0;
+    vec3d e1;
+
+    for ( int p = 0 ; p < ( int )leafPairVec.size() ; p++ )
+    {
+        const TBvhNode & n0 = m_Bvh.m_NodeVec[ leafPairVec[p].first ];
+        const TBvhNode & n1 = tm->m_Bvh.m_NodeVec[ leafPairVec[p].second ];
+
+        for ( int i = n0.m_Start ; i < n0.m_Start + n0.m_Count ; i++ )
+        {
+            TTri* t0 = m_TVec[ m_Bvh.m_TriIndex[i] ];
+            for ( int j = n1.m_Start ; j < n1.m_Start + n1.m_Count ; j++ )
+            {
+                TTri* t1 = tm->m_TVec[ tm->m_Bvh.m_TriIndex[j] ];
+
+                int iflag = tri_tri_intersection_test_3d(
+                                t0->m_N0->m_Pnt.v, t0->m_N1->m_Pnt.v, t0->m_N2->m_Pnt.v,
+                                t1->m_N0->m_Pnt.v, t1->m_N1->m_Pnt.v, t1->m_N2->m_Pnt.v,
+                                &coplanarFlag, e0.v, e1.v );
+
+                if ( iflag && !coplanarFlag )
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+//==== Squared Gap Between Two Boxes, Zero If They Overlap ====//
+static double BvhBoxDistSquared( const BndBox & b0, const BndBox & b1 )
+{
+    double d2 = 0.0;
+    for ( int i = 0 ; i < 3 ; i++ )
+    {
+        double gap = std::max( b0.GetMin( i ) - b1.GetMax( i ), b1.GetMin( i ) - b0.GetMax( i ) );
+        if ( gap > 0.0 )
+        {
+            d2 += gap * gap;
+        }
+    }
+    return d2;
+}
+
+//==== Squared Distance From Point To Box, Zero If Inside ====//
+static double BvhBoxDistSquared( const BndBox & box, const vec3d & pnt )
+{
+    double d2 = 0.0;
+    for ( int i = 0 ; i < 3 ; i++ )
+    {
+        double gap = std::max( box.GetMin( i ) - pnt[i], pnt[i] - box.GetMax( i ) );
+        if ( gap > 0.0 )
+        {
+            d2 += gap * gap;
+        }
+    }
+    return d2;
+}
+
+//==== Recursive Min Distance Between Two BVH Nodes ====//
+static double BvhMinDistance( TMesh* tm0, int n0, TMesh* tm1, int n1, double curr_min_dist )
+{
+    const TBvhNode & node0 = tm0->m_Bvh.m_NodeVec[n0];
+    const TBvhNode & node1 = tm1->m_Bvh.m_NodeVec[n1];
+
+    if ( BvhBoxDistSquared( node0.m_Box, node1.m_Box ) >= curr_min_dist * curr_min_dist )
+    {
+        return curr_min_dist;
+    }
+
+    //==== Descend The Larger Box, Nearer Child First So The Other Is More Likely Culled ====//
+    if ( !node0.IsLeaf() && ( node1.IsLeaf() || node0.m_Box.DiagDist() >= node1.m_Box.DiagDist() ) )
+    {
+        int c0 = n0 + 1;
+        int c1 = node0.m_Right;
+        if ( BvhBoxDistSquared( tm0->m_Bvh.m_NodeVec[c1].m_Box, node1.m_Box ) <
+             BvhBoxDistSquared( tm0->m_Bvh.m_NodeVec[c0].m_Box, node1.m_Box ) )
+        {
+            std::swap( c0, c1 );
+        }
+        curr_min_dist = BvhMinDistance( tm0, c0, tm1, n1, curr_min_dist );
+        curr_min_dist = BvhMinDistance( tm0, c1, tm1, n1, curr_min_dist );
+    }
+    else if ( !node1.IsLeaf() )
+    {
+        int c0 = n1 + 1;
+        int c1 = node1.m_Right;
+        if ( BvhBoxDistSquared( node0.m_Box, tm1->m_Bvh.m_NodeVec[c1].m_Box ) <
+             BvhBoxDistSquared( node0.m_Box, tm1->m_Bvh.m_NodeVec[c0].m_Box ) )
+        {
+            std::swap( c0, c1 );
+        }
+        curr_min_dist = BvhMinDistance( tm0, n0, tm1, c0, curr_min_dist );
+        curr_min_dist = BvhMinDistance( tm0, n0, tm1, c1, curr_min_dist );
+    }
+    //==== Check All Tris Against Other Tris ====//
+    else
+    {
+        for ( int i = node0.m_Start ; i < node0.m_Start + node0.m_Count ; i++ )
+        {
+            TTri* t0 = tm0->m_TVec[ tm0->m_Bvh.m_TriIndex[i] ];
+            for ( int j = node1.m_Start ; j < node1.m_Start + node1.m_Count ; j++ )
+            {
+                TTri* t1 = tm1->m_TVec[ tm1->m_Bvh.m_TriIndex[j] ];
+                double d = tri_tri_min_dist( t0->m_N0->m_Pnt, t0->m_N1->m_Pnt, t0->m_N2->m_Pnt,
+                                             t1->m_N0->m_Pnt, t1->m_N1->m_Pnt, t1->m_N2->m_Pnt );
+
+                if ( d < curr_min_dist )
+                {
+                    curr_min_dist = d;
+                }
+            }
+        }
+    }
+
+    return curr_min_dist;
 }
 
 double TMesh::MinDistance( TMesh* tm, double curr_min_dist )
 {
-    return m_TBox.MinDistance( &tm->m_TBox, curr_min_dist );
+    if ( m_Bvh.IsEmpty() || tm->m_Bvh.IsEmpty() )
+    {
+        return curr_min_dist;
+    }
+    return BvhMinDistance( this, 0, tm, 0, curr_min_dist );
+}
+
+double TMesh::MinDistance( const vec3d & pnt, double curr_min_dist, vec3d & near_pnt )
+{
+    if ( m_Bvh.IsEmpty() )
+    {
+        return curr_min_dist;
+    }
+
+    double min_dist2 = curr_min_dist * curr_min_dist;
+
+    vector< int > stackVec;
+    stackVec.push_back( 0 );
+
+    while ( !stackVec.empty() )
+    {
+        int n = stackVec.back();
+        stackVec.pop_back();
+
+        const TBvhNode & node = m_Bvh.m_NodeVec[n];
+        if ( BvhBoxDistSquared( node.m_Box, pnt ) >= min_dist2 )
+        {
+            continue;
+        }
+
+        if ( node.IsLeaf() )
+        {
+            for ( int i = node.m_Start ; i < node.m_Start + node.m_Count ; i++ )
+            {
+                TTri* t = m_TVec[ m_Bvh.m_TriIndex[i] ];
+                vec3d p = pnt_tri_closest_pnt( t->m_N0->m_Pnt, t->m_N1->m_Pnt, t->m_N2->m_Pnt, pnt );
+                double d2 = dist_squared( p, pnt );
+                if ( d2 < min_dist2 )
+                {
+                    min_dist2 = d2;
+                    near_pnt = p;
+                }
+            }
+        }
+        //==== Nearer Child Popped First ====//
+        else
+        {
+            int c0 = n + 1;
+            int c1 = node.m_Right;
+            if ( BvhBoxDistSquared( m_Bvh.m_NodeVec[c1].m_Box, pnt ) < BvhBoxDistSquared( m_Bvh.m_NodeVec[c0].m_Box, pnt ) )
+            {
+                std::swap( c0, c1 );
+            }
+            stackVec.push_back( c1 );
+            stackVec.push_back( c0 );
+        }
+    }
+
+    return sqrt( min_dist2 );
+}
+
+void TMesh::RayCast( vec3d & orig, vec3d & dir, vector<double> & tParmVec )
+{
+    vector< int > triVec;
+    m_Bvh.FindRayTris( orig, dir, triVec );
+
+    double tparm, uparm, vparm;
+
+    for ( int i = 0 ; i < ( int )triVec.size() ; i++ )
+    {
+        TTri* tri = m_TVec[ triVec[i] ];
+        int iFlag = intersect_triangle( orig.v, dir.v,
+                                        tri->m_N0->m_Pnt.v, tri->m_N1->m_Pnt.v, tri->m_N2->m_Pnt.v, &tparm, &uparm, &vparm );
+
+        if ( iFlag && tparm > 0.0 )
+        {
+            //==== Find If T is Already Included ====//
+            int dupFlag = 0;
+            for ( int j = 0 ; j < ( int )tParmVec.size() ; j++ )
+            {
+                if ( std::abs( tparm - tParmVec[j] ) < 0.0000001 )
+                {
+                    dupFlag = 1;
+                    break;
+                }
+            }
+
+            if ( !dupFlag )
+            {
+                tParmVec.push_back( tparm );
+            }
+        }
+    }
 }
 
 void TMesh::Split()
 {
     int t;
+
+    //==== Collect Intersected Tris ====//
+    vector< int > splitVec;
+    splitVec.reserve( m_TVec.size() );
     for ( t = 0 ; t < ( int )m_TVec.size() ; t++ )
     {
-        m_TVec[t]->SplitTri();
+        if ( m_TVec[t]->m_ISectEdgeVec.size() )
+        {
+            splitVec.push_back( t );
+        }
+    }
+
+    //==== SplitTri Moves Corner Nodes While Triangulating - Only Parallel If None Are Shared ====//
+    bool sharedFlag = false;
+    map< TNode*, int > cornerMap;
+    for ( int i = 0 ; i < ( int )splitVec.size() && !sharedFlag ; i++ )
+    {
+        TTri* tri = m_TVec[ splitVec[i] ];
+        TNode* corners[3] = { tri->m_N0, tri->m_N1, tri->m_N2 };
+        for ( int c = 0 ; c < 3 ; c++ )
+        {
+            if ( cornerMap.count( corners[c] ) && cornerMap[ corners[c] ] != splitVec[i] )
+            {
+                sharedFlag = true;
+                break;
+            }
+            cornerMap[ corners[c] ] = splitVec[i];
+        }
+    }
+
+    //==== Each Tri Owns Its Split Nodes, Edges And Tris ====//
+    // There are no per-thread pools; they are allocated with new and rely on
+    // the runtime's per-thread malloc arenas (see SplitThreadBench).  Each
+    // TriangulateSplit call has its own Triangle context.
+    int nsplit = splitVec.size();
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic ) if ( !sharedFlag )
+#endif
+    for ( int i = 0 ; i < nsplit ; i++ )
+    {
+        m_TVec[ splitVec[i] ]->SplitTri();
+    }
+
+    //==== Number New Nodes In Tri Order, Independent Of Thread Timing ====//
+    int id = m_NVec.size();
+    for ( int i = 0 ; i < nsplit ; i++ )
+    {
+        TTri* tri = m_TVec[ splitVec[i] ];
+        for ( int n = 3 ; n < ( int )tri->m_NVec.size() ; n++ )
+        {
+            tri->m_NVec[n]->m_ID = id;
+            id++;
+        }
     }
 }
 
@@ -874,6 +1509,7 @@ bool TMesh::DecideIgnoreTri( int aType, const vector < int > & bTypes, const vec
 
 void TMesh::SetIgnoreTriFlag( vector< TMesh* >& meshVec, const vector < int > & bTypes, const vector < bool > & thicksurf )
 {
+    vector< bool > aInB;
     for ( int t = 0 ; t < ( int )m_TVec.size() ; t++ )
     {
         TTri* tri = m_TVec[t];
@@ -884,12 +1520,14 @@ void TMesh::SetIgnoreTriFlag( vector< TMesh* >& meshVec, const vector < int > &
             tri->m_IgnoreTriFlag = true;
             for ( int s = 0 ; s < ( int )tri->m_SplitVec.size() ; s++ )
             {
-                tri->m_SplitVec[s]->m_IgnoreTriFlag = DecideIgnoreTri( m_SurfCfdType, bTypes, thicksurf, tri->m_SplitVec[s]->m_insideSurf );
+                GetInsideVec( tri->m_SplitVec[s]->m_InsideIndex, aInB );
+                tri->m_SplitVec[s]->m_IgnoreTriFlag = DecideIgnoreTri( m_SurfCfdType, bTypes, thicksurf, aInB );
             }
         }
         else
         {
-            tri->m_IgnoreTriFlag = DecideIgnoreTri( m_SurfCfdType, bTypes, thicksurf, tri->m_insideSurf );
+            GetInsideVec( tri->m_InsideIndex, aInB );
+            tri->m_IgnoreTriFlag = DecideIgnoreTri( m_SurfCfdType, bTypes, thicksurf, aInB );
         }
     }
 }
@@ -925,6 +1563,14 @@ void TMesh::IgnoreYLessThan( const double & ytol )
 
 void TMesh::DeterIntExt( vector< TMesh* >& meshVec )
 {
+    ResetInside( meshVec.size() );
+
+    vector< int > idVec( meshVec.size() );
+    for ( int m = 0 ; m < ( int )meshVec.size() ; m++ )
+    {
+        idVec[m] = TTriTable::InternID( meshVec[m]->m_PtrID );
+    }
+
     for ( int t = 0 ; t < ( int )m_TVec.size() ; t++ )
     {
         TTri* tri = m_TVec[t];
@@ -934,47 +1580,241 @@ void TMesh::DeterIntExt( vector< TMesh* >& meshVec )
         {
             for ( int s = 0 ; s < ( int )tri->m_SplitVec.size() ; s++ )
             {
-                DeterIntExtTri( tri->m_SplitVec[s], meshVec );
+                DeterIntExtTri( tri->m_SplitVec[s], meshVec, idVec );
             }
         }
         else
         {
-            DeterIntExtTri( tri, meshVec );
+            DeterIntExtTri( tri, meshVec, idVec );
         }
     }
 }
 
-void TMesh::DeterIntExtTri( TTri* tri, vector< TMesh* >& meshVec )
+void TMesh::DeterIntExtTri( TTri* tri, vector< TMesh* >& meshVec, const vector< int > & idVec )
+{
+    vec3d orig = ( tri->m_N0->m_Pnt + tri->m_N1->m_Pnt ) * 0.5;
+    orig = ( orig + tri->m_N2->m_Pnt ) * 0.5;
+    tri->m_IgnoreTriFlag = false;
+    int prior = -1;
+
+    vec3d dir( 1.0, 0.000001, 0.000001 );
+
+    tri->m_InsideIndex = AddInside();
+
+    for ( int m = 0 ; m < ( int )meshVec.size() ; m++ )
+    {
+        if ( meshVec[m] != this && meshVec[m]->m_ThickSurf )
+        {
+            vector<double > tParmVec;
+            meshVec[m]->RayCast( orig, dir, tParmVec );
+            if ( tParmVec.size() % 2 )
+            {
+                SetInside( tri->m_InsideIndex, m );
+
+                // Priority assignment for wave drag.  Mass prop may need some adjustments.
+                if ( meshVec[m]->m_MassPrior > prior ) // Should possibly check that priority is only for vsp::CFD_NORMAL
+                {
+                    tri->m_IDIndex = idVec[m];
+                    tri->m_Density = meshVec[m]->m_Density;
+                    prior = meshVec[m]->m_MassPrior;
+                }
+            }
+        }
+    }
+}
+
+//==== Classify Connected Regions Instead of Every Tri ====//
+// Inside/outside can only change across an intersection curve.  Base tris
+// that no other mesh crossed, however short the crossing, and that are joined
+// by edges away from any crossed tri share one classification.
+void TMesh::DeterIntExtRegions( vector< TMesh* >& meshVec )
+{
+    int ntri = m_TVec.size();
+
+    ResetInside( meshVec.size() );
+
+    vector< int > idVec( meshVec.size() );
+    for ( int m = 0 ; m < ( int )meshVec.size() ; m++ )
+    {
+        idVec[m] = TTriTable::InternID( meshVec[m]->m_PtrID );
+    }
+
+    vector< vec3d > cornerVec( 3 * ntri );
+    vector< bool > blockVec( ntri );
+    for ( int t = 0 ; t < ntri ; t++ )
+    {
+        TTri* tri = m_TVec[t];
+        cornerVec[ 3 * t ] = tri->m_N0->m_Pnt;
+        cornerVec[ 3 * t + 1 ] = tri->m_N1->m_Pnt;
+        cornerVec[ 3 * t + 2 ] = tri->m_N2->m_Pnt;
+        blockVec[t] = tri->m_ISectFlag || tri->m_ISectEdgeVec.size() || tri->m_SplitVec.size();
+    }
+
+    vector< int > regionVec;
+    int nregion = BuildTriRegions( cornerVec, blockVec, regionVec );
+
+    vector< vector< TTri* > > regionTriVec( nregion );
+    for ( int t = 0 ; t < ntri ; t++ )
+    {
+        TTri* tri = m_TVec[t];
+
+        if ( regionVec[t] >= 0 )
+        {
+            regionTriVec[ regionVec[t] ].push_back( tri );
+        }
+        //==== Tris Along Intersection Curves Are Done One By One ====//
+        else if ( tri->m_SplitVec.size() )
+        {
+            for ( int s = 0 ; s < ( int )tri->m_SplitVec.size() ; s++ )
+            {
+                DeterIntExtTri( tri->m_SplitVec[s], meshVec, idVec );
+            }
+        }
+        else
+        {
+            DeterIntExtTri( tri, meshVec, idVec );
+        }
+    }
+
+    for ( int r = 0 ; r < nregion ; r++ )
+    {
+        DeterIntExtRegion( regionTriVec[r], meshVec, idVec );
+    }
+}
+
+void TMesh::DeterIntExtRegion( const vector< TTri* > & triVec, vector< TMesh* >& meshVec, const vector< int > & idVec )
+{
+    if ( triVec.empty() )
+    {
+        return;
+    }
+
+    // Three rays spread over the region must agree.  A region they disagree
+    // on is classified tri by tri.
+    vector< TTri* > voteVec;
+    voteVec.push_back( triVec[0] );
+    if ( triVec.size() >= 3 )
+    {
+        voteVec.push_back( triVec[ triVec.size() / 2 ] );
+        voteVec.push_back( triVec.back() );
+    }
+
+    vec3d dir( 1.0, 0.000001, 0.000001 );
+
+    int nmesh = meshVec.size();
+    vector< bool > inVec( nmesh, false );
+
+    for ( int m = 0 ; m < nmesh ; m++ )
+    {
+        if ( meshVec[m] != this && meshVec[m]->m_ThickSurf )
+        {
+            int nin = 0;
+            for ( int v = 0 ; v < ( int )voteVec.size() ; v++ )
+            {
+                TTri* tri = voteVec[v];
+                vec3d orig = ( tri->m_N0->m_Pnt + tri->m_N1->m_Pnt ) * 0.5;
+                orig = ( orig + tri->m_N2->m_Pnt ) * 0.5;
+
+                vector<double > tParmVec;
+                meshVec[m]->RayCast( orig, dir, tParmVec );
+                if ( tParmVec.size() % 2 )
+                {
+                    nin++;
+                }
+            }
+
+            if ( nin > 0 && nin < ( int )voteVec.size() )
+            {
+                for ( int t = 0 ; t < ( int )triVec.size() ; t++ )
+                {
+                    DeterIntExtTri( triVec[t], meshVec, idVec );
+                }
+                return;
+            }
+            inVec[m] = ( nin > 0 );
+        }
+    }
+
+    int slot = AddInside();
+    int prior = -1;
+    int priorMesh = -1;
+
+    for ( int m = 0 ; m < nmesh ; m++ )
+    {
+        if ( inVec[m] )
+        {
+            SetInside( slot, m );
+
+            // Priority assignment for wave drag.  Mass prop may need some adjustments.
+            if ( meshVec[m]->m_MassPrior > prior )
+            {
+                prior = meshVec[m]->m_MassPrior;
+                priorMesh = m;
+            }
+        }
+    }
+
+    //==== Whole Region Shares One Slot ====//
+    for ( int t = 0 ; t < ( int )triVec.size() ; t++ )
+    {
+        TTri* tri = triVec[t];
+        tri->m_IgnoreTriFlag = false;
+        tri->m_InsideIndex = slot;
+
+        if ( priorMesh >= 0 )
+        {
+            tri->m_IDIndex = idVec[ priorMesh ];
+            tri->m_Density = meshVec[ priorMesh ]->m_Density;
+        }
+    }
+}
+
+//==== Clear Inside Flags For A New Classification Against nmesh Meshes ====//
+void TMesh::ResetInside( int nmesh )
+{
+    m_NumInsideMeshes = nmesh;
+    m_InsideWords = ( nmesh + 31 ) / 32;
+    m_InsideBits.clear();
+}
+
+int TMesh::AddInside()
+{
+    int slot = 0;
+    if ( m_InsideWords > 0 )
+    {
+        slot = m_InsideBits.size() / m_InsideWords;
+    }
+    m_InsideBits.resize( m_InsideBits.size() + m_InsideWords, 0 );
+    return slot;
+}
+
+void TMesh::SetInside( int slot, int m )
 {
-    vec3d orig = ( tri->m_N0->m_Pnt + tri->m_N1->m_Pnt ) * 0.5;
-    orig = ( orig + tri->m_N2->m_Pnt ) * 0.5;
-    tri->m_IgnoreTriFlag = false;
-    int prior = -1;
-
-    vec3d dir( 1.0, 0.000001, 0.000001 );
+    m_InsideBits[ slot * m_InsideWords + m / 32 ] |= ( 1u << ( m % 32 ) );
+}
 
-    int nmesh = meshVec.size();
-    tri->m_insideSurf.resize( nmesh, false );
+bool TMesh::GetInside( int slot, int m ) const
+{
+    if ( slot < 0 || m < 0 || m >= m_NumInsideMeshes || ( slot + 1 ) * m_InsideWords > ( int )m_InsideBits.size() )
+    {
+        return false;
+    }
+    return !!( m_InsideBits[ slot * m_InsideWords + m / 32 ] & ( 1u << ( m % 32 ) ) );
+}
 
-    for ( int m = 0 ; m < ( int )meshVec.size() ; m++ )
+//==== Unpack Flags For DecideIgnoreTri, Empty If Not Classified ====//
+void TMesh::GetInsideVec( int slot, vector< bool > & insideVec ) const
+{
+    insideVec.clear();
+    if ( slot < 0 )
     {
-        if ( meshVec[m] != this && meshVec[m]->m_ThickSurf )
-        {
-            vector<double > tParmVec;
-            meshVec[m]->m_TBox.RayCast( orig, dir, tParmVec );
-            if ( tParmVec.size() % 2 )
-            {
-                tri->m_insideSurf[m] = true;
+        return;
+    }
 
-                // Priority assignment for wave drag.  Mass prop may need some adjustments.
-                if ( meshVec[m]->m_MassPrior > prior ) // Should possibly check that priority is only for vsp::CFD_NORMAL
-                {
-                    tri->m_ID = meshVec[m]->m_PtrID;
-                    tri->m_Density = meshVec[m]->m_Density;
-                    prior = meshVec[m]->m_MassPrior;
-                }
-            }
-        }
+    insideVec.resize( m_NumInsideMeshes, false );
+    for ( int m = 0 ; m < m_NumInsideMeshes ; m++ )
+    {
+        insideVec[m] = GetInside( slot, m );
     }
 }
 
@@ -994,7 +1834,7 @@ double TMesh::ComputeTheoArea()
         m_TheoArea += area;
         if ( ntags > 0 )
         {
-            int itag = SubSurfaceMgr.GetTag(m_TVec[t]->m_Tags) - 1;
+            int itag = SubSurfaceMgr.GetTag( m_TVec[t]->GetTags() ) - 1;
             if ( itag >= 0 && itag < ntags )
             {
                 m_TagTheoAreaVec[itag] += area;
@@ -1021,7 +1861,7 @@ double TMesh::ComputeWetArea()
 
         // TMesh::SubTag guarantees that split tris have same tags as normal tris.
         // So, just look up tag index once per tri.
-        int itag = SubSurfaceMgr.GetTag( tri->m_Tags ) - 1;
+        int itag = SubSurfaceMgr.GetTag( tri->GetTags() ) - 1;
 
         //==== Do Interior Tris ====//
         if ( tri->m_SplitVec.size() )
@@ -1078,7 +1918,7 @@ double TMesh::ComputeWaveDragArea( const std::map< string, int > &idmap )
                     m_AreaCenter = m_AreaCenter + tri->m_SplitVec[s]->ComputeCenter()*area;
                     m_WetArea += area;
 
-                    std::map<string, int>::const_iterator it = idmap.find( tri->m_SplitVec[s]->m_ID );
+                    std::map<string, int>::const_iterator it = idmap.find( tri->m_SplitVec[s]->GetID() );
                     if ( it != idmap.end() )
                     {
                         m_CompAreaVec[ it->second ] += area;
@@ -1092,7 +1932,7 @@ double TMesh::ComputeWaveDragArea( const std::map< string, int > &idmap )
             m_AreaCenter = m_AreaCenter + tri->ComputeCenter()*area;
             m_WetArea += area;
 
-            std::map<string, int>::const_iterator it = idmap.find( tri->m_ID );
+            std::map<string, int>::const_iterator it = idmap.find( tri->GetID() );
             if ( it != idmap.end() )
             {
                 m_CompAreaVec[ it->second ] += area;
@@ -1281,84 +2121,93 @@ void TMesh::AddUWTri( const vec3d & uw0, const vec3d & uw1, const vec3d & uw2, c
 }
 
 
-void TMesh::LoadBndBox()
+void TMesh::LoadBndBox( const TBvh* bvh )
 {
     m_TBox.Reset();
 
+    if ( bvh )
+    {
+        for ( int i = 0 ; i < ( int )m_TVec.size() ; i++ )
+        {
+            m_TBox.AddTri( m_TVec[i] );
+        }
+        m_Bvh = *bvh;
+        return;
+    }
+
+    vector< BndBox > triBoxVec( m_TVec.size() );
     for ( int i = 0 ; i < ( int )m_TVec.size() ; i++ )
     {
-        m_TBox.AddTri( m_TVec[i] );
+        triBoxVec[i].Update( m_TVec[i]->m_N0->m_Pnt );
+        triBoxVec[i].Update( m_TVec[i]->m_N1->m_Pnt );
+        triBoxVec[i].Update( m_TVec[i]->m_N2->m_Pnt );
+        m_TBox.m_Box.Update( triBoxVec[i] );
     }
 
-    m_TBox.SplitBox();
+    // m_TBox only holds the overall box, queries go through the BVH.
+    m_Bvh.Build( triBoxVec );
 }
 
 //==== Write STL Tris =====//
-void TMesh::WriteSTLTris( FILE* file_id, Matrix4d XFormMat )
+//==== Base Tri (Or Its Split Tris) As STL Facets ====//
+class TMeshSTLFormatter : public ExportFormatter
 {
-    int t, s;
-    vec3d norm;
-    vec3d v0, v1, v2;
-    vec3d d30, d21;
+public:
+    TMeshSTLFormatter( const vector< TTri* > & tri_vec, const Matrix4d & mat ) : m_TriVec( tri_vec ), m_Mat( mat )
+    {
+    }
 
-    for ( t = 0 ; t < ( int )m_TVec.size() ; t++ )
+    virtual int NumItems() const
     {
-        TTri* tri = m_TVec[t];
+        return m_TriVec.size();
+    }
+
+    virtual void Format( int t, ExportBuffer & buf ) const
+    {
+        TTri* tri = m_TriVec[t];
 
         if ( tri->m_SplitVec.size() )
         {
-            for ( s = 0 ; s < ( int )tri->m_SplitVec.size() ; s++ )
+            for ( int s = 0 ; s < ( int )tri->m_SplitVec.size() ; s++ )
             {
-                if ( !tri->m_SplitVec[s]->m_IgnoreTriFlag )
-                {
-                    v0 = XFormMat.xform( tri->m_SplitVec[s]->m_N0->m_Pnt );
-                    v1 = XFormMat.xform( tri->m_SplitVec[s]->m_N1->m_Pnt );
-                    v2 = XFormMat.xform( tri->m_SplitVec[s]->m_N2->m_Pnt );
-
-                    d21 = v2 - v1;
-
-                    if ( d21.mag() > 0.000001 )
-                    {
-                        norm = cross( d21, v0 - v1 );
-                        norm.normalize();
-
-                        fprintf( file_id, " facet normal  %2.10le %2.10le %2.10le\n",  norm.x(), norm.y(), norm.z() );
-                        fprintf( file_id, "   outer loop\n" );
-                        fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", v0.x(), v0.y(), v0.z() );
-                        fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", v1.x(), v1.y(), v1.z() );
-                        fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", v2.x(), v2.y(), v2.z() );
-                        fprintf( file_id, "   endloop\n" );
-                        fprintf( file_id, " endfacet\n" );
-                    }
-                }
+                FormatTri( tri->m_SplitVec[s], buf );
             }
         }
         else
         {
-            if ( !tri->m_IgnoreTriFlag )
-            {
-                v0 = XFormMat.xform( tri->m_N0->m_Pnt );
-                v1 = XFormMat.xform( tri->m_N1->m_Pnt );
-                v2 = XFormMat.xform( tri->m_N2->m_Pnt );
+            FormatTri( tri, buf );
+        }
+    }
 
-                d21 = v2 - v1;
+protected:
 
-                if ( d21.mag() > 0.000001 )
-                {
-                    norm = cross( d21, v0 - v1 );
-                    norm.normalize();
+    void FormatTri( TTri* tri, ExportBuffer & buf ) const
+    {
+        if ( !tri->m_IgnoreTriFlag )
+        {
+            vec3d v0 = m_Mat.xform( tri->m_N0->m_Pnt );
+            vec3d v1 = m_Mat.xform( tri->m_N1->m_Pnt );
+            vec3d v2 = m_Mat.xform( tri->m_N2->m_Pnt );
 
-                    fprintf( file_id, " facet normal  %2.10le %2.10le %2.10le\n",  norm.x(), norm.y(), norm.z() );
-                    fprintf( file_id, "   outer loop\n" );
-                    fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", v0.x(), v0.y(), v0.z() );
-                    fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", v1.x(), v1.y(), v1.z() );
-                    fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", v2.x(), v2.y(), v2.z() );
-                    fprintf( file_id, "   endloop\n" );
-                    fprintf( file_id, " endfacet\n" );
-                }
+            vec3d d21 = v2 - v1;
+
+            if ( d21.mag() > 0.000001 )
+            {
+                vec3d norm = cross( d21, v0 - v1 );
+                norm.normalize();
+
+                ExportWriter::FormatSTLFacet( norm, v0, v1, v2, buf );
             }
         }
     }
+
+    const vector< TTri* > & m_TriVec;
+    Matrix4d m_Mat;
+};
+
+void TMesh::WriteSTLTris( FILE* file_id, Matrix4d XFormMat )
+{
+    ExportWriter::Write( file_id, TMeshSTLFormatter( m_TVec, XFormMat ) );
 }
 
 vec3d TMesh::GetVertex( int index )
@@ -1386,6 +2235,217 @@ int TMesh::NumVerts()
 //===============================================//
 //===============================================//
 //                  TTri
+//===============================================//
+//                  TTriTable
+//===============================================//
+
+// Deques so references handed out stay valid as entries are added.
+class TTriTableData
+{
+public:
+    TTriTableData()
+    {
+        m_IDVec.push_back( string() );
+        m_IDMap[ string() ] = 0;
+        m_TagVec.push_back( vector< int >() );
+        m_TagMap[ vector< int >() ] = 0;
+        m_NumTris = 0;
+    }
+
+    int m_NumTris;
+    deque< string > m_IDVec;
+    map< string, int > m_IDMap;
+    deque< vector< int > > m_TagVec;
+    map< vector< int >, int > m_TagMap;
+};
+
+static TTriTableData & GetTTriTableData()
+{
+    static TTriTableData data;
+    return data;
+}
+
+int TTriTable::InternID( const string & id )
+{
+    TTriTableData & data = GetTTriTableData();
+    int index;
+
+#ifdef VSP_USE_OPENMP
+#pragma omp critical( ttri_table )
+#endif
+    {
+        map< string, int >::const_iterator it = data.m_IDMap.find( id );
+        if ( it != data.m_IDMap.end() )
+        {
+            index = it->second;
+        }
+        else
+        {
+            index = data.m_IDVec.size();
+            data.m_IDVec.push_back( id );
+            data.m_IDMap[ id ] = index;
+        }
+    }
+    return index;
+}
+
+const string & TTriTable::GetID( int index )
+{
+    TTriTableData & data = GetTTriTableData();
+    const string* id;
+
+#ifdef VSP_USE_OPENMP
+#pragma omp critical( ttri_table )
+#endif
+    {
+        id = &data.m_IDVec[ index ];
+    }
+    return *id;
+}
+
+int TTriTable::InternTags( const vector< int > & tags )
+{
+    TTriTableData & data = GetTTriTableData();
+    int index;
+
+#ifdef VSP_USE_OPENMP
+#pragma omp critical( ttri_table )
+#endif
+    {
+        map< vector< int >, int >::const_iterator it = data.m_TagMap.find( tags );
+        if ( it != data.m_TagMap.end() )
+        {
+            index = it->second;
+        }
+        else
+        {
+            index = data.m_TagVec.size();
+            data.m_TagVec.push_back( tags );
+            data.m_TagMap[ tags ] = index;
+        }
+    }
+    return index;
+}
+
+const vector< int > & TTriTable::GetTags( int index )
+{
+    TTriTableData & data = GetTTriTableData();
+    const vector< int >* tags;
+
+#ifdef VSP_USE_OPENMP
+#pragma omp critical( ttri_table )
+#endif
+    {
+        tags = &data.m_TagVec[ index ];
+    }
+    return *tags;
+}
+
+//==== Count Tris That May Hold Indices ====//
+void TTriTable::AttachTri()
+{
+    TTriTableData & data = GetTTriTableData();
+
+#ifdef VSP_USE_OPENMP
+#pragma omp atomic
+#endif
+    data.m_NumTris++;
+}
+
+void TTriTable::DetachTri()
+{
+    TTriTableData & data = GetTTriTableData();
+
+#ifdef VSP_USE_OPENMP
+#pragma omp atomic
+#endif
+    data.m_NumTris--;
+}
+
+int TTriTable::NumTris()
+{
+    TTriTableData & data = GetTTriTableData();
+    int ntri;
+
+#ifdef VSP_USE_OPENMP
+#pragma omp atomic read
+#endif
+    ntri = data.m_NumTris;
+
+    return ntri;
+}
+
+//==== Drop All But The Empty Entries If No Tri Is Left ====//
+// Not for use inside a parallel region that creates tris.
+bool TTriTable::Reset()
+{
+    TTriTableData & data = GetTTriTableData();
+    bool reset = false;
+
+#ifdef VSP_USE_OPENMP
+#pragma omp critical( ttri_table )
+#endif
+    {
+        if ( data.m_NumTris == 0 )
+        {
+            data = TTriTableData();
+            reset = true;
+        }
+    }
+    return reset;
+}
+
+int TTriTable::NumIDs()
+{
+    TTriTableData & data = GetTTriTableData();
+    int num;
+
+#ifdef VSP_USE_OPENMP
+#pragma omp critical( ttri_table )
+#endif
+    {
+        num = data.m_IDVec.size();
+    }
+    return num;
+}
+
+int TTriTable::NumTagCombos()
+{
+    TTriTableData & data = GetTTriTableData();
+    int num;
+
+#ifdef VSP_USE_OPENMP
+#pragma omp critical( ttri_table )
+#endif
+    {
+        num = data.m_TagVec.size();
+    }
+    return num;
+}
+
+//==== Approximate Bytes Held By Both Tables ====//
+size_t TTriTable::MemoryUsage()
+{
+    TTriTableData & data = GetTTriTableData();
+    size_t mem = 0;
+
+#ifdef VSP_USE_OPENMP
+#pragma omp critical( ttri_table )
+#endif
+    {
+        for ( int i = 0 ; i < ( int )data.m_IDVec.size() ; i++ )
+        {
+            // Stored once in the deque and once as a map key.
+            mem += 2 * ( sizeof( string ) + data.m_IDVec[i].capacity() ) + sizeof( int );
+        }
+        for ( int i = 0 ; i < ( int )data.m_TagVec.size() ; i++ )
+        {
+            mem += 2 * ( sizeof( vector< int > ) + data.m_TagVec[i].capacity() * sizeof( int ) ) + sizeof( int );
+        }
+    }
+    return mem;
+}
+
 //===============================================//
 //===============================================//
 //===============================================//
@@ -1393,25 +2453,27 @@ int TMesh::NumVerts()
 
 TTri::TTri( TMesh* tmesh )
 {
-    static int cnt = 0;
-    cnt++;
-//printf("Tri Construct Cnt = %d \n", cnt);
     m_E0 = m_E1 = m_E2 = 0;
     m_N0 = m_N1 = m_N2 = 0;
     m_IgnoreTriFlag = false;
+    m_ISectFlag = false;
     m_InvalidFlag  = 0;
     m_Density = 1.0;
+    m_IDIndex = 0;
+    m_TagIndex = 0;
+    m_InsideIndex = -1;
     m_TMesh = tmesh;
     m_PEArr[0] = m_PEArr[1] = m_PEArr[2] = NULL;
+
+    TTriTable::AttachTri();
 }
 
 TTri::~TTri()
 {
-    static int cnt = 0;
-    cnt++;
-//printf("Tri Destruct Cnt = %d \n", cnt);
     int i;
 
+    TTriTable::DetachTri();
+
     //==== Delete Split Edges ====//
     for ( i = 0 ; i < ( int )m_EVec.size() ; i++ )
     {
@@ -1445,6 +2507,15 @@ TTri::~TTri()
 
 }
 
+bool TTri::GetInsideSurf( int m ) const
+{
+    if ( !m_TMesh )
+    {
+        return false;
+    }
+    return m_TMesh->GetInside( m_InsideIndex, m );
+}
+
 void TTri::CopyFrom( const TTri* tri )
 {
     m_N0 = new TNode();
@@ -1457,8 +2528,8 @@ void TTri::CopyFrom( const TTri* tri )
 
     m_Norm = tri->m_Norm;
     m_Density = tri->m_Density;
-    m_Tags = tri->m_Tags;
-    m_ID = tri->m_ID;
+    m_TagIndex = tri->m_TagIndex;
+    m_IDIndex = tri->m_IDIndex;
     m_InvalidFlag = tri->m_InvalidFlag;
     m_IgnoreTriFlag = tri->m_IgnoreTriFlag;
 }
@@ -1973,9 +3044,6 @@ void TTri::TriangulateSplit( int flattenAxis )
     triangleio in, out;
     int tristatus = TRI_NULL;
 
-    // init
-    ctx = triangle_context_create();
-
     memset( &in, 0, sizeof( in ) ); // Load Zeros
     memset( &out, 0, sizeof( out ) );
 
@@ -2098,10 +3166,10 @@ void TTri::TriangulateSplit( int flattenAxis )
 
     in.numberofsegments = segIndList.size() / 2;
 
+    //==== Check For Duplicate Points =====//
+    int dupFlag = 0;
     if ( in.numberofpoints > 3 && in.numberofsegments > 3 )
     {
-        //==== Check For Duplicate Points =====//
-        int dupFlag = 0;
         for ( i = 0 ; i < in.numberofpoints ; i++ )
             for ( j = i + 1 ; j < in.numberofpoints ; j++ )
             {
@@ -2113,8 +3181,19 @@ void TTri::TriangulateSplit( int flattenAxis )
                     dupFlag = 1;
                 }
             }
+    }
 
-        if ( !dupFlag )
+    //==== Triangle Keeps Its Random Seed And Exact Arithmetic Constants In Globals ====//
+    // The bundled Triangle is patched (Libraries/Triangle_ThreadSafe.cmake) to
+    // keep the seed per thread and compute the constants once, so contexts run
+    // concurrently.  A system Triangle without the patch runs one tri at a time.
+#if defined( VSP_USE_OPENMP ) && !defined( TRIANGLE_THREAD_SAFE )
+#pragma omp critical( triangle_lib )
+#endif
+    {
+        ctx = triangle_context_create();
+
+        if ( in.numberofpoints > 3 && in.numberofsegments > 3 && !dupFlag )
         {
             char cmdline[] = "zpQ";
 
@@ -2126,13 +3205,18 @@ void TTri::TriangulateSplit( int flattenAxis )
             tristatus = triangle_mesh_create( ctx, &in );
             if ( tristatus != TRI_OK ) printf( "triangle_mesh_create Error\n" );
         }
-//fprintf(fp, "Triangulate in = %d out = %d \n", in.numberofpoints, out.numberofpoints );
+
+        if ( tristatus == TRI_OK )
+        {
+            triangle_mesh_copy( ctx, &out, 1, 1 );
+        }
+
+        // cleanup
+        triangle_context_destroy( ctx );
     }
 
     if ( tristatus == TRI_OK )
     {
-        triangle_mesh_copy( ctx, &out, 1, 1 );
-
         //==== Load Triangles if No New Point Created ====//
         cnt = 0;
         for ( i = 0; i < out.numberoftriangles; i++ )
@@ -2145,7 +3229,7 @@ void TTri::TriangulateSplit( int flattenAxis )
                 t->m_N0 = m_NVec[out.trianglelist[cnt]];
                 t->m_N1 = m_NVec[out.trianglelist[cnt + 1]];
                 t->m_N2 = m_NVec[out.trianglelist[cnt + 2]];
-                t->m_Tags = m_Tags; // Set split tri to have same tags as original triangle
+                t->m_TagIndex = m_TagIndex; // Set split tri to have same tags as original triangle
                 t->m_Norm = m_Norm;
                 m_SplitVec.push_back( t );
             }
@@ -2220,9 +3304,6 @@ void TTri::TriangulateSplit( int flattenAxis )
 
     //free( in.edgelist );
     //free( in.edgemarkerlist );
-
-    // cleanup
-    triangle_context_destroy( ctx );
 }
 
 int TTri::OnEdge( const vec3d & p, TEdge* e, double onEdgeTol, double * t )
@@ -2361,393 +3442,418 @@ int TTri::WakeEdge()
 
 
 //===============================================//
-//===============================================//
-//===============================================//
-//===============================================//
-//                  TBndBox
-//===============================================//
-//===============================================//
-//===============================================//
+//===============================================//
+//===============================================//
+//===============================================//
+//                  TBndBox
+//===============================================//
+//===============================================//
+//===============================================//
+//===============================================//
+
+TBndBox::TBndBox()
+{
+}
+
+TBndBox::~TBndBox()
+{
+}
+
+void TBndBox::Reset()
+{
+    m_Box.Reset();
+}
+
+void TBndBox::AddTri( TTri* t )
+{
+    m_Box.Update( t->m_N0->m_Pnt );
+    m_Box.Update( t->m_N1->m_Pnt );
+    m_Box.Update( t->m_N2->m_Pnt );
+}
+
+//==== Add Intersection Edges To Both Tris If They Cross ====//
+void TBndBox::IntersectTris( TTri* t0, TTri* t1, bool UWFlag )
+{
+    double tol = 1e-6; // was 1e-6
+
+    int coplanarFlag = 0; // Must be initialized to 0 before use in tri_tri_intersection_test_3d
+    vec3d e0;
+    vec3d e1;
+
+    int iflag = tri_tri_intersection_test_3d(
+                    t0->m_N0->m_Pnt.v, t0->m_N1->m_Pnt.v, t0->m_N2->m_Pnt.v,
+                    t1->m_N0->m_Pnt.v, t1->m_N1->m_Pnt.v, t1->m_N2->m_Pnt.v,
+                    &coplanarFlag, e0.v, e1.v );
+
+    if ( iflag && !coplanarFlag )
+    {
+        t0->m_ISectFlag = true;
+        t1->m_ISectFlag = true;
+
+        if ( UWFlag )
+        {
+            if ( dist( e0, e1 ) > tol ) // was 1e-6
+            {
+                // Figure out with tri has xyz info
+                TTri* tri;
+                int d_info = TNode::HAS_XYZ; // desired info number
+                if ( ( t0->m_N0->GetCoordInfo() & d_info ) == d_info &&  ( t0->m_N1->GetCoordInfo() & d_info ) == d_info
+                        && ( t0->m_N2->GetCoordInfo() & d_info ) == d_info )
+                {
+                    tri = t0;
+                }
+                else
+                {
+                    tri = t1;
+                }
+                // Use Bilinear interpolation to convert edge uw points to xyz points
+                vec3d e0xyz = tri->CompPnt( e0 );
+                vec3d e1xyz = tri->CompPnt( e1 );
+
+                // Create the new edges
+
+                TEdge* ie0 = new TEdge();
+                int info = TNode::HAS_UW | TNode::HAS_XYZ;
+                ie0->m_N0 = new TNode();
+                ie0->m_N0->SetUWPnt( e0 );
+                ie0->m_N0->SetXYZPnt( e0xyz );
+                ie0->m_N0->MakePntUW();
+                ie0->m_N0->SetCoordInfo( info );
+                ie0->m_N1 = new TNode();
+                ie0->m_N1->SetUWPnt( e1 );
+                ie0->m_N1->SetXYZPnt( e1xyz );
+                ie0->m_N1->MakePntUW();
+                ie0->m_N1->SetCoordInfo( info );
+
+                TEdge* ie1 = new TEdge();
+                ie1->m_N0 = new TNode();
+                ie1->m_N0->SetUWPnt( e0 );
+                ie1->m_N0->SetXYZPnt( e0xyz );
+                ie1->m_N0->MakePntUW();
+                ie1->m_N0->SetCoordInfo( info );
+                ie1->m_N1 = new TNode();
+                ie1->m_N1->SetUWPnt( e1 );
+                ie1->m_N1->SetXYZPnt( e1xyz );
+                ie1->m_N1->MakePntUW();
+                ie1->m_N1->SetCoordInfo( info );
+
+                t0->m_ISectEdgeVec.push_back( ie0 );
+                t1->m_ISectEdgeVec.push_back( ie1 );
+
+                if ( tri->GetTMeshPtr() )
+                {
+                    tri->GetTMeshPtr()->SplitAliasEdges( tri, tri->m_ISectEdgeVec.back() );
+                }
+
+            }
+        }
+        else
+        {
+            AddISectEdges( t0, t1, e0, e1 );
+        }
+    }
+}
+
+//==== Add XYZ Intersection Segment To Both Tris ====//
+void TBndBox::AddISectEdges( TTri* t0, TTri* t1, const vec3d & e0, const vec3d & e1 )
+{
+    AddISectEdge( t0, e0, e1 );
+    AddISectEdge( t1, e0, e1 );
+}
+
+//==== Add XYZ Intersection Segment To One Tri ====//
+// Every crossing flags the tri.  Only segments long enough to split on become edges.
+void TBndBox::AddISectEdge( TTri* t, const vec3d & e0, const vec3d & e1 )
+{
+    t->m_ISectFlag = true;
+
+    if ( dist( e0, e1 ) <= 1e-6 )
+    {
+        return;
+    }
+
+    TEdge* ie = new TEdge();
+    int info = TNode::HAS_UW | TNode::HAS_XYZ;
+    ie->m_N0 = new TNode();
+    ie->m_N0->m_Pnt = e0;
+    ie->m_N0->m_UWPnt = t->CompUW( e0 );
+    ie->m_N0->SetCoordInfo( info );
+    ie->m_N1 = new TNode();
+    ie->m_N1->m_Pnt = e1;
+    ie->m_N1->m_UWPnt = t->CompUW( e1 );
+    ie->m_N1->SetCoordInfo( info );
+
+    t->m_ISectEdgeVec.push_back( ie );
+}
+
+//===============================================//
+//                  TBvh
 //===============================================//
 
-TBndBox::TBndBox()
+TBvh::TBvh()
 {
-    for ( int i = 0 ; i < 8 ; i++ )
-    {
-        m_SBoxVec[i] = 0;
-    }
 }
 
-TBndBox::~TBndBox()
+TBvh::~TBvh()
 {
-    for ( int i = 0 ; i < 8 ; i++ )
-    {
-        delete m_SBoxVec[i];
-    }
 }
 
-void TBndBox::Reset()
+void TBvh::Reset()
 {
-    for ( int i = 0 ; i < 8 ; i++ )
-    {
-        delete m_SBoxVec[i];
-        m_SBoxVec[i] = 0;
-    }
-
-    m_Box.Reset();
-    m_TriVec.clear();
+    m_NodeVec.clear();
+    m_TriIndex.clear();
 }
 
-//==== Create Oct Tree of Overlapping BndBoxes ====//
-void TBndBox::SplitBox()
+//==== Surface Area of Box For SAH Cost ====//
+static double BvhBoxArea( const BndBox & box )
 {
-    int i;
-    if ( m_TriVec.size() > 32 )
-    {
-        //==== Find Split Points ====//
-        double hx = 0.5 * ( m_Box.GetMax( 0 ) + m_Box.GetMin( 0 ) );
-        double hy = 0.5 * ( m_Box.GetMax( 1 ) + m_Box.GetMin( 1 ) );
-        double hz = 0.5 * ( m_Box.GetMax( 2 ) + m_Box.GetMin( 2 ) );
+    double dx = box.GetMax( 0 ) - box.GetMin( 0 );
+    double dy = box.GetMax( 1 ) - box.GetMin( 1 );
+    double dz = box.GetMax( 2 ) - box.GetMin( 2 );
 
-        for ( i = 0 ; i < 8 ; i++ )
-        {
-            m_SBoxVec[i] = new TBndBox();
-        }
+    if ( dx < 0 || dy < 0 || dz < 0 )
+    {
+        return 0.0;
+    }
+    return 2.0 * ( dx * dy + dy * dz + dz * dx );
+}
 
-        for ( i = 0 ; i < ( int )m_TriVec.size() ; i++ )
-        {
-            int cnt = 0;
-            if ( m_TriVec[i]->m_N0->m_Pnt.x() > hx )
-            {
-                cnt += 1;
-            }
-            if ( m_TriVec[i]->m_N0->m_Pnt.y() > hy )
-            {
-                cnt += 2;
-            }
-            if ( m_TriVec[i]->m_N0->m_Pnt.z() > hz )
-            {
-                cnt += 4;
-            }
-            m_SBoxVec[cnt]->AddTri( m_TriVec[i] );
-        }
+void TBvh::Build( const vector< BndBox > & triBoxVec )
+{
+    Reset();
 
-        int contSplitFlag = 1;
+    int ntri = triBoxVec.size();
+    if ( ntri == 0 )
+    {
+        return;
+    }
 
-        for ( i = 0 ; i < 8 ; i++ )
-        {
-            if ( m_TriVec.size() == m_SBoxVec[i]->m_TriVec.size() )
-            {
-                contSplitFlag = 0;
-                break;
-            }
-        }
-        if ( contSplitFlag )
-        {
-            for ( i = 0 ; i < 8 ; i++ )
-            {
-                m_SBoxVec[i]->SplitBox();
-            }
-        }
+    vector< vec3d > cenVec( ntri );
+    m_TriIndex.resize( ntri );
+    for ( int i = 0 ; i < ntri ; i++ )
+    {
+        cenVec[i] = triBoxVec[i].GetCenter();
+        m_TriIndex[i] = i;
     }
-}
 
-void TBndBox::AddTri( TTri* t )
-{
-    m_TriVec.push_back( t );
-    m_Box.Update( t->m_N0->m_Pnt );
-    m_Box.Update( t->m_N1->m_Pnt );
-    m_Box.Update( t->m_N2->m_Pnt );
+    m_NodeVec.reserve( ntri );
+    BuildNode( triBoxVec, cenVec, 0, ntri );
 }
 
-bool TBndBox::CheckIntersect( TBndBox* iBox  )
+//==== Binned SAH Split, Depth First Node Order ====//
+int TBvh::BuildNode( const vector< BndBox > & triBoxVec, const vector< vec3d > & cenVec, int start, int count )
 {
-    int i, j;
+    const int min_leaf = 2;
+    const int max_leaf = 8;
+    const int nbin = 16;
 
-    //==== Compare Bounding Boxes ====//
-    if ( !Compare( m_Box, iBox->m_Box ) )
+    int node = m_NodeVec.size();
+    m_NodeVec.push_back( TBvhNode() );
+
+    BndBox box, cenBox;
+    for ( int i = start ; i < start + count ; i++ )
     {
-        return false;
+        box.Update( triBoxVec[ m_TriIndex[i] ] );
+        cenBox.Update( cenVec[ m_TriIndex[i] ] );
     }
+    m_NodeVec[node].m_Box = box;
+    m_NodeVec[node].m_Start = start;
+    m_NodeVec[node].m_Count = count;
 
-    //==== Recursively Check Sub Boxes ====//
-    if ( m_SBoxVec[0] )
+    if ( count <= min_leaf )
     {
-        for ( i = 0 ; i < 8 ; i++ )
-        {
-           if ( iBox->CheckIntersect( m_SBoxVec[i] ) )
-           return true;
-        }
+        return node;
     }
-    else if ( iBox->m_SBoxVec[0] )
+
+    //==== Find Cheapest Bin Boundary Over All Three Axes ====//
+    double bestCost = 1.0e300;
+    int bestAxis = -1;
+    int bestBin = -1;
+    double boxArea = BvhBoxArea( box );
+
+    for ( int axis = 0 ; axis < 3 ; axis++ )
     {
-        for ( i = 0 ; i < 8 ; i++ )
+        double cmin = cenBox.GetMin( axis );
+        double extent = cenBox.GetMax( axis ) - cmin;
+        if ( extent <= 0.0 )
         {
-            if ( iBox->m_SBoxVec[i]->CheckIntersect( this ) )
-                return true;
+            continue;
         }
-    }
-    else
-    {
-        int coplanarFlag = 0; // Must be initialized to 0 before use in tri_tri_intersection_test_3d
-        vec3d e0;
-        vec3d e1;
 
-        //==== Check All Tris In One Box Against The Other ====//
-        for ( i = 0 ; i < ( int )m_TriVec.size() ; i++ )
+        BndBox binBox[nbin];
+        int binCount[nbin];
+        for ( int b = 0 ; b < nbin ; b++ )
         {
-            TTri* t0 = m_TriVec[i];
-            for ( j = 0 ; j < ( int )iBox->m_TriVec.size() ; j++ )
-            {
-                TTri* t1 = iBox->m_TriVec[j];
+            binCount[b] = 0;
+        }
 
-                int iflag = tri_tri_intersection_test_3d(
-                                t0->m_N0->m_Pnt.v, t0->m_N1->m_Pnt.v, t0->m_N2->m_Pnt.v,
-                                t1->m_N0->m_Pnt.v, t1->m_N1->m_Pnt.v, t1->m_N2->m_Pnt.v,
-                                &coplanarFlag, e0.v, e1.v );
+        for ( int i = start ; i < start + count ; i++ )
+        {
+            int b = ( int )( nbin * ( cenVec[ m_TriIndex[i] ][axis] - cmin ) / extent );
+            b = std::min( b, nbin - 1 );
+            binBox[b].Update( triBoxVec[ m_TriIndex[i] ] );
+            binCount[b]++;
+        }
 
-                if ( iflag && !coplanarFlag )
-                    return true;
+        //==== Sweep From The Right ====//
+        double rightArea[nbin];
+        int rightCount[nbin];
+        BndBox accBox;
+        int accCount = 0;
+        for ( int b = nbin - 1 ; b > 0 ; b-- )
+        {
+            accBox.Update( binBox[b] );
+            accCount += binCount[b];
+            rightArea[b] = BvhBoxArea( accBox );
+            rightCount[b] = accCount;
+        }
+
+        //==== Sweep From The Left ====//
+        accBox.Reset();
+        accCount = 0;
+        for ( int b = 0 ; b < nbin - 1 ; b++ )
+        {
+            accBox.Update( binBox[b] );
+            accCount += binCount[b];
+
+            if ( accCount == 0 || rightCount[b + 1] == 0 )
+            {
+                continue;
+            }
+
+            double cost = BvhBoxArea( accBox ) * accCount + rightArea[b + 1] * rightCount[b + 1];
+            if ( cost < bestCost )
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = b;
             }
         }
     }
-    return false;
-}
-
-double TBndBox::MinDistance( TBndBox* iBox, double curr_min_dist )
-{
-    int i, j;
 
-    //==== Compare Bounding Boxes ====//
-    if ( !Compare( m_Box, iBox->m_Box, curr_min_dist ) )
+    //==== Leaf If No Split Or Split Costs More Than Testing All Tris ====//
+    if ( bestAxis < 0 )
     {
-        return curr_min_dist;
+        return node;
+    }
+    if ( count <= max_leaf && boxArea > 0.0 && 1.0 + bestCost / boxArea >= count )
+    {
+        return node;
     }
 
-    //==== Recursively Check Sub Boxes ====//
-    if ( m_SBoxVec[0] )
+    double cmin = cenBox.GetMin( bestAxis );
+    double extent = cenBox.GetMax( bestAxis ) - cmin;
+
+    //==== Stable Partition About Chosen Bin Boundary ====//
+    vector< int > leftVec, rightVec;
+    leftVec.reserve( count );
+    rightVec.reserve( count );
+    for ( int i = start ; i < start + count ; i++ )
     {
-        for ( i = 0 ; i < 8 ; i++ )
+        int b = ( int )( nbin * ( cenVec[ m_TriIndex[i] ][bestAxis] - cmin ) / extent );
+        b = std::min( b, nbin - 1 );
+        if ( b <= bestBin )
         {
-            curr_min_dist = iBox->MinDistance( m_SBoxVec[i], curr_min_dist );
+            leftVec.push_back( m_TriIndex[i] );
         }
-    }
-    else if ( iBox->m_SBoxVec[0] )
-    {
-        for ( i = 0 ; i < 8 ; i++ )
+        else
         {
-            curr_min_dist = iBox->m_SBoxVec[i]->MinDistance( this, curr_min_dist );
+            rightVec.push_back( m_TriIndex[i] );
         }
     }
-    //==== Check All Points Against Other Points ====//
-    else
+
+    int nleft = leftVec.size();
+    if ( nleft == 0 || nleft == count )
     {
-        for ( i = 0 ; i < ( int )m_TriVec.size() ; i++ )
-        {
-            TTri* t0 = m_TriVec[i];
-            for ( j = 0 ; j < ( int )iBox->m_TriVec.size() ; j++ )
-            {
+        return node;
+    }
 
-                TTri* t1 = iBox->m_TriVec[j];
-                double d = tri_tri_min_dist( t0->m_N0->m_Pnt, t0->m_N1->m_Pnt, t0->m_N2->m_Pnt,
-                                             t1->m_N0->m_Pnt, t1->m_N1->m_Pnt, t1->m_N2->m_Pnt);
+    std::copy( leftVec.begin(), leftVec.end(), m_TriIndex.begin() + start );
+    std::copy( rightVec.begin(), rightVec.end(), m_TriIndex.begin() + start + nleft );
 
-                if ( d < curr_min_dist )
-                    curr_min_dist = d;
-            }
-        }
-    }
+    BuildNode( triBoxVec, cenVec, start, nleft );
+    int right = BuildNode( triBoxVec, cenVec, start + nleft, count - nleft );
+    m_NodeVec[node].m_Right = right;
 
-    return curr_min_dist;
+    return node;
 }
 
-
-void TBndBox::Intersect( TBndBox* iBox, bool UWFlag )
+void TBvh::FindLeafPairs( const TBvh & other, vector< pair< int, int > > & leafPairVec, double tol ) const
 {
-    int i;
-
-    double tol = 1e-6; // was 1e-6
-
-    if ( !Compare( m_Box, iBox->m_Box ) )
+    if ( IsEmpty() || other.IsEmpty() )
     {
         return;
     }
 
-    if ( m_SBoxVec[0] )
+    vector< pair< int, int > > stackVec;
+    stackVec.push_back( pair< int, int >( 0, 0 ) );
+
+    while ( !stackVec.empty() )
     {
-        for ( i = 0 ; i < 8 ; i++ )
+        pair< int, int > p = stackVec.back();
+        stackVec.pop_back();
+
+        const TBvhNode & n0 = m_NodeVec[ p.first ];
+        const TBvhNode & n1 = other.m_NodeVec[ p.second ];
+
+        if ( !Compare( n0.m_Box, n1.m_Box, tol ) )
         {
-            iBox->Intersect( m_SBoxVec[i], UWFlag );
+            continue;
         }
-    }
-    else if ( iBox->m_SBoxVec[0] )
-    {
-        for ( i = 0 ; i < 8 ; i++ )
+
+        if ( n0.IsLeaf() && n1.IsLeaf() )
         {
-            iBox->m_SBoxVec[i]->Intersect( this, UWFlag );
+            leafPairVec.push_back( p );
         }
-    }
-    else
-    {
-        for ( i = 0 ; i < ( int )m_TriVec.size() ; i++ )
+        //==== Descend The Larger Box, Left Child Popped First ====//
+        else if ( n1.IsLeaf() || ( !n0.IsLeaf() && n0.m_Box.DiagDist() >= n1.m_Box.DiagDist() ) )
         {
-            TTri* t0 = m_TriVec[i];
-            for ( int j = 0 ; j < ( int )iBox->m_TriVec.size() ; j++ )
-            {
-                TTri* t1 = iBox->m_TriVec[j];
-
-                int coplanarFlag = 0; // Must be initialized to 0 before use in tri_tri_intersection_test_3d
-                vec3d e0;
-                vec3d e1;
-
-                int iflag = tri_tri_intersection_test_3d(
-                                t0->m_N0->m_Pnt.v, t0->m_N1->m_Pnt.v, t0->m_N2->m_Pnt.v,
-                                t1->m_N0->m_Pnt.v, t1->m_N1->m_Pnt.v, t1->m_N2->m_Pnt.v,
-                                &coplanarFlag, e0.v, e1.v );
-
-                if ( iflag && !coplanarFlag )
-                {
-                    if ( UWFlag )
-                    {
-                        if ( dist( e0, e1 ) > tol ) // was 1e-6
-                        {
-                            // Figure out with tri has xyz info
-                            TTri* tri;
-                            int d_info = TNode::HAS_XYZ; // desired info number
-                            if ( ( t0->m_N0->GetCoordInfo() & d_info ) == d_info &&  ( t0->m_N1->GetCoordInfo() & d_info ) == d_info
-                                    && ( t0->m_N2->GetCoordInfo() & d_info ) == d_info )
-                            {
-                                tri = t0;
-                            }
-                            else
-                            {
-                                tri = t1;
-                            }
-                            // Use Bilinear interpolation to convert edge uw points to xyz points
-                            vec3d e0xyz = tri->CompPnt( e0 );
-                            vec3d e1xyz = tri->CompPnt( e1 );
-
-                            // Create the new edges
-
-                            TEdge* ie0 = new TEdge();
-                            int info = TNode::HAS_UW | TNode::HAS_XYZ;
-                            ie0->m_N0 = new TNode();
-                            ie0->m_N0->SetUWPnt( e0 );
-                            ie0->m_N0->SetXYZPnt( e0xyz );
-                            ie0->m_N0->MakePntUW();
-                            ie0->m_N0->SetCoordInfo( info );
-                            ie0->m_N1 = new TNode();
-                            ie0->m_N1->SetUWPnt( e1 );
-                            ie0->m_N1->SetXYZPnt( e1xyz );
-                            ie0->m_N1->MakePntUW();
-                            ie0->m_N1->SetCoordInfo( info );
-
-                            TEdge* ie1 = new TEdge();
-                            ie1->m_N0 = new TNode();
-                            ie1->m_N0->SetUWPnt( e0 );
-                            ie1->m_N0->SetXYZPnt( e0xyz );
-                            ie1->m_N0->MakePntUW();
-                            ie1->m_N0->SetCoordInfo( info );
-                            ie1->m_N1 = new TNode();
-                            ie1->m_N1->SetUWPnt( e1 );
-                            ie1->m_N1->SetXYZPnt( e1xyz );
-                            ie1->m_N1->MakePntUW();
-                            ie1->m_N1->SetCoordInfo( info );
-
-                            t0->m_ISectEdgeVec.push_back( ie0 );
-                            t1->m_ISectEdgeVec.push_back( ie1 );
-
-                            if ( tri->GetTMeshPtr() )
-                            {
-                                tri->GetTMeshPtr()->SplitAliasEdges( tri, tri->m_ISectEdgeVec.back() );
-                            }
-
-                        }
-                    }
-                    else
-                    {
-                        if ( dist( e0, e1 ) > tol )
-                        {
-                            TEdge* ie0 = new TEdge();
-                            int info = TNode::HAS_UW | TNode::HAS_XYZ;
-                            ie0->m_N0 = new TNode();
-                            ie0->m_N0->m_Pnt = e0;
-                            ie0->m_N0->m_UWPnt = t0->CompUW( e0 );
-                            ie0->m_N0->SetCoordInfo( info );
-                            ie0->m_N1 = new TNode();
-                            ie0->m_N1->m_Pnt = e1;
-                            ie0->m_N1->m_UWPnt = t0->CompUW( e1 );
-                            ie0->m_N1->SetCoordInfo( info );
-
-                            TEdge* ie1 = new TEdge();
-                            ie1->m_N0 = new TNode();
-                            ie1->m_N0->m_Pnt = e0;
-                            ie1->m_N0->m_UWPnt = t1->CompUW( e0 );
-                            ie1->m_N0->SetCoordInfo( info );
-                            ie1->m_N1 = new TNode();
-                            ie1->m_N1->m_Pnt = e1;
-                            ie1->m_N1->m_UWPnt = t1->CompUW( e1 );
-                            ie1->m_N1->SetCoordInfo( info );
-
-                            t0->m_ISectEdgeVec.push_back( ie0 );
-                            t1->m_ISectEdgeVec.push_back( ie1 );
-                        }
-                    }
-                }
-            }
+            stackVec.push_back( pair< int, int >( n0.m_Right, p.second ) );
+            stackVec.push_back( pair< int, int >( p.first + 1, p.second ) );
+        }
+        else
+        {
+            stackVec.push_back( pair< int, int >( p.first, n1.m_Right ) );
+            stackVec.push_back( pair< int, int >( p.first, p.second + 1 ) );
         }
     }
 }
 
-void  TBndBox::RayCast( vec3d & orig, vec3d & dir, vector<double> & tParmVec )
+void TBvh::FindRayTris( const vec3d & orig, const vec3d & dir, vector< int > & triVec ) const
 {
-    int i;
-
-    double coord[3];
-
-    if( !intersectRayAABB( m_Box.GetMin().v, m_Box.GetMax().v, orig.v, dir.v, coord ) )
-    {
-        return;
-    }
-
-    if ( m_SBoxVec[0] )
+    if ( IsEmpty() )
     {
-        for ( i = 0 ; i < 8 ; i++ )
-        {
-            m_SBoxVec[i]->RayCast( orig, dir, tParmVec );
-        }
         return;
     }
 
-    //==== Check All Tris In Box ====//
-    double tparm, uparm, vparm;
+    double coord[3];
+    vector< int > stackVec;
+    stackVec.push_back( 0 );
 
-    for ( i = 0 ; i < ( int )m_TriVec.size() ; i++ )
+    while ( !stackVec.empty() )
     {
-        TTri* tri = m_TriVec[i];
-        int iFlag = intersect_triangle( orig.v, dir.v,
-                                        tri->m_N0->m_Pnt.v, tri->m_N1->m_Pnt.v, tri->m_N2->m_Pnt.v, &tparm, &uparm, &vparm );
+        int n = stackVec.back();
+        stackVec.pop_back();
 
-        if ( iFlag && tparm > 0.0 )
+        const TBvhNode & node = m_NodeVec[n];
+        if ( !intersectRayAABB( node.m_Box.GetMin().v, node.m_Box.GetMax().v, orig.v, dir.v, coord ) )
         {
-            //==== Find If T is Already Included ====//
-            int dupFlag = 0;
-            for ( int j = 0 ; j < ( int )tParmVec.size() ; j++ )
-            {
-                if ( std::abs( tparm - tParmVec[j] ) < 0.0000001 )
-                {
-                    dupFlag = 1;
-                    break;
-                }
-            }
+            continue;
+        }
 
-            if ( !dupFlag )
+        if ( node.IsLeaf() )
+        {
+            for ( int i = node.m_Start ; i < node.m_Start + node.m_Count ; i++ )
             {
-                tParmVec.push_back( tparm );
+                triVec.push_back( m_TriIndex[i] );
             }
         }
+        else
+        {
+            stackVec.push_back( node.m_Right );
+            stackVec.push_back( n + 1 );
+        }
     }
-
 }
 
 //===============================================//
@@ -3165,8 +4271,8 @@ void TMesh::BuildNodeMaps()
         pnCloud.AddPntNode( m_NVec[n]->m_Pnt );
     }
 
-    //==== Use NanoFlann to Find Close Points and Group ====//
-    IndexPntNodes( pnCloud, tol );
+    //==== Use Hash Grid to Find Close Points and Group ====//
+    WeldPntNodes( pnCloud, tol );
 
     for ( n = 0 ; n < ( int )m_NVec.size() ; n++ )
     {
@@ -3239,10 +4345,22 @@ void TMesh::DeleteDupNodes()
         m_TVec[t]->m_N2->m_TriVec.push_back( m_TVec[t] );
     }
 
+    //==== Keep Masters In NVec Order, Not Pointer Order ====//
+    vector< TNode* > masterVec;
+    masterVec.reserve( m_NAMap.size() );
+    for ( int n = 0 ; n < ( int )m_NVec.size() ; n++ )
+    {
+        if ( m_NAMap.count( m_NVec[n] ) )
+        {
+            masterVec.push_back( m_NVec[n] );
+        }
+    }
+
     //==== Nuke Redundant Nodes And Update NVec ====//
     m_NVec.clear();
-    for ( mit = m_NAMap.begin() ; mit != m_NAMap.end() ; ++mit )
+    for ( int n = 0 ; n < ( int )masterVec.size() ; n++ )
     {
+        mit = m_NAMap.find( masterVec[n] );
         TNode* nk = mit->first;
         list< TNode* >& dnodes =  mit->second;
 
@@ -3432,8 +4550,39 @@ void TMesh::CheckValid( FILE* fid )
         {
             fprintf( fid, "There are %d Invalid Triangles\n", ( int )ivTriVec.size() );
         }
+
+        MeshTopology topo;
+        CheckTopology( topo );
+        fprintf( fid, "  %d Open Edges, %d Edges > 2 Tris, %d Flipped Edges\n", ( int )topo.m_OpenEdgeVec.size(),
+                 ( int )topo.m_NonManifoldEdgeVec.size(), ( int )topo.m_FlippedEdgeVec.size() );
+    }
+
+}
+
+void TMesh::CheckTopology( MeshTopology & topo )
+{
+    //==== Number Nodes Through m_ID, Then Put It Back ====//
+    vector< int > saveID( m_NVec.size() );
+    for ( int n = 0 ; n < ( int )m_NVec.size() ; n++ )
+    {
+        saveID[n] = m_NVec[n]->m_ID;
+        m_NVec[n]->m_ID = n;
     }
 
+    vector< int > triNodes( 3 * m_TVec.size() );
+    for ( int t = 0 ; t < ( int )m_TVec.size() ; t++ )
+    {
+        triNodes[ 3 * t ] = m_TVec[t]->m_N0->m_ID;
+        triNodes[ 3 * t + 1 ] = m_TVec[t]->m_N1->m_ID;
+        triNodes[ 3 * t + 2 ] = m_TVec[t]->m_N2->m_ID;
+    }
+
+    for ( int n = 0 ; n < ( int )m_NVec.size() ; n++ )
+    {
+        m_NVec[n]->m_ID = saveID[n];
+    }
+
+    topo.CheckTris( triNodes );
 }
 
 
@@ -3859,24 +5008,26 @@ void TMesh::SubTag( int part_num, bool tag_subs )
     if ( tag_subs ) sub_surfs = SubSurfaceMgr.GetSubSurfs( m_PtrID, m_SurfNum );
     int ss_num = ( int )sub_surfs.size();
 
+    vector< int > tags;
     for ( int t = 0 ; t < ( int )m_TVec.size(); t ++ )
     {
         TTri* tri = m_TVec[t];
-        tri->m_Tags.clear();
-        tri->m_Tags.push_back( part_num ); // Give Tri overall surface ID number
+        tags.clear();
+        tags.push_back( part_num ); // Give Tri overall surface ID number
         for ( int s = 0; s < ss_num; s++ )
         {
             if ( sub_surfs[s]->Subtag( tri ) )
             {
-                tri->m_Tags.push_back( sub_surfs[s]->m_Tag );
+                tags.push_back( sub_surfs[s]->m_Tag );
             }
         }
 
-        SubSurfaceMgr.m_TagCombos.insert( tri->m_Tags );
+        tri->SetTags( tags );
+        SubSurfaceMgr.m_TagCombos.insert( tags );
 
         for ( int st = 0; st < ( int )tri->m_SplitVec.size() ; st++ ) // Set split tris to have same tags as main tri
         {
-            tri->m_SplitVec[st]->m_Tags = tri->m_Tags;
+            tri->m_SplitVec[st]->m_TagIndex = tri->m_TagIndex;
         }
     }
 }
@@ -4077,3 +5228,93 @@ void BuildTMeshTris( TMesh *tmesh, bool flipnormal, double wmax )
         }
     }
 }
+
+//==== Flood Fill Tris Across Unblocked Shared Edges ====//
+int BuildTriRegions( const vector< vec3d > & cornerVec, const vector< bool > & blockVec, vector< int > & regionVec )
+{
+    int ntri = blockVec.size();
+    regionVec.assign( ntri, -1 );
+
+    //==== Merge Coincident Corners ====//
+    PntNodeCloud pnCloud;
+    pnCloud.AddPntNodes( cornerVec );
+    WeldPntNodes( pnCloud, 1.0e-12 );
+
+    vector< int > nodeVec( cornerVec.size() );
+    vector< bool > nodeBlockVec( cornerVec.size(), false );
+    for ( int i = 0 ; i < ( int )cornerVec.size() ; i++ )
+    {
+        nodeVec[i] = pnCloud.GetNodeBaseIndex( i );
+    }
+    for ( int t = 0 ; t < ntri ; t++ )
+    {
+        if ( blockVec[t] )
+        {
+            for ( int k = 0 ; k < 3 ; k++ )
+            {
+                nodeBlockVec[ nodeVec[ 3 * t + k ] ] = true;
+            }
+        }
+    }
+
+    //==== Walk Tris Sharing Each Free Edge ====//
+    map< pair< int, int >, vector< int > > edgeTriMap;
+    for ( int t = 0 ; t < ntri ; t++ )
+    {
+        if ( blockVec[t] )
+        {
+            continue;
+        }
+        for ( int k = 0 ; k < 3 ; k++ )
+        {
+            int n0 = nodeVec[ 3 * t + k ];
+            int n1 = nodeVec[ 3 * t + ( k + 1 ) % 3 ];
+            if ( n0 != n1 && !nodeBlockVec[n0] && !nodeBlockVec[n1] )
+            {
+                edgeTriMap[ pair< int, int >( min( n0, n1 ), max( n0, n1 ) ) ].push_back( t );
+            }
+        }
+    }
+
+    vector< vector< int > > adjVec( ntri );
+    map< pair< int, int >, vector< int > >::iterator eit;
+    for ( eit = edgeTriMap.begin() ; eit != edgeTriMap.end() ; ++eit )
+    {
+        const vector< int > & triVec = eit->second;
+        for ( int i = 1 ; i < ( int )triVec.size() ; i++ )
+        {
+            adjVec[ triVec[0] ].push_back( triVec[i] );
+            adjVec[ triVec[i] ].push_back( triVec[0] );
+        }
+    }
+
+    int nregion = 0;
+    vector< int > stackVec;
+    for ( int t = 0 ; t < ntri ; t++ )
+    {
+        if ( blockVec[t] || regionVec[t] >= 0 )
+        {
+            continue;
+        }
+
+        regionVec[t] = nregion;
+        stackVec.push_back( t );
+        while ( !stackVec.empty() )
+        {
+            int c = stackVec.back();
+            stackVec.pop_back();
+            for ( int i = 0 ; i < ( int )adjVec[c].size() ; i++ )
+            {
+                int a = adjVec[c][i];
+                if ( regionVec[a] < 0 )
+                {
+                    regionVec[a] = nregion;
+                    stackVec.push_back( a );
+                }
+            }
+        }
+        nregion++;
+    }
+
+    return nregion;
+}
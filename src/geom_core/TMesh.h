@@ -29,6 +29,7 @@
 #include <string>
 #include <map>
 #include <list>
+#include <stdint.h>
 using namespace std;            //jrg windows??
 
 class TEdge;
@@ -36,6 +37,7 @@ class TTri;
 class TBndBox;
 class NBndBox;
 class TMesh;
+class MeshTopology;
 
 class TetraMassProp
 {
@@ -266,6 +268,32 @@ protected:
 
 
 
+//==== Shared Tables For Per Tri Metadata ====//
+// Geom IDs and sub-surface tag combinations are stored once here and tris
+// keep small indices into them.  Index zero is the empty ID and the empty
+// tag combination.  Interning and lookups share one lock so both may be
+// called from the parallel CompGeom loops.  Every TTri registers itself, and
+// Reset (called from Vehicle::Wype) only clears the tables once no tri holds
+// an index.
+class TTriTable
+{
+public:
+    static int InternID( const string & id );
+    static const string & GetID( int index );
+
+    static int InternTags( const vector< int > & tags );
+    static const vector< int > & GetTags( int index );
+
+    static void AttachTri();
+    static void DetachTri();
+    static int NumTris();
+    static bool Reset();
+
+    static int NumIDs();
+    static int NumTagCombos();
+    static size_t MemoryUsage();
+};
+
 class TTri
 {
 public:
@@ -340,10 +368,29 @@ public:
 
     virtual int WakeEdge();
 
+    const string & GetID() const
+    {
+        return TTriTable::GetID( m_IDIndex );
+    }
+    void SetID( const string & id )
+    {
+        m_IDIndex = TTriTable::InternID( id );
+    }
+    const vector< int > & GetTags() const
+    {
+        return TTriTable::GetTags( m_TagIndex );
+    }
+    void SetTags( const vector< int > & tags )
+    {
+        m_TagIndex = TTriTable::InternTags( tags );
+    }
+    virtual bool GetInsideSurf( int m ) const;
+
     bool m_IgnoreTriFlag;
-    vector< bool > m_insideSurf;
-    string m_ID;
-    vector<int> m_Tags;
+    bool m_ISectFlag;       // Crossed by another mesh, even where the segment was too short to split on
+    int m_IDIndex;          // Into TTriTable IDs
+    int m_TagIndex;         // Into TTriTable tag combinations
+    int m_InsideIndex;      // Slot in the owning TMesh inside flag table, -1 if not classified
     double m_Density;
     int m_InvalidFlag;
 
@@ -360,6 +407,8 @@ private:
 
 };
 
+//==== Overall Mesh Box And Tri Pair Intersection Helpers ====//
+// Queries go through TMesh::m_Bvh.
 class TBndBox
 {
 public:
@@ -369,17 +418,75 @@ public:
     virtual void Reset();
 
     BndBox m_Box;
-    vector< TTri* > m_TriVec;
-
-    TBndBox* m_SBoxVec[8];      // Split Bnd Boxes
 
-    void SplitBox();
     void AddTri( TTri* t );
-    virtual void Intersect( TBndBox* iBox, bool UWFlag = false );
-    virtual void RayCast( vec3d & orig, vec3d & dir, vector<double> & tParmVec );
+    static void IntersectTris( TTri* t0, TTri* t1, bool UWFlag );
+    static void AddISectEdges( TTri* t0, TTri* t1, const vec3d & e0, const vec3d & e1 );
+    static void AddISectEdge( TTri* t, const vec3d & e0, const vec3d & e1 );
+
+};
+
+//==== Intersection Segment Between Two Tris, Indexed Into Each m_TVec ====//
+// Crossings shorter than the split tolerance are kept so both tris are still
+// flagged as crossed.
+class TISectSeg
+{
+public:
+    int m_T0;
+    int m_T1;
+    vec3d m_E0;
+    vec3d m_E1;
+};
+
+//==== Bounding Volume Hierarchy Node ====//
+class TBvhNode
+{
+public:
+    TBvhNode()
+    {
+        m_Right = -1;
+        m_Start = 0;
+        m_Count = 0;
+    }
+
+    bool IsLeaf() const
+    {
+        return m_Right < 0;
+    }
+
+    BndBox m_Box;
+    int m_Right;                // Right child index, left child is the next node.  -1 for leaf.
+    int m_Start;                // Leaf range into TBvh::m_TriIndex
+    int m_Count;
+};
+
+//==== Surface Area Heuristic Bounding Volume Hierarchy ====//
+// Nodes are stored depth first in one array.  Tri indices refer to the
+// order of the tri boxes passed to Build.
+class TBvh
+{
+public:
+    TBvh();
+    virtual ~TBvh();
+
+    virtual void Reset();
+    virtual void Build( const vector< BndBox > & triBoxVec );
+
+    bool IsEmpty() const
+    {
+        return m_NodeVec.empty();
+    }
 
-    virtual bool CheckIntersect( TBndBox* iBox );
-    virtual double MinDistance( TBndBox* iBox, double curr_min_dist );
+    // Pairs of leaf nodes with overlapping boxes, in a fixed traversal order
+    virtual void FindLeafPairs( const TBvh & other, vector< pair< int, int > > & leafPairVec, double tol = 1.0e-12 ) const;
+    // Tris in leaf nodes whose boxes are hit by the ray
+    virtual void FindRayTris( const vec3d & orig, const vec3d & dir, vector< int > & triVec ) const;
+
+    vector< TBvhNode > m_NodeVec;
+    vector< int > m_TriIndex;
+
+protected:
+    int BuildNode( const vector< BndBox > & triBoxVec, const vector< vec3d > & cenVec, int start, int count );
 
 };
 
@@ -396,13 +503,20 @@ public:
     vector< TEdge* > m_EVec;
 
     TBndBox m_TBox;
+    TBvh m_Bvh;
 
     void copy( TMesh* m );
     void CopyFlatten( TMesh* m );
     virtual xmlNodePtr EncodeXml( xmlNodePtr & node );
     virtual void DecodeXml( xmlNodePtr & node );
+    // Legacy layout, one Tri node of text coordinates per tri.  Still read.
     virtual xmlNodePtr EncodeTriList( xmlNodePtr & node );
     virtual void DecodeTriList( xmlNodePtr & node, int num_tris );
+    // Shared node, tri index, normal and tag arrays as base64 binary.  Decode
+    // returns false, leaving the mesh empty, if the arrays are inconsistent or
+    // do not hold num_tris tris (when num_tris >= 0).
+    virtual xmlNodePtr EncodeTriData( xmlNodePtr & node );
+    virtual bool DecodeTriData( xmlNodePtr & node, int num_tris = -1 );
 
     //==== Stuff Copied From Geom That Created This Mesh ====//
     string m_PtrID;
@@ -428,12 +542,23 @@ public:
     double m_WetVol;
     vec3d m_AreaCenter;
 
+    int m_CacheID;      // CompGeomCache mesh this was copied from, -1 if not cached or since modified
+
     void LoadGeomAttributes( const Geom* geomPtr );
     int  RemoveDegenerate();
     void RemoveIsectEdges();
     void Intersect( TMesh* tm, bool UWFlag = false );
+    // Split form of Intersect( tm ): Find only reads both meshes and may be run
+    // concurrently, Add creates the edges on the tris of both meshes.
+    void FindISectSegs( TMesh* tm, vector< TISectSeg > & segVec );
+    void AddISectSegs( TMesh* tm, const vector< TISectSeg > & segVec );
+    // Only this mesh gets the edges, for cutting planes against a shared mesh.
+    void AddOwnISectSegs( const vector< TISectSeg > & segVec );
     bool CheckIntersect( TMesh* tm );
     double MinDistance( TMesh* tm, double curr_min_dist );
+    // near_pnt is only set when a tri closer than curr_min_dist is found.
+    double MinDistance( const vec3d & pnt, double curr_min_dist, vec3d & near_pnt );
+    void RayCast( vec3d & orig, vec3d & dir, vector<double> & tParmVec );
     void Split();
 
     bool DecideIgnoreTri( int aType, const vector < int > & bTypes, const vector < bool > & thicksurf, const vector < bool > & aInB );
@@ -441,9 +566,25 @@ public:
     void IgnoreYLessThan( const double & ytol );
 
     void DeterIntExt( vector< TMesh* >& meshVec );
-    void DeterIntExtTri( TTri* tri, vector< TMesh* >& meshVec );
-
-    void LoadBndBox();
+    // idVec holds the TTriTable index of each mesh's m_PtrID
+    void DeterIntExtTri( TTri* tri, vector< TMesh* >& meshVec, const vector< int > & idVec );
+    // Classify whole regions bounded by intersected tris with one ray vote each
+    void DeterIntExtRegions( vector< TMesh* >& meshVec );
+    void DeterIntExtRegion( const vector< TTri* > & triVec, vector< TMesh* >& meshVec, const vector< int > & idVec );
+
+    //==== Packed Inside Flags Of Classified Tris, m_InsideWords Per Slot ====//
+    void ResetInside( int nmesh );
+    int AddInside();
+    void SetInside( int slot, int m );
+    bool GetInside( int slot, int m ) const;
+    void GetInsideVec( int slot, vector< bool > & insideVec ) const;
+
+    vector< uint32_t > m_InsideBits;
+    int m_InsideWords;
+    int m_NumInsideMeshes;
+
+    // Tree may be passed in when it was built for identical tris (CompGeomCache)
+    void LoadBndBox( const TBvh* bvh = NULL );
 
     virtual double ComputeTheoArea();
     virtual double ComputeWetArea();
@@ -481,6 +622,8 @@ public:
 
     virtual void MatchNodes();
     virtual void CheckValid( FILE* fid );
+    // Open, non-manifold and flipped edges of the tris as they are numbered in m_NVec.
+    virtual void CheckTopology( MeshTopology & topo );
     virtual void SwapEdges( double size );
     virtual vec3d ProjectOnISectPairs( vec3d & offPnt, vector< vec3d > & pairVec );
 
@@ -531,4 +674,9 @@ void CreateTMeshVecFromPts( const Geom * geom,
                             int indx, int surftype, int cfdsurftype, bool thicksurf, bool flipnormal, double wmax );
 
 void BuildTMeshTris( TMesh *tmesh, bool f_norm, double wmax );
+
+// Group tris (three corners each in cornerVec) into regions connected across
+// shared edges.  Blocked tris and edges touching their corners are not
+// crossed, blocked tris get region -1.  Returns the number of regions.
+int BuildTriRegions( const vector< vec3d > & cornerVec, const vector< bool > & blockVec, vector< int > & regionVec );
 #endif
@@ -0,0 +1,272 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// UpdateProfileMgr.cpp: Wall clock time spent in each stage of each Geom update
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "UpdateProfileMgr.h"
+#include "ResultsMgr.h"
+#include "VehicleMgr.h"
+#include "Vehicle.h"
+
+#include <cstdio>
+
+#ifdef VSP_USE_OPENMP
+#include <omp.h>
+#endif
+
+// Events past this many are counted but not kept.
+static const int MAX_TRACE_EVENTS = 1 << 22;
+
+UpdateProfileMgrSingleton::UpdateProfileMgrSingleton()
+{
+    m_Enabled = false;
+    m_TraceFlag = false;
+    Reset();
+}
+
+string UpdateProfileMgrSingleton::GetStageName( int stage )
+{
+    static const char* names[NUM_STAGES] = { "UpdateSurf", "UpdateXForm", "UpdateEndCaps", "UpdateFeatureLines",
+                                             "UpdateFlags", "UpdatePreTess", "UpdateSymmAttach", "UpdateSurfVec",
+                                             "SubSurfaces", "FeaStructures", "UpdateMainTessVec",
+                                             "UpdateMainDegenGeomPreview", "UpdateTessVec", "UpdateDegenGeomPreview",
+                                             "UpdateBBox", "UpdateDrawObj", "UpdateHighlightDrawObj",
+                                             "LinkMgr", "AdvLinkMgr"
+                                           };
+
+    if ( stage < 0 || stage >= NUM_STAGES )
+    {
+        return string();
+    }
+    return string( names[stage] );
+}
+
+void UpdateProfileMgrSingleton::Start( bool trace_flag )
+{
+    Reset();
+    m_TraceFlag = trace_flag;
+    m_Enabled = true;
+}
+
+void UpdateProfileMgrSingleton::Stop()
+{
+    m_Enabled = false;
+}
+
+void UpdateProfileMgrSingleton::Reset()
+{
+    m_NumDropped = 0;
+    m_IDVec.clear();
+    m_StatMap.clear();
+    m_EventVec.clear();
+    m_Origin = std::chrono::steady_clock::now();
+}
+
+double UpdateProfileMgrSingleton::GetTime() const
+{
+    return std::chrono::duration< double >( std::chrono::steady_clock::now() - m_Origin ).count();
+}
+
+void UpdateProfileMgrSingleton::AddStage( const string & id, int stage, double start, double dur )
+{
+    if ( stage < 0 || stage >= NUM_STAGES )
+    {
+        return;
+    }
+
+    int thread = 0;
+#ifdef VSP_USE_OPENMP
+    thread = omp_get_thread_num();
+#endif
+
+    // Stages of different Geoms may finish on different threads.
+#ifdef VSP_USE_OPENMP
+#pragma omp critical( update_profile )
+#endif
+    {
+        map< string, vector< UpdateStageStat > >::iterator it = m_StatMap.find( id );
+        if ( it == m_StatMap.end() )
+        {
+            m_IDVec.push_back( id );
+            it = m_StatMap.insert( std::make_pair( id, vector< UpdateStageStat >( NUM_STAGES ) ) ).first;
+        }
+
+        UpdateStageStat & stat = it->second[ stage ];
+        stat.m_Count++;
+        stat.m_Total += dur;
+        if ( dur > stat.m_Max )
+        {
+            stat.m_Max = dur;
+        }
+
+        if ( m_TraceFlag )
+        {
+            if ( ( int )m_EventVec.size() < MAX_TRACE_EVENTS )
+            {
+                UpdateStageEvent ev;
+                ev.m_ID = id;
+                ev.m_Stage = stage;
+                ev.m_Thread = thread;
+                ev.m_Start = start;
+                ev.m_Dur = dur;
+                m_EventVec.push_back( ev );
+            }
+            else
+            {
+                m_NumDropped++;
+            }
+        }
+    }
+}
+
+int UpdateProfileMgrSingleton::GetNumCalls( const string & id, int stage ) const
+{
+    map< string, vector< UpdateStageStat > >::const_iterator it = m_StatMap.find( id );
+    if ( it == m_StatMap.end() || stage < 0 || stage >= NUM_STAGES )
+    {
+        return 0;
+    }
+    return it->second[ stage ].m_Count;
+}
+
+string UpdateProfileMgrSingleton::GetGeomName( const string & id ) const
+{
+    Vehicle* veh = VehicleMgr.GetVehicle();
+    if ( veh )
+    {
+        Geom* geom = veh->FindGeom( id );
+        if ( geom )
+        {
+            return geom->GetName();
+        }
+    }
+    return id;
+}
+
+string UpdateProfileMgrSingleton::CreateResults()
+{
+    Results* res = ResultsMgr.CreateResults( "Update_Profile" );
+    if ( !res )
+    {
+        return string();
+    }
+
+    vector< string > id_vec, name_vec, stage_vec;
+    vector< int > count_vec;
+    vector< double > total_vec, max_vec;
+
+    vector< string > geom_name_vec;
+    vector< double > geom_total_vec;
+
+    for ( int i = 0 ; i < ( int )m_IDVec.size() ; i++ )
+    {
+        const vector< UpdateStageStat > & stat_vec = m_StatMap[ m_IDVec[i] ];
+        string name = GetGeomName( m_IDVec[i] );
+
+        double geom_total = 0;
+        for ( int s = 0 ; s < NUM_STAGES ; s++ )
+        {
+            if ( stat_vec[s].m_Count == 0 )
+            {
+                continue;
+            }
+
+            id_vec.push_back( m_IDVec[i] );
+            name_vec.push_back( name );
+            stage_vec.push_back( GetStageName( s ) );
+            count_vec.push_back( stat_vec[s].m_Count );
+            total_vec.push_back( stat_vec[s].m_Total );
+            max_vec.push_back( stat_vec[s].m_Max );
+
+            if ( s != LINK_STAGE && s != ADV_LINK_STAGE )
+            {
+                geom_total += stat_vec[s].m_Total;
+            }
+        }
+
+        geom_name_vec.push_back( name );
+        geom_total_vec.push_back( geom_total );
+    }
+
+    res->Add( NameValData( "Num_Rows", ( int )id_vec.size() ) );
+    res->Add( NameValData( "Geom_ID", id_vec ) );
+    res->Add( NameValData( "Geom_Name", name_vec ) );
+    res->Add( NameValData( "Stage", stage_vec ) );
+    res->Add( NameValData( "Num_Calls", count_vec ) );
+    res->Add( NameValData( "Total_Time", total_vec ) );
+    res->Add( NameValData( "Max_Time", max_vec ) );
+
+    res->Add( NameValData( "Num_Geoms", ( int )m_IDVec.size() ) );
+    res->Add( NameValData( "Geom_Total_ID", m_IDVec ) );
+    res->Add( NameValData( "Geom_Total_Name", geom_name_vec ) );
+    res->Add( NameValData( "Geom_Total_Time", geom_total_vec ) );
+
+    res->Add( NameValData( "Elapsed_Time", GetTime() ) );
+
+    return res->GetID();
+}
+
+// Quote and escape for JSON.
+static string JsonString( const string & str )
+{
+    string out = "\"";
+    for ( int i = 0 ; i < ( int )str.size() ; i++ )
+    {
+        unsigned char c = str[i];
+        if ( c == '"' || c == '\\' )
+        {
+            out += '\\';
+            out += c;
+        }
+        else if ( c < 0x20 )
+        {
+            char buf[8];
+            snprintf( buf, sizeof( buf ), "\\u%04x", c );
+            out += buf;
+        }
+        else
+        {
+            out += c;
+        }
+    }
+    out += "\"";
+    return out;
+}
+
+bool UpdateProfileMgrSingleton::WriteChromeTrace( const string & file_name ) const
+{
+    FILE* fp = fopen( file_name.c_str(), "w" );
+    if ( !fp )
+    {
+        return false;
+    }
+
+    map< string, string > name_map;
+    for ( int i = 0 ; i < ( int )m_IDVec.size() ; i++ )
+    {
+        name_map[ m_IDVec[i] ] = GetGeomName( m_IDVec[i] );
+    }
+
+    // Complete events, times in microseconds.
+    fprintf( fp, "{\"traceEvents\":[\n" );
+    for ( int i = 0 ; i < ( int )m_EventVec.size() ; i++ )
+    {
+        const UpdateStageEvent & ev = m_EventVec[i];
+        string name = name_map[ ev.m_ID ];
+
+        fprintf( fp, "{\"name\":%s,\"cat\":%s,\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,"
+                 "\"args\":{\"id\":%s,\"geom\":%s}}%s\n",
+                 JsonString( GetStageName( ev.m_Stage ) ).c_str(), JsonString( name ).c_str(),
+                 ev.m_Start * 1.0e6, ev.m_Dur * 1.0e6, ev.m_Thread,
+                 JsonString( ev.m_ID ).c_str(), JsonString( name ).c_str(),
+                 i + 1 < ( int )m_EventVec.size() ? "," : "" );
+    }
+    fprintf( fp, "],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":{\"dropped_events\":%d}}\n", m_NumDropped );
+
+    fclose( fp );
+    return true;
+}
@@ -0,0 +1,150 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// UpdateProfileMgr.h: Wall clock time spent in each stage of each Geom update
+//
+// Geom::Update and link propagation place an UpdateStageTimer around each
+// stage.  While profiling is off a timer only tests a flag.  While it is on,
+// each stage adds to per Geom aggregates and, when tracing, is kept as an
+// event for a Chrome trace (chrome://tracing or Perfetto).
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(VSP_UPDATE_PROFILE_MANAGER__INCLUDED_)
+#define VSP_UPDATE_PROFILE_MANAGER__INCLUDED_
+
+#include <vector>
+#include <string>
+#include <map>
+#include <chrono>
+
+using std::vector;
+using std::string;
+using std::map;
+
+//==== Aggregate Of One Stage Of One Geom ====//
+class UpdateStageStat
+{
+public:
+    UpdateStageStat() : m_Count( 0 ), m_Total( 0 ), m_Max( 0 ) {}
+
+    int m_Count;
+    double m_Total;     // Seconds
+    double m_Max;
+};
+
+//==== One Timed Stage ====//
+class UpdateStageEvent
+{
+public:
+    string m_ID;
+    int m_Stage;
+    int m_Thread;
+    double m_Start;     // Seconds since Reset
+    double m_Dur;
+};
+
+class UpdateProfileMgrSingleton
+{
+public:
+    static UpdateProfileMgrSingleton& getInstance()
+    {
+        static UpdateProfileMgrSingleton instance;
+        return instance;
+    }
+
+    enum { SURF_STAGE, XFORM_STAGE, END_CAPS_STAGE, FEATURE_LINES_STAGE, FLAGS_STAGE, PRE_TESS_STAGE,
+           SYMM_ATTACH_STAGE, SURF_VEC_STAGE, SUB_SURF_STAGE, FEA_STRUCT_STAGE, MAIN_TESS_STAGE,
+           MAIN_DEGEN_PREVIEW_STAGE, TESS_VEC_STAGE, DEGEN_PREVIEW_STAGE, BBOX_STAGE, DRAW_OBJ_STAGE,
+           HIGHLIGHT_DRAW_OBJ_STAGE,
+           LINK_STAGE,          // Includes the updates the link sets off
+           ADV_LINK_STAGE,      // Includes the updates the link sets off
+           NUM_STAGES
+         };
+
+    static string GetStageName( int stage );
+
+    // Profiling starts from an empty record.  trace_flag also keeps every
+    // event for WriteChromeTrace.
+    void Start( bool trace_flag = false );
+    void Stop();
+    void Reset();
+
+    bool IsEnabled() const
+    {
+        return m_Enabled;
+    }
+
+    double GetTime() const;     // Seconds since Reset
+    void AddStage( const string & id, int stage, double start, double dur );
+
+    // One row per Geom and stage that ran, then one total per Geom
+    // (link stages excluded, as they include other updates).
+    string CreateResults();
+    bool WriteChromeTrace( const string & file_name ) const;
+
+    // Times stage ran for Geom id since Start.
+    int GetNumCalls( const string & id, int stage ) const;
+
+    int GetNumDroppedEvents() const
+    {
+        return m_NumDropped;
+    }
+
+private:
+
+    UpdateProfileMgrSingleton();
+    UpdateProfileMgrSingleton( UpdateProfileMgrSingleton const& copy );            // Not Implemented
+    UpdateProfileMgrSingleton& operator=( UpdateProfileMgrSingleton const& copy ); // Not Implemented
+
+    string GetGeomName( const string & id ) const;
+
+    bool m_Enabled;
+    bool m_TraceFlag;
+    int m_NumDropped;
+
+    std::chrono::steady_clock::time_point m_Origin;
+
+    vector< string > m_IDVec;                       // In order first seen
+    map< string, vector< UpdateStageStat > > m_StatMap;
+    vector< UpdateStageEvent > m_EventVec;
+};
+
+#define UpdateProfileMgr UpdateProfileMgrSingleton::getInstance()
+
+//==== Times A Stage Until It Goes Out Of Scope ====//
+class UpdateStageTimer
+{
+public:
+    UpdateStageTimer( const string & id, int stage ) : m_Active( UpdateProfileMgr.IsEnabled() )
+    {
+        if ( m_Active )
+        {
+            m_ID = id;
+            m_Stage = stage;
+            m_Start = UpdateProfileMgr.GetTime();
+        }
+    }
+
+    ~UpdateStageTimer()
+    {
+        if ( m_Active )
+        {
+            UpdateProfileMgr.AddStage( m_ID, m_Stage, m_Start, UpdateProfileMgr.GetTime() - m_Start );
+        }
+    }
+
+private:
+
+    UpdateStageTimer( UpdateStageTimer const& copy );            // Not Implemented
+    UpdateStageTimer& operator=( UpdateStageTimer const& copy ); // Not Implemented
+
+    bool m_Active;
+    string m_ID;
+    int m_Stage;
+    double m_Start;
+};
+
+#endif // !defined(VSP_UPDATE_PROFILE_MANAGER__INCLUDED_)
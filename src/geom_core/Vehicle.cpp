@@ -42,6 +42,7 @@
 #include "WireGeom.h"
 
 #include "ProjectionMgr.h"
+#include "GeomUpdateGraph.h"
 
 using namespace vsp;
 
@@ -162,6 +163,8 @@ Vehicle::Vehicle()
     m_WType.SetDescript( "Target W fixed or free" );
     m_WTargetPt.Init( "W_TargetPt", "FitModel", this, 0, 0, 1 );
     m_WTargetPt.SetDescript( "W Coordinate of Fixed Point" );
+    m_MaxFitPts.Init( "Max_Fit_Pts", "FitModel", this, 10000, 1, 1.0e9 );
+    m_MaxFitPts.SetDescript( "Most selected points added as targets, larger selections are sampled evenly" );
     m_SelectOneFlag.Init( "Select_One_Flag", "FitModel", this, false, 0, 1 );
     m_SelectBoxFlag.Init( "Select_Box_Flag", "FitModel", this, false, 0, 1 );
 
@@ -210,6 +213,7 @@ Vehicle::Vehicle()
     m_STLExportPropMainSurf.Init( "ExportPropMainSurf", "STLSettings", this, false, 0, 1 );
 
     m_UpdatingBBox = false;
+    m_HeadlessFlag = false;
     m_BbXLen.Init( "X_Len", "BBox", this, 0, 0, 1e12 );
     m_BbXLen.SetDescript( "X length of vehicle bounding box" );
     m_BbYLen.Init( "Y_Len", "BBox", this, 0, 0, 1e12 );
@@ -243,6 +247,8 @@ Vehicle::Vehicle()
 
     m_NumMassSlices.Init( "NumMassSlices", "MassProperties", this, 20, 10, 200 );
     m_NumMassSlices.SetDescript( "Number of slices used to display mesh" );
+    m_MassPropEngine.Init( "MassPropEngine", "MassProperties", this, vsp::MASS_PROP_SLICE, vsp::MASS_PROP_SLICE, vsp::MASS_PROP_SURFACE_INTEGRAL );
+    m_MassPropEngine.SetDescript( "Method used to integrate mass properties over the trimmed volume" );
 
     m_DrawCgFlag.Init( "DrawCgFlag", "MassProperties", this, true, false, true );
     m_DrawCgFlag.SetDescript( "Adds red center point to mesh" );
@@ -255,6 +261,8 @@ Vehicle::Vehicle()
 
     m_PlanarAxisType.Init( "PlanarAxisType", "PSlice", this, vsp::X_DIR, vsp::X_DIR, vsp::Z_DIR );
     m_PlanarAxisType.SetDescript( "Selects from X,Y,Z Axis for Planar Slice" );
+    m_PlanarSliceEngine.Init( "PlanarSliceEngine", "PSlice", this, vsp::PLANAR_SLICE_MESH, vsp::PLANAR_SLICE_MESH, vsp::PLANAR_SLICE_SWEEP );
+    m_PlanarSliceEngine.SetDescript( "Method used to compute planar slice areas" );
     
     m_PlanarStartLocation.Init( "PlanarStartLocation", "PSlice", this, 0, -1e12, 1e12 );
     m_PlanarStartLocation.SetDescript( "Planar Start Location" );
@@ -262,6 +270,14 @@ Vehicle::Vehicle()
     m_PlanarEndLocation.Init( "PlanarEndLocation", "PSlice", this, 10, -1e12, 1e12 );
     m_PlanarEndLocation.SetDescript( "Planar End Location" );
 
+    m_IntExtMode.Init( "IntExtMode", "CompGeom", this, vsp::INT_EXT_PER_TRI, vsp::INT_EXT_PER_TRI, vsp::INT_EXT_REGION );
+    m_IntExtMode.SetDescript( "Interior/exterior classification of trimmed triangles" );
+    m_CompGeomCacheFlag.Init( "CompGeomCacheFlag", "CompGeom", this, false, false, true );
+    m_CompGeomCacheFlag.SetDescript( "Reuse tessellation and intersections of unchanged components between CompGeom runs" );
+
+    m_ParallelUpdateFlag.Init( "ParallelUpdateFlag", "Update", this, false, false, true );
+    m_ParallelUpdateFlag.SetDescript( "Tessellate independent components concurrently during a full update" );
+
     SetupPaths();
     m_VehProjectVec3d.resize( 3 );
     m_ColorCount = 0;
@@ -481,6 +497,12 @@ void Vehicle::Wype()
 
     m_ExportFileNames.clear();
 
+    m_CompGeomCache.Clear();
+    m_SnapTo.ClearCache();
+
+    // Tri ID and tag tables, if no other Vehicle still holds meshes
+    TTriTable::Reset();
+
     // Clear out various managers...
     LinkMgr.Renew();
     AdvLinkMgr.Renew();
@@ -644,6 +666,15 @@ void Vehicle::UnDo()
 //===== Update All Geometry ====//
 void Vehicle::Update( bool fullupdate )
 {
+#ifdef VSP_USE_OPENMP
+    if ( fullupdate && m_ParallelUpdateFlag() && !m_HeadlessFlag )
+    {
+        UpdateParallel();
+        MeasureMgr.Update();
+        return;
+    }
+#endif
+
     for ( int i = 0 ; i < ( int )m_TopGeom.size() ; i++ )
     {
         Geom* g_ptr = FindGeom( m_TopGeom[i] );
@@ -656,6 +687,105 @@ void Vehicle::Update( bool fullupdate )
     MeasureMgr.Update();
 }
 
+// Full update with the Geom-local work run as tasks.  Surfaces, transforms
+// and everything else that touches Parms, links or other Geoms are updated
+// serially in the usual order.  As soon as every top Geom of an update group
+// is done, the tessellation (and DegenGeom preview, if displayed) of each of
+// its Geoms is handed to a task, and the serial walk carries on with the next
+// group.
+// Draw objects are built serially once all tasks are done.
+void Vehicle::UpdateParallel()
+{
+    GeomUpdateGraph graph;
+    graph.Build( this, m_TopGeom );
+
+    vector< int > tops_left( graph.m_NumGroups, 0 );
+    for ( int i = 0 ; i < ( int )graph.m_TopNodeVec.size() ; i++ )
+    {
+        if ( graph.m_TopNodeVec[i] >= 0 )
+        {
+            tops_left[ graph.m_GroupVec[ graph.m_TopNodeVec[i] ] ]++;
+        }
+    }
+
+    for ( int i = 0 ; i < ( int )m_GeomStoreVec.size() ; i++ )
+    {
+        if ( m_GeomStoreVec[i] )
+        {
+            m_GeomStoreVec[i]->SetDeferTessFlag( true );
+        }
+    }
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
+    {
+        for ( int i = 0 ; i < ( int )m_TopGeom.size() ; i++ )
+        {
+            int node = graph.m_TopNodeVec[i];
+            if ( node < 0 )
+            {
+                continue;
+            }
+
+            graph.m_GeomVec[ node ]->Update( true );
+
+            int group = graph.m_GroupVec[ node ];
+            tops_left[ group ]--;
+            if ( tops_left[ group ] > 0 )
+            {
+                continue;
+            }
+
+            const vector< int > & group_nodes = graph.m_GroupNodeVec[ group ];
+            for ( int j = 0 ; j < ( int )group_nodes.size() ; j++ )
+            {
+                Geom* g_ptr = graph.m_GeomVec[ group_nodes[j] ];
+                if ( g_ptr->IsTessPending() )
+                {
+#ifdef VSP_USE_OPENMP
+#pragma omp task firstprivate( g_ptr )
+#endif
+                    g_ptr->UpdatePendingTess();
+                }
+            }
+        }
+    }
+
+    // Anything left over (Geoms updated outside the walk) is finished here.
+    for ( int i = 0 ; i < ( int )m_GeomStoreVec.size() ; i++ )
+    {
+        if ( m_GeomStoreVec[i] )
+        {
+            m_GeomStoreVec[i]->SetDeferTessFlag( false );
+            m_GeomStoreVec[i]->UpdatePendingDrawObj();
+        }
+    }
+}
+
+void Vehicle::SetHeadless( bool flag )
+{
+    if ( flag == m_HeadlessFlag )
+    {
+        return;
+    }
+
+    m_HeadlessFlag = flag;
+
+    // Catch up on what headless updates left for display.
+    if ( !m_HeadlessFlag )
+    {
+        for ( int i = 0 ; i < ( int )m_GeomStoreVec.size() ; i++ )
+        {
+            if ( m_GeomStoreVec[i] )
+            {
+                m_GeomStoreVec[i]->UpdatePendingDrawObj();
+            }
+        }
+    }
+}
+
 // Update managers that are normally only updated by their 
 // associated GUI. This enables update from the API
 void Vehicle::UpdateManagers()
@@ -944,7 +1074,15 @@ string Vehicle::AddMeshGeom( int normal_set, int degen_set, bool suppressdisks )
         {
             if ( g_ptr->GetSetFlag( normal_set ) )
             {
-                vector< TMesh* > tMeshVec = g_ptr->CreateTMeshVec();
+                vector< TMesh* > tMeshVec;
+                if ( m_CompGeomCacheFlag() )
+                {
+                    tMeshVec = m_CompGeomCache.CreateTMeshVec( g_ptr );
+                }
+                else
+                {
+                    tMeshVec = g_ptr->CreateTMeshVec();
+                }
                 for ( int j = 0 ; j < ( int )tMeshVec.size() ; j++ )
                 {
                     if ( suppressdisks && ( tMeshVec[j]->m_SurfType == vsp::DISK_SURF ) )
@@ -2065,7 +2203,7 @@ void Vehicle::WriteXSecFile( const string & file_name, int write_set )
     }
 
     //==== Open file ====//
-    FILE* dump_file = fopen( file_name.c_str(), "w" );
+    FILE* dump_file = OpenExportFile( file_name );
 
     fprintf( dump_file, " HERMITE INPUT FILE\n\n" );
     fprintf( dump_file, " NUMBER OF COMPONENTS = %d\n", geom_cnt );
@@ -2096,7 +2234,7 @@ void Vehicle::WritePLOT3DFile( const string & file_name, int write_set )
     }
 
     //==== Open file ====//
-    FILE* dump_file = fopen( file_name.c_str(), "w" );
+    FILE* dump_file = OpenExportFile( file_name );
 
     //==== Write total number of surfaces ===//
     fprintf( dump_file, " %d\n", geom_cnt );
@@ -2192,7 +2330,7 @@ string Vehicle::WriteSTLFile( const string & file_name, int write_set )
     }
 
     // Open File
-    FILE* fid = fopen( file_name.c_str(), "w" );
+    FILE* fid = OpenExportFile( file_name );
     fprintf( fid, "solid\n" );
     for ( int i = 0 ; i < ( int )geom_vec.size() ; i++ )
     {
@@ -2254,7 +2392,7 @@ string Vehicle::WriteTaggedMSSTLFile( const string & file_name, int write_set )
         }
     }
 
-    FILE* file_id = fopen( file_name.c_str(), "w" );
+    FILE* file_id = OpenExportFile( file_name );
     if ( file_id )
     {
         std::vector< int > tags = SubSurfaceMgr.GetAllTags();
@@ -2312,7 +2450,7 @@ string Vehicle::WriteFacetFile( const string & file_name, int write_set )
     }
 
     // Open File
-    FILE* fid = fopen( file_name.c_str(), "w" );
+    FILE* fid = OpenExportFile( file_name );
 
     if ( fid )
     {
@@ -2416,7 +2554,7 @@ string Vehicle::WriteTRIFile( const string & file_name, int write_set )
     }
 
     //==== Open file ====//
-    FILE* file_id = fopen( file_name.c_str(), "w" );
+    FILE* file_id = OpenExportFile( file_name );
 
     if ( !file_id )
     {
@@ -2518,7 +2656,7 @@ string Vehicle::WriteOBJFile( const string & file_name, int write_set )
     }
 
     //==== Open file ====//
-    FILE* file_id = fopen( file_name.c_str(), "w" );
+    FILE* file_id = OpenExportFile( file_name );
 
     if ( !file_id )
     {
@@ -2655,7 +2793,7 @@ string Vehicle::WriteVSPGeomFile( const string &file_name, int write_set, int de
     }
 
     //==== Open file ====//
-    FILE *file_id = fopen( file_name.c_str(), "w" );
+    FILE *file_id = OpenExportFile( file_name );
 
     if ( !file_id )
     {
@@ -2772,7 +2910,7 @@ string Vehicle::WriteNascartFiles( const string & file_name, int write_set )
         }
     }
 
-    FILE* file_id = fopen( file_name.c_str(), "w" );
+    FILE* file_id = OpenExportFile( file_name );
 
     if ( !file_id )
     {
@@ -2822,7 +2960,7 @@ string Vehicle::WriteNascartFiles( const string & file_name, int write_set )
 
     fclose( file_id );
 
-    string key_name = file_name;
+    string key_name = StripGzipSuffix( file_name );
     std::string::size_type loc = key_name.find_last_of( "." );
     if ( loc == key_name.npos )
     {
@@ -2869,7 +3007,7 @@ string Vehicle::WriteGmshFile( const string & file_name, int write_set )
         }
     }
 
-    FILE* file_id = fopen( file_name.c_str(), "w" );
+    FILE* file_id = OpenExportFile( file_name );
 
     if( !file_id )
     {
@@ -3601,7 +3739,7 @@ void Vehicle::WriteAirfoilFile( const string &file_name, int write_set )
 
 void Vehicle::WriteDXFFile( const string & file_name, int write_set )
 {
-    FILE* dxf_file = fopen( file_name.c_str(), "w" );
+    FILE* dxf_file = OpenExportFile( file_name );
 
     if ( dxf_file )
     {
@@ -4031,7 +4169,7 @@ void Vehicle::WritePMARCFile( const string & file_name, int write_set )
     double b = 1.0;
 
     //==== Open file ====//
-    FILE* fp = fopen( file_name.c_str(), "w" );
+    FILE* fp = OpenExportFile( file_name );
 
     // PMARC header.
 
@@ -4568,6 +4706,15 @@ void Vehicle::resetExportFileNames()
 
 string Vehicle::CompGeom( int set, int degenset, int halfFlag, int intSubsFlag, bool hideset, bool suppressdisks )
 {
+    if ( m_CompGeomCacheFlag() )
+    {
+        m_CompGeomCache.Prune( this );
+    }
+    else
+    {
+        m_CompGeomCache.Clear();
+    }
+    m_CompGeomCache.ResetStats();
 
     string id = AddMeshGeom( set, degenset, suppressdisks );
     if ( id.compare( "NONE" ) == 0 )
@@ -4719,7 +4866,8 @@ string Vehicle::MassPropsAndFlatten( int set, int numSlices, bool hidegeom, bool
     return id;
 }
 
-string Vehicle::PSlice( int set, int numSlices, vec3d axis, bool autoBoundsFlag, double start, double end )
+string Vehicle::PSlice( int set, int numSlices, vec3d axis, bool autoBoundsFlag, double start, double end,
+                       bool hidegeom, bool sliceMeshFlag )
 {
 
     string id = AddMeshGeom( set );
@@ -4728,7 +4876,10 @@ string Vehicle::PSlice( int set, int numSlices, vec3d axis, bool autoBoundsFlag,
         return id;
     }
 
-    HideAllExcept( id );
+    if ( hidegeom )
+    {
+        HideAllExcept( id );
+    }
 
     MeshGeom* mesh_ptr = ( MeshGeom* )FindGeom( id );
     if ( mesh_ptr == NULL )
@@ -4738,7 +4889,12 @@ string Vehicle::PSlice( int set, int numSlices, vec3d axis, bool autoBoundsFlag,
 
     if ( mesh_ptr->m_TMeshVec.size() )
     {
-        mesh_ptr->AreaSlice( numSlices, axis, autoBoundsFlag, start, end );
+        int engine = m_PlanarSliceEngine();
+        if ( sliceMeshFlag )
+        {
+            engine = vsp::PLANAR_SLICE_MESH;
+        }
+        mesh_ptr->AreaSlice( numSlices, axis, autoBoundsFlag, start, end, engine );
     }
     else
     {
@@ -4752,7 +4908,7 @@ string Vehicle::PSlice( int set, int numSlices, vec3d axis, bool autoBoundsFlag,
 
 string Vehicle::PSliceAndFlatten( int set, int numSlices, vec3d axis, bool autoBoundsFlag, double start, double end )
 {
-    string id = PSlice( set, numSlices, axis, autoBoundsFlag, start, end );
+    string id = PSlice( set, numSlices, axis, autoBoundsFlag, start, end, true, true );
     Geom* geom = FindGeom( id );
     if ( !geom )
     {
@@ -5403,7 +5559,7 @@ string Vehicle::WriteDegenGeomFile()
     if ( getExportDegenGeomCsvFile() )
     {
         string file_name = getExportFileName( DEGEN_GEOM_CSV_TYPE );
-        FILE* file_id = fopen(file_name.c_str(), "w");
+        FILE* file_id = OpenExportFile( file_name );
 
         if ( !file_id ) // Check if the file was successfully opened
         {
@@ -5449,7 +5605,7 @@ string Vehicle::WriteDegenGeomFile()
     if ( getExportDegenGeomMFile() )
     {
         string file_name = getExportFileName( DEGEN_GEOM_M_TYPE );
-        FILE* file_id = fopen(file_name.c_str(), "w");
+        FILE* file_id = OpenExportFile( file_name );
         if ( !file_id )
         {
             outStr += "\tFAILED TO OPEN: ";
@@ -28,6 +28,7 @@
 #include "MaterialMgr.h"
 #include "WaveDragMgr.h"
 #include "GroupTransformations.h"
+#include "CompGeomCache.h"
 
 #include <cassert>
 
@@ -39,7 +40,7 @@
 
 // File versions must be integers.
 #define MIN_FILE_VER 4 // Lowest file version number for 3.X vsp file
-#define CURRENT_FILE_VER 5 // File version number for 3.X files that this executable writes
+#define CURRENT_FILE_VER 6 // File version number for 3.X files that this executable writes
 
 // We have not made substantial use of this flag to determine file compatibility issues.  However,
 // its use will likely increase going forward.  Most parameters additions and file format changes
@@ -47,6 +48,7 @@
 //
 // 4 -- 3.0      Base 3.X file.
 // 5 -- 3.17.1   Add support for scaling thickness of file-type airfoils.
+// 6 -- 3.31.1   MeshGeom tris written as base64 Tri_Data.  Older builds read these meshes empty.
 //
 
 #define NUM_SETS 20 // Number of sets
@@ -70,10 +72,20 @@ public:
     static void UnDo();
 
     void Update( bool fullupdate = true );
+    void UpdateParallel();
     void UpdateManagers();
     void UpdateGeom( const string &geom_id );
     void ForceUpdate( int dirtyflag = GeomBase::NONE );
     static void UpdateGui();
+
+    // Headless updates (scripts and the API with no GUI) leave draw objects
+    // and display tessellation pending until something draws or asks for them.
+    void SetHeadless( bool flag );
+    bool IsHeadless() const
+    {
+        return m_HeadlessFlag;
+    }
+
     static int RunScript( const string & file_name, const string & function_name = "main" );
 
     Geom* FindGeom( const string & geom_id );
@@ -259,7 +271,10 @@ public:
     string CompGeomAndFlatten( int set, int halfFlag, int intSubsFlag = 1, int degenset = vsp::SET_NONE, bool hideset = true, bool suppressdisks = false );
     string MassProps( int set, int numSlices, bool hidegeom = true, bool writefile = true );
     string MassPropsAndFlatten( int set, int numSlices, bool hidegeom = true, bool writefile = true );
-    string PSlice( int set, int numSlices, vec3d norm, bool autoBoundsFlag, double start = 0, double end = 0 );
+    // PSlice uses m_PlanarSliceEngine.  The sweep engine builds no slice meshes, so
+    // PSliceAndFlatten, which returns them, always uses the mesh engine.
+    string PSlice( int set, int numSlices, vec3d norm, bool autoBoundsFlag, double start = 0, double end = 0,
+                   bool hidegeom = true, bool sliceMeshFlag = false );
     string PSliceAndFlatten( int set, int numSlices, vec3d norm, bool autoBoundsFlag, double start = 0, double end = 0 );
 
     //==== Degenerate Geometry ====//
@@ -305,6 +320,11 @@ public:
         return &m_SnapTo;
     }
 
+    CompGeomCache* GetCompGeomCachePtr()
+    {
+        return &m_CompGeomCache;
+    }
+
     // ==== Getter for GroupTransformations ==== //
     GroupTransformations* GetGroupTransformationsPtr()
     {
@@ -321,6 +341,7 @@ public:
     double m_TotalMass;
 
     IntParm m_NumMassSlices;
+    IntParm m_MassPropEngine;
     BoolParm m_DrawCgFlag;
 
     IntParm m_NumPlanerSlices;
@@ -328,6 +349,12 @@ public:
     Parm m_PlanarStartLocation;
     Parm m_PlanarEndLocation;
     IntParm m_PlanarAxisType;
+    IntParm m_PlanarSliceEngine;
+
+    IntParm m_IntExtMode;
+    BoolParm m_CompGeomCacheFlag;
+
+    BoolParm m_ParallelUpdateFlag;
 
     Parm m_BbXLen;
     Parm m_BbYLen;
@@ -433,6 +460,7 @@ public:
     IntParm m_WType;
     Parm m_UTargetPt;
     Parm m_WTargetPt;
+    IntParm m_MaxFitPts;
 
     // ProjectionMgr
     IntParm m_TargetType;
@@ -516,6 +544,7 @@ protected:
     vector< GeomType > m_GeomTypeVec;
 
     bool m_UpdatingBBox;
+    bool m_HeadlessFlag;
     BndBox m_BBox;                              // Bounding Box Around All Geometries
 
     void SetApplyAbsIgnoreFlag( const vector< string > &g_vec, bool val );
@@ -549,6 +578,8 @@ protected:
     ClippingMgr m_ClippingMgr;
     SnapTo m_SnapTo;
 
+    CompGeomCache m_CompGeomCache;
+
     // Class to handle group transformations
     GroupTransformations m_GroupTransformations;
 
@@ -43,6 +43,10 @@ PtCloudScreen::PtCloudScreen( ScreenMgr* mgr ) : GeomScreen( mgr, 300, 525, "Poi
     m_ProjectLayout.AddYGap();
     m_ProjectLayout.AddButton( m_ProjectButton, "Project" );
 
+    m_ProjectLayout.AddYGap();
+    m_ProjectLayout.AddDividerBox( "Display" );
+    m_ProjectLayout.AddInput( m_MaxDrawPtsInput, "Max Draw Pts", "%9.0f" );
+
 }
 
 
@@ -74,6 +78,8 @@ bool PtCloudScreen::Update()
     PtCloudGeom* pt_cloud_geom_ptr = dynamic_cast< PtCloudGeom* >( geom_ptr );
     assert( pt_cloud_geom_ptr );
 
+    m_MaxDrawPtsInput.Update( pt_cloud_geom_ptr->m_MaxDrawPts.GetID() );
+
     m_GeomPicker.Update();
 
     m_SurfChoice.ClearItems();
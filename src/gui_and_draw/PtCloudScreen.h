@@ -26,6 +26,8 @@ protected:
     GeomPicker m_GeomPicker;
     Choice m_SurfChoice;
 
+    Input m_MaxDrawPtsInput;
+
 };
 
 
@@ -846,8 +846,8 @@ SdaiSurface* STEPutil::MakeSurf( piecewise_surface_type& s, const string& label,
         //==== Build Map ====//
         pnCloud.AddPntNodes( allPntVec );
 
-        //==== Use NanoFlann to Find Close Points and Group ====//
-        IndexPntNodes( pnCloud, merge_tol );
+        //==== Use Hash Grid to Find Close Points and Group ====//
+        WeldPntNodes( pnCloud, merge_tol );
 
         //==== Load Used Points ====//
         for ( int i = 0; i < (int)allPntVec.size(); i++ )
@@ -968,8 +968,8 @@ SdaiB_spline_curve_with_knots* STEPutil::MakeCurve( vector < vec3d > cp_vec, con
         //==== Build Map ====//
         pnCloud.AddPntNodes( cp_vec );
 
-        //==== Use NanoFlann to Find Close Points and Group ====//
-        IndexPntNodes( pnCloud, merge_tol );
+        //==== Use Hash Grid to Find Close Points and Group ====//
+        WeldPntNodes( pnCloud, merge_tol );
 
         //==== Load Used Points ====//
         for ( size_t j = 0; j < cp_vec.size(); j++ )
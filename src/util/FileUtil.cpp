@@ -24,6 +24,19 @@
 #include <libgen.h>
 #endif
 
+#ifdef VSP_USE_ZLIB
+#include <zlib.h>
+
+#if defined( __GLIBC__ )
+#define VSP_GZIP_STREAM_FOPENCOOKIE
+#elif defined( __APPLE__ ) || defined( __FreeBSD__ )
+#define VSP_GZIP_STREAM_FUNOPEN
+#endif
+#endif
+
+#include <stdio.h>
+#include <algorithm>
+
 vector< string > ScanFolder( const char* dir_path )
 {
     vector< string > file_vec;
@@ -327,3 +340,109 @@ string GetBasename( const string &fname )
     }
     return base_name;
 }
+
+//==== Streaming Gzip Export ====//
+// Fast compression; the point is to cut the bytes sent to (network) disk, not
+// to get the smallest file.
+static const char* GZIP_WRITE_MODE = "wb1";
+static const int GZIP_BUFFER_SIZE = 1 << 20;
+
+bool IsGzipFileName( const string & file_name )
+{
+    return file_name.size() > 3 && file_name.compare( file_name.size() - 3, 3, ".gz" ) == 0;
+}
+
+string StripGzipSuffix( const string & file_name )
+{
+    if ( IsGzipFileName( file_name ) )
+    {
+        return file_name.substr( 0, file_name.size() - 3 );
+    }
+    return file_name;
+}
+
+#if defined( VSP_GZIP_STREAM_FOPENCOOKIE )
+
+static ssize_t GzipCookieWrite( void* cookie, const char* buf, size_t size )
+{
+    size_t done = 0;
+    while ( done < size )
+    {
+        unsigned int len = ( unsigned int ) std::min( size - done, ( size_t ) GZIP_BUFFER_SIZE );
+        int n = gzwrite( ( gzFile ) cookie, buf + done, len );
+        if ( n <= 0 )
+        {
+            return done ? ( ssize_t ) done : -1;
+        }
+        done += n;
+    }
+    return done;
+}
+
+static int GzipCookieClose( void* cookie )
+{
+    return gzclose( ( gzFile ) cookie ) == Z_OK ? 0 : EOF;
+}
+
+#elif defined( VSP_GZIP_STREAM_FUNOPEN )
+
+static int GzipCookieWrite( void* cookie, const char* buf, int size )
+{
+    int n = gzwrite( ( gzFile ) cookie, buf, ( unsigned int ) size );
+    return n > 0 ? n : -1;
+}
+
+static int GzipCookieClose( void* cookie )
+{
+    return gzclose( ( gzFile ) cookie ) == Z_OK ? 0 : EOF;
+}
+
+#endif
+
+bool ExportCompressionAvailable()
+{
+#if defined( VSP_GZIP_STREAM_FOPENCOOKIE ) || defined( VSP_GZIP_STREAM_FUNOPEN )
+    return true;
+#else
+    return false;
+#endif
+}
+
+FILE* OpenExportFile( const string & file_name )
+{
+    if ( !IsGzipFileName( file_name ) )
+    {
+        return fopen( file_name.c_str(), "w" );
+    }
+
+#if defined( VSP_GZIP_STREAM_FOPENCOOKIE ) || defined( VSP_GZIP_STREAM_FUNOPEN )
+    gzFile gz = gzopen( file_name.c_str(), GZIP_WRITE_MODE );
+    if ( !gz )
+    {
+        return NULL;
+    }
+    gzbuffer( gz, GZIP_BUFFER_SIZE );
+
+#if defined( VSP_GZIP_STREAM_FOPENCOOKIE )
+    cookie_io_functions_t funcs;
+    funcs.read = NULL;
+    funcs.write = GzipCookieWrite;
+    funcs.seek = NULL;
+    funcs.close = GzipCookieClose;
+    FILE* fp = fopencookie( gz, "w", funcs );
+#else
+    FILE* fp = funopen( gz, NULL, GzipCookieWrite, NULL, GzipCookieClose );
+#endif
+
+    if ( !fp )
+    {
+        gzclose( gz );
+        return NULL;
+    }
+    setvbuf( fp, NULL, _IOFBF, GZIP_BUFFER_SIZE );
+    return fp;
+#else
+    printf( "Error: compressed export of %s is not available in this build\n", file_name.c_str() );
+    return NULL;
+#endif
+}
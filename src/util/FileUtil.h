@@ -6,6 +6,7 @@
 #if !defined(FILE_UTIL__INCLUDED_)
 #define FILE_UTIL__INCLUDED_
 
+#include <stdio.h>
 #include <vector>
 #include <string>
 using std::vector;
@@ -23,5 +24,14 @@ bool FileExist( const string & file );
 string GetFilename( const string &pathfile );
 string GetBasename( const string &fname );
 
+//==== Export Files ====//
+// Names ending in .gz are written through a streaming gzip compressor; the
+// returned FILE* is used and closed with fclose as usual.  Returns NULL if the
+// file can not be opened, or compression is requested but not available.
+FILE* OpenExportFile( const string & file_name );
+bool IsGzipFileName( const string & file_name );
+bool ExportCompressionAvailable();
+string StripGzipSuffix( const string & file_name );
+
 #endif
 
@@ -0,0 +1,266 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// MeshTopology.cpp: Edge use checks for indexed tri and quad meshes
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "MeshTopology.h"
+
+#include <algorithm>
+
+// Buckets are scanned in this many contiguous blocks, each with its own results.
+static const int TOPOLOGY_NUM_BLOCKS = 256;
+
+//==== Results Of One Block Of Buckets ====//
+struct TopologyBlock
+{
+    TopologyBlock() : m_NumEdges( 0 ), m_NumExcessUses( 0 ) {}
+
+    int m_NumEdges;
+    int m_NumExcessUses;
+    vector< pair< pair< int, int >, int > > m_Open;
+    vector< pair< int, int > > m_NonManifold;
+    vector< pair< int, int > > m_Flipped;
+    vector< int > m_ExcessFaces;
+    vector< int > m_FlippedFaces;
+};
+
+static void SortUnique( vector< int > & vec )
+{
+    std::sort( vec.begin(), vec.end() );
+    vec.erase( std::unique( vec.begin(), vec.end() ), vec.end() );
+}
+
+MeshTopology::MeshTopology()
+{
+    Clear();
+}
+
+void MeshTopology::Clear()
+{
+    m_NumFaces = 0;
+    m_NumEdges = 0;
+    m_NumExcessUses = 0;
+
+    m_OpenEdgeVec.clear();
+    m_NonManifoldEdgeVec.clear();
+    m_FlippedEdgeVec.clear();
+    m_OpenEdgeFaceVec.clear();
+    m_ExcessFaceVec.clear();
+    m_FlippedFaceVec.clear();
+    m_DegenerateFaceVec.clear();
+}
+
+unsigned int MeshTopology::HashEdge( unsigned long long key, unsigned int mask )
+{
+    unsigned long long h = key * 0x9E3779B97F4A7C15ULL;
+    return ( unsigned int )( h >> 32 ) & mask;
+}
+
+void MeshTopology::CheckTris( const vector< int > & tri_nodes )
+{
+    int ntri = tri_nodes.size() / 3;
+    vector< int > face_start( ntri + 1 );
+    for ( int t = 0 ; t <= ntri ; t++ )
+    {
+        face_start[t] = 3 * t;
+    }
+    Check( face_start, tri_nodes );
+}
+
+void MeshTopology::Check( const vector< int > & face_start, const vector< int > & face_nodes )
+{
+    Clear();
+
+    if ( face_start.size() < 2 )
+    {
+        return;
+    }
+
+    m_NumFaces = face_start.size() - 1;
+    int nhalf = face_start.back();
+
+    //==== Half Edge Keys ====//
+    // key is min node in the high word and max node in the low word,
+    // forward is set when the side runs from min to max.
+    vector< unsigned long long > key_vec( nhalf );
+    vector< int > face_vec( nhalf );
+    vector< unsigned char > forward_vec( nhalf );
+    vector< unsigned char > degen_vec( nhalf, 0 );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for ( int f = 0 ; f < m_NumFaces ; f++ )
+    {
+        int s = face_start[f];
+        int e = face_start[f + 1];
+        for ( int h = s ; h < e ; h++ )
+        {
+            int a = face_nodes[h];
+            int b = face_nodes[ h + 1 < e ? h + 1 : s ];
+
+            face_vec[h] = f;
+            forward_vec[h] = a < b;
+            degen_vec[h] = a == b;
+            key_vec[h] = ( ( unsigned long long )( unsigned int )std::min( a, b ) << 32 ) |
+                         ( unsigned int )std::max( a, b );
+        }
+    }
+
+    for ( int h = 0 ; h < nhalf ; h++ )
+    {
+        if ( degen_vec[h] )
+        {
+            m_DegenerateFaceVec.push_back( face_vec[h] );
+        }
+    }
+    SortUnique( m_DegenerateFaceVec );
+
+    //==== At Least As Many Buckets As Half Edges ====//
+    unsigned int nbucket = 1;
+    while ( nbucket < ( unsigned int )nhalf )
+    {
+        nbucket *= 2;
+    }
+    unsigned int mask = nbucket - 1;
+
+    vector< unsigned int > bucket_vec( nhalf );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for ( int h = 0 ; h < nhalf ; h++ )
+    {
+        bucket_vec[h] = HashEdge( key_vec[h], mask );
+    }
+
+    //==== Counting Sort By Bucket, Half Edges Ascending Within A Bucket ====//
+    vector< int > bucket_start( nbucket + 1, 0 );
+    for ( int h = 0 ; h < nhalf ; h++ )
+    {
+        if ( !degen_vec[h] )
+        {
+            bucket_start[ bucket_vec[h] + 1 ]++;
+        }
+    }
+    for ( unsigned int b = 0 ; b < nbucket ; b++ )
+    {
+        bucket_start[b + 1] += bucket_start[b];
+    }
+
+    vector< int > fill( bucket_start.begin(), bucket_start.end() - 1 );
+    vector< int > bucket_half( bucket_start[ nbucket ] );
+    for ( int h = 0 ; h < nhalf ; h++ )
+    {
+        if ( !degen_vec[h] )
+        {
+            bucket_half[ fill[ bucket_vec[h] ]++ ] = h;
+        }
+    }
+
+    //==== Group Matching Keys Bucket By Bucket ====//
+    int nblock = std::min( ( int )nbucket, TOPOLOGY_NUM_BLOCKS );
+    vector< TopologyBlock > block_vec( nblock );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( int blk = 0 ; blk < nblock ; blk++ )
+    {
+        TopologyBlock & res = block_vec[blk];
+        unsigned int b0 = ( unsigned long long )nbucket * blk / nblock;
+        unsigned int b1 = ( unsigned long long )nbucket * ( blk + 1 ) / nblock;
+
+        // Key then half edge, so each group is contiguous and in face order.
+        vector< pair< unsigned long long, int > > use_vec;
+
+        for ( unsigned int b = b0 ; b < b1 ; b++ )
+        {
+            int s = bucket_start[b];
+            int e = bucket_start[b + 1];
+            if ( s == e )
+            {
+                continue;
+            }
+
+            use_vec.clear();
+            for ( int i = s ; i < e ; i++ )
+            {
+                use_vec.push_back( pair< unsigned long long, int >( key_vec[ bucket_half[i] ], bucket_half[i] ) );
+            }
+            std::sort( use_vec.begin(), use_vec.end() );
+
+            int g = 0;
+            while ( g < ( int )use_vec.size() )
+            {
+                int gend = g + 1;
+                while ( gend < ( int )use_vec.size() && use_vec[gend].first == use_vec[g].first )
+                {
+                    gend++;
+                }
+
+                unsigned long long key = use_vec[g].first;
+                pair< int, int > edge( ( int )( key >> 32 ), ( int )( key & 0xFFFFFFFFULL ) );
+                int nuse = gend - g;
+
+                res.m_NumEdges++;
+                if ( nuse == 1 )
+                {
+                    res.m_Open.push_back( pair< pair< int, int >, int >( edge, face_vec[ use_vec[g].second ] ) );
+                }
+                else if ( nuse == 2 )
+                {
+                    if ( forward_vec[ use_vec[g].second ] == forward_vec[ use_vec[g + 1].second ] )
+                    {
+                        res.m_Flipped.push_back( edge );
+                        res.m_FlippedFaces.push_back( face_vec[ use_vec[g + 1].second ] );
+                    }
+                }
+                else
+                {
+                    res.m_NonManifold.push_back( edge );
+                    res.m_NumExcessUses += nuse - 2;
+                    for ( int u = g + 2 ; u < gend ; u++ )
+                    {
+                        res.m_ExcessFaces.push_back( face_vec[ use_vec[u].second ] );
+                    }
+                }
+
+                g = gend;
+            }
+        }
+    }
+
+    //==== Join Blocks ====//
+    vector< pair< pair< int, int >, int > > open_vec;
+    for ( int blk = 0 ; blk < nblock ; blk++ )
+    {
+        const TopologyBlock & res = block_vec[blk];
+        m_NumEdges += res.m_NumEdges;
+        m_NumExcessUses += res.m_NumExcessUses;
+        open_vec.insert( open_vec.end(), res.m_Open.begin(), res.m_Open.end() );
+        m_NonManifoldEdgeVec.insert( m_NonManifoldEdgeVec.end(), res.m_NonManifold.begin(), res.m_NonManifold.end() );
+        m_FlippedEdgeVec.insert( m_FlippedEdgeVec.end(), res.m_Flipped.begin(), res.m_Flipped.end() );
+        m_ExcessFaceVec.insert( m_ExcessFaceVec.end(), res.m_ExcessFaces.begin(), res.m_ExcessFaces.end() );
+        m_FlippedFaceVec.insert( m_FlippedFaceVec.end(), res.m_FlippedFaces.begin(), res.m_FlippedFaces.end() );
+    }
+
+    //==== Same Order For Any Thread Count ====//
+    std::sort( open_vec.begin(), open_vec.end() );
+    m_OpenEdgeVec.resize( open_vec.size() );
+    m_OpenEdgeFaceVec.resize( open_vec.size() );
+    for ( int i = 0 ; i < ( int )open_vec.size() ; i++ )
+    {
+        m_OpenEdgeVec[i] = open_vec[i].first;
+        m_OpenEdgeFaceVec[i] = open_vec[i].second;
+    }
+
+    std::sort( m_NonManifoldEdgeVec.begin(), m_NonManifoldEdgeVec.end() );
+    std::sort( m_FlippedEdgeVec.begin(), m_FlippedEdgeVec.end() );
+    SortUnique( m_ExcessFaceVec );
+    SortUnique( m_FlippedFaceVec );
+}
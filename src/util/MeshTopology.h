@@ -0,0 +1,69 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// MeshTopology.h: Edge use checks for indexed tri and quad meshes
+//
+// Every side of every face is a half edge.  Half edges are hashed on their
+// (min, max) node pair, so both uses of an edge land in the same bucket
+// whatever their direction, and buckets are scanned in parallel.  One pass
+// finds open edges, edges shared by more than two faces and neighboring
+// faces with inconsistent orientation.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(MESHTOPOLOGY__INCLUDED_)
+#define MESHTOPOLOGY__INCLUDED_
+
+#include <vector>
+#include <utility>
+
+using std::vector;
+using std::pair;
+
+class MeshTopology
+{
+public:
+    MeshTopology();
+
+    void Clear();
+
+    // Face f is face_nodes[ face_start[f] ] ... face_nodes[ face_start[f + 1] - 1 ]
+    // in winding order, so face_start has one more entry than there are faces.
+    void Check( const vector< int > & face_start, const vector< int > & face_nodes );
+
+    // Three nodes per tri.
+    void CheckTris( const vector< int > & tri_nodes );
+
+    bool IsWaterTight() const
+    {
+        return m_OpenEdgeVec.empty() && m_NonManifoldEdgeVec.empty();
+    }
+    bool IsOriented() const
+    {
+        return m_FlippedEdgeVec.empty();
+    }
+
+    int m_NumFaces;
+    int m_NumEdges;                                 // Distinct node pairs
+
+    // Edges as ( min, max ) node pairs, ascending.
+    vector< pair< int, int > > m_OpenEdgeVec;       // Used by one face
+    vector< pair< int, int > > m_NonManifoldEdgeVec;// Used by more than two faces
+    vector< pair< int, int > > m_FlippedEdgeVec;    // Used by two faces in the same direction
+    vector< int > m_OpenEdgeFaceVec;                // Face of each open edge
+
+    // Faces, ascending without repeats.
+    vector< int > m_ExcessFaceVec;                  // Faces past the first two (in face order) on a non-manifold edge
+    vector< int > m_FlippedFaceVec;                 // Second face (in face order) on a flipped edge
+    vector< int > m_DegenerateFaceVec;              // Faces with a side that starts and ends at one node
+
+    int m_NumExcessUses;                            // Half edges past the first two on non-manifold edges
+
+protected:
+
+    static unsigned int HashEdge( unsigned long long key, unsigned int mask );
+};
+
+#endif // !defined(MESHTOPOLOGY__INCLUDED_)
@@ -13,6 +13,9 @@
 
 #include "PntNodeMerge.h"
 
+#include <algorithm>
+#include <cmath>
+
 
 void PntNodeCloud::AddPntNodes( const vector< vec3d > & pnts )
 {
@@ -85,5 +88,437 @@ void IndexPntNodes( PntNodeCloud & cloud, double tol )
     cloud.m_NumUsedPts = cnt;
 }
 
+//===============================================================================//
+//===============================================================================//
+
+// Buckets handled per parallel work item.
+static const int HASH_GRID_BLOCK = 4096;
+
+// Cells are this many merge distances across.
+static const double HASH_GRID_CELL_RADII = 4.0;
+
+// Cell coordinates are kept well inside the range of long long.
+static const double HASH_GRID_MAX_CELLS = 1.0e15;
+
+PntHashGrid::PntHashGrid()
+{
+    m_CellSize = 1.0;
+    m_BucketMask = 0;
+}
+
+void PntHashGrid::Clear()
+{
+    m_Pnts.clear();
+    m_BucketStart.clear();
+    m_BucketPnts.clear();
+    m_BucketKeys.clear();
+    m_BucketMask = 0;
+}
+
+PntHashGrid::CellKey PntHashGrid::ComputeKey( const vec3d & pnt ) const
+{
+    CellKey key;
+    for ( int d = 0 ; d < 3 ; d++ )
+    {
+        key.m_I[d] = ( long long )std::floor( ( pnt.v[d] - m_Origin.v[d] ) / m_CellSize );
+    }
+    return key;
+}
+
+unsigned int PntHashGrid::ComputeBucket( const CellKey & key ) const
+{
+    unsigned long long h = ( unsigned long long )key.m_I[0] * 73856093ULL ^
+                           ( unsigned long long )key.m_I[1] * 19349663ULL ^
+                           ( unsigned long long )key.m_I[2] * 83492791ULL;
+    h ^= h >> 29;
+    return ( unsigned int )h & m_BucketMask;
+}
+
+void PntHashGrid::Build( const vector< vec3d > & pnts, double radius )
+{
+    Clear();
+    m_Pnts = pnts;
+
+    if ( m_Pnts.empty() )
+    {
+        return;
+    }
+
+    //==== Grid Origin And Cell Size ====//
+    vec3d pmin = m_Pnts[0];
+    vec3d pmax = m_Pnts[0];
+    for ( int i = 1 ; i < ( int )m_Pnts.size() ; i++ )
+    {
+        for ( int d = 0 ; d < 3 ; d++ )
+        {
+            pmin.v[d] = std::min( pmin.v[d], m_Pnts[i].v[d] );
+            pmax.v[d] = std::max( pmax.v[d], m_Pnts[i].v[d] );
+        }
+    }
+    double extent = std::max( pmax.x() - pmin.x(), std::max( pmax.y() - pmin.y(), pmax.z() - pmin.z() ) );
+
+    m_Origin = pmin;
+    m_CellSize = std::max( HASH_GRID_CELL_RADII * radius, extent / HASH_GRID_MAX_CELLS );
+    if ( !( m_CellSize > 0.0 ) )
+    {
+        m_CellSize = 1.0;
+    }
+
+    //==== At Least As Many Buckets As Points ====//
+    int npnt = m_Pnts.size();
+    unsigned int nbucket = 1;
+    while ( nbucket < ( unsigned int )npnt )
+    {
+        nbucket *= 2;
+    }
+    m_BucketMask = nbucket - 1;
+
+    vector< CellKey > key_vec( npnt );
+    vector< unsigned int > bucket_vec( npnt );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for ( int i = 0 ; i < npnt ; i++ )
+    {
+        key_vec[i] = ComputeKey( m_Pnts[i] );
+        bucket_vec[i] = ComputeBucket( key_vec[i] );
+    }
+
+    //==== Counting Sort By Bucket ====//
+    m_BucketStart.assign( nbucket + 1, 0 );
+    for ( int i = 0 ; i < npnt ; i++ )
+    {
+        m_BucketStart[ bucket_vec[i] + 1 ]++;
+    }
+    for ( unsigned int b = 0 ; b < nbucket ; b++ )
+    {
+        m_BucketStart[b + 1] += m_BucketStart[b];
+    }
+
+    vector< int > fill( m_BucketStart.begin(), m_BucketStart.end() - 1 );
+    m_BucketPnts.resize( npnt );
+    m_BucketKeys.resize( npnt );
+    for ( int i = 0 ; i < npnt ; i++ )
+    {
+        int e = fill[ bucket_vec[i] ]++;
+        m_BucketPnts[e] = i;
+        m_BucketKeys[e] = key_vec[i];
+    }
+}
+
+bool PntHashGrid::IsNear( const vec3d & a, const vec3d & b, double tol, int metric )
+{
+    if ( metric == BOX_METRIC )
+    {
+        return std::abs( a.x() - b.x() ) < tol &&
+               std::abs( a.y() - b.y() ) < tol &&
+               std::abs( a.z() - b.z() ) < tol;
+    }
+
+    // Same sum as the nanoflann L2_Simple_Adaptor
+    double dist = 0.0;
+    for ( int d = 0 ; d < 3 ; d++ )
+    {
+        double diff = a.v[d] - b.v[d];
+        dist += diff * diff;
+    }
+    return dist < tol;
+}
+
+void PntHashGrid::FindCandidates( const vec3d & lo, const vec3d & hi, double tol, int metric, vector< int > & ind_vec ) const
+{
+    ind_vec.clear();
+
+    if ( m_Pnts.empty() )
+    {
+        return;
+    }
+
+    // Grow the box a little past the merge distance so round off can only add candidates.
+    double r = metric == BOX_METRIC ? tol : std::sqrt( tol );
+    double mag = std::abs( lo.x() ) + std::abs( lo.y() ) + std::abs( lo.z() ) +
+                 std::abs( hi.x() ) + std::abs( hi.y() ) + std::abs( hi.z() );
+    r = r * ( 1.0 + 1.0e-6 ) + mag * 1.0e-14;
+
+    CellKey klo = ComputeKey( lo - vec3d( r, r, r ) );
+    CellKey khi = ComputeKey( hi + vec3d( r, r, r ) );
+
+    CellKey key;
+    for ( key.m_I[0] = klo.m_I[0] ; key.m_I[0] <= khi.m_I[0] ; key.m_I[0]++ )
+    {
+        for ( key.m_I[1] = klo.m_I[1] ; key.m_I[1] <= khi.m_I[1] ; key.m_I[1]++ )
+        {
+            for ( key.m_I[2] = klo.m_I[2] ; key.m_I[2] <= khi.m_I[2] ; key.m_I[2]++ )
+            {
+                unsigned int b = ComputeBucket( key );
+                for ( int e = m_BucketStart[b] ; e < m_BucketStart[b + 1] ; e++ )
+                {
+                    if ( m_BucketKeys[e] == key )
+                    {
+                        ind_vec.push_back( m_BucketPnts[e] );
+                    }
+                }
+            }
+        }
+    }
+}
+
+int PntHashGrid::FindFirstNear( const vec3d & pnt, double tol, int metric ) const
+{
+    vector< int > ind_vec;
+    FindCandidates( pnt, pnt, tol, metric, ind_vec );
+
+    int first = -1;
+    for ( int i = 0 ; i < ( int )ind_vec.size() ; i++ )
+    {
+        int ind = ind_vec[i];
+        if ( ( first < 0 || ind < first ) && IsNear( pnt, m_Pnts[ind], tol, metric ) )
+        {
+            first = ind;
+        }
+    }
+    return first;
+}
+
+void PntHashGrid::FindNeighbors( double tol, int metric, vector< int > & nbr_start, vector< int > & nbr_vec ) const
+{
+    int npnt = m_Pnts.size();
+    int nbucket = m_BucketStart.empty() ? 0 : m_BucketStart.size() - 1;
+    int nblock = ( nbucket + HASH_GRID_BLOCK - 1 ) / HASH_GRID_BLOCK;
+
+    nbr_start.assign( npnt + 1, 0 );
+    nbr_vec.clear();
+
+    //==== Neighbors Of The Points In Each Block Of Buckets ====//
+    // Candidates are gathered once per cell, over the box of the points in it.
+    // Records are ( point, first, end ) into the block's neighbor list.
+    vector< vector< int > > block_rec( nblock );
+    vector< vector< int > > block_nbr( nblock );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( int blk = 0 ; blk < nblock ; blk++ )
+    {
+        int bstart = blk * HASH_GRID_BLOCK;
+        int bend = std::min( bstart + HASH_GRID_BLOCK, nbucket );
+
+        vector< int > cand_vec;
+        for ( int b = bstart ; b < bend ; b++ )
+        {
+            int first = m_BucketStart[b];
+            int last = m_BucketStart[b + 1];
+            for ( int p = first ; p < last ; p++ )
+            {
+                const CellKey & key = m_BucketKeys[p];
 
+                // Cell already handled with an earlier point of this bucket
+                bool done = false;
+                for ( int q = first ; q < p ; q++ )
+                {
+                    if ( m_BucketKeys[q] == key )
+                    {
+                        done = true;
+                        break;
+                    }
+                }
+                if ( done )
+                {
+                    continue;
+                }
 
+                vec3d lo = m_Pnts[ m_BucketPnts[p] ];
+                vec3d hi = lo;
+                for ( int q = p + 1 ; q < last ; q++ )
+                {
+                    if ( m_BucketKeys[q] == key )
+                    {
+                        const vec3d & pnt = m_Pnts[ m_BucketPnts[q] ];
+                        for ( int d = 0 ; d < 3 ; d++ )
+                        {
+                            lo.v[d] = std::min( lo.v[d], pnt.v[d] );
+                            hi.v[d] = std::max( hi.v[d], pnt.v[d] );
+                        }
+                    }
+                }
+
+                FindCandidates( lo, hi, tol, metric, cand_vec );
+                std::sort( cand_vec.begin(), cand_vec.end() );
+
+                for ( int q = p ; q < last ; q++ )
+                {
+                    if ( !( m_BucketKeys[q] == key ) )
+                    {
+                        continue;
+                    }
+
+                    int i = m_BucketPnts[q];
+                    block_rec[blk].push_back( i );
+                    block_rec[blk].push_back( block_nbr[blk].size() );
+                    for ( int c = 0 ; c < ( int )cand_vec.size() ; c++ )
+                    {
+                        if ( IsNear( m_Pnts[i], m_Pnts[ cand_vec[c] ], tol, metric ) )
+                        {
+                            block_nbr[blk].push_back( cand_vec[c] );
+                        }
+                    }
+                    block_rec[blk].push_back( block_nbr[blk].size() );
+                }
+            }
+        }
+    }
+
+    //==== Flatten In Point Order ====//
+    for ( int blk = 0 ; blk < nblock ; blk++ )
+    {
+        for ( int r = 0 ; r < ( int )block_rec[blk].size() ; r += 3 )
+        {
+            nbr_start[ block_rec[blk][r] + 1 ] = block_rec[blk][r + 2] - block_rec[blk][r + 1];
+        }
+    }
+    for ( int i = 0 ; i < npnt ; i++ )
+    {
+        nbr_start[i + 1] += nbr_start[i];
+    }
+    nbr_vec.resize( nbr_start[npnt] );
+
+#ifdef VSP_USE_OPENMP
+#pragma omp parallel for schedule( dynamic )
+#endif
+    for ( int blk = 0 ; blk < nblock ; blk++ )
+    {
+        for ( int r = 0 ; r < ( int )block_rec[blk].size() ; r += 3 )
+        {
+            std::copy( block_nbr[blk].begin() + block_rec[blk][r + 1], block_nbr[blk].begin() + block_rec[blk][r + 2],
+                       nbr_vec.begin() + nbr_start[ block_rec[blk][r] ] );
+        }
+    }
+}
+
+void WeldPntNodes( PntNodeCloud & cloud, double tol )
+{
+    if ( !( tol > 0.0 ) )
+    {
+        // Degenerate tolerance, keep the exact behavior of the kd-tree search.
+        IndexPntNodes( cloud, tol );
+        return;
+    }
+
+    vector< vec3d > pnts( cloud.m_PntNodes.size() );
+    for ( size_t i = 0 ; i < pnts.size() ; i++ )
+    {
+        pnts[i] = cloud.m_PntNodes[i].m_Pnt;
+    }
+
+    PntHashGrid grid;
+    grid.Build( pnts, std::sqrt( tol ) );
+
+    vector< int > nbr_start;
+    vector< int > nbr_vec;
+    grid.FindNeighbors( tol, PntHashGrid::DIST_SQ_METRIC, nbr_start, nbr_vec );
+
+    //==== Find Close Point Groups ====//
+    // As in IndexPntNodes, each unclaimed point in turn claims all of its neighbors.
+    int cnt = 0;
+    for ( size_t i = 0 ; i < cloud.m_PntNodes.size() ; i++ )
+    {
+        if ( cloud.m_PntNodes[i].m_Index == -1 )
+        {
+            for ( int j = nbr_start[i] ; j < nbr_start[i + 1] ; j++ )
+            {
+                cloud.m_PntNodes[ nbr_vec[j] ].m_Index = i;
+            }
+            cloud.m_PntNodes[i].m_UsedIndex = cnt;
+            cnt++;
+        }
+    }
+    cloud.m_NumUsedPts = cnt;
+}
+
+//===============================================================================//
+//===============================================================================//
+
+PntIndexMap::PntIndexMap()
+{
+    m_Tol = 0.0;
+}
+
+void PntIndexMap::Clear()
+{
+    m_KeyMap.clear();
+    m_Pnts.clear();
+}
+
+int PntIndexMap::ComputeKey( const vec3d & pnt )
+{
+    return ( int )( ( pnt.x() + pnt.y() + pnt.z() ) * 10000.0 );
+}
+
+int PntIndexMap::Build( const vector< vec3d* > & pnt_vec, double tol, vector< int > & pnt_shift )
+{
+    Clear();
+    m_Tol = tol;
+
+    vector< vec3d > all_pnts( pnt_vec.size() );
+    vector< int > key_vec( pnt_vec.size() );
+    for ( size_t i = 0 ; i < pnt_vec.size() ; i++ )
+    {
+        all_pnts[i] = *pnt_vec[i];
+        key_vec[i] = ComputeKey( all_pnts[i] );
+    }
+
+    PntHashGrid all_grid;
+    all_grid.Build( all_pnts, tol );
+
+    vector< int > nbr_start;
+    vector< int > nbr_vec;
+    all_grid.FindNeighbors( tol, PntHashGrid::BOX_METRIC, nbr_start, nbr_vec );
+
+    //==== Keep Points Not Matching An Earlier Kept Point With The Same Key ====//
+    pnt_shift.assign( pnt_vec.size(), -999 );
+    int cnt = 0;
+    for ( int i = 0 ; i < ( int )pnt_vec.size() ; i++ )
+    {
+        bool keep = true;
+        for ( int j = nbr_start[i] ; j < nbr_start[i + 1] && nbr_vec[j] < i ; j++ )
+        {
+            int n = nbr_vec[j];
+            if ( pnt_shift[n] >= 0 && key_vec[n] == key_vec[i] )
+            {
+                keep = false;
+                break;
+            }
+        }
+
+        if ( keep )
+        {
+            pnt_shift[i] = cnt;
+            cnt++;
+            m_KeyMap[ key_vec[i] ].push_back( i );
+        }
+    }
+
+    m_Pnts.swap( all_pnts );
+
+    return cnt;
+}
+
+int PntIndexMap::Find( const vec3d & pnt ) const
+{
+    map< int, vector< int > >::const_iterator iter = m_KeyMap.find( ComputeKey( pnt ) );
+    if ( iter == m_KeyMap.end() )
+    {
+        return -1;
+    }
+
+    for ( int j = 0 ; j < ( int )iter->second.size() ; j++ )
+    {
+        int ind = iter->second[j];
+        if ( PntHashGrid::IsNear( pnt, m_Pnts[ind], m_Tol, PntHashGrid::BOX_METRIC ) )
+        {
+            return ind;
+        }
+    }
+    return -1;
+}
@@ -28,6 +28,7 @@
 #include "nanoflann.hpp"
 
 #include <vector>
+#include <map>
 using namespace std;
 using namespace nanoflann;
 
@@ -97,4 +98,97 @@ struct PntNodeCloud
 
 void IndexPntNodes( PntNodeCloud & cloud, double tol );
 
+//==== Uniform Hash Grid Over A Point Set ====//
+// Points are binned into cells a few merge distances across, and cells are
+// hashed into buckets.  Searches visit only the cells overlapping the search
+// box, so the cost per point does not depend on the size of the set.
+class PntHashGrid
+{
+public:
+
+    enum { DIST_SQ_METRIC,      // Squared distance below tol (nanoflann radius convention)
+           BOX_METRIC,          // Every coordinate within tol
+         };
+
+    PntHashGrid();
+
+    // radius is the largest merge distance the grid will be searched with.
+    void Build( const vector< vec3d > & pnts, double radius );
+    void Clear();
+
+    int NumPnts() const
+    {
+        return m_Pnts.size();
+    }
+    const vec3d & GetPnt( int i ) const
+    {
+        return m_Pnts[i];
+    }
+
+    static bool IsNear( const vec3d & a, const vec3d & b, double tol, int metric );
+
+    // Lowest numbered point near pnt, or -1.
+    int FindFirstNear( const vec3d & pnt, double tol, int metric ) const;
+
+    // All points near each point (including itself), flattened as
+    // nbr_vec[ nbr_start[i] ] ... nbr_vec[ nbr_start[i + 1] - 1 ] in ascending order.
+    void FindNeighbors( double tol, int metric, vector< int > & nbr_start, vector< int > & nbr_vec ) const;
+
+protected:
+
+    struct CellKey
+    {
+        long long m_I[3];
+
+        bool operator==( const CellKey & k ) const
+        {
+            return m_I[0] == k.m_I[0] && m_I[1] == k.m_I[1] && m_I[2] == k.m_I[2];
+        }
+    };
+
+    CellKey ComputeKey( const vec3d & pnt ) const;
+    unsigned int ComputeBucket( const CellKey & key ) const;
+
+    // Points in the cells overlapping the box around lo and hi grown by tol.
+    void FindCandidates( const vec3d & lo, const vec3d & hi, double tol, int metric, vector< int > & ind_vec ) const;
+
+    vector< vec3d > m_Pnts;
+    vec3d m_Origin;
+    double m_CellSize;
+
+    unsigned int m_BucketMask;
+    vector< int > m_BucketStart;        // Per bucket, first entry in m_BucketPnts (plus end)
+    vector< int > m_BucketPnts;         // Point indices sorted by bucket, ascending within a bucket
+    vector< CellKey > m_BucketKeys;     // Cell of each entry of m_BucketPnts
+};
+
+// Same groups as IndexPntNodes, with neighbors found through a PntHashGrid in parallel.
+void WeldPntNodes( PntNodeCloud & cloud, double tol );
+
+//==== Merged Point Numbering For Mesh Writers ====//
+// Points are bucketed by the sum of their coordinates.  A point is kept unless
+// every coordinate is within tol of an earlier kept point in the same bucket;
+// near points that straddle two buckets stay apart.  Find returns the lowest
+// numbered kept point in the bucket matching a position.
+class PntIndexMap
+{
+public:
+    PntIndexMap();
+
+    // Returns the number of kept points.  pnt_shift is the new number of each
+    // kept point and negative for the others.
+    int Build( const vector< vec3d* > & pnt_vec, double tol, vector< int > & pnt_shift );
+    void Clear();
+
+    int Find( const vec3d & pnt ) const;
+
+    static int ComputeKey( const vec3d & pnt );
+
+protected:
+
+    double m_Tol;
+    vector< vec3d > m_Pnts;                     // Copy of pnt_vec
+    map< int, vector< int > > m_KeyMap;         // Kept points in each bucket
+};
+
 #endif
@@ -169,3 +169,14 @@ void SimpleTess::CalcTexCoords( )
         }
     }
 }
+
+SimpleTessInstance::SimpleTessInstance()
+{
+    m_MainIndx = 0;
+    m_FlipNormal = false;
+}
+
+void SimpleTessInstance::Transform( const Matrix4d & mat )
+{
+    m_XForm.postMult( mat );
+}
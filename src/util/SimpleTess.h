@@ -36,4 +36,23 @@ public:
     vector< vector< vector< double > > > m_vtex;
 };
 
+//==== Placement Of A Shared SimpleTess ====//
+// Stands in for a transformed copy of m_MainIndx, so symmetric copies and
+// propeller blades keep one tessellation and a matrix each.
+class SimpleTessInstance
+{
+public:
+    SimpleTessInstance();
+
+    bool GetFlipNormal() const { return m_FlipNormal; }
+    void FlipNormal() { m_FlipNormal = !m_FlipNormal; }
+
+    // Applied after any transform already held.
+    void Transform( const Matrix4d & mat );
+
+    int m_MainIndx;
+    bool m_FlipNormal;
+    Matrix4d m_XForm;
+};
+
 #endif // SIMPLETESS_H
\ No newline at end of file
@@ -11,6 +11,9 @@
 #include "StringUtil.h"
 #include "StlHelper.h"
 #include "VspUtil.h"
+#include "PntNodeMerge.h"
+#include "FileUtil.h"
+#include "MeshTopology.h"
 
 //==== Test vec2d ====//
 void UtilTestSuite::Vec2dUtilTest()
@@ -716,3 +719,265 @@ void UtilTestSuite::NumbersTest()
 //        printf( "%d\t%f\t%f\t%f\t%f\t%f\n", i, di, magx, magrd, magru, magp1ru );
     }
 }
+
+void UtilTestSuite::PntHashGridTest()
+{
+    //==== Grid Of Points, Each Repeated With Small Perturbations ====//
+    double eps = 1.0e-9;
+    vector< vec3d > pnts;
+    for ( int i = 0 ; i < 40 ; i++ )
+    {
+        for ( int j = 0 ; j < 40 ; j++ )
+        {
+            vec3d p( 0.1 * i, 0.1 * j, sin( 0.1 * i ) );
+            pnts.push_back( p );
+            pnts.push_back( p + vec3d( eps * ( i % 3 ), 0, 0 ) );
+            pnts.push_back( p + vec3d( 0, -eps * ( j % 3 ), 0 ) );
+        }
+    }
+
+    //==== Same Groups As The Kd-Tree ====//
+    double tol_vec[3] = { 1.0e-20, 2.0e-18, 0.02 };
+    for ( int t = 0 ; t < 3 ; t++ )
+    {
+        PntNodeCloud tree_cloud;
+        PntNodeCloud grid_cloud;
+        tree_cloud.AddPntNodes( pnts );
+        grid_cloud.AddPntNodes( pnts );
+
+        IndexPntNodes( tree_cloud, tol_vec[t] );
+        WeldPntNodes( grid_cloud, tol_vec[t] );
+
+        TEST_ASSERT( tree_cloud.m_NumUsedPts == grid_cloud.m_NumUsedPts );
+        for ( int i = 0 ; i < ( int )pnts.size() ; i++ )
+        {
+            TEST_ASSERT( tree_cloud.GetNodeBaseIndex( i ) == grid_cloud.GetNodeBaseIndex( i ) );
+        }
+    }
+
+    //==== Box Matching For Mesh Writers ====//
+    vector< vec3d* > pnt_ptr_vec( pnts.size() );
+    for ( int i = 0 ; i < ( int )pnts.size() ; i++ )
+    {
+        pnt_ptr_vec[i] = &pnts[i];
+    }
+
+    //==== Reference Coordinate Sum Buckets ====//
+    double box_tol = 2.5 * eps;
+    map< int, vector< int > > ref_map;
+    int ref_kept = 0;
+    for ( int i = 0 ; i < ( int )pnts.size() ; i++ )
+    {
+        vector< int > & bucket = ref_map[ PntIndexMap::ComputeKey( pnts[i] ) ];
+        bool add_flag = true;
+        for ( int j = 0 ; j < ( int )bucket.size() ; j++ )
+        {
+            if ( PntHashGrid::IsNear( pnts[i], pnts[ bucket[j] ], box_tol, PntHashGrid::BOX_METRIC ) )
+            {
+                add_flag = false;
+            }
+        }
+        if ( add_flag )
+        {
+            bucket.push_back( i );
+            ref_kept++;
+        }
+    }
+
+    PntIndexMap ind_map;
+    vector< int > pnt_shift;
+    int num_kept = ind_map.Build( pnt_ptr_vec, box_tol, pnt_shift );
+    TEST_ASSERT( num_kept == ref_kept );
+
+    for ( int i = 0 ; i < ( int )pnts.size() ; i++ )
+    {
+        vector< int > & bucket = ref_map[ PntIndexMap::ComputeKey( pnts[i] ) ];
+        int ref_ind = -1;
+        for ( int j = 0 ; j < ( int )bucket.size() && ref_ind < 0 ; j++ )
+        {
+            if ( PntHashGrid::IsNear( pnts[i], pnts[ bucket[j] ], box_tol, PntHashGrid::BOX_METRIC ) )
+            {
+                ref_ind = bucket[j];
+            }
+        }
+
+        int ind = ind_map.Find( pnts[i] );
+        TEST_ASSERT( ind == ref_ind );
+        TEST_ASSERT( ind >= 0 && pnt_shift[ind] >= 0 );
+    }
+    TEST_ASSERT( ind_map.Find( vec3d( 0.05, 0.05, 0.05 ) ) < 0 );
+
+    //==== Near Points In Different Buckets Stay Apart ====//
+    vector< vec3d > straddle_pnts;
+    straddle_pnts.push_back( vec3d( 0, 0, 1.0e-4 - 2.0e-13 ) );
+    straddle_pnts.push_back( vec3d( 0, 0, 1.0e-4 + 2.0e-13 ) );
+    straddle_pnts.push_back( vec3d( 0, 0, 1.0e-4 + 4.0e-13 ) );
+    vector< vec3d* > straddle_ptr_vec;
+    for ( int i = 0 ; i < ( int )straddle_pnts.size() ; i++ )
+    {
+        straddle_ptr_vec.push_back( &straddle_pnts[i] );
+    }
+
+    PntIndexMap straddle_map;
+    TEST_ASSERT( straddle_map.Build( straddle_ptr_vec, 1.0e-12, pnt_shift ) == 2 );
+    TEST_ASSERT( straddle_map.Find( straddle_pnts[0] ) == 0 );
+    TEST_ASSERT( straddle_map.Find( straddle_pnts[1] ) == 1 );
+    TEST_ASSERT( straddle_map.Find( straddle_pnts[2] ) == 1 );
+}
+
+void UtilTestSuite::ExportFileTest()
+{
+    TEST_ASSERT( IsGzipFileName( "mesh.tri.gz" ) );
+    TEST_ASSERT( !IsGzipFileName( "mesh.tri" ) );
+    TEST_ASSERT( !IsGzipFileName( ".gz" ) );
+    TEST_ASSERT( StripGzipSuffix( "mesh.tri.gz" ) == "mesh.tri" );
+    TEST_ASSERT( StripGzipSuffix( "mesh.tri" ) == "mesh.tri" );
+
+    //==== Plain Text ====//
+    FILE* fp = OpenExportFile( "export_file_test.txt" );
+    TEST_ASSERT( fp != NULL );
+    if ( fp )
+    {
+        fprintf( fp, "export\n" );
+        fclose( fp );
+    }
+
+    fp = fopen( "export_file_test.txt", "rb" );
+    TEST_ASSERT( fp != NULL );
+    if ( fp )
+    {
+        char buf[8] = {};
+        TEST_ASSERT( fread( buf, 1, 7, fp ) == 7 );
+        TEST_ASSERT( string( buf ) == "export\n" );
+        fclose( fp );
+    }
+
+    //==== Gzip Stream ====//
+    fp = OpenExportFile( "export_file_test.txt.gz" );
+    if ( !ExportCompressionAvailable() )
+    {
+        TEST_ASSERT( fp == NULL );
+        return;
+    }
+
+    TEST_ASSERT( fp != NULL );
+    if ( fp )
+    {
+        for ( int i = 0 ; i < 100000 ; i++ )
+        {
+            fprintf( fp, "%d %16.10g\n", i, 0.5 * i );
+        }
+        fclose( fp );
+    }
+
+    fp = fopen( "export_file_test.txt.gz", "rb" );
+    TEST_ASSERT( fp != NULL );
+    if ( fp )
+    {
+        // Gzip magic number, and much smaller than the text
+        unsigned char magic[2] = {};
+        TEST_ASSERT( fread( magic, 1, 2, fp ) == 2 );
+        TEST_ASSERT( magic[0] == 0x1f && magic[1] == 0x8b );
+
+        fseek( fp, 0, SEEK_END );
+        long size = ftell( fp );
+        TEST_ASSERT( size > 0 && size < 100000 * 10 );
+        fclose( fp );
+    }
+}
+
+//==== Closed, Consistently Oriented Torus Of n x n Quads, Split Into Tris When tris Is Set ====//
+static void BuildTorusFaces( int n, bool tris, vector< int > & face_start, vector< int > & face_nodes )
+{
+    face_start.assign( 1, 0 );
+    face_nodes.clear();
+    for ( int i = 0 ; i < n ; i++ )
+    {
+        for ( int j = 0 ; j < n ; j++ )
+        {
+            int n0 = i * n + j;
+            int n1 = ( ( i + 1 ) % n ) * n + j;
+            int n2 = ( ( i + 1 ) % n ) * n + ( j + 1 ) % n;
+            int n3 = i * n + ( j + 1 ) % n;
+            if ( tris )
+            {
+                int t[6] = { n0, n1, n2, n0, n2, n3 };
+                face_nodes.insert( face_nodes.end(), t, t + 6 );
+                face_start.push_back( face_nodes.size() - 3 );
+            }
+            else
+            {
+                int q[4] = { n0, n1, n2, n3 };
+                face_nodes.insert( face_nodes.end(), q, q + 4 );
+            }
+            face_start.push_back( face_nodes.size() );
+        }
+    }
+}
+
+void UtilTestSuite::MeshTopologyTest()
+{
+    vector< int > face_start;
+    vector< int > face_nodes;
+    MeshTopology topo;
+
+    //==== Closed Quads And Tris ====//
+    BuildTorusFaces( 40, false, face_start, face_nodes );
+    topo.Check( face_start, face_nodes );
+    TEST_ASSERT( topo.m_NumFaces == 1600 );
+    TEST_ASSERT( topo.m_NumEdges == 3200 );
+    TEST_ASSERT( topo.IsWaterTight() && topo.IsOriented() );
+
+    BuildTorusFaces( 40, true, face_start, face_nodes );
+    topo.CheckTris( face_nodes );
+    TEST_ASSERT( topo.m_NumFaces == 3200 );
+    TEST_ASSERT( topo.m_NumEdges == 4800 );
+    TEST_ASSERT( topo.IsWaterTight() && topo.IsOriented() );
+    TEST_ASSERT( topo.m_DegenerateFaceVec.empty() );
+
+    //==== Flipped Tri ====//
+    vector< int > tri_nodes = face_nodes;
+    std::swap( tri_nodes[ 3 * 7 + 1 ], tri_nodes[ 3 * 7 + 2 ] );
+    topo.CheckTris( tri_nodes );
+    TEST_ASSERT( topo.IsWaterTight() );
+    TEST_ASSERT( topo.m_FlippedEdgeVec.size() == 3 );
+    TEST_ASSERT( topo.m_FlippedFaceVec.size() == 3 );
+    TEST_ASSERT( std::binary_search( topo.m_FlippedFaceVec.begin(), topo.m_FlippedFaceVec.end(), 7 ) );
+
+    //==== Missing Tri ====//
+    tri_nodes.assign( face_nodes.begin() + 3, face_nodes.end() );
+    topo.CheckTris( tri_nodes );
+    TEST_ASSERT( !topo.IsWaterTight() && topo.IsOriented() );
+    TEST_ASSERT( topo.m_OpenEdgeVec.size() == 3 );
+    TEST_ASSERT( topo.m_OpenEdgeFaceVec.size() == 3 );
+    TEST_ASSERT( topo.m_NonManifoldEdgeVec.empty() );
+    for ( int i = 0 ; i < ( int )topo.m_OpenEdgeVec.size() ; i++ )
+    {
+        TEST_ASSERT( topo.m_OpenEdgeVec[i].first < topo.m_OpenEdgeVec[i].second );
+        int f = topo.m_OpenEdgeFaceVec[i];
+        int nmatch = 0;
+        for ( int k = 0 ; k < 3 ; k++ )
+        {
+            int a = tri_nodes[ 3 * f + k ];
+            nmatch += ( a == topo.m_OpenEdgeVec[i].first || a == topo.m_OpenEdgeVec[i].second );
+        }
+        TEST_ASSERT( nmatch == 2 );
+    }
+
+    //==== Repeated Tri, Plus A Degenerate One Folded Back On Itself ====//
+    tri_nodes = face_nodes;
+    tri_nodes.insert( tri_nodes.end(), face_nodes.begin() + 30, face_nodes.begin() + 33 );
+    tri_nodes.push_back( 5 );
+    tri_nodes.push_back( 5 );
+    tri_nodes.push_back( 500 );
+    topo.CheckTris( tri_nodes );
+    TEST_ASSERT( topo.m_NonManifoldEdgeVec.size() == 3 );
+    TEST_ASSERT( topo.m_NumExcessUses == 3 );
+    TEST_ASSERT( topo.m_ExcessFaceVec.size() == 1 && topo.m_ExcessFaceVec[0] == 3200 );
+    TEST_ASSERT( topo.m_DegenerateFaceVec.size() == 1 && topo.m_DegenerateFaceVec[0] == 3201 );
+    TEST_ASSERT( topo.m_OpenEdgeVec.empty() && topo.IsOriented() );
+
+    //==== Empty ====//
+    topo.CheckTris( vector< int >() );
+    TEST_ASSERT( topo.m_NumFaces == 0 && topo.m_NumEdges == 0 && topo.IsWaterTight() );
+}
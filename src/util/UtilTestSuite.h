@@ -38,6 +38,9 @@ public:
         TEST_ADD( UtilTestSuite::BilinearInterpTest )
         TEST_ADD( UtilTestSuite::FormatWidthTest )
         TEST_ADD( UtilTestSuite::NumbersTest )
+        TEST_ADD( UtilTestSuite::PntHashGridTest )
+        TEST_ADD( UtilTestSuite::ExportFileTest )
+        TEST_ADD( UtilTestSuite::MeshTopologyTest )
     }
 
 private:
@@ -52,6 +55,9 @@ private:
     void BilinearInterpTest();
     void FormatWidthTest();
     void NumbersTest();
+    void PntHashGridTest();
+    void ExportFileTest();
+    void MeshTopologyTest();
 
     static void WritePntVecs( vector< vector< vec3d > > & pnt_vecs,  string file_name );
     void WriteCurve( VspCurve& crv, string file_name );
@@ -1554,6 +1554,72 @@ void BilinearWeights( const vec3d & p0, const vec3d & p1, const vec3d & p, std::
 
 }
 
+static double clamp_unit( double val )
+{
+    return std::min( std::max( val, 0.0 ), 1.0 );
+}
+
+//==== Squared Distance Between Segments, Parallel Test Relative To Segment Lengths ====//
+static double seg_seg_dist_squared( const vec3d & p0, const vec3d & p1, const vec3d & q0, const vec3d & q1 )
+{
+    vec3d d1 = p1 - p0;
+    vec3d d2 = q1 - q0;
+    vec3d r = p0 - q0;
+
+    double a = dot( d1, d1 );
+    double e = dot( d2, d2 );
+    double f = dot( d2, r );
+
+    double s = 0.0;
+    double t = 0.0;
+
+    if ( a <= DBL_EPSILON && e <= DBL_EPSILON )
+    {
+        return dot( r, r );
+    }
+
+    if ( a <= DBL_EPSILON )
+    {
+        t = clamp_unit( f / e );
+    }
+    else
+    {
+        double c = dot( d1, r );
+        if ( e <= DBL_EPSILON )
+        {
+            s = clamp_unit( -c / a );
+        }
+        else
+        {
+            double b = dot( d1, d2 );
+            double denom = a * e - b * b;
+
+            //==== Parallel Segments Pick s = 0 ====//
+            if ( denom > DBL_EPSILON * a * e )
+            {
+                s = clamp_unit( ( b * f - c * e ) / denom );
+            }
+
+            t = ( b * s + f ) / e;
+            if ( t < 0.0 )
+            {
+                t = 0.0;
+                s = clamp_unit( -c / a );
+            }
+            else if ( t > 1.0 )
+            {
+                t = 1.0;
+                s = clamp_unit( ( b - c ) / a );
+            }
+        }
+    }
+
+    return dist_squared( p0 + d1 * s, q0 + d2 * t );
+}
+
+//==== Min Distance Between Two Non-Intersecting Tris ====//
+// The closest pair is either a vertex and the other tri or two edges.
+// Intersecting tris must be caught with tri_tri_intersection_test_3d first.
 double tri_tri_min_dist( vec3d & v0, vec3d & v1, vec3d & v2, vec3d & v3, vec3d & v4, vec3d & v5 )
 {
     double d;
@@ -1567,31 +1633,85 @@ double tri_tri_min_dist( vec3d & v0, vec3d & v1, vec3d & v2, vec3d & v3, vec3d &
     d = pnt_tri_min_dist( v3, v4, v5, v1 );     min_dist = std::min( d, min_dist );
     d = pnt_tri_min_dist( v3, v4, v5, v2 );     min_dist = std::min( d, min_dist );
 
-    return min_dist;
+    //==== Edge Pairs ====//
+    const vec3d* a[3] = { &v0, &v1, &v2 };
+    const vec3d* b[3] = { &v3, &v4, &v5 };
+
+    double min_dist2 = min_dist * min_dist;
+    for ( int i = 0 ; i < 3 ; i++ )
+    {
+        for ( int j = 0 ; j < 3 ; j++ )
+        {
+            double d2 = seg_seg_dist_squared( *a[i], *a[( i + 1 ) % 3], *b[j], *b[( j + 1 ) % 3] );
+            min_dist2 = std::min( d2, min_dist2 );
+        }
+    }
+
+    return std::min( min_dist, sqrt( min_dist2 ) );
 }
 
 double pnt_tri_min_dist( vec3d & v0, vec3d & v1, vec3d & v2, vec3d & pnt )
 {
-    vec2d uw = MapToPlane( pnt, v0, v1-v0, v2-v0 );
-    vec3d plnpnt = MapFromPlane( uw, v0, v1-v0, v2-v0 );
+    return dist( pnt, pnt_tri_closest_pnt( v0, v1, v2, pnt ) );
+}
+
+//==== Closest Point On Tri, Found By Which Vertex, Edge Or Face Region Holds pnt ====//
+// Stays well defined for degenerate tris, unlike a projection to the tri plane.
+vec3d pnt_tri_closest_pnt( const vec3d & v0, const vec3d & v1, const vec3d & v2, const vec3d & pnt )
+{
+    vec3d ab = v1 - v0;
+    vec3d ac = v2 - v0;
+    vec3d ap = pnt - v0;
+
+    double d1 = dot( ab, ap );
+    double d2 = dot( ac, ap );
+    if ( d1 <= 0.0 && d2 <= 0.0 )
+    {
+        return v0;
+    }
+
+    vec3d bp = pnt - v1;
+    double d3 = dot( ab, bp );
+    double d4 = dot( ac, bp );
+    if ( d3 >= 0.0 && d4 <= d3 )
+    {
+        return v1;
+    }
+
+    double vc = d1 * d4 - d3 * d2;
+    if ( vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0 )
+    {
+        return v0 + ab * ( d1 / ( d1 - d3 ) );
+    }
+
+    vec3d cp = pnt - v2;
+    double d5 = dot( ab, cp );
+    double d6 = dot( ac, cp );
+    if ( d6 >= 0.0 && d5 <= d6 )
+    {
+        return v2;
+    }
+
+    double vb = d5 * d2 - d1 * d6;
+    if ( vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0 )
+    {
+        return v0 + ac * ( d2 / ( d2 - d6 ) );
+    }
+
+    double va = d3 * d6 - d5 * d4;
+    if ( va <= 0.0 && ( d4 - d3 ) >= 0.0 && ( d5 - d6 ) >= 0.0 )
+    {
+        return v1 + ( v2 - v1 ) * ( ( d4 - d3 ) / ( ( d4 - d3 ) + ( d5 - d6 ) ) );
+    }
 
-    //====  Check If Point In Tri ====//
-    if ( uw[0] >= 0.0 && uw[0] <= 1.0 && uw[1] >= 0.0 && uw[1] <= 1.0 && 
-         uw[0] + uw[1] <= 1.0 )
+    double sum = va + vb + vc;
+    if ( sum <= 0.0 )
     {
-        return dist( pnt, plnpnt );
+        return v0;
     }
-    double t;
-    double d01 = pointSegDistSquared( pnt, v0, v1, &t );
-    double d12 = pointSegDistSquared( pnt, v1, v2, &t );
-    double d20 = pointSegDistSquared( pnt, v2, v0, &t );
 
-    if ( d01 < d12 && d01 < d20 )
-        return sqrt(d01);
-    else if ( d12 < d20 )
-        return sqrt(d12);
-    else 
-        return sqrt(d20);
+    double denom = 1.0 / sum;
+    return v0 + ab * ( vb * denom ) + ac * ( vc * denom );
 }
 
 namespace std
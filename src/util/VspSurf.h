@@ -198,6 +198,10 @@ public:
 
     void ResetUSkip() const;
     void FlagDuplicate( const VspSurf &othersurf ) const;
+    const vector < bool > & GetUSkip() const
+    {
+        return m_USkip;
+    }
 
     void SetClustering( const double &le, const double &te );
     void SetRootTipClustering( const vector < double > &root, const vector < double > &tip ) const;
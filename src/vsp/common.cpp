@@ -127,6 +127,9 @@ int batchMode( int argc, char *argv[], Vehicle* vPtr, int &ret )
 
     if ( scriptModeFlag )
     {
+        // Nothing is drawn in batch mode
+        vPtr->SetHeadless( true );
+
         // Read Script File
         ret = vPtr->RunScript( script_filename );
         return scriptModeFlag;
@@ -7,6 +7,7 @@
 #include "XmlUtil.h"
 #include "StringUtil.h"
 #include <cfloat>
+#include <stdint.h>
 
 //==== Get Number of Same Names ====//
 unsigned int XmlUtil::GetNumNames( xmlNodePtr node, const char * name )
@@ -668,6 +669,211 @@ vector< vec3d > XmlUtil::GetVectorVec3dNode( xmlNodePtr node )
     return ret_vec;
 }
 
+static const char base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Base64 characters per Chunk node, well under the libxml text node limit.
+static const size_t base64_chunk_size = 1 << 22;
+
+//==== Encode Bytes As Base64 ====//
+string XmlUtil::EncodeBase64( const unsigned char * data, size_t len )
+{
+    string str;
+    str.reserve( 4 * ( ( len + 2 ) / 3 ) );
+
+    size_t i = 0;
+    for ( ; i + 2 < len ; i += 3 )
+    {
+        uint32_t v = ( data[i] << 16 ) | ( data[i + 1] << 8 ) | data[i + 2];
+        str.push_back( base64_chars[ ( v >> 18 ) & 0x3F ] );
+        str.push_back( base64_chars[ ( v >> 12 ) & 0x3F ] );
+        str.push_back( base64_chars[ ( v >> 6 ) & 0x3F ] );
+        str.push_back( base64_chars[ v & 0x3F ] );
+    }
+
+    if ( i < len )
+    {
+        uint32_t v = data[i] << 16;
+        if ( i + 1 < len )
+        {
+            v |= data[i + 1] << 8;
+        }
+        str.push_back( base64_chars[ ( v >> 18 ) & 0x3F ] );
+        str.push_back( base64_chars[ ( v >> 12 ) & 0x3F ] );
+        str.push_back( i + 1 < len ? base64_chars[ ( v >> 6 ) & 0x3F ] : '=' );
+        str.push_back( '=' );
+    }
+
+    return str;
+}
+
+//==== Decode Base64, Appending To Data ====//
+// Whitespace is skipped.  Returns false on any other invalid character.
+bool XmlUtil::DecodeBase64( const char * str, vector< unsigned char > & data )
+{
+    int lookup[256];
+    for ( int i = 0 ; i < 256 ; i++ )
+    {
+        lookup[i] = -1;
+    }
+    for ( int i = 0 ; i < 64 ; i++ )
+    {
+        lookup[ ( unsigned char )base64_chars[i] ] = i;
+    }
+
+    uint32_t v = 0;
+    int nbits = 0;
+    for ( const char* c = str ; *c ; c++ )
+    {
+        unsigned char ch = ( unsigned char )*c;
+        if ( ch == '=' )
+        {
+            break;
+        }
+        if ( ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t' )
+        {
+            continue;
+        }
+        if ( lookup[ch] < 0 )
+        {
+            return false;
+        }
+
+        v = ( v << 6 ) | lookup[ch];
+        nbits += 6;
+        if ( nbits >= 8 )
+        {
+            nbits -= 8;
+            data.push_back( ( unsigned char )( ( v >> nbits ) & 0xFF ) );
+        }
+    }
+    return true;
+}
+
+//==== Create Node and Add Base64 Chunks ====//
+xmlNodePtr XmlUtil::AddBase64Node( xmlNodePtr root, const char * name, const vector< unsigned char > & data )
+{
+    xmlNodePtr node = xmlNewChild( root, NULL, ( const xmlChar * )name, NULL );
+    SetIntProp( node, "Bytes", ( int )data.size() );
+
+    // Chunk boundaries fall on whole 3 byte groups so each chunk decodes alone.
+    size_t chunk_bytes = 3 * ( base64_chunk_size / 4 );
+    for ( size_t start = 0 ; start < data.size() ; start += chunk_bytes )
+    {
+        size_t len = std::min( chunk_bytes, data.size() - start );
+        AddStringNode( node, "Chunk", EncodeBase64( &data[start], len ) );
+    }
+
+    return node;
+}
+
+//==== Create Node and Add Vector Of Ints (32 Bit Little Endian) ====//
+xmlNodePtr XmlUtil::AddVectorIntBase64Node( xmlNodePtr root, const char * name, const vector< int > & vec )
+{
+    vector< unsigned char > data( 4 * vec.size() );
+    for ( size_t i = 0 ; i < vec.size() ; i++ )
+    {
+        uint32_t v = ( uint32_t )vec[i];
+        for ( int b = 0 ; b < 4 ; b++ )
+        {
+            data[ 4 * i + b ] = ( unsigned char )( ( v >> ( 8 * b ) ) & 0xFF );
+        }
+    }
+    return AddBase64Node( root, name, data );
+}
+
+//==== Create Node and Add Vector Of Doubles (IEEE 754 Little Endian) ====//
+xmlNodePtr XmlUtil::AddVectorDoubleBase64Node( xmlNodePtr root, const char * name, const vector< double > & vec )
+{
+    vector< unsigned char > data( 8 * vec.size() );
+    for ( size_t i = 0 ; i < vec.size() ; i++ )
+    {
+        uint64_t v;
+        memcpy( &v, &vec[i], 8 );
+        for ( int b = 0 ; b < 8 ; b++ )
+        {
+            data[ 8 * i + b ] = ( unsigned char )( ( v >> ( 8 * b ) ) & 0xFF );
+        }
+    }
+    return AddBase64Node( root, name, data );
+}
+
+//==== Extract Base64 Chunks ====//
+// Returns an empty vector if the node is missing or the data is not the
+// recorded size.
+vector< unsigned char > XmlUtil::ExtractBase64Node( xmlNodePtr root, const char * name )
+{
+    vector< unsigned char > data;
+
+    xmlNodePtr node = GetNode( root, name, 0 );
+    if ( !node )
+    {
+        return data;
+    }
+
+    int nbytes = FindIntProp( node, "Bytes", 0 );
+    data.reserve( nbytes );
+
+    for ( xmlNodePtr iter_node = node->xmlChildrenNode ; iter_node != NULL ; iter_node = iter_node->next )
+    {
+        if ( !xmlStrcmp( iter_node->name, ( const xmlChar * )"Chunk" ) )
+        {
+            char* str = ( char* )xmlNodeListGetString( iter_node->doc, iter_node->xmlChildrenNode, 1 );
+            if ( str )
+            {
+                bool valid = DecodeBase64( str, data );
+                xmlFree( str );
+                if ( !valid )
+                {
+                    data.clear();
+                    return data;
+                }
+            }
+        }
+    }
+
+    if ( ( int )data.size() != nbytes )
+    {
+        data.clear();
+    }
+    return data;
+}
+
+//==== Extract Vector Of Ints (32 Bit Little Endian) ====//
+vector< int > XmlUtil::ExtractVectorIntBase64Node( xmlNodePtr root, const char * name )
+{
+    vector< unsigned char > data = ExtractBase64Node( root, name );
+
+    vector< int > ret_vec( data.size() / 4 );
+    for ( size_t i = 0 ; i < ret_vec.size() ; i++ )
+    {
+        uint32_t v = 0;
+        for ( int b = 0 ; b < 4 ; b++ )
+        {
+            v |= ( uint32_t )data[ 4 * i + b ] << ( 8 * b );
+        }
+        ret_vec[i] = ( int )v;
+    }
+    return ret_vec;
+}
+
+//==== Extract Vector Of Doubles (IEEE 754 Little Endian) ====//
+vector< double > XmlUtil::ExtractVectorDoubleBase64Node( xmlNodePtr root, const char * name )
+{
+    vector< unsigned char > data = ExtractBase64Node( root, name );
+
+    vector< double > ret_vec( data.size() / 8 );
+    for ( size_t i = 0 ; i < ret_vec.size() ; i++ )
+    {
+        uint64_t v = 0;
+        for ( int b = 0 ; b < 8 ; b++ )
+        {
+            v |= ( uint64_t )data[ 8 * i + b ] << ( 8 * b );
+        }
+        memcpy( &ret_vec[i], &v, 8 );
+    }
+    return ret_vec;
+}
+
 //==== Encode File Contents ====//
 xmlNodePtr XmlUtil::EncodeFileContents( xmlNodePtr root, const char* file_name )
 {
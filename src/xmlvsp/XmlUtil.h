@@ -68,6 +68,19 @@ vec2d GetVec2dNode( xmlNodePtr node );
 vec3d GetVec3dNode( xmlNodePtr node );
 vector< vec3d > GetVectorVec3dNode( xmlNodePtr node );
 
+// Binary arrays, stored little endian and base64 encoded in Chunk children
+// (libxml limits the size of a single text node).
+xmlNodePtr AddBase64Node( xmlNodePtr root, const char * name, const vector< unsigned char > & data );
+xmlNodePtr AddVectorIntBase64Node( xmlNodePtr root, const char * name, const vector< int > & vec );
+xmlNodePtr AddVectorDoubleBase64Node( xmlNodePtr root, const char * name, const vector< double > & vec );
+
+vector< unsigned char > ExtractBase64Node( xmlNodePtr root, const char * name );
+vector< int >    ExtractVectorIntBase64Node( xmlNodePtr root, const char * name );
+vector< double > ExtractVectorDoubleBase64Node( xmlNodePtr root, const char * name );
+
+string EncodeBase64( const unsigned char * data, size_t len );
+bool DecodeBase64( const char * str, vector< unsigned char > & data );
+
 xmlNodePtr EncodeFileContents( xmlNodePtr root, const char* file_name );
 xmlNodePtr DecodeFileContents( xmlNodePtr root, const char* file_name );
 